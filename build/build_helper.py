@@ -322,6 +322,7 @@ if __name__ == '__main__':
     gn.add(BooleanArg('is_defined_JASL_USE_STD_STRING_VIEW_AS_BASE', 'ssv'))
     gn.add(BooleanArg('is_defined_JASL_SUPPORT_STD_TO_JASL', 's2j'))
     gn.add(BooleanArg('is_defined_JASL_SUPPORT_JASL_TO_STD', 'j2s'))
+    gn.add(BooleanArg('is_defined_JASL_DISABLE_SIMD', 'nosimd'))
 
     # These filters exclude illegal variations
     gn.filter_out(lambda x: is_sanitizer(
@@ -0,0 +1,298 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_hash.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+// A block is a cache line: every key sets and tests bits of one block only.
+constexpr size_t bloom_block_bits = 512;
+constexpr size_t bloom_block_words = bloom_block_bits / 64;
+constexpr unsigned bloom_max_hash_count = 16;
+// keys hashed (and their blocks prefetched) before the bulk operations touch
+// the blocks
+constexpr size_t bloom_batch_size = 16;
+
+/**
+ * The false positive rate of a blocked Bloom filter: the number of the keys
+ * in a block is Poisson distributed, the rate of a block is the rate of a
+ * classic Bloom filter of 512 bits with that many keys.
+ */
+inline double bloom_false_positive_rate(double keys_per_block,
+                                        unsigned hash_count) {
+  const double spread = 10 * std::sqrt(keys_per_block) + 10;
+  const double bits = static_cast<double>(bloom_block_bits);
+  const double k = static_cast<double>(hash_count);
+  double rate = 0;
+  for (double i = std::max(std::floor(keys_per_block - spread), 0.0);
+       i <= keys_per_block + spread; ++i) {
+    const double probability = std::exp(
+        i * std::log(keys_per_block) - keys_per_block - std::lgamma(i + 1));
+    rate += probability * std::pow(1 - std::pow(1 - 1 / bits, i * k), k);
+  }
+  return rate;
+}
+
+}  // namespace inner
+
+/**
+ * Cache-blocked Bloom filter of strings: a set with false positives but no
+ * false negatives. The bits of a key are in a single 64 byte block, so an
+ * insert or a query touches one cache line, and the bits are derived from the
+ * one 128 bit hash of the key: the first half chooses the block, the bits
+ * are the top 9 bits of an enhanced double hashing sequence of the halves.
+ *
+ * The bulk operations hash a batch of keys and prefetch their blocks first,
+ * so the cache misses of the batch overlap.
+ *
+ * The keys are not spread evenly among the blocks, so a blocked filter needs
+ * more bits than a classic one for the same false positive rate: it is sized
+ * by the rate of the blocked layout.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_bloom_filter {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+ private:
+  std::unique_ptr<uint64_t[]> _storage;
+  uint64_t* _blocks;  // 64 byte aligned in _storage
+  size_t _block_count;
+  unsigned _hash_count;
+
+ public:
+  /**
+   * Sized for expected_count keys with the given false positive rate.
+   * Throws std::invalid_argument if the rate isn't in (0, 1).
+   */
+  explicit basic_bloom_filter(size_t expected_count,
+                              double false_positive_rate = 0.01)
+      : _blocks(nullptr), _block_count(0), _hash_count(0) {
+    if (!(false_positive_rate > 0 && false_positive_rate < 1)) {
+      JASL_THROW(std::invalid_argument(
+          "bloom_filter: false_positive_rate is not in (0, 1)"));
+    }
+    const double ln2 = 0.6931471805599453;
+    const double n = static_cast<double>(std::max<size_t>(expected_count, 1));
+    // the size of a classic Bloom filter, grown until the blocked one is good
+    double blocks = std::ceil(-n * std::log(false_positive_rate) /
+                              (ln2 * ln2) /
+                              static_cast<double>(inner::bloom_block_bits));
+    for (;; blocks = std::ceil(blocks * 1.05)) {
+      double best = 1;
+      for (unsigned k = 1; k <= inner::bloom_max_hash_count; ++k) {
+        const double rate = inner::bloom_false_positive_rate(n / blocks, k);
+        if (rate < best) {
+          best = rate;
+          _hash_count = k;
+        }
+      }
+      if (best <= false_positive_rate)
+        break;
+    }
+    // the block is chosen by the high 32 bits of a hash
+    if (blocks > 4294967296.0)
+      JASL_THROW(std::length_error("bloom_filter: too many bits"));
+    _block_count = std::max<size_t>(static_cast<size_t>(blocks), 1);
+    const size_t words = _block_count * inner::bloom_block_words;
+    _storage.reset(new uint64_t[words + inner::bloom_block_words - 1]);
+    const uintptr_t address = reinterpret_cast<uintptr_t>(_storage.get());
+    _blocks = _storage.get() + (64 - address % 64) % 64 / sizeof(uint64_t);
+    clear();
+  }
+
+  /**
+   * The moved-from filter has no bits: it can only be assigned to, cleared
+   * or destroyed.
+   */
+  basic_bloom_filter(basic_bloom_filter&& other) noexcept
+      : _storage(std::move(other._storage)),
+        _blocks(other._blocks),
+        _block_count(other._block_count),
+        _hash_count(other._hash_count) {
+    other.reset();
+  }
+
+  basic_bloom_filter& operator=(basic_bloom_filter&& other) noexcept {
+    if (this != &other) {
+      _storage = std::move(other._storage);
+      _blocks = other._blocks;
+      _block_count = other._block_count;
+      _hash_count = other._hash_count;
+      other.reset();
+    }
+    return *this;
+  }
+
+  size_t bit_count() const noexcept {
+    return _block_count * inner::bloom_block_bits;
+  }
+
+  /**
+   * Number of bits set and tested per key.
+   */
+  unsigned hash_count() const noexcept { return _hash_count; }
+
+  /**
+   * Bytes allocated by the filter.
+   */
+  size_t memory_usage() const noexcept {
+    if (!_storage)
+      return 0;
+    return (_block_count + 1) * inner::bloom_block_words * sizeof(uint64_t) -
+           sizeof(uint64_t);
+  }
+
+  void clear() noexcept {
+    if (_block_count == 0)
+      return;
+    std::memset(_blocks, 0,
+                _block_count * inner::bloom_block_words * sizeof(uint64_t));
+  }
+
+  void insert(string_view_type key) noexcept {
+    uint64_t hash[2];
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    set(hash);
+  }
+
+  /**
+   * False if key was never inserted, true if it probably was.
+   */
+  bool contains(string_view_type key) const noexcept {
+    uint64_t hash[2];
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    return test(hash);
+  }
+
+  /**
+   * Inserts the keys of the range. The elements can be jasl::string_view-s,
+   * jasl::string-s, [std::string]-s or anything else with data() and size().
+   */
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    uint64_t hashes[inner::bloom_batch_size][2];
+    while (first != last) {
+      size_t count = 0;
+      for (; count < inner::bloom_batch_size && first != last;
+           ++first, ++count)
+        hash_and_prefetch(*first, hashes[count]);
+      for (size_t i = 0; i < count; ++i)
+        set(hashes[i]);
+    }
+  }
+
+  /**
+   * Writes contains(key) for every key of the range to out. Returns the end
+   * of the output.
+   */
+  template <typename InputIt, typename OutputIt>
+  OutputIt contains(InputIt first, InputIt last, OutputIt out) const {
+    uint64_t hashes[inner::bloom_batch_size][2];
+    while (first != last) {
+      size_t count = 0;
+      for (; count < inner::bloom_batch_size && first != last;
+           ++first, ++count)
+        hash_and_prefetch(*first, hashes[count]);
+      for (size_t i = 0; i < count; ++i, ++out)
+        *out = test(hashes[i]);
+    }
+    return out;
+  }
+
+  /**
+   * The probability of a false positive, estimated from the ratio of the set
+   * bits as if they were spread evenly; the rate of the uneven blocks is
+   * somewhat higher.
+   */
+  double estimated_false_positive_rate() const noexcept {
+    if (_block_count == 0)
+      return 0;
+    size_t set_bits = 0;
+    for (size_t i = 0; i < _block_count * inner::bloom_block_words; ++i)
+      set_bits += inner::popcount64(_blocks[i]);
+    return std::pow(
+        static_cast<double>(set_bits) / static_cast<double>(bit_count()),
+        static_cast<double>(_hash_count));
+  }
+
+ private:
+  void reset() noexcept {
+    _blocks = nullptr;
+    _block_count = 0;
+  }
+
+  template <typename Key>
+  void hash_and_prefetch(const Key& key, uint64_t hash[2]) const noexcept {
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    inner::prefetch(block(hash));
+  }
+
+  uint64_t* block(const uint64_t hash[2]) const noexcept {
+    JASL_ASSERT(_block_count != 0, "bloom_filter: it was moved from");
+    const size_t index =
+        static_cast<size_t>(((hash[0] >> 32) * _block_count) >> 32);
+    return _blocks + index * inner::bloom_block_words;
+  }
+
+  /**
+   * The bits of the key in its block.
+   */
+  void masks(const uint64_t hash[2], uint64_t* out) const noexcept {
+    for (size_t w = 0; w < inner::bloom_block_words; ++w)
+      out[w] = 0;
+    // With x + i * y alone, a query whose x and y equal those of a key of
+    // its block (1 in 512^2 within a block) is a false positive: the second
+    // difference z makes it 1 in 512^3.
+    uint64_t x = hash[1];
+    uint64_t y = (hash[0] << 32) | (hash[0] >> 32);
+    const uint64_t z = (hash[1] << 32) | (hash[1] >> 32);
+    for (unsigned i = 0; i < _hash_count; ++i, x += y, y += z) {
+      const unsigned bit = static_cast<unsigned>(x >> 55);
+      out[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+  }
+
+  void set(const uint64_t hash[2]) noexcept {
+    uint64_t mask[inner::bloom_block_words];
+    masks(hash, mask);
+    uint64_t* const b = block(hash);
+    for (size_t w = 0; w < inner::bloom_block_words; ++w)
+      b[w] |= mask[w];
+  }
+
+  bool test(const uint64_t hash[2]) const noexcept {
+    uint64_t mask[inner::bloom_block_words];
+    masks(hash, mask);
+    const uint64_t* const b = block(hash);
+    uint64_t missing = 0;
+    for (size_t w = 0; w < inner::bloom_block_words; ++w)
+      missing |= mask[w] & ~b[w];
+    return missing == 0;
+  }
+};
+
+typedef basic_bloom_filter<char> bloom_filter;
+
+}  // namespace jasl
@@ -0,0 +1,105 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+
+/**
+ * A null terminated copy of a view for the C interfaces (open, getenv, ...):
+ *
+ *   ::open(jasl::c_str_buffer(path).c_str(), O_RDONLY);
+ *
+ * The strings which are null terminated already (the jasl strings for which
+ * is_null_terminated() is true and [std::string]) are not copied, c_str()
+ * returns their characters. The other ones are copied into the buffer
+ * member if they are shorter than BufferSize, otherwise into an allocation.
+ *
+ * The object refers to the characters of the string, so it has to be
+ * destroyed before the string. It can't be copied or moved, it is meant to
+ * be a temporary or a local.
+ */
+template <typename CharT,
+          typename Traits = std::char_traits<CharT>,
+          size_t BufferSize = 256>
+class basic_c_str_buffer {
+  static_assert(BufferSize > 0, "BufferSize > 0");
+
+ private:
+  const CharT* _ptr;
+  std::unique_ptr<CharT[]> _allocated;
+  CharT _buffer[BufferSize];
+
+  void copy(const CharT* ptr, size_t size) {
+    CharT* out = _buffer;
+    if (size >= BufferSize) {
+      _allocated.reset(new CharT[size + 1]);
+      out = _allocated.get();
+    }
+    if (size > 0)
+      Traits::copy(out, ptr, size);
+    out[size] = CharT();
+    _ptr = out;
+  }
+
+ public:
+  explicit basic_c_str_buffer(basic_string_view<CharT, Traits> sv) {
+    copy(sv.data(), sv.size());
+  }
+
+  explicit basic_c_str_buffer(const basic_static_string<CharT, Traits>& str) {
+    if (str.is_null_terminated())
+      _ptr = str.c_str();
+    else
+      copy(str.data(), str.size());
+  }
+
+  template <size_t N>
+  explicit basic_c_str_buffer(const CharT (&str)[N])
+      : basic_c_str_buffer(basic_static_string<CharT, Traits>(str)) {}
+
+  template <typename AllocatorT>
+  explicit basic_c_str_buffer(
+      const basic_string<CharT, Traits, AllocatorT>& str) {
+    if (str.is_null_terminated())
+      _ptr = str.c_str();
+    else
+      copy(str.data(), str.size());
+  }
+
+  template <typename AllocatorT>
+  explicit basic_c_str_buffer(
+      const std::basic_string<CharT, Traits, AllocatorT>& str) noexcept
+      : _ptr(str.c_str()) {}
+
+  basic_c_str_buffer(const basic_c_str_buffer&) = delete;
+  basic_c_str_buffer& operator=(const basic_c_str_buffer&) = delete;
+
+  /**
+   * True if the characters were copied (into the buffer or an allocation).
+   */
+  bool is_copy() const noexcept {
+    return _ptr == _buffer || _ptr == _allocated.get();
+  }
+
+  const CharT* c_str() const noexcept { return _ptr; }
+};
+
+typedef basic_c_str_buffer<char> c_str_buffer;
+typedef basic_c_str_buffer<wchar_t> wc_str_buffer;
+
+}  // namespace jasl
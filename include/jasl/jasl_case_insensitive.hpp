@@ -0,0 +1,185 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "jasl/jasl_internal/jasl_ascii_case.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_murmurhash3.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+inline uint64_t rotate_left64(uint64_t x, unsigned r) noexcept {
+  return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * MurmurHash3_x64_128 of the case folded bytes, without folding them into a
+ * temporary: the blocks are folded 8 bytes at once after they are loaded.
+ * The result is the same as hashing the lower case copy of the key.
+ */
+JASL_USAN_IGNORE(integer)
+inline void ascii_case_insensitive_murmurhash3_x64_128(const void* key,
+                                                       size_t size,
+                                                       uint32_t seed,
+                                                       uint64_t out[2]) {
+  const unsigned char* data = static_cast<const unsigned char*>(key);
+  const size_t nblocks = size / 16;
+  const uint64_t c1 = 0x87c37b91114253d5ull;
+  const uint64_t c2 = 0x4cf5ad432745937full;
+  uint64_t h1 = seed;
+  uint64_t h2 = seed;
+
+  for (size_t i = 0; i < nblocks; ++i) {
+    uint64_t k1 = ascii_fold8(load_u64(data + i * 16));
+    uint64_t k2 = ascii_fold8(load_u64(data + i * 16 + 8));
+
+    k1 *= c1;
+    k1 = rotate_left64(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+
+    h1 = rotate_left64(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = rotate_left64(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+
+    h2 = rotate_left64(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  const unsigned char* tail = data + nblocks * 16;
+  const size_t rest = size & 15;
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+  for (size_t i = rest; i > 8; --i)
+    k2 ^= static_cast<uint64_t>(ascii_fold(tail[i - 1])) << ((i - 9) * 8);
+  for (size_t i = rest < 8 ? rest : 8; i > 0; --i)
+    k1 ^= static_cast<uint64_t>(ascii_fold(tail[i - 1])) << ((i - 1) * 8);
+  if (rest > 8) {
+    k2 *= c2;
+    k2 = rotate_left64(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+  }
+  if (rest > 0) {
+    k1 *= c1;
+    k1 = rotate_left64(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+  }
+
+  h1 ^= size;
+  h2 ^= size;
+
+  h1 += h2;
+  h2 += h1;
+
+  h1 = murmurhash3::fmix64(h1);
+  h2 = murmurhash3::fmix64(h2);
+
+  h1 += h2;
+  h2 += h1;
+
+  out[0] = h1;
+  out[1] = h2;
+}
+
+}  // namespace inner
+
+/**
+ * Character traits of char which compare the ASCII letters case
+ * insensitively (as lower case); the other bytes, including the non-ASCII
+ * ones, are compared as they are. Everything else (length, copy, ...) is
+ * std::char_traits<char>.
+ *
+ * The strings with these traits (jasl::ci_string_view, jasl::ci_static_string
+ * and jasl::ci_string) are equal and ordered regardless of the case, and
+ * jasl::ascii_case_insensitive_hash hashes them regardless of the case, so
+ * case-insensitive maps need no lower case temporaries:
+ *
+ *   std::unordered_map<jasl::ci_string_view, int,
+ *                      jasl::ascii_case_insensitive_hash> headers;
+ *   headers.find(jasl::ci_static_string("content-type"));
+ */
+struct ascii_case_insensitive_traits : public std::char_traits<char> {
+  static constexpr bool eq(char_type a, char_type b) noexcept {
+    return inner::ascii_fold(static_cast<unsigned char>(a)) ==
+           inner::ascii_fold(static_cast<unsigned char>(b));
+  }
+
+  static constexpr bool lt(char_type a, char_type b) noexcept {
+    return inner::ascii_fold(static_cast<unsigned char>(a)) <
+           inner::ascii_fold(static_cast<unsigned char>(b));
+  }
+
+  /**
+   * The case folded blocks are compared 16 bytes at once (SSE2).
+   */
+  static int compare(const char_type* a,
+                     const char_type* b,
+                     size_t size) noexcept {
+    return inner::ascii_case_insensitive_compare(
+        reinterpret_cast<const unsigned char*>(a),
+        reinterpret_cast<const unsigned char*>(b), size);
+  }
+
+  static const char_type* find(const char_type* ptr,
+                               size_t size,
+                               const char_type& c) noexcept {
+    const unsigned char folded =
+        inner::ascii_fold(static_cast<unsigned char>(c));
+    for (size_t i = 0; i < size; ++i) {
+      if (inner::ascii_fold(static_cast<unsigned char>(ptr[i])) == folded)
+        return ptr + i;
+    }
+    return nullptr;
+  }
+};
+
+typedef basic_string_view<char, ascii_case_insensitive_traits> ci_string_view;
+typedef basic_static_string<char, ascii_case_insensitive_traits>
+    ci_static_string;
+typedef basic_string<char, ascii_case_insensitive_traits> ci_string;
+
+/**
+ * Hash of the case insensitive strings: MurmurHash3 of the lower case
+ * characters, computed without a lower case copy. Equal strings (in the
+ * sense of ascii_case_insensitive_traits) have equal hashes.
+ */
+struct ascii_case_insensitive_hash {
+  size_t operator()(ci_string_view str) const noexcept {
+    uint64_t res[2];
+    inner::ascii_case_insensitive_murmurhash3_x64_128(str.data(), str.size(),
+                                                      33, res);
+    return static_cast<size_t>(res[0]);
+  }
+};
+
+}  // namespace jasl
+
+namespace std {
+template <>
+struct hash<jasl::ci_string_view> : public jasl::ascii_case_insensitive_hash {
+};
+}  // namespace std
@@ -0,0 +1,1205 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_power_of_five.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#  include <intrin.h>
+#endif
+
+namespace jasl {
+
+/**
+ * The result of jasl::from_chars, like std::from_chars_result of C++17. ptr
+ * points to the first character which is not part of the number. ec is
+ * - std::errc() on success,
+ * - std::errc::invalid_argument if there is no number (ptr is the first
+ *   character then),
+ * - std::errc::result_out_of_range if the number doesn't fit into the type
+ *   (the value is not modified then).
+ */
+struct from_chars_result {
+  const char* ptr;
+  std::errc ec;
+};
+
+namespace inner {
+
+/**
+ * c - '0'. It is 10 or above for the other characters.
+ */
+inline unsigned digit_value(char c) noexcept {
+  return static_cast<unsigned>(static_cast<unsigned char>(c)) -
+         static_cast<unsigned>('0');
+}
+
+/**
+ * The value of a digit of the bases up to 36: 0-9, then the letters
+ * case-insensitively. It is 36 for the other characters.
+ */
+inline unsigned base_digit_value(char c) noexcept {
+  const unsigned d = digit_value(c);
+  if (d < 10)
+    return d;
+  const unsigned letter =
+      (static_cast<unsigned>(static_cast<unsigned char>(c)) | 0x20u) -
+      static_cast<unsigned>('a');
+  return letter < 26 ? letter + 10 : 36;
+}
+
+/**
+ * 8 characters in a word, the first one is the lowest byte.
+ */
+inline uint64_t load_eight_chars(const char* ptr) noexcept {
+#if JASL_INNER_LITTLE_ENDIAN
+  return load_u64(ptr);
+#else
+  return byteswap64(load_u64(ptr));
+#endif
+}
+
+/**
+ * Adding 0x46 sets the top bit of the bytes above '9', subtracting 0x30
+ * sets it for the ones below '0'.
+ */
+inline bool is_eight_digits(uint64_t x) noexcept {
+  return (((x + 0x4646464646464646u) | (x - 0x3030303030303030u)) &
+          0x8080808080808080u) == 0;
+}
+
+/**
+ * The value of 8 digits (see is_eight_digits): the neighbouring digits are
+ * combined into pairs, then the pairs into the result, with 3
+ * multiplications instead of 8.
+ */
+inline uint32_t parse_eight_digits(uint64_t x) noexcept {
+  const uint64_t mask = 0x000000FF000000FFu;
+  const uint64_t mul1 = 100 + (uint64_t(1000000) << 32);
+  const uint64_t mul2 = 1 + (uint64_t(10000) << 32);
+  x -= 0x3030303030303030u;
+  x = (x * 10) + (x >> 8);
+  x = (((x & mask) * mul1) + (((x >> 16) & mask) * mul2)) >> 32;
+  return static_cast<uint32_t>(x);
+}
+
+/**
+ * Parses every digit of base at the beginning of [p, last) into value and
+ * returns the end of them. overflow is set if the number is above limit. In
+ * base 10 the first 19 significant digits, which can't overflow, are parsed 8
+ * at a time.
+ */
+inline const char* parse_unsigned(const char* p,
+                                  const char* last,
+                                  unsigned base,
+                                  uint64_t limit,
+                                  uint64_t& value,
+                                  bool& overflow) noexcept {
+  uint64_t v = 0;
+  overflow = false;
+  if (base == 10) {
+    while (p != last && *p == '0')
+      ++p;
+    const char* const significant = p;
+    while (last - p >= 8 && p - significant <= 11) {
+      const uint64_t x = load_eight_chars(p);
+      if (!is_eight_digits(x))
+        break;
+      v = v * 100000000 + parse_eight_digits(x);
+      p += 8;
+    }
+    for (unsigned d; p != last && p - significant < 19 &&
+                     (d = digit_value(*p)) < 10;
+         ++p)
+      v = v * 10 + d;
+  }
+  for (unsigned d; p != last && (d = base_digit_value(*p)) < base; ++p) {
+    if (overflow || v > (std::numeric_limits<uint64_t>::max() - d) / base)
+      overflow = true;
+    else
+      v = v * base + d;
+  }
+  value = v;
+  overflow = overflow || v > limit;
+  return p;
+}
+
+template <typename T>
+from_chars_result from_chars_integer(const char* first,
+                                     const char* last,
+                                     T& value,
+                                     int base) noexcept {
+  JASL_ASSERT(base >= 2 && base <= 36, "from_chars: invalid base");
+  const char* p = first;
+  const bool negative = std::is_signed<T>::value && p != last && *p == '-';
+  if (negative)
+    ++p;
+  const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) +
+                         (negative ? 1 : 0);
+  uint64_t magnitude;
+  bool overflow;
+  const char* const end = parse_unsigned(p, last, static_cast<unsigned>(base),
+                                         limit, magnitude, overflow);
+  if (end == p)
+    return {first, std::errc::invalid_argument};
+  if (overflow)
+    return {end, std::errc::result_out_of_range};
+  if (negative)
+    value = static_cast<T>(T(0) - static_cast<T>(magnitude - 1) - 1);
+  else
+    value = static_cast<T>(magnitude);
+  return {end, std::errc()};
+}
+
+/*
+ * Floating point parsing: the first 19 significant digits are parsed into an
+ * integer w (8 at a time), so the number is w * 10^q. If w and q are small,
+ * the result is a single exact multiplication or division (Clinger's fast
+ * path). Otherwise the Eisel-Lemire algorithm computes the correctly rounded
+ * result from the 128-bit approximation of 5^q. It is always right for 19
+ * digits; for more, the result has to be the same for w and w + 1, which is
+ * the usual case. The rest is left to the C library.
+ */
+
+template <typename T>
+struct binary_format;
+
+template <>
+struct binary_format<double> {
+  typedef uint64_t bits_type;
+  static constexpr int mantissa_bits = 52;
+  static constexpr int minimum_exponent = -1023;
+  static constexpr int infinite_power = 0x7FF;
+  static constexpr int min_exponent_round_to_even = -4;
+  static constexpr int max_exponent_round_to_even = 23;
+  static constexpr int smallest_power_of_ten = -342;
+  static constexpr int largest_power_of_ten = 308;
+  static constexpr int max_exponent_fast_path = 22;
+
+  static double from_c_string(const char* str) noexcept {
+    return std::strtod(str, nullptr);
+  }
+};
+
+template <>
+struct binary_format<float> {
+  typedef uint32_t bits_type;
+  static constexpr int mantissa_bits = 23;
+  static constexpr int minimum_exponent = -127;
+  static constexpr int infinite_power = 0xFF;
+  static constexpr int min_exponent_round_to_even = -17;
+  static constexpr int max_exponent_round_to_even = 10;
+  static constexpr int smallest_power_of_ten = -65;
+  static constexpr int largest_power_of_ten = 38;
+  static constexpr int max_exponent_fast_path = 10;
+
+  static float from_c_string(const char* str) noexcept {
+    return std::strtof(str, nullptr);
+  }
+};
+
+/**
+ * 10^e for e in [0, 22], these are exact doubles.
+ */
+inline double exact_power_of_ten(int64_t e) noexcept {
+  static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  return powers[e];
+}
+
+struct uint128_parts {
+  uint64_t low;
+  uint64_t high;
+};
+
+inline uint128_parts multiply_64x64(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_type;
+  const uint128_type r = static_cast<uint128_type>(a) * b;
+  return {static_cast<uint64_t>(r), static_cast<uint64_t>(r >> 64)};
+#elif defined(_MSC_VER) && defined(_M_X64)
+  uint64_t high;
+  const uint64_t low = _umul128(a, b, &high);
+  return {low, high};
+#else
+  const uint64_t a_low = a & 0xFFFFFFFFu;
+  const uint64_t a_high = a >> 32;
+  const uint64_t b_low = b & 0xFFFFFFFFu;
+  const uint64_t b_high = b >> 32;
+  const uint64_t low_low = a_low * b_low;
+  const uint64_t high_low = a_high * b_low;
+  const uint64_t cross =
+      (low_low >> 32) + (high_low & 0xFFFFFFFFu) + a_low * b_high;
+  return {(cross << 32) | (low_low & 0xFFFFFFFFu),
+          a_high * b_high + (high_low >> 32) + (cross >> 32)};
+#endif
+}
+
+/**
+ * A binary floating point number: the mantissa without the implicit bit and
+ * the biased exponent.
+ */
+struct adjusted_mantissa {
+  uint64_t mantissa;
+  int power2;
+
+  bool operator==(const adjusted_mantissa& other) const noexcept {
+    return mantissa == other.mantissa && power2 == other.power2;
+  }
+};
+
+/**
+ * The Eisel-Lemire algorithm: the correctly rounded w * 10^q, w < 10^19.
+ */
+template <typename T>
+adjusted_mantissa compute_float(int64_t q, uint64_t w) noexcept {
+  typedef binary_format<T> format;
+  typedef power_of_five_table<> table;
+  if (w == 0 || q < format::smallest_power_of_ten)
+    return {0, 0};
+  if (q > format::largest_power_of_ten)
+    return {0, format::infinite_power};
+  const unsigned lz = count_leading_zeros64(w);
+  w <<= lz;
+  // the 64 + mantissa_bits + 3 bits of the product are needed; the second
+  // half of 5^q is only used if they can be affected by it
+  const size_t index = 2 * static_cast<size_t>(q - table::smallest);
+  uint128_parts product = multiply_64x64(w, table::values[index]);
+  const uint64_t precision_mask =
+      std::numeric_limits<uint64_t>::max() >> (format::mantissa_bits + 3);
+  if ((product.high & precision_mask) == precision_mask) {
+    const uint128_parts second = multiply_64x64(w, table::values[index + 1]);
+    product.low += second.high;
+    if (second.high > product.low)
+      ++product.high;
+  }
+  const int upper_bit = static_cast<int>(product.high >> 63);
+  const int shift = upper_bit + 64 - format::mantissa_bits - 3;
+  adjusted_mantissa answer;
+  answer.mantissa = product.high >> shift;
+  // floor(q * log2(10)) + 63
+  const int power = static_cast<int>(((152170 + 65536) * q) >> 16) + 63;
+  answer.power2 =
+      power + upper_bit - static_cast<int>(lz) - format::minimum_exponent;
+  if (answer.power2 <= 0) {
+    // subnormal
+    if (-answer.power2 + 1 >= 64)
+      return {0, 0};
+    answer.mantissa >>= -answer.power2 + 1;
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    answer.power2 =
+        answer.mantissa < (uint64_t(1) << format::mantissa_bits) ? 0 : 1;
+    return answer;
+  }
+  // exactly halfway between two floats: round to even
+  if (product.low <= 1 && q >= format::min_exponent_round_to_even &&
+      q <= format::max_exponent_round_to_even &&
+      (answer.mantissa & 3) == 1 &&
+      (answer.mantissa << shift) == product.high)
+    answer.mantissa &= ~uint64_t(1);
+  answer.mantissa += (answer.mantissa & 1);
+  answer.mantissa >>= 1;
+  if (answer.mantissa >= (uint64_t(2) << format::mantissa_bits)) {
+    answer.mantissa = uint64_t(1) << format::mantissa_bits;
+    ++answer.power2;
+  }
+  answer.mantissa &= ~(uint64_t(1) << format::mantissa_bits);
+  if (answer.power2 >= format::infinite_power)
+    return {0, format::infinite_power};
+  return answer;
+}
+
+template <typename T>
+T to_float(adjusted_mantissa am) noexcept {
+  typedef typename binary_format<T>::bits_type bits_type;
+  const bits_type bits = static_cast<bits_type>(
+      am.mantissa |
+      (static_cast<uint64_t>(am.power2) << binary_format<T>::mantissa_bits));
+  T value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * The decimal number as it is written, and w and q of it.
+ */
+struct parsed_decimal {
+  const char* integer_begin;
+  const char* integer_end;
+  const char* fraction_begin;
+  const char* fraction_end;
+  int64_t exponent_number;  // the number after the 'e'
+  uint64_t w;               // the first 19 significant digits
+  int64_t q;
+  bool too_many_digits;  // w is truncated
+};
+
+/**
+ * Continues value with the digits at the beginning of [p, last), 8 at a
+ * time, and returns the end of them. value wraps around if there are too
+ * many.
+ */
+inline const char* parse_decimal_digits(const char* p,
+                                        const char* last,
+                                        uint64_t& value) noexcept {
+  uint64_t v = value;
+  while (last - p >= 8) {
+    const uint64_t x = load_eight_chars(p);
+    if (!is_eight_digits(x))
+      break;
+    v = v * 100000000 + parse_eight_digits(x);
+    p += 8;
+  }
+  for (unsigned d; p != last && (d = digit_value(*p)) < 10; ++p)
+    v = v * 10 + d;
+  value = v;
+  return p;
+}
+
+/**
+ * Parses [-]digits[.digits][(e|E)[+|-]digits] without the sign. Returns
+ * nullptr if there is no digit.
+ */
+inline const char* parse_decimal(const char* p,
+                                 const char* last,
+                                 parsed_decimal& number) noexcept {
+  number.w = 0;
+  number.integer_begin = p;
+  p = parse_decimal_digits(p, last, number.w);
+  number.integer_end = p;
+  number.fraction_begin = p;
+  if (p != last && *p == '.') {
+    number.fraction_begin = ++p;
+    p = parse_decimal_digits(p, last, number.w);
+  }
+  number.fraction_end = p;
+  const int64_t integer_size = number.integer_end - number.integer_begin;
+  const int64_t fraction_size = number.fraction_end - number.fraction_begin;
+  int64_t digit_count = integer_size + fraction_size;
+  if (digit_count == 0)
+    return nullptr;
+
+  number.exponent_number = 0;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    const char* e = p + 1;
+    const bool negative = e != last && *e == '-';
+    if (e != last && (*e == '-' || *e == '+'))
+      ++e;
+    if (e != last && digit_value(*e) < 10) {
+      int64_t exponent = 0;
+      for (unsigned d; e != last && (d = digit_value(*e)) < 10; ++e) {
+        // far beyond the range of any floating point type
+        if (exponent < 0x10000000)
+          exponent = exponent * 10 + d;
+      }
+      number.exponent_number = negative ? -exponent : exponent;
+      p = e;
+    }
+  }
+  number.q = number.exponent_number - fraction_size;
+
+  number.too_many_digits = false;
+  if (digit_count > 19) {
+    // the leading zeros are not significant
+    for (const char* s = number.integer_begin;
+         s != number.fraction_end && (*s == '0' || *s == '.'); ++s) {
+      if (*s == '0')
+        --digit_count;
+    }
+  }
+  if (digit_count > 19) {
+    number.too_many_digits = true;
+    const uint64_t min_nineteen_digits = 1000000000000000000u;
+    uint64_t w = 0;
+    const char* s = number.integer_begin;
+    while (w < min_nineteen_digits && s != number.integer_end)
+      w = w * 10 + digit_value(*s++);
+    if (w >= min_nineteen_digits) {
+      number.q = (number.integer_end - s) + number.exponent_number;
+    } else {
+      s = number.fraction_begin;
+      while (w < min_nineteen_digits && s != number.fraction_end)
+        w = w * 10 + digit_value(*s++);
+      number.q = (number.fraction_begin - s) + number.exponent_number;
+    }
+    number.w = w;
+  }
+  return p;
+}
+
+/**
+ * Correctly rounded conversion by the C library. The significant digits are
+ * written without the decimal point, so the locale doesn't matter, followed
+ * by the exponent. Only the first 768 digits can affect the rounding, the
+ * rest is replaced by a 1 if it is not zero.
+ */
+template <typename T>
+T parse_decimal_slow(const parsed_decimal& number) noexcept {
+  const size_t max_digits = 768;
+  char buffer[max_digits + 32];
+  size_t size = 0;
+  int64_t exponent =
+      number.exponent_number - (number.fraction_end - number.fraction_begin);
+  bool nonzero_rest = false;
+  const char* const ranges[2][2] = {
+      {number.integer_begin, number.integer_end},
+      {number.fraction_begin, number.fraction_end}};
+  for (size_t r = 0; r < 2; ++r) {
+    for (const char* p = ranges[r][0]; p != ranges[r][1]; ++p) {
+      if (size == 0 && *p == '0')
+        continue;
+      if (size < max_digits) {
+        buffer[size++] = *p;
+      } else {
+        ++exponent;
+        nonzero_rest = nonzero_rest || *p != '0';
+      }
+    }
+  }
+  if (nonzero_rest) {
+    buffer[size++] = '1';
+    --exponent;
+  }
+  buffer[size++] = 'e';
+  if (exponent < 0)
+    buffer[size++] = '-';
+  uint64_t magnitude = static_cast<uint64_t>(exponent < 0 ? -exponent
+                                                          : exponent);
+  char* const digits = buffer + size;
+  do {
+    buffer[size++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  std::reverse(digits, buffer + size);
+  buffer[size] = '\0';
+  return binary_format<T>::from_c_string(buffer);
+}
+
+/**
+ * Compares the characters at p to the lower case word case-insensitively.
+ */
+inline bool match_word(const char* p,
+                       const char* last,
+                       const char* word) noexcept {
+  for (; *word != '\0'; ++p, ++word) {
+    if (p == last ||
+        (static_cast<unsigned char>(*p) | 0x20) !=
+            static_cast<unsigned char>(*word))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * inf, infinity, nan and nan(chars), case-insensitively.
+ */
+template <typename T>
+from_chars_result parse_infinity_or_nan(const char* first,
+                                        const char* p,
+                                        const char* last,
+                                        bool negative,
+                                        T& value) noexcept {
+  if (match_word(p, last, "inf")) {
+    p += 3;
+    if (match_word(p, last, "inity"))
+      p += 5;
+    value = negative ? -std::numeric_limits<T>::infinity()
+                     : std::numeric_limits<T>::infinity();
+    return {p, std::errc()};
+  }
+  if (match_word(p, last, "nan")) {
+    p += 3;
+    if (p != last && *p == '(') {
+      const char* s = p + 1;
+      while (s != last && (base_digit_value(*s) < 36 || *s == '_'))
+        ++s;
+      if (s != last && *s == ')')
+        p = s + 1;
+    }
+    value = negative ? -std::numeric_limits<T>::quiet_NaN()
+                     : std::numeric_limits<T>::quiet_NaN();
+    return {p, std::errc()};
+  }
+  return {first, std::errc::invalid_argument};
+}
+
+template <typename T>
+from_chars_result from_chars_float(const char* first,
+                                   const char* last,
+                                   T& value) noexcept {
+  typedef binary_format<T> format;
+  const bool negative = first != last && *first == '-';
+  const char* const begin = negative ? first + 1 : first;
+  parsed_decimal number;
+  const char* const end = parse_decimal(begin, last, number);
+  if (end == nullptr)
+    return parse_infinity_or_nan(first, begin, last, negative, value);
+
+  T result;
+  bool done = false;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  // Clinger: both w and 10^|q| are exact, the operation rounds correctly
+  if (!number.too_many_digits && number.q >= -format::max_exponent_fast_path &&
+      number.q <= format::max_exponent_fast_path &&
+      number.w <= (uint64_t(2) << format::mantissa_bits)) {
+    result = static_cast<T>(number.w);
+    if (number.q < 0)
+      result /= static_cast<T>(exact_power_of_ten(-number.q));
+    else
+      result *= static_cast<T>(exact_power_of_ten(number.q));
+    done = true;
+  }
+#endif
+  if (!done) {
+    const adjusted_mantissa am = compute_float<T>(number.q, number.w);
+    if (number.too_many_digits && !(am == compute_float<T>(number.q,
+                                                           number.w + 1)))
+      result = parse_decimal_slow<T>(number);
+    else
+      result = to_float<T>(am);
+  }
+  if (result > std::numeric_limits<T>::max() ||
+      (result == 0 && number.w != 0))
+    return {end, std::errc::result_out_of_range};
+  value = negative ? -result : result;
+  return {end, std::errc()};
+}
+
+}  // namespace inner
+
+/**
+ * Parses an integer at the beginning of [first, last) like std::from_chars
+ * of C++17, also in the earlier standards: an optional '-' (only for the
+ * signed types), then the digits of base (2 to 36, the letters are
+ * case-insensitive). There is no whitespace, '+' or prefix, no locale and no
+ * NUL termination is needed. The decimal digits are parsed 8 at a time
+ * (SWAR).
+ */
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value,
+                                  int>::type = 0>
+from_chars_result from_chars(const char* first,
+                             const char* last,
+                             T& value,
+                             int base = 10) noexcept {
+  return inner::from_chars_integer(first, last, value, base);
+}
+
+/**
+ * jasl::from_chars of the characters of the view (or the jasl strings).
+ */
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value,
+                                  int>::type = 0>
+from_chars_result from_chars(string_view str,
+                             T& value,
+                             int base = 10) noexcept {
+  return inner::from_chars_integer(str.data(), str.data() + str.size(),
+                                   value, base);
+}
+
+/**
+ * Parses a floating point number at the beginning of [first, last) like
+ * std::from_chars with std::chars_format::general: an optional '-', the
+ * digits with an optional decimal point, an optional exponent, or inf,
+ * infinity, nan, nan(chars) case-insensitively. The result is correctly
+ * rounded (to nearest, ties to even). Too large numbers and the nonzero ones
+ * which round to 0 are out of range.
+ *
+ * No copy, locale or NUL termination is needed: the digits are parsed 8 at a
+ * time into an integer, then converted with the Eisel-Lemire algorithm. Only
+ * the numbers of more than 19 significant digits, which are very close to
+ * the halfway between two doubles, are converted by std::strtod (from a
+ * stack buffer).
+ */
+inline from_chars_result from_chars(const char* first,
+                                    const char* last,
+                                    double& value) noexcept {
+  return inner::from_chars_float(first, last, value);
+}
+
+/**
+ * The float version of jasl::from_chars.
+ */
+inline from_chars_result from_chars(const char* first,
+                                    const char* last,
+                                    float& value) noexcept {
+  return inner::from_chars_float(first, last, value);
+}
+
+/**
+ * jasl::from_chars of the characters of the view (or the jasl strings).
+ */
+inline from_chars_result from_chars(string_view str, double& value) noexcept {
+  return inner::from_chars_float(str.data(), str.data() + str.size(), value);
+}
+
+/**
+ * jasl::from_chars of the characters of the view (or the jasl strings).
+ */
+inline from_chars_result from_chars(string_view str, float& value) noexcept {
+  return inner::from_chars_float(str.data(), str.data() + str.size(), value);
+}
+
+/**
+ * The result of jasl::to_chars, like std::to_chars_result of C++17. ptr
+ * points after the last written character. ec is std::errc() on success and
+ * std::errc::value_too_large if the result doesn't fit (ptr is last then and
+ * the content of the range is unspecified).
+ */
+struct to_chars_result {
+  char* ptr;
+  std::errc ec;
+};
+
+namespace inner {
+
+/**
+ * "00", "01", ... "99" after each other.
+ */
+inline const char* two_digits() noexcept {
+  static const char digits[] =
+      "00010203040506070809101112131415161718192021222324"
+      "25262728293031323334353637383940414243444546474849"
+      "50515253545556575859606162636465666768697071727374"
+      "75767778798081828384858687888990919293949596979899";
+  return digits;
+}
+
+inline unsigned decimal_digit_count(uint64_t x) noexcept {
+  unsigned n = 1;
+  for (;;) {
+    if (x < 10)
+      return n;
+    if (x < 100)
+      return n + 1;
+    if (x < 1000)
+      return n + 2;
+    if (x < 10000)
+      return n + 3;
+    x /= 10000;
+    n += 4;
+  }
+}
+
+/**
+ * Writes the digit_count digits of x to out, two at a time from the end.
+ */
+inline void write_decimal(char* out,
+                          unsigned digit_count,
+                          uint64_t x) noexcept {
+  char* p = out + digit_count;
+  while (x >= 100) {
+    const size_t i = static_cast<size_t>(x % 100) * 2;
+    x /= 100;
+    p -= 2;
+    std::memcpy(p, two_digits() + i, 2);
+  }
+  if (x >= 10)
+    std::memcpy(p - 2, two_digits() + x * 2, 2);
+  else
+    *--p = static_cast<char>('0' + x);
+}
+
+template <typename T>
+bool is_negative(T value, std::true_type /*is_signed*/) noexcept {
+  return value < 0;
+}
+
+template <typename T>
+bool is_negative(T, std::false_type /*is_signed*/) noexcept {
+  return false;
+}
+
+template <typename T>
+to_chars_result to_chars_integer(char* first,
+                                 char* last,
+                                 T value,
+                                 int base) noexcept {
+  JASL_ASSERT(base >= 2 && base <= 36, "to_chars: invalid base");
+  const bool negative = is_negative(value, std::is_signed<T>());
+  // the conversion is modulo 2^64, so this is the magnitude
+  const uint64_t magnitude = negative
+                                 ? uint64_t(0) - static_cast<uint64_t>(value)
+                                 : static_cast<uint64_t>(value);
+  const unsigned b = static_cast<unsigned>(base);
+  unsigned digit_count;
+  if (b == 10) {
+    digit_count = decimal_digit_count(magnitude);
+  } else {
+    digit_count = 1;
+    for (uint64_t x = magnitude / b; x != 0; x /= b)
+      ++digit_count;
+  }
+  if (last - first < static_cast<ptrdiff_t>(digit_count + (negative ? 1 : 0)))
+    return {last, std::errc::value_too_large};
+  if (negative)
+    *first++ = '-';
+  if (b == 10) {
+    write_decimal(first, digit_count, magnitude);
+  } else {
+    const char* const digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+    uint64_t x = magnitude;
+    for (char* p = first + digit_count; p != first; x /= b)
+      *--p = digits[x % b];
+  }
+  return {first + digit_count, std::errc()};
+}
+
+/*
+ * Shortest floating point output with the Grisu2 algorithm of Florian
+ * Loitsch ("Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers"): the boundaries of the rounding interval of the value are
+ * scaled with a cached power of ten into 64-bit integers, and the digits are
+ * generated until they are within the interval. The result always parses
+ * back to the same value, and it is the shortest such one for nearly every
+ * value.
+ */
+
+/**
+ * f * 2^e
+ */
+struct diy_fp {
+  uint64_t f;
+  int e;
+
+  static diy_fp sub(const diy_fp& x, const diy_fp& y) noexcept {
+    return {x.f - y.f, x.e};
+  }
+
+  /**
+   * The upper 64 bits of the product, rounded.
+   */
+  static diy_fp mul(const diy_fp& x, const diy_fp& y) noexcept {
+    uint128_parts p = multiply_64x64(x.f, y.f);
+    p.high += p.low >> 63;
+    return {p.high, x.e + y.e + 64};
+  }
+
+  static diy_fp normalize(diy_fp x) noexcept {
+    const unsigned shift = count_leading_zeros64(x.f);
+    return {x.f << shift, x.e - static_cast<int>(shift)};
+  }
+
+  static diy_fp normalize_to(const diy_fp& x, int e) noexcept {
+    return {x.f << (x.e - e), e};
+  }
+};
+
+/**
+ * The value and the boundaries of its rounding interval (the midpoints to
+ * the neighbouring floating point numbers), the latter two with the same
+ * exponent.
+ */
+struct fp_boundaries {
+  diy_fp w;
+  diy_fp minus;
+  diy_fp plus;
+};
+
+template <typename T>
+fp_boundaries compute_boundaries(T value) noexcept {
+  typedef binary_format<T> format;
+  typename format::bits_type bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint64_t hidden_bit = uint64_t(1) << format::mantissa_bits;
+  const int bias = -format::minimum_exponent + format::mantissa_bits;
+  const uint64_t fraction = bits & (hidden_bit - 1);
+  const int exponent = static_cast<int>(bits >> format::mantissa_bits);
+  const diy_fp v = exponent == 0
+                       ? diy_fp{fraction, 1 - bias}
+                       : diy_fp{fraction + hidden_bit, exponent - bias};
+  // the lower neighbour is closer at the powers of two
+  const bool lower_is_closer = fraction == 0 && exponent > 1;
+  const diy_fp plus = diy_fp::normalize({2 * v.f + 1, v.e - 1});
+  const diy_fp minus = lower_is_closer ? diy_fp{4 * v.f - 1, v.e - 2}
+                                       : diy_fp{2 * v.f - 1, v.e - 1};
+  return {diy_fp::normalize(v), diy_fp::normalize_to(minus, plus.e), plus};
+}
+
+/**
+ * 10^k as f * 2^e.
+ */
+struct cached_power {
+  uint64_t f;
+  int e;
+  int k;
+};
+
+/**
+ * The powers of ten from 10^-300 to 10^324 by 8, rounded to 64 bits.
+ */
+template <typename T = void>
+struct cached_power_table {
+  static constexpr int smallest = -300;
+  static constexpr int step = 8;
+  static const cached_power values[79];
+};
+
+template <typename T>
+constexpr int cached_power_table<T>::smallest;
+
+template <typename T>
+constexpr int cached_power_table<T>::step;
+
+template <typename T>
+const cached_power cached_power_table<T>::values[] = {
+    {0xAB70FE17C79AC6CAu, -1060, -300},
+    {0xFF77B1FCBEBCDC4Fu, -1034, -292},
+    {0xBE5691EF416BD60Cu, -1007, -284},
+    {0x8DD01FAD907FFC3Cu, -980, -276},
+    {0xD3515C2831559A83u, -954, -268},
+    {0x9D71AC8FADA6C9B5u, -927, -260},
+    {0xEA9C227723EE8BCBu, -901, -252},
+    {0xAECC49914078536Du, -874, -244},
+    {0x823C12795DB6CE57u, -847, -236},
+    {0xC21094364DFB5637u, -821, -228},
+    {0x9096EA6F3848984Fu, -794, -220},
+    {0xD77485CB25823AC7u, -768, -212},
+    {0xA086CFCD97BF97F4u, -741, -204},
+    {0xEF340A98172AACE5u, -715, -196},
+    {0xB23867FB2A35B28Eu, -688, -188},
+    {0x84C8D4DFD2C63F3Bu, -661, -180},
+    {0xC5DD44271AD3CDBAu, -635, -172},
+    {0x936B9FCEBB25C996u, -608, -164},
+    {0xDBAC6C247D62A584u, -582, -156},
+    {0xA3AB66580D5FDAF6u, -555, -148},
+    {0xF3E2F893DEC3F126u, -529, -140},
+    {0xB5B5ADA8AAFF80B8u, -502, -132},
+    {0x87625F056C7C4A8Bu, -475, -124},
+    {0xC9BCFF6034C13053u, -449, -116},
+    {0x964E858C91BA2655u, -422, -108},
+    {0xDFF9772470297EBDu, -396, -100},
+    {0xA6DFBD9FB8E5B88Fu, -369, -92},
+    {0xF8A95FCF88747D94u, -343, -84},
+    {0xB94470938FA89BCFu, -316, -76},
+    {0x8A08F0F8BF0F156Bu, -289, -68},
+    {0xCDB02555653131B6u, -263, -60},
+    {0x993FE2C6D07B7FACu, -236, -52},
+    {0xE45C10C42A2B3B06u, -210, -44},
+    {0xAA242499697392D3u, -183, -36},
+    {0xFD87B5F28300CA0Eu, -157, -28},
+    {0xBCE5086492111AEBu, -130, -20},
+    {0x8CBCCC096F5088CCu, -103, -12},
+    {0xD1B71758E219652Cu, -77, -4},
+    {0x9C40000000000000u, -50, 4},
+    {0xE8D4A51000000000u, -24, 12},
+    {0xAD78EBC5AC620000u, 3, 20},
+    {0x813F3978F8940984u, 30, 28},
+    {0xC097CE7BC90715B3u, 56, 36},
+    {0x8F7E32CE7BEA5C70u, 83, 44},
+    {0xD5D238A4ABE98068u, 109, 52},
+    {0x9F4F2726179A2245u, 136, 60},
+    {0xED63A231D4C4FB27u, 162, 68},
+    {0xB0DE65388CC8ADA8u, 189, 76},
+    {0x83C7088E1AAB65DBu, 216, 84},
+    {0xC45D1DF942711D9Au, 242, 92},
+    {0x924D692CA61BE758u, 269, 100},
+    {0xDA01EE641A708DEAu, 295, 108},
+    {0xA26DA3999AEF774Au, 322, 116},
+    {0xF209787BB47D6B85u, 348, 124},
+    {0xB454E4A179DD1877u, 375, 132},
+    {0x865B86925B9BC5C2u, 402, 140},
+    {0xC83553C5C8965D3Du, 428, 148},
+    {0x952AB45CFA97A0B3u, 455, 156},
+    {0xDE469FBD99A05FE3u, 481, 164},
+    {0xA59BC234DB398C25u, 508, 172},
+    {0xF6C69A72A3989F5Cu, 534, 180},
+    {0xB7DCBF5354E9BECEu, 561, 188},
+    {0x88FCF317F22241E2u, 588, 196},
+    {0xCC20CE9BD35C78A5u, 614, 204},
+    {0x98165AF37B2153DFu, 641, 212},
+    {0xE2A0B5DC971F303Au, 667, 220},
+    {0xA8D9D1535CE3B396u, 694, 228},
+    {0xFB9B7CD9A4A7443Cu, 720, 236},
+    {0xBB764C4CA7A44410u, 747, 244},
+    {0x8BAB8EEFB6409C1Au, 774, 252},
+    {0xD01FEF10A657842Cu, 800, 260},
+    {0x9B10A4E5E9913129u, 827, 268},
+    {0xE7109BFBA19C0C9Du, 853, 276},
+    {0xAC2820D9623BF429u, 880, 284},
+    {0x80444B5E7AA7CF85u, 907, 292},
+    {0xBF21E44003ACDD2Du, 933, 300},
+    {0x8E679C2F5E44FF8Fu, 960, 308},
+    {0xD433179D9C8CB841u, 986, 316},
+    {0x9E19DB92B4E31BA9u, 1013, 324},
+};
+
+// the range of the binary exponent of the scaled values
+constexpr int grisu_alpha = -60;
+constexpr int grisu_gamma = -32;
+
+/**
+ * A power of ten c such that the binary exponent of x * c is in [alpha,
+ * gamma] for a normalized x with exponent e.
+ */
+inline cached_power cached_power_for(int e) noexcept {
+  typedef cached_power_table<> table;
+  const int f = grisu_alpha - e - 1;
+  // ceil(f * log10(2))
+  const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+  const int index = (k - table::smallest + table::step - 1) / table::step;
+  JASL_ASSERT(index >= 0 && index < 79, "cached_power_for: out of range");
+  return table::values[index];
+}
+
+/**
+ * The number of the digits of n and 10^(that - 1).
+ */
+inline int largest_power_of_ten(uint32_t n, uint32_t& power) noexcept {
+  int digit_count = 1;
+  power = 1;
+  while (n / power >= 10) {
+    power *= 10;
+    ++digit_count;
+  }
+  return digit_count;
+}
+
+/**
+ * Moves the last digit towards w while the number stays in the interval.
+ */
+inline void grisu_round(char* buffer,
+                        int length,
+                        uint64_t distance,
+                        uint64_t delta,
+                        uint64_t rest,
+                        uint64_t ten_k) noexcept {
+  while (rest < distance && delta - rest >= ten_k &&
+         (rest + ten_k < distance ||
+          distance - rest > rest + ten_k - distance)) {
+    --buffer[length - 1];
+    rest += ten_k;
+  }
+}
+
+/**
+ * Generates the shortest digits of the scaled interval: the integral part
+ * first, then the fractional part, until the rest is within it.
+ */
+inline void grisu_digit_gen(char* buffer,
+                            int& length,
+                            int& decimal_exponent,
+                            diy_fp minus,
+                            diy_fp w,
+                            diy_fp plus) noexcept {
+  uint64_t delta = diy_fp::sub(plus, minus).f;
+  uint64_t distance = diy_fp::sub(plus, w).f;
+  const diy_fp one = {uint64_t(1) << -plus.e, plus.e};
+  uint32_t p1 = static_cast<uint32_t>(plus.f >> -one.e);
+  uint64_t p2 = plus.f & (one.f - 1);
+
+  uint32_t power;
+  int n = largest_power_of_ten(p1, power);
+  while (n > 0) {
+    const uint32_t d = p1 / power;
+    p1 %= power;
+    buffer[length++] = static_cast<char>('0' + d);
+    --n;
+    const uint64_t rest = (uint64_t(p1) << -one.e) + p2;
+    if (rest <= delta) {
+      decimal_exponent += n;
+      grisu_round(buffer, length, distance, delta, rest,
+                  uint64_t(power) << -one.e);
+      return;
+    }
+    power /= 10;
+  }
+
+  int m = 0;
+  for (;;) {
+    p2 *= 10;
+    const uint64_t d = p2 >> -one.e;
+    p2 &= one.f - 1;
+    buffer[length++] = static_cast<char>('0' + d);
+    ++m;
+    delta *= 10;
+    distance *= 10;
+    if (p2 <= delta)
+      break;
+  }
+  decimal_exponent -= m;
+  grisu_round(buffer, length, distance, delta, p2, one.f);
+}
+
+/**
+ * The shortest digits of a positive finite value: value = digits *
+ * 10^decimal_exponent.
+ */
+template <typename T>
+void grisu2(char* buffer,
+            int& length,
+            int& decimal_exponent,
+            T value) noexcept {
+  const fp_boundaries b = compute_boundaries(value);
+  const cached_power cached = cached_power_for(b.plus.e);
+  const diy_fp c = {cached.f, cached.e};
+  const diy_fp w = diy_fp::mul(b.w, c);
+  const diy_fp minus = diy_fp::mul(b.minus, c);
+  const diy_fp plus = diy_fp::mul(b.plus, c);
+  // the products are rounded, the interval is shrunk by their error
+  length = 0;
+  decimal_exponent = -cached.k;
+  grisu_digit_gen(buffer, length, decimal_exponent, {minus.f + 1, minus.e}, w,
+                  {plus.f - 1, plus.e});
+}
+
+/**
+ * Writes digits * 10^decimal_exponent like %g would: in fixed notation if the
+ * decimal point is after at most max_point digits and there are at most 3
+ * zeros after it, otherwise in scientific notation with an exponent of at
+ * least 2 digits. buffer contains the digits and has room for the result.
+ */
+inline char* format_shortest(char* buffer,
+                             int length,
+                             int decimal_exponent,
+                             int max_point) noexcept {
+  const int k = length;
+  const int n = length + decimal_exponent;  // the place of the decimal point
+  const size_t uk = static_cast<size_t>(k);
+  if (k <= n && n <= max_point) {
+    std::memset(buffer + k, '0', static_cast<size_t>(n - k));
+    return buffer + n;
+  }
+  if (0 < n && n <= max_point) {
+    const size_t un = static_cast<size_t>(n);
+    std::memmove(buffer + un + 1, buffer + un, uk - un);
+    buffer[n] = '.';
+    return buffer + k + 1;
+  }
+  if (-4 < n && n <= 0) {
+    const size_t zeros = static_cast<size_t>(-n);
+    std::memmove(buffer + 2 + zeros, buffer, uk);
+    buffer[0] = '0';
+    buffer[1] = '.';
+    std::memset(buffer + 2, '0', zeros);
+    return buffer + 2 + zeros + uk;
+  }
+  char* p = buffer + 1;
+  if (k > 1) {
+    std::memmove(buffer + 2, buffer + 1, uk - 1);
+    buffer[1] = '.';
+    p = buffer + 1 + k;
+  }
+  *p++ = 'e';
+  int e = n - 1;
+  *p++ = e < 0 ? '-' : '+';
+  const unsigned ue = static_cast<unsigned>(e < 0 ? -e : e);
+  if (ue >= 100) {
+    *p++ = static_cast<char>('0' + ue / 100);
+    std::memcpy(p, two_digits() + (ue % 100) * 2, 2);
+  } else {
+    std::memcpy(p, two_digits() + ue * 2, 2);
+  }
+  return p + 2;
+}
+
+/**
+ * The longest output: "-1.2345678901234567e-308".
+ */
+constexpr size_t max_float_chars = 24;
+
+template <typename T>
+to_chars_result to_chars_float(char* first, char* last, T value) noexcept {
+  char buffer[max_float_chars + 8];
+  char* p = buffer;
+  typename binary_format<T>::bits_type bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if (bits >> (sizeof(bits) * 8 - 1)) {
+    *p++ = '-';
+    value = -value;
+  }
+  if (value != value) {
+    std::memcpy(p, "nan", 3);
+    p += 3;
+  } else if (value > std::numeric_limits<T>::max()) {
+    std::memcpy(p, "inf", 3);
+    p += 3;
+  } else if (value == 0) {
+    *p++ = '0';
+  } else {
+    int length;
+    int decimal_exponent;
+    grisu2(p, length, decimal_exponent, value);
+    p = format_shortest(p, length, decimal_exponent,
+                        std::numeric_limits<T>::digits10);
+  }
+  const size_t size = static_cast<size_t>(p - buffer);
+  if (static_cast<size_t>(last - first) < size)
+    return {last, std::errc::value_too_large};
+  std::memcpy(first, buffer, size);
+  return {first + size, std::errc()};
+}
+
+}  // namespace inner
+
+/**
+ * Writes the integer into [first, last) like std::to_chars of C++17, also
+ * in the earlier standards: '-' for the negative numbers, then the digits of
+ * base (2 to 36, the letters are lower case). The decimal digits are written
+ * two at a time from a table.
+ */
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value,
+                                  int>::type = 0>
+to_chars_result to_chars(char* first,
+                         char* last,
+                         T value,
+                         int base = 10) noexcept {
+  return inner::to_chars_integer(first, last, value, base);
+}
+
+/**
+ * Writes the shortest representation of the value which jasl::from_chars
+ * (and std::strtod) parses back to the same value, locale-independently. The
+ * notation is the one of %g: fixed if the exponent is in [-4, 15), otherwise
+ * scientific ("1e+20"). The infinities and NaNs are "inf", "-inf", "nan" and
+ * "-nan". At most 24 characters are written.
+ *
+ * The digits are generated with the Grisu2 algorithm, which finds the
+ * shortest digits for more than 99.9% of the values, and one more digit for
+ * the rest.
+ */
+inline to_chars_result to_chars(char* first,
+                                char* last,
+                                double value) noexcept {
+  return inner::to_chars_float(first, last, value);
+}
+
+/**
+ * The float version of jasl::to_chars: the shortest representation which
+ * parses back to the same float, in fixed notation if the exponent is in
+ * [-4, 6).
+ */
+inline to_chars_result to_chars(char* first,
+                                char* last,
+                                float value) noexcept {
+  return inner::to_chars_float(first, last, value);
+}
+
+}  // namespace jasl
@@ -0,0 +1,593 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_internal/jasl_varint.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+// FSST: Fast Static Symbol Table compression (Boncz, Neumann, Leis 2020).
+// Symbols are 1-8 bytes, kept as little-endian words with zeros after their
+// length. Code 255 is the escape: the next byte is a literal.
+
+constexpr unsigned fsst_escape = 255;
+constexpr unsigned fsst_max_symbols = 255;
+constexpr unsigned fsst_hash_size = 2048;
+constexpr size_t fsst_sample_size = 1 << 16;
+constexpr unsigned fsst_rounds = 5;
+
+struct fsst_symbol {
+  uint64_t word;
+  unsigned length;
+};
+
+inline uint64_t fsst_mask(unsigned length) noexcept {
+  return length >= 8 ? ~uint64_t(0) : (uint64_t(1) << (8 * length)) - 1;
+}
+
+// bucket of the first 3 bytes of word
+inline uint32_t fsst_hash(uint64_t word) noexcept {
+  return static_cast<uint32_t>(((word & 0xffffff) * 2654435761u) >> 15) &
+         (fsst_hash_size - 1);
+}
+
+class fsst_symbol_table {
+  uint64_t _words[256];
+  uint8_t _lengths[256];
+  unsigned _count;
+  // The matches are (length << 8) | code, length 0 is the escape.
+  uint16_t _byte_codes[256];
+  // the 2 byte symbol of the first 2 bytes or the byte code of the first byte
+  uint16_t _short_codes[1 << 16];
+  // the only symbol of 3 or more bytes of a bucket
+  uint64_t _hash_words[fsst_hash_size];
+  uint16_t _hash_codes[fsst_hash_size];
+
+ public:
+  /**
+   * Takes the symbols in order as long as there are free codes. Skips the
+   * duplicates and the long symbols whose bucket is taken.
+   */
+  explicit fsst_symbol_table(const std::vector<fsst_symbol>& symbols) noexcept
+      : _count(0) {
+    std::memset(_byte_codes, 0, sizeof(_byte_codes));
+    std::memset(_short_codes, 0, sizeof(_short_codes));
+    std::memset(_hash_codes, 0, sizeof(_hash_codes));
+    for (const fsst_symbol& symbol : symbols) {
+      if (_count == fsst_max_symbols)
+        break;
+      const uint16_t match =
+          static_cast<uint16_t>(symbol.length << 8 | _count);
+      if (symbol.length >= 3) {
+        const uint32_t h = fsst_hash(symbol.word);
+        if (_hash_codes[h] != 0)
+          continue;
+        _hash_words[h] = symbol.word;
+        _hash_codes[h] = match;
+      } else {
+        uint16_t& slot = symbol.length == 2
+                             ? _short_codes[symbol.word & 0xffff]
+                             : _byte_codes[symbol.word & 0xff];
+        if (slot != 0)
+          continue;
+        slot = match;
+      }
+      _words[_count] = symbol.word;
+      _lengths[_count] = static_cast<uint8_t>(symbol.length);
+      ++_count;
+    }
+    for (uint32_t key = 0; key < (1 << 16); ++key) {
+      if (_short_codes[key] == 0)
+        _short_codes[key] = _byte_codes[key & 0xff];
+    }
+  }
+
+  unsigned count() const noexcept { return _count; }
+
+  fsst_symbol symbol(unsigned code) const noexcept {
+    return fsst_symbol{_words[code], _lengths[code]};
+  }
+
+  /**
+   * The longest symbol at the start of word, of which size bytes are valid
+   * (the rest are 0), as (length << 8) | code. Length 0 is the escape.
+   */
+  unsigned find_longest(uint64_t word, size_t size) const noexcept {
+    const uint32_t h = fsst_hash(word);
+    const unsigned hashed = _hash_codes[h];
+    if (hashed != 0) {
+      const unsigned length = hashed >> 8;
+      if (length <= size && ((word ^ _hash_words[h]) & fsst_mask(length)) == 0)
+        return hashed;
+    }
+    const unsigned match = _short_codes[word & 0xffff];
+    if ((match >> 8) <= size)
+      return match;
+    return _byte_codes[word & 0xff];
+  }
+
+  /**
+   * Appends the codes of [s, s + size) to out.
+   */
+  void encode(const unsigned char* s,
+              size_t size,
+              std::vector<unsigned char>& out) const {
+    const size_t start = out.size();
+    out.resize(start + 2 * size);
+    unsigned char* o = out.data() + start;
+    const unsigned char* const end = s + size;
+    unsigned char tail[8];
+    while (s < end) {
+      const size_t left = static_cast<size_t>(end - s);
+      uint64_t word;
+      if (left >= 8) {
+        word = load_le64(s);
+      } else {
+        std::memset(tail, 0, sizeof(tail));
+        std::memcpy(tail, s, left);
+        word = load_le64(tail);
+      }
+      const unsigned match = find_longest(word, left);
+      if (match >> 8 != 0) {
+        *o++ = static_cast<unsigned char>(match);
+        s += match >> 8;
+      } else {
+        *o++ = static_cast<unsigned char>(fsst_escape);
+        *o++ = *s++;
+      }
+    }
+    out.resize(static_cast<size_t>(o - out.data()));
+  }
+
+  /**
+   * Decodes count codes into out, writes at most capacity bytes (possibly
+   * after the decoded bytes). Returns the decoded size, which can be more
+   * than capacity.
+   */
+  size_t decode(const unsigned char* codes,
+                size_t count,
+                unsigned char* out,
+                size_t capacity) const noexcept {
+    const unsigned char* const end = codes + count;
+    size_t size = 0;
+    // whole words while they fit, 4 symbols at once if none is escaped
+    while (end - codes >= 4 && capacity - size >= 32) {
+      const uint32_t four = load_u32(codes);
+      if (((~four - 0x01010101u) & four & 0x80808080u) != 0) {
+        const unsigned code = *codes++;
+        if (code != fsst_escape) {
+          store_le64(out + size, _words[code]);
+          size += _lengths[code];
+        } else {
+          out[size++] = *codes++;
+        }
+        continue;
+      }
+      const unsigned c0 = codes[0];
+      const unsigned c1 = codes[1];
+      const unsigned c2 = codes[2];
+      const unsigned c3 = codes[3];
+      codes += 4;
+      store_le64(out + size, _words[c0]);
+      size += _lengths[c0];
+      store_le64(out + size, _words[c1]);
+      size += _lengths[c1];
+      store_le64(out + size, _words[c2]);
+      size += _lengths[c2];
+      store_le64(out + size, _words[c3]);
+      size += _lengths[c3];
+    }
+    while (codes != end && capacity - size >= 8) {
+      const unsigned code = *codes++;
+      if (code != fsst_escape) {
+        store_le64(out + size, _words[code]);
+        size += _lengths[code];
+      } else {
+        out[size++] = *codes++;
+      }
+    }
+    while (codes != end) {
+      const unsigned code = *codes++;
+      if (code == fsst_escape) {
+        if (size < capacity)
+          out[size] = *codes;
+        ++codes;
+        ++size;
+        continue;
+      }
+      uint64_t word = _words[code];
+      for (unsigned i = 0; i < _lengths[code]; ++i, ++size, word >>= 8) {
+        if (size < capacity)
+          out[size] = static_cast<unsigned char>(word);
+      }
+    }
+    return size;
+  }
+
+  /**
+   * The decoded size of count codes.
+   */
+  size_t decoded_size(const unsigned char* codes, size_t count) const
+      noexcept {
+    const unsigned char* const end = codes + count;
+    size_t size = 0;
+    while (codes != end) {
+      const unsigned code = *codes++;
+      if (code == fsst_escape) {
+        ++codes;
+        ++size;
+      } else {
+        size += _lengths[code];
+      }
+    }
+    return size;
+  }
+
+  /**
+   * Builds the table in a few rounds: each round compresses the sample with
+   * the previous table, counts the codes and the pairs of consecutive codes
+   * (escaped bytes count as 1 byte symbols), then keeps the symbols and the
+   * concatenated pairs with the highest gain (frequency * length).
+   */
+  static std::unique_ptr<fsst_symbol_table> train(
+      const std::vector<std::pair<const unsigned char*, size_t>>& sample) {
+    std::unique_ptr<fsst_symbol_table> table(
+        new fsst_symbol_table(std::vector<fsst_symbol>()));
+    // codes 0-254 are the symbols, 256 + b is the byte b
+    std::vector<uint32_t> counts1(512);
+    std::vector<uint32_t> counts2(512 * 512);
+    std::vector<std::pair<uint64_t, fsst_symbol>> candidates;
+    std::vector<fsst_symbol> symbols;
+    for (unsigned round = 0; round < fsst_rounds; ++round) {
+      std::fill(counts1.begin(), counts1.end(), 0);
+      std::fill(counts2.begin(), counts2.end(), 0);
+      for (const auto& str : sample)
+        table->count(str.first, str.second, counts1, counts2);
+
+      candidates.clear();
+      for (unsigned c = 0; c < 512; ++c) {
+        if (counts1[c] == 0)
+          continue;
+        const fsst_symbol first = table->symbol_of(c);
+        candidates.emplace_back(uint64_t(counts1[c]) * first.length, first);
+        if (first.length == 8)
+          continue;
+        for (unsigned d = 0; d < 512; ++d) {
+          const uint32_t count = counts2[c * 512 + d];
+          if (count == 0)
+            continue;
+          const fsst_symbol second = table->symbol_of(d);
+          const unsigned length = std::min(first.length + second.length, 8u);
+          const fsst_symbol pair{
+              (first.word | second.word << (8 * first.length)) &
+                  fsst_mask(length),
+              length};
+          candidates.emplace_back(uint64_t(count) * length, pair);
+        }
+      }
+      // merges the gains of the same symbols
+      std::sort(candidates.begin(), candidates.end(),
+                [](const std::pair<uint64_t, fsst_symbol>& a,
+                   const std::pair<uint64_t, fsst_symbol>& b) {
+                  return a.second.length != b.second.length
+                             ? a.second.length < b.second.length
+                             : a.second.word < b.second.word;
+                });
+      size_t merged = 0;
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        if (merged > 0 &&
+            candidates[merged - 1].second.length ==
+                candidates[i].second.length &&
+            candidates[merged - 1].second.word == candidates[i].second.word) {
+          candidates[merged - 1].first += candidates[i].first;
+        } else {
+          candidates[merged++] = candidates[i];
+        }
+      }
+      candidates.resize(merged);
+      std::stable_sort(candidates.begin(), candidates.end(),
+                       [](const std::pair<uint64_t, fsst_symbol>& a,
+                          const std::pair<uint64_t, fsst_symbol>& b) {
+                         return a.first > b.first;
+                       });
+      symbols.clear();
+      for (const auto& candidate : candidates)
+        symbols.push_back(candidate.second);
+      table.reset(new fsst_symbol_table(symbols));
+    }
+    return table;
+  }
+
+ private:
+  fsst_symbol symbol_of(unsigned c) const noexcept {
+    return c < 256 ? symbol(c) : fsst_symbol{c - 256, 1};
+  }
+
+  void count(const unsigned char* s,
+             size_t size,
+             std::vector<uint32_t>& counts1,
+             std::vector<uint32_t>& counts2) const noexcept {
+    unsigned char tail[8];
+    unsigned previous = 512;
+    for (size_t pos = 0; pos < size;) {
+      const size_t left = size - pos;
+      uint64_t word;
+      if (left >= 8) {
+        word = load_le64(s + pos);
+      } else {
+        std::memset(tail, 0, sizeof(tail));
+        std::memcpy(tail, s + pos, left);
+        word = load_le64(tail);
+      }
+      const unsigned match = find_longest(word, left);
+      unsigned c = 256 + s[pos];
+      if (match >> 8 != 0) {
+        // the first byte alone is a candidate as well
+        if (match >> 8 > 1)
+          ++counts1[c];
+        c = match & 0xff;
+        pos += match >> 8;
+      } else {
+        ++pos;
+      }
+      ++counts1[c];
+      if (previous != 512)
+        ++counts2[previous * 512 + c];
+      previous = c;
+    }
+  }
+};
+
+}  // namespace inner
+
+/**
+ * Compressed container of strings for large sets of short strings, like URLs
+ * and ids. It trains a static symbol table on a sample of the strings (FSST):
+ * up to 255 symbols of 1-8 bytes which are replaced by 1 byte codes, the
+ * other bytes are escaped. Every string is compressed on its own, so any
+ * entry can be decompressed without the others; decompression writes whole
+ * symbols in a tight loop.
+ *
+ * The compression is deterministic, so two strings are equal if and only if
+ * their codes are: a key is compressed once with compress(), then equals()
+ * and find() compare it with the entries without decompressing them.
+ *
+ * Only single byte characters with the standard traits are supported.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_compressed_strings {
+  static_assert(inner::is_byte_char<CharT, Traits>::value,
+                "Only single byte characters are supported.");
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef std::basic_string<CharT, Traits> buffer_type;
+  /**
+   * The codes of a compressed key, see compress().
+   */
+  typedef std::vector<unsigned char> compressed_key;
+
+  constexpr static size_t npos = static_cast<size_t>(-1);
+
+ private:
+  // entries per sampled offset
+  constexpr static size_t sample_rate = 8;
+
+  std::shared_ptr<const inner::fsst_symbol_table> _table;
+  // the code count and the codes of the entries
+  std::vector<unsigned char> _codes;
+  std::vector<size_t> _offsets;
+  size_t _size;
+
+ public:
+  /**
+   * Trains the symbol table on a sample of the range, then compresses the
+   * range. The elements can be jasl::string_view-s, jasl::static_string-s,
+   * jasl::string-s, [std::string]-s or anything else with data() and size();
+   * the range is iterated three times.
+   */
+  template <typename ForwardIt>
+  basic_compressed_strings(ForwardIt first, ForwardIt last) : _size(0) {
+    size_t count = 0;
+    size_t total = 0;
+    for (ForwardIt it = first; it != last; ++it, ++count)
+      total += (*it).size();
+    // every stride-th string, about fsst_sample_size bytes
+    const size_t stride = total / inner::fsst_sample_size + 1;
+    std::vector<std::pair<const unsigned char*, size_t>> sample;
+    size_t index = 0;
+    for (ForwardIt it = first; it != last; ++it, ++index) {
+      if (index % stride == 0) {
+        const auto& element = *it;
+        sample.emplace_back(
+            reinterpret_cast<const unsigned char*>(element.data()),
+            std::min<size_t>(element.size(), inner::fsst_sample_size));
+      }
+    }
+    _table = inner::fsst_symbol_table::train(sample);
+
+    _codes.reserve(total / 2 + count);
+    _offsets.reserve(count / sample_rate + 1);
+    for (; first != last; ++first) {
+      const auto& element = *first;
+      push_back(string_view_type(element.data(), element.size()));
+    }
+    _codes.shrink_to_fit();
+  }
+
+  /**
+   * Compresses str with the trained table and appends it.
+   */
+  void push_back(string_view_type str) {
+    if (_size % sample_rate == 0)
+      _offsets.push_back(_codes.size());
+    const size_t start = _codes.size();
+    const size_t gap = inner::max_varint_size;
+    _codes.resize(start + gap);
+    encode(str, _codes);
+    // moves the codes after their count
+    const size_t count = _codes.size() - start - gap;
+    unsigned char length[inner::max_varint_size];
+    const size_t length_size = inner::write_varint(length, count);
+    std::memmove(_codes.data() + start + length_size,
+                 _codes.data() + start + gap, count);
+    std::memcpy(_codes.data() + start, length, length_size);
+    _codes.resize(start + length_size + count);
+    ++_size;
+  }
+
+  /**
+   * Number of strings.
+   */
+  size_t size() const noexcept { return _size; }
+  bool empty() const noexcept { return _size == 0; }
+
+  /**
+   * Number of symbols in the trained table.
+   */
+  size_t symbol_count() const noexcept { return _table->count(); }
+
+  /**
+   * Bytes allocated by the container, including the symbol table.
+   */
+  size_t memory_usage() const noexcept {
+    return _codes.capacity() + _offsets.capacity() * sizeof(size_t) +
+           sizeof(inner::fsst_symbol_table);
+  }
+
+  /**
+   * Size of the compressed entries, without the symbol table and the index.
+   */
+  size_t compressed_size() const noexcept { return _codes.size(); }
+
+  /**
+   * Decompresses the i-th string into [out, out + capacity). Like snprintf,
+   * it returns the size of the whole string, the output is truncated if it is
+   * more than capacity. The bytes after the string may be overwritten (up to
+   * capacity) because whole symbols are written at once.
+   */
+  size_t decompress(size_t i, CharT* out, size_t capacity) const noexcept {
+    const std::pair<const unsigned char*, size_t> entry = codes(i);
+    return _table->decode(entry.first, entry.second,
+                          reinterpret_cast<unsigned char*>(out), capacity);
+  }
+
+  /**
+   * Decompresses the i-th string into buffer. The returned view refers to
+   * buffer.
+   */
+  string_view_type decompress(size_t i, buffer_type& buffer) const {
+    const std::pair<const unsigned char*, size_t> entry = codes(i);
+    // every code decodes to at most 8 bytes
+    buffer.resize(8 * entry.second);
+    buffer.resize(_table->decode(
+        entry.first, entry.second,
+        reinterpret_cast<unsigned char*>(&buffer[0]), buffer.size()));
+    return string_view_type(buffer.data(), buffer.size());
+  }
+
+  /**
+   * Decompresses the i-th string into a new jasl::basic_string.
+   */
+  template <typename AllocatorT = std::allocator<CharT>>
+  basic_string<CharT, Traits, AllocatorT> to_string(
+      size_t i,
+      const AllocatorT& alloc = AllocatorT()) const {
+    const std::pair<const unsigned char*, size_t> entry = codes(i);
+    const size_t size = _table->decoded_size(entry.first, entry.second);
+    // the capacity is exactly the size, so decode() doesn't write past it
+    return basic_string<CharT, Traits, AllocatorT>::build(
+        size,
+        [&](CharT* ptr) {
+          _table->decode(entry.first, entry.second,
+                         reinterpret_cast<unsigned char*>(ptr), size);
+        },
+        alloc);
+  }
+
+  /**
+   * Compresses key with the table of the container for equals() and find().
+   */
+  compressed_key compress(string_view_type key) const {
+    compressed_key result;
+    encode(key, result);
+    return result;
+  }
+
+  /**
+   * Whether the i-th string equals the compressed key.
+   */
+  bool equals(size_t i, const compressed_key& key) const noexcept {
+    const std::pair<const unsigned char*, size_t> entry = codes(i);
+    return entry.second == key.size() &&
+           (key.empty() ||
+            std::memcmp(entry.first, key.data(), key.size()) == 0);
+  }
+
+  /**
+   * The index of the first string at pos or after which equals the
+   * compressed key, npos if there is none.
+   */
+  size_t find(const compressed_key& key, size_t pos = 0) const noexcept {
+    if (pos >= _size)
+      return npos;
+    const unsigned char* p = entry_begin(pos);
+    for (; pos < _size; ++pos) {
+      const size_t count = inner::read_varint(p);
+      if (count == key.size() &&
+          (count == 0 || std::memcmp(p, key.data(), count) == 0))
+        return pos;
+      p += count;
+    }
+    return npos;
+  }
+
+ private:
+  void encode(string_view_type str, std::vector<unsigned char>& out) const {
+    _table->encode(reinterpret_cast<const unsigned char*>(str.data()),
+                   str.size(), out);
+  }
+
+  const unsigned char* entry_begin(size_t i) const noexcept {
+    const unsigned char* p = _codes.data() + _offsets[i / sample_rate];
+    for (size_t k = i % sample_rate; k > 0; --k) {
+      const size_t count = inner::read_varint(p);
+      p += count;
+    }
+    return p;
+  }
+
+  /**
+   * The codes of the i-th entry and their count.
+   */
+  std::pair<const unsigned char*, size_t> codes(size_t i) const noexcept {
+    JASL_ASSERT(i < _size, "i < size()");
+    const unsigned char* p = entry_begin(i);
+    const size_t count = inner::read_varint(p);
+    return std::make_pair(p, count);
+  }
+};
+
+typedef basic_compressed_strings<char> compressed_strings;
+
+}  // namespace jasl
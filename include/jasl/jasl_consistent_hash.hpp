@@ -0,0 +1,435 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_hash.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+constexpr size_t consistent_hash_batch_size = 16;
+
+/**
+ * Jump consistent hash (Lamping and Veach): the bucket of key among
+ * bucket_count buckets.
+ */
+inline uint32_t jump_consistent_hash(uint64_t key,
+                                     uint32_t bucket_count) noexcept {
+  int64_t b = -1;
+  int64_t j = 0;
+  while (j < static_cast<int64_t>(bucket_count)) {
+    b = j;
+    key = key * 2862933555777941757ULL + 1;
+    j = static_cast<int64_t>(static_cast<double>(b + 1) *
+                             (static_cast<double>(int64_t(1) << 31) /
+                              static_cast<double>((key >> 33) + 1)));
+  }
+  return static_cast<uint32_t>(b);
+}
+
+/**
+ * jump_consistent_hash of 4 keys in lockstep: their dependency chains of
+ * multiplications and divisions overlap.
+ */
+inline void jump_consistent_hash4(const uint64_t keys[4],
+                                  uint32_t bucket_count,
+                                  uint32_t out[4]) noexcept {
+  const int64_t n = static_cast<int64_t>(bucket_count);
+  uint64_t key[4] = {keys[0], keys[1], keys[2], keys[3]};
+  int64_t b[4] = {-1, -1, -1, -1};
+  int64_t j[4] = {0, 0, 0, 0};
+  while (j[0] < n || j[1] < n || j[2] < n || j[3] < n) {
+    for (size_t i = 0; i < 4; ++i) {
+      if (j[i] < n) {
+        b[i] = j[i];
+        key[i] = key[i] * 2862933555777941757ULL + 1;
+        j[i] = static_cast<int64_t>(static_cast<double>(b[i] + 1) *
+                                    (static_cast<double>(int64_t(1) << 31) /
+                                     static_cast<double>((key[i] >> 33) + 1)));
+      }
+    }
+  }
+  for (size_t i = 0; i < 4; ++i)
+    out[i] = static_cast<uint32_t>(b[i]);
+}
+
+template <typename CharT>
+uint64_t consistent_hash_key(const CharT* data, size_t size) noexcept {
+  uint64_t hash[2];
+  hash128(data, size * sizeof(CharT), hash);
+  return hash[0];
+}
+
+/**
+ * Branchless lower bound of a sorted non-empty array: the number of the
+ * points less than key.
+ */
+inline size_t ring_lower_bound(const uint64_t* points,
+                               size_t size,
+                               uint64_t key) noexcept {
+  const uint64_t* base = points;
+  for (size_t n = size; n > 1; n -= n / 2)
+    base = base[n / 2] < key ? base + n / 2 : base;
+  return static_cast<size_t>(base - points) + (*base < key);
+}
+
+/**
+ * ring_lower_bound of count keys in lockstep: the searches take the same
+ * steps, so the cache misses of the keys overlap.
+ */
+inline void ring_lower_bound_batch(const uint64_t* points,
+                                   size_t size,
+                                   const uint64_t* keys,
+                                   size_t count,
+                                   size_t* out) noexcept {
+  const uint64_t* bases[consistent_hash_batch_size];
+  for (size_t i = 0; i < count; ++i)
+    bases[i] = points;
+  for (size_t n = size; n > 1; n -= n / 2) {
+    for (size_t i = 0; i < count; ++i)
+      bases[i] = bases[i][n / 2] < keys[i] ? bases[i] + n / 2 : bases[i];
+  }
+  for (size_t i = 0; i < count; ++i)
+    out[i] = static_cast<size_t>(bases[i] - points) + (*bases[i] < keys[i]);
+}
+
+}  // namespace inner
+
+/**
+ * Jump consistent hash of string keys: the shard of a key among shard_count
+ * numbered shards, in O(log shard_count) time and without memory. When the
+ * count grows from n to n + 1, only 1 / (n + 1) of the keys move, all of
+ * them to the new shard. Shards can only be added and removed at the end;
+ * see basic_rendezvous_hash and basic_hash_ring for named nodes.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_jump_hash {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+ private:
+  uint32_t _shard_count;
+
+ public:
+  /**
+   * Throws std::invalid_argument if shard_count isn't in [1, 2^31).
+   */
+  explicit basic_jump_hash(size_t shard_count)
+      : _shard_count(static_cast<uint32_t>(shard_count)) {
+    if (shard_count == 0 || static_cast<uint64_t>(shard_count) >= (1U << 31)) {
+      JASL_THROW(std::invalid_argument(
+          "jump_hash: shard_count is not in [1, 2^31)"));
+    }
+  }
+
+  size_t shard_count() const noexcept { return _shard_count; }
+
+  size_t shard(string_view_type key) const noexcept {
+    return inner::jump_consistent_hash(
+        inner::consistent_hash_key(key.data(), key.size()), _shard_count);
+  }
+
+  /**
+   * Writes shard(key) for every key of the range to out. Returns the end of
+   * the output. The elements can be jasl::string_view-s, jasl::string-s,
+   * [std::string]-s or anything else with data() and size().
+   */
+  template <typename InputIt, typename OutputIt>
+  OutputIt shards(InputIt first, InputIt last, OutputIt out) const {
+    uint64_t keys[inner::consistent_hash_batch_size];
+    uint32_t result[inner::consistent_hash_batch_size];
+    while (first != last) {
+      size_t count = 0;
+      for (; count < inner::consistent_hash_batch_size && first != last;
+           ++first, ++count)
+        keys[count] = inner::consistent_hash_key(first->data(), first->size());
+      size_t i = 0;
+      for (; i + 4 <= count; i += 4)
+        inner::jump_consistent_hash4(keys + i, _shard_count, result + i);
+      for (; i < count; ++i)
+        result[i] = inner::jump_consistent_hash(keys[i], _shard_count);
+      for (i = 0; i < count; ++i, ++out)
+        *out = static_cast<size_t>(result[i]);
+    }
+    return out;
+  }
+};
+
+/**
+ * Rendezvous (highest random weight) hashing of string keys to named nodes:
+ * the node of a key is the one with the highest score of the pair. Adding or
+ * removing a node moves only the keys of that node, evenly, in O(node_count)
+ * time per lookup.
+ *
+ * The returned node names are valid until the nodes change.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_rendezvous_hash {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef std::basic_string<CharT, Traits> node_type;
+
+ private:
+  std::vector<node_type> _nodes;
+  std::vector<uint64_t> _node_hashes;
+
+ public:
+  basic_rendezvous_hash() = default;
+
+  /**
+   * The nodes are the elements of the range.
+   */
+  template <typename InputIt>
+  basic_rendezvous_hash(InputIt first, InputIt last) {
+    for (; first != last; ++first)
+      add_node(string_view_type(first->data(), first->size()));
+  }
+
+  size_t node_count() const noexcept { return _nodes.size(); }
+
+  const std::vector<node_type>& node_names() const noexcept {
+    return _nodes;
+  }
+
+  /**
+   * Returns false if the node already exists.
+   */
+  bool add_node(string_view_type name) {
+    if (find_node(name) != _nodes.size())
+      return false;
+    _nodes.push_back(node_type(name.data(), name.size()));
+    _node_hashes.push_back(
+        inner::consistent_hash_key(name.data(), name.size()));
+    return true;
+  }
+
+  /**
+   * Returns false if there is no such node.
+   */
+  bool remove_node(string_view_type name) {
+    const size_t index = find_node(name);
+    if (index == _nodes.size())
+      return false;
+    _nodes.erase(_nodes.begin() + static_cast<std::ptrdiff_t>(index));
+    _node_hashes.erase(_node_hashes.begin() +
+                       static_cast<std::ptrdiff_t>(index));
+    return true;
+  }
+
+  /**
+   * The node of the key. The nodes must not be empty.
+   */
+  string_view_type node(string_view_type key) const noexcept {
+    return node_of(inner::consistent_hash_key(key.data(), key.size()));
+  }
+
+  /**
+   * Writes node(key) for every key of the range to out. Returns the end of
+   * the output.
+   */
+  template <typename InputIt, typename OutputIt>
+  OutputIt nodes(InputIt first, InputIt last, OutputIt out) const {
+    for (; first != last; ++first, ++out)
+      *out = node_of(inner::consistent_hash_key(first->data(), first->size()));
+    return out;
+  }
+
+ private:
+  size_t find_node(string_view_type name) const noexcept {
+    size_t i = 0;
+    while (i < _nodes.size() && string_view_type(_nodes[i].data(),
+                                                 _nodes[i].size()) != name)
+      ++i;
+    return i;
+  }
+
+  string_view_type node_of(uint64_t key) const noexcept {
+    JASL_ASSERT(!_nodes.empty(), "node_count() > 0");
+    size_t best = 0;
+    uint64_t best_score = 0;
+    for (size_t i = 0; i < _node_hashes.size(); ++i) {
+      const uint64_t score = inner::mix64(key ^ _node_hashes[i]);
+      if (score >= best_score) {
+        best = i;
+        best_score = score;
+      }
+    }
+    return string_view_type(_nodes[best].data(), _nodes[best].size());
+  }
+};
+
+/**
+ * Consistent hash ring of string keys to named nodes: every node has
+ * virtual_node_count points on a ring of 64 bit hashes, and the node of a key
+ * is the owner of the first point from the hash of the key. A lookup is a
+ * binary search; adding or removing a node moves only the keys of its
+ * points.
+ *
+ * The batch lookup searches a batch of keys in lockstep.
+ *
+ * The returned node names are valid until the nodes change.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_hash_ring {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef std::basic_string<CharT, Traits> node_type;
+
+ private:
+  size_t _virtual_node_count;
+  std::vector<node_type> _nodes;
+  // the sorted points, and the node index of each
+  std::vector<uint64_t> _points;
+  std::vector<uint32_t> _owners;
+
+ public:
+  /**
+   * Throws std::invalid_argument if virtual_node_count is 0.
+   */
+  explicit basic_hash_ring(size_t virtual_node_count = 160)
+      : _virtual_node_count(virtual_node_count) {
+    if (virtual_node_count == 0) {
+      JASL_THROW(
+          std::invalid_argument("hash_ring: virtual_node_count is 0"));
+    }
+  }
+
+  /**
+   * The nodes are the elements of the range.
+   */
+  template <typename InputIt>
+  basic_hash_ring(InputIt first,
+                  InputIt last,
+                  size_t virtual_node_count = 160)
+      : basic_hash_ring(virtual_node_count) {
+    for (; first != last; ++first) {
+      const string_view_type name(first->data(), first->size());
+      if (find_node(name) == _nodes.size())
+        _nodes.push_back(node_type(name.data(), name.size()));
+    }
+    rebuild();
+  }
+
+  size_t node_count() const noexcept { return _nodes.size(); }
+  size_t virtual_node_count() const noexcept { return _virtual_node_count; }
+
+  const std::vector<node_type>& node_names() const noexcept {
+    return _nodes;
+  }
+
+  /**
+   * Returns false if the node already exists.
+   */
+  bool add_node(string_view_type name) {
+    if (find_node(name) != _nodes.size())
+      return false;
+    _nodes.push_back(node_type(name.data(), name.size()));
+    rebuild();
+    return true;
+  }
+
+  /**
+   * Returns false if there is no such node.
+   */
+  bool remove_node(string_view_type name) {
+    const size_t index = find_node(name);
+    if (index == _nodes.size())
+      return false;
+    _nodes.erase(_nodes.begin() + static_cast<std::ptrdiff_t>(index));
+    rebuild();
+    return true;
+  }
+
+  /**
+   * The node of the key. The nodes must not be empty.
+   */
+  string_view_type node(string_view_type key) const noexcept {
+    JASL_ASSERT(!_nodes.empty(), "node_count() > 0");
+    return name(owner(inner::ring_lower_bound(
+        _points.data(), _points.size(),
+        inner::consistent_hash_key(key.data(), key.size()))));
+  }
+
+  /**
+   * Writes node(key) for every key of the range to out. Returns the end of
+   * the output.
+   */
+  template <typename InputIt, typename OutputIt>
+  OutputIt nodes(InputIt first, InputIt last, OutputIt out) const {
+    JASL_ASSERT(first == last || !_nodes.empty(), "node_count() > 0");
+    uint64_t keys[inner::consistent_hash_batch_size];
+    size_t positions[inner::consistent_hash_batch_size];
+    while (first != last) {
+      size_t count = 0;
+      for (; count < inner::consistent_hash_batch_size && first != last;
+           ++first, ++count)
+        keys[count] = inner::consistent_hash_key(first->data(), first->size());
+      inner::ring_lower_bound_batch(_points.data(), _points.size(), keys,
+                                    count, positions);
+      for (size_t i = 0; i < count; ++i, ++out)
+        *out = name(owner(positions[i]));
+    }
+    return out;
+  }
+
+ private:
+  string_view_type name(size_t index) const noexcept {
+    return string_view_type(_nodes[index].data(), _nodes[index].size());
+  }
+
+  /**
+   * The node of the point at position, the first one after the last.
+   */
+  size_t owner(size_t position) const noexcept {
+    return _owners[position < _points.size() ? position : 0];
+  }
+
+  size_t find_node(string_view_type node_name) const noexcept {
+    size_t i = 0;
+    while (i < _nodes.size() && name(i) != node_name)
+      ++i;
+    return i;
+  }
+
+  void rebuild() {
+    std::vector<std::pair<uint64_t, uint32_t>> points;
+    points.reserve(_nodes.size() * _virtual_node_count);
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+      uint64_t hash[2];
+      inner::hash128(_nodes[i].data(), _nodes[i].size() * sizeof(CharT), hash);
+      for (size_t v = 0; v < _virtual_node_count; ++v) {
+        points.push_back(std::make_pair(inner::mix64(hash[0] + v * hash[1]),
+                                        static_cast<uint32_t>(i)));
+      }
+    }
+    std::sort(points.begin(), points.end());
+    _points.clear();
+    _owners.clear();
+    for (const std::pair<uint64_t, uint32_t>& point : points) {
+      _points.push_back(point.first);
+      _owners.push_back(point.second);
+    }
+  }
+};
+
+typedef basic_jump_hash<char> jump_hash;
+typedef basic_rendezvous_hash<char> rendezvous_hash;
+typedef basic_hash_ring<char> hash_ring;
+
+}  // namespace jasl
@@ -0,0 +1,295 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "jasl/jasl_internal/jasl_byte_find.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * Bit i of the result is the parity of the bits 0..i of x. Applied to the
+ * quote positions it gives the bytes inside the quoted regions (the opening
+ * quote included, the closing one excluded). A doubled quote inside a quoted
+ * region flips it twice, so it stays inside.
+ */
+inline uint64_t prefix_xor(uint64_t x) noexcept {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+/**
+ * Bitmasks of the delimiters, the quotes and the newlines of a 64 byte block.
+ */
+struct csv_block_masks {
+  uint64_t delimiters;
+  uint64_t quotes;
+  uint64_t newlines;
+};
+
+inline csv_block_masks classify_csv_block(const unsigned char* ptr,
+                                          unsigned char delimiter,
+                                          unsigned char quote) noexcept {
+  csv_block_masks m = {0, 0, 0};
+#if JASL_INNER_SSE2
+  const __m128i d = _mm_set1_epi8(static_cast<char>(delimiter));
+  const __m128i q = _mm_set1_epi8(static_cast<char>(quote));
+  const __m128i n = _mm_set1_epi8('\n');
+  for (unsigned i = 0; i < 64; i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+    m.delimiters |= static_cast<uint64_t>(static_cast<uint32_t>(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(block, d))))
+                    << i;
+    m.quotes |= static_cast<uint64_t>(static_cast<uint32_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(block, q))))
+                << i;
+    m.newlines |= static_cast<uint64_t>(static_cast<uint32_t>(
+                      _mm_movemask_epi8(_mm_cmpeq_epi8(block, n))))
+                  << i;
+  }
+#elif JASL_INNER_LITTLE_ENDIAN
+  const uint64_t ones = 0x0101010101010101ull;
+  for (unsigned i = 0; i < 64; i += 8) {
+    const uint64_t x = load_u64(ptr + i);
+    m.delimiters |=
+        static_cast<uint64_t>(zero_byte_mask8(x ^ (ones * delimiter))) << i;
+    m.quotes |= static_cast<uint64_t>(zero_byte_mask8(x ^ (ones * quote)))
+                << i;
+    m.newlines |= static_cast<uint64_t>(zero_byte_mask8(x ^ (ones * '\n')))
+                  << i;
+  }
+#else
+  for (unsigned i = 0; i < 64; ++i) {
+    m.delimiters |= static_cast<uint64_t>(ptr[i] == delimiter) << i;
+    m.quotes |= static_cast<uint64_t>(ptr[i] == quote) << i;
+    m.newlines |= static_cast<uint64_t>(ptr[i] == '\n') << i;
+  }
+#endif
+  return m;
+}
+
+}  // namespace inner
+
+/**
+ * Splits a whole CSV (or TSV) buffer into fields without copying them.
+ *
+ * The buffer is classified 64 bytes at once: the quotes, the delimiters and
+ * the newlines become bitmasks (SSE2 if it is available), the quoted regions
+ * are computed from the quote mask with a prefix xor, and the delimiters and
+ * newlines outside of them are the field boundaries. Finding the next field
+ * is popping the lowest bit of the mask.
+ *
+ * The fields are views into the buffer (which has to outlive the scanner and
+ * the fields), without the enclosing quotes. Only the fields which contain
+ * doubled quotes have to be unescaped, see unescape.
+ *
+ * Format (RFC 4180): records are terminated by "\n" or "\r\n" (the last one
+ * can be unterminated), quotes are expected only at the beginning of the
+ * fields, quotes inside quoted fields are doubled. An empty line is a record
+ * with one empty field. With quoting turned off (typical for TSV) the quote
+ * characters are ordinary characters.
+ *
+ * Only single byte characters with the standard traits are supported.
+ *
+ * `while (scanner.next(field)) { ...; if (field.end_of_record) ... }`
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_csv_scanner {
+  static_assert(inner::is_byte_char<CharT, Traits>::value,
+                "Only single byte characters are supported.");
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+  struct field {
+    string_view_type value;  ///< without the enclosing quotes, still escaped
+    bool quoted;             ///< it was enclosed in quotes
+    bool escaped;            ///< it contains doubled quotes, see unescape
+    bool end_of_record;      ///< it is the last field of the record
+  };
+
+ private:
+  string_view_type _buffer;
+  CharT _delimiter;
+  CharT _quote;
+  bool _quoting;
+  bool _done;
+  size_t _field_begin;
+  size_t _block;           // the beginning of the classified block
+  size_t _next_block;      // the beginning of the next block to classify
+  uint64_t _boundaries;    // the unvisited field boundaries of the block
+  uint64_t _inside_carry;  // ~0 if the next block starts in a quoted region
+
+ public:
+  /**
+   * Throws std::invalid_argument if the delimiter is a newline character, or
+   * with quoting, if the quote is a newline character or the delimiter.
+   */
+  explicit basic_csv_scanner(string_view_type buffer,
+                             CharT delimiter = CharT(','),
+                             bool quoting = true,
+                             CharT quote = CharT('"'))
+      : _buffer(buffer),
+        _delimiter(delimiter),
+        _quote(quote),
+        _quoting(quoting),
+        _done(buffer.empty()),
+        _field_begin(0),
+        _block(0),
+        _next_block(0),
+        _boundaries(0),
+        _inside_carry(0) {
+    if (is_newline(delimiter) ||
+        (quoting && (is_newline(quote) || quote == delimiter))) {
+      JASL_THROW(std::invalid_argument(
+          "csv_scanner: the delimiter or the quote is ambiguous"));
+    }
+  }
+
+  /**
+   * Stores the next field and returns true, or returns false at the end of
+   * the buffer.
+   */
+  bool next(field& f) noexcept {
+    if (_done)
+      return false;
+    const size_t size = _buffer.size();
+    const size_t begin = _field_begin;
+    const size_t boundary = next_boundary();
+    size_t end;
+    if (boundary == static_cast<size_t>(-1)) {
+      end = size;
+      f.end_of_record = true;
+      _done = true;
+    } else {
+      end = boundary;
+      f.end_of_record = _buffer[boundary] != _delimiter;
+      _field_begin = boundary + 1;
+      _done = f.end_of_record && _field_begin == size;
+    }
+    const CharT* data = _buffer.data();
+    if (f.end_of_record && end > begin && data[end - 1] == CharT('\r'))
+      --end;
+    f.quoted = _quoting && end > begin && data[begin] == _quote;
+    if (f.quoted) {
+      const size_t last = end - 1 > begin && data[end - 1] == _quote ? 1 : 0;
+      f.value = string_view_type(data + begin + 1, end - begin - 1 - last);
+      f.escaped =
+          inner::find_byte(
+              reinterpret_cast<const unsigned char*>(f.value.data()),
+              f.value.size(),
+              static_cast<unsigned char>(_quote)) != static_cast<size_t>(-1);
+    } else {
+      f.value = string_view_type(data + begin, end - begin);
+      f.escaped = false;
+    }
+    return true;
+  }
+
+  /**
+   * Writes the value of the field into out with the doubled quotes undoubled
+   * and returns the written size. out has to have room for
+   * f.value.size() characters.
+   */
+  size_t unescape(const field& f, CharT* out) const noexcept {
+    if (!f.escaped) {
+      Traits::copy(out, f.value.data(), f.value.size());
+      return f.value.size();
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < f.value.size(); ++i) {
+      out[n++] = f.value[i];
+      if (f.value[i] == _quote && i + 1 < f.value.size() &&
+          f.value[i + 1] == _quote)
+        ++i;
+    }
+    return n;
+  }
+
+  /**
+   * The unescaped value of the field in a single allocation.
+   */
+  basic_string<CharT, Traits> unescape(const field& f) const {
+    size_t size = f.value.size();
+    if (f.escaped) {
+      for (size_t i = 0; i + 1 < f.value.size(); ++i) {
+        if (f.value[i] == _quote && f.value[i + 1] == _quote) {
+          --size;
+          ++i;
+        }
+      }
+    }
+    return basic_string<CharT, Traits>::build(
+        size, [&](CharT* out) { unescape(f, out); });
+  }
+
+ private:
+  static bool is_newline(CharT c) noexcept {
+    return c == CharT('\n') || c == CharT('\r');
+  }
+
+  size_t next_boundary() noexcept {
+    for (;;) {
+      if (_boundaries != 0) {
+        const size_t pos = _block + inner::count_trailing_zeros64(_boundaries);
+        _boundaries &= _boundaries - 1;
+        return pos;
+      }
+      if (_next_block >= _buffer.size())
+        return static_cast<size_t>(-1);
+      classify_next_block();
+    }
+  }
+
+  void classify_next_block() noexcept {
+    const unsigned char* ptr =
+        reinterpret_cast<const unsigned char*>(_buffer.data()) + _next_block;
+    const size_t n = _buffer.size() - _next_block;
+    uint64_t valid = ~static_cast<uint64_t>(0);
+    unsigned char tail[64];
+    if (n < 64) {
+      // the last block is copied, so nothing is read beyond the buffer
+      std::memcpy(tail, ptr, n);
+      std::memset(tail + n, 0, 64 - n);
+      ptr = tail;
+      valid = (static_cast<uint64_t>(1) << n) - 1;
+    }
+    const inner::csv_block_masks m = inner::classify_csv_block(
+        ptr, static_cast<unsigned char>(_delimiter),
+        static_cast<unsigned char>(_quote));
+    uint64_t inside = 0;
+    if (_quoting) {
+      inside = inner::prefix_xor(m.quotes & valid) ^ _inside_carry;
+      _inside_carry = static_cast<uint64_t>(0) - (inside >> 63);
+    }
+    _boundaries = (m.delimiters | m.newlines) & valid & ~inside;
+    _block = _next_block;
+    _next_block += 64;
+  }
+};
+
+typedef basic_csv_scanner<char> csv_scanner;
+
+}  // namespace jasl
@@ -0,0 +1,458 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_internal/jasl_string_view_bridge.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * Myers' bit-parallel edit distance (in Hyyro's formulation). A column of the
+ * dynamic programming matrix (one cell for each pattern character) is stored
+ * as two bit vectors of its vertical differences: pv has a bit where the
+ * cell is one more than the one above it, mv where it is one less. A text
+ * character advances the whole column with a few word operations. Patterns
+ * longer than 64 characters are split into blocks of 64 rows; the blocks are
+ * chained by the horizontal difference of their bottom row.
+ */
+
+/**
+ * Advances the 64 rows of a block by a text character. eq has the bits of
+ * the rows matching the character, hin is the horizontal difference (-1, 0
+ * or +1) of the row above the block. Returns the horizontal difference of
+ * the row of out_bit. The bits only affect the higher bits, so the bits
+ * above the last row of a pattern don't matter.
+ */
+inline int myers_advance(uint64_t& pv,
+                         uint64_t& mv,
+                         uint64_t eq,
+                         int hin,
+                         uint64_t out_bit) noexcept {
+  const uint64_t hin_neg = static_cast<uint64_t>(hin < 0);
+  const uint64_t xv = eq | mv;
+  eq |= hin_neg;
+  const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+  uint64_t ph = mv | ~(xh | pv);
+  uint64_t mh = pv & xh;
+  const int hout = static_cast<int>((ph & out_bit) != 0) -
+                   static_cast<int>((mh & out_bit) != 0);
+  ph = (ph << 1) | static_cast<uint64_t>(hin > 0);
+  mh = (mh << 1) | hin_neg;
+  pv = mh | ~(xv | ph);
+  mv = ph & xv;
+  return hout;
+}
+
+inline size_t add_difference(size_t value, int difference) noexcept {
+  return difference >= 0 ? value + static_cast<size_t>(difference)
+                         : value - static_cast<size_t>(-difference);
+}
+
+/**
+ * The match bit vectors of the pattern characters: row(c)[w] has a bit for
+ * each row of block w which is equal to c. Byte characters are looked up in a
+ * table of 256 rows, the others by binary search in the sorted distinct
+ * characters of the pattern (ordered and compared by Traits).
+ */
+template <typename CharT,
+          typename Traits,
+          bool Direct = is_byte_char<CharT, Traits>::value>
+class myers_match_bits {
+  size_t _words;
+  std::vector<uint64_t> _bits;
+
+ public:
+  myers_match_bits(const CharT* pattern, size_t size, bool reversed)
+      : _words((size + 63) / 64), _bits(256 * _words) {
+    for (size_t i = 0; i < size; ++i) {
+      const CharT c = pattern[reversed ? size - 1 - i : i];
+      _bits[static_cast<unsigned char>(c) * _words + i / 64] |=
+          static_cast<uint64_t>(1) << (i % 64);
+    }
+  }
+
+  const uint64_t* row(CharT c) const noexcept {
+    return _bits.data() + static_cast<unsigned char>(c) * _words;
+  }
+};
+
+template <typename CharT, typename Traits>
+class myers_match_bits<CharT, Traits, false> {
+  size_t _words;
+  std::vector<CharT> _chars;
+  // one more row of zeros for the characters which are not in the pattern
+  std::vector<uint64_t> _bits;
+
+  static bool less(CharT a, CharT b) noexcept { return Traits::lt(a, b); }
+
+ public:
+  myers_match_bits(const CharT* pattern, size_t size, bool reversed)
+      : _words((size + 63) / 64), _chars(pattern, pattern + size) {
+    std::sort(_chars.begin(), _chars.end(), &less);
+    _chars.erase(std::unique(_chars.begin(), _chars.end(),
+                             [](CharT a, CharT b) { return Traits::eq(a, b); }),
+                 _chars.end());
+    _bits.resize((_chars.size() + 1) * _words);
+    for (size_t i = 0; i < size; ++i) {
+      const CharT c = pattern[reversed ? size - 1 - i : i];
+      const size_t index = static_cast<size_t>(
+          std::lower_bound(_chars.begin(), _chars.end(), c, &less) -
+          _chars.begin());
+      _bits[index * _words + i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+    }
+  }
+
+  const uint64_t* row(CharT c) const noexcept {
+    const auto it = std::lower_bound(_chars.begin(), _chars.end(), c, &less);
+    const size_t index = it != _chars.end() && !Traits::lt(c, *it)
+                             ? static_cast<size_t>(it - _chars.begin())
+                             : _chars.size();
+    return _bits.data() + index * _words;
+  }
+};
+
+/**
+ * The distance of a pattern of 1..64 characters and the text, or
+ * max_distance + 1 if it is more (max_distance + text_size can't overflow).
+ * match_bits(c) is the match bit vector of c.
+ */
+template <typename CharT, typename MatchBitsF>
+size_t myers_distance_word(size_t size,
+                           const CharT* text,
+                           size_t text_size,
+                           size_t max_distance,
+                           MatchBitsF&& match_bits) {
+  const uint64_t out_bit = static_cast<uint64_t>(1) << (size - 1);
+  uint64_t pv = ~static_cast<uint64_t>(0);
+  uint64_t mv = 0;
+  size_t distance = size;
+  for (size_t j = 0; j < text_size; ++j) {
+    distance = add_difference(
+        distance, myers_advance(pv, mv, match_bits(text[j]), 1, out_bit));
+    // the distance decreases at most by one with each remaining character
+    if (distance > max_distance + (text_size - j - 1))
+      return max_distance + 1;
+  }
+  return distance;
+}
+
+}  // namespace inner
+
+/**
+ * A fuzzy occurrence of a pattern in a text: the pattern can be edited into
+ * text.substr(position, length) by distance insertions, deletions or
+ * substitutions. If there is no occurrence the position is npos (-1) and the
+ * object converts to false.
+ */
+struct fuzzy_match {
+  size_t position;
+  size_t length;
+  size_t distance;
+
+  explicit operator bool() const noexcept {
+    return position != static_cast<size_t>(-1);
+  }
+};
+
+/**
+ * A pattern prepared for computing its Levenshtein (edit) distance to many
+ * texts and for finding it in texts with errors, e.g. for matching user input
+ * against a dictionary with typos allowed. The cost is O(text_size) word
+ * operations for patterns up to 64 characters, O(text_size * size / 64)
+ * otherwise (Myers' bit-parallel algorithm); the thresholded distance only
+ * computes the blocks of the diagonal band which can hold the distance.
+ *
+ * The match bit vectors of the pattern are built in the construction, the
+ * characters are not referred to later. Characters are compared with
+ * Traits::eq, so e.g. jasl::ascii_case_insensitive_traits gives a case
+ * insensitive distance.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_levenshtein_pattern {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+ private:
+  size_t _size;
+  size_t _words;
+  inner::myers_match_bits<CharT, Traits> _forward;
+  inner::myers_match_bits<CharT, Traits> _backward;
+
+ public:
+  explicit basic_levenshtein_pattern(string_view_type pattern)
+      : _size(pattern.size()),
+        _words((pattern.size() + 63) / 64),
+        _forward(pattern.data(), pattern.size(), false),
+        _backward(pattern.data(), pattern.size(), true) {}
+
+  /**
+   * Number of characters of the pattern.
+   */
+  size_t size() const noexcept { return _size; }
+
+  /**
+   * The Levenshtein distance of the pattern and the text.
+   */
+  size_t distance(string_view_type text) const {
+    return distance(text, static_cast<size_t>(-1));
+  }
+
+  /**
+   * The Levenshtein distance of the pattern and the text if it is at most
+   * max_distance, max_distance + 1 otherwise. Texts which differ in size by
+   * more than max_distance are rejected without looking at them, the others
+   * are given up as soon as the distance can't get small enough.
+   */
+  size_t distance(string_view_type text, size_t max_distance) const {
+    const size_t text_size = text.size();
+    const size_t difference =
+        _size > text_size ? _size - text_size : text_size - _size;
+    if (difference > max_distance)
+      return max_distance + 1;
+    // the distance is never more than the longer size
+    const size_t limit = std::min(max_distance, std::max(_size, text_size));
+    if (_size == 0)
+      return text_size;
+    if (text_size == 0)
+      return _size;
+    if (_words == 1) {
+      return inner::myers_distance_word(
+          _size, text.data(), text_size, limit,
+          [this](CharT c) { return *_forward.row(c); });
+    }
+    return banded_distance(text.data(), text_size, limit);
+  }
+
+  /**
+   * The first fuzzy occurrence of the pattern in text[pos..): the one which
+   * ends first with at most max_distance errors. The distance is the least
+   * one of the substrings ending there, and the length is the shortest of
+   * them. For the next non-overlapping occurrence search from
+   * position + length (+ 1 if the length is 0).
+   */
+  fuzzy_match find(string_view_type text,
+                   size_t max_distance,
+                   size_t pos = 0) const {
+    const size_t npos = static_cast<size_t>(-1);
+    const size_t text_size = text.size();
+    fuzzy_match result = {npos, 0, 0};
+    if (pos > text_size)
+      return result;
+    if (_size <= max_distance) {
+      // deleting the whole pattern is good enough
+      result.position = pos;
+      result.distance = _size;
+      return result;
+    }
+    const CharT* const ptr = text.data();
+    const size_t words = _words;
+    const uint64_t high_bit = static_cast<uint64_t>(1) << 63;
+    const uint64_t last_bit = static_cast<uint64_t>(1) << ((_size - 1) % 64);
+    std::vector<uint64_t> pv(words, ~static_cast<uint64_t>(0));
+    std::vector<uint64_t> mv(words, 0);
+
+    // Searching: the first row of the matrix is zero, an occurrence can
+    // start anywhere.
+    size_t distance = _size;
+    size_t end = npos;
+    for (size_t j = pos; j < text_size; ++j) {
+      const uint64_t* eq = _forward.row(ptr[j]);
+      int h = 0;
+      for (size_t w = 0; w < words; ++w) {
+        h = inner::myers_advance(pv[w], mv[w], eq[w], h,
+                                 w + 1 == words ? last_bit : high_bit);
+      }
+      distance = inner::add_difference(distance, h);
+      if (distance <= max_distance) {
+        end = j + 1;
+        break;
+      }
+    }
+    if (end == npos)
+      return result;
+
+    // The start: the reversed pattern is aligned to the characters before
+    // the end backwards, the shortest one with the least distance wins.
+    std::fill(pv.begin(), pv.end(), ~static_cast<uint64_t>(0));
+    std::fill(mv.begin(), mv.end(), 0);
+    const size_t max_length = std::min(end - pos, _size + max_distance);
+    size_t backward = _size;
+    result.distance = _size;
+    for (size_t length = 1; length <= max_length; ++length) {
+      const uint64_t* eq = _backward.row(ptr[end - length]);
+      int h = 1;
+      for (size_t w = 0; w < words; ++w) {
+        h = inner::myers_advance(pv[w], mv[w], eq[w], h,
+                                 w + 1 == words ? last_bit : high_bit);
+      }
+      backward = inner::add_difference(backward, h);
+      if (backward < result.distance) {
+        result.distance = backward;
+        result.length = length;
+      }
+    }
+    JASL_ASSERT(result.distance == distance, "the two directions agree");
+    result.position = end - result.length;
+    return result;
+  }
+
+ private:
+  /**
+   * The multi-block distance limited to the diagonal band of the cells which
+   * can be on an alignment of at most max_distance cost: a cell on diagonal
+   * d = row - column costs at least |d| to reach and |d - (size - text_size)|
+   * to leave. Only the blocks intersecting the band are advanced.
+   *
+   * A block entering the band at the bottom starts from the block above it
+   * plus one for each row, a block leaving it at the top is not advanced
+   * anymore and the block below it takes +1 as its horizontal input. Both
+   * can only overestimate the cells, and they overestimate only the cells
+   * which are more than max_distance already, so the cells of the cheap
+   * alignments are exact.
+   */
+  size_t banded_distance(const CharT* text,
+                         size_t text_size,
+                         size_t max_distance) const {
+    const size_t words = _words;
+    const uint64_t high_bit = static_cast<uint64_t>(1) << 63;
+    const uint64_t last_bit = static_cast<uint64_t>(1) << ((_size - 1) % 64);
+    const std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(_size) -
+                                 static_cast<std::ptrdiff_t>(text_size);
+    const std::ptrdiff_t slack = static_cast<std::ptrdiff_t>(
+        (max_distance - static_cast<size_t>(delta < 0 ? -delta : delta)) / 2);
+    const std::ptrdiff_t low = std::min<std::ptrdiff_t>(0, delta) - slack;
+    const std::ptrdiff_t high = std::max<std::ptrdiff_t>(0, delta) + slack;
+
+    std::vector<uint64_t> pv(words);
+    std::vector<uint64_t> mv(words);
+    // the cell of the bottom row of the block
+    std::vector<size_t> bottom(words);
+    size_t first = 0;
+    size_t initialized = 0;
+    for (size_t j = 1; j <= text_size; ++j) {
+      // the rows of the band are [j + low, j + high], 1 based
+      const std::ptrdiff_t top_row = static_cast<std::ptrdiff_t>(j) + low;
+      const size_t bottom_row = std::min(
+          _size, static_cast<size_t>(static_cast<std::ptrdiff_t>(j) + high));
+      if (top_row > 1)
+        first = std::max(first, static_cast<size_t>(top_row - 1) / 64);
+      const size_t last = (bottom_row - 1) / 64;
+      for (; initialized <= last; ++initialized) {
+        const size_t b = initialized;
+        pv[b] = ~static_cast<uint64_t>(0);
+        mv[b] = 0;
+        bottom[b] = (b == 0 ? 0 : bottom[b - 1]) +
+                    std::min<size_t>(64, _size - b * 64);
+      }
+      const uint64_t* eq = _forward.row(text[j - 1]);
+      int h = 1;
+      for (size_t b = first; b <= last; ++b) {
+        h = inner::myers_advance(pv[b], mv[b], eq[b], h,
+                                 b + 1 == words ? last_bit : high_bit);
+        bottom[b] = inner::add_difference(bottom[b], h);
+      }
+      if (last + 1 == words && bottom[last] > max_distance + (text_size - j))
+        return max_distance + 1;
+    }
+    return bottom[words - 1];
+  }
+};
+
+typedef basic_levenshtein_pattern<char> levenshtein_pattern;
+
+/**
+ * The Levenshtein distance of two strings if it is at most max_distance,
+ * max_distance + 1 otherwise. The shorter string is the pattern; byte
+ * strings up to 64 characters need no allocation.
+ */
+template <typename CharT, typename Traits>
+size_t levenshtein_distance(
+    basic_string_view<CharT, Traits> a,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type b,
+    size_t max_distance = static_cast<size_t>(-1)) {
+  const basic_string_view<CharT, Traits> pattern = a.size() <= b.size() ? a : b;
+  const basic_string_view<CharT, Traits> text = a.size() <= b.size() ? b : a;
+  if (text.size() - pattern.size() > max_distance)
+    return max_distance + 1;
+  if (pattern.empty())
+    return text.size();
+  if (!inner::is_byte_char<CharT, Traits>::value || pattern.size() > 64) {
+    return basic_levenshtein_pattern<CharT, Traits>(pattern).distance(
+        text, max_distance);
+  }
+  // Only the entries of the characters of the two strings are read.
+  uint64_t match_bits[256];
+  if (pattern.size() + text.size() < 256) {
+    for (size_t i = 0; i < text.size(); ++i)
+      match_bits[static_cast<unsigned char>(text[i])] = 0;
+    for (size_t i = 0; i < pattern.size(); ++i)
+      match_bits[static_cast<unsigned char>(pattern[i])] = 0;
+  } else {
+    std::fill(match_bits, match_bits + 256, 0);
+  }
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    match_bits[static_cast<unsigned char>(pattern[i])] |=
+        static_cast<uint64_t>(1) << i;
+  }
+  return inner::myers_distance_word(
+      pattern.size(), text.data(), text.size(),
+      std::min(max_distance, text.size()),
+      [&match_bits](CharT c) {
+        return match_bits[static_cast<unsigned char>(c)];
+      });
+}
+
+/**
+ * The first fuzzy occurrence of the pattern in text[pos..) with at most
+ * max_distance errors, see basic_levenshtein_pattern::find.
+ */
+template <typename CharT, typename Traits>
+fuzzy_match fuzzy_find(
+    basic_string_view<CharT, Traits> text,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type pattern,
+    size_t max_distance,
+    size_t pos = 0) {
+  return basic_levenshtein_pattern<CharT, Traits>(pattern).find(
+      text, max_distance, pos);
+}
+
+/*
+ * The same for the jasl::static_string and jasl::string.
+ */
+
+template <typename CharT, typename Traits>
+size_t levenshtein_distance(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& a,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type b,
+    size_t max_distance = static_cast<size_t>(-1)) {
+  return levenshtein_distance(static_cast<basic_string_view<CharT, Traits>>(a),
+                              b, max_distance);
+}
+
+template <typename CharT, typename Traits>
+fuzzy_match fuzzy_find(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& text,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type pattern,
+    size_t max_distance,
+    size_t pos = 0) {
+  return fuzzy_find(static_cast<basic_string_view<CharT, Traits>>(text),
+                    pattern, max_distance, pos);
+}
+
+}  // namespace jasl
@@ -0,0 +1,225 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "jasl/jasl_charconv.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * An argument of jasl::format as characters: the numbers are written into
+ * the buffer, the strings are referenced.
+ */
+struct format_arg {
+  const char* ptr;  // nullptr if the characters are in the buffer
+  size_t size;
+  char buffer[max_float_chars];
+
+  const char* data() const noexcept { return ptr != nullptr ? ptr : buffer; }
+};
+
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value &&
+                                      !std::is_same<T, bool>::value &&
+                                      !std::is_same<T, char>::value,
+                                  int>::type = 0>
+void set_format_arg(format_arg& arg, T value) noexcept {
+  const to_chars_result r =
+      jasl::to_chars(arg.buffer, arg.buffer + sizeof(arg.buffer), value);
+  arg.ptr = nullptr;
+  arg.size = static_cast<size_t>(r.ptr - arg.buffer);
+}
+
+inline void set_format_arg(format_arg& arg, double value) noexcept {
+  const to_chars_result r =
+      jasl::to_chars(arg.buffer, arg.buffer + sizeof(arg.buffer), value);
+  arg.ptr = nullptr;
+  arg.size = static_cast<size_t>(r.ptr - arg.buffer);
+}
+
+inline void set_format_arg(format_arg& arg, float value) noexcept {
+  const to_chars_result r =
+      jasl::to_chars(arg.buffer, arg.buffer + sizeof(arg.buffer), value);
+  arg.ptr = nullptr;
+  arg.size = static_cast<size_t>(r.ptr - arg.buffer);
+}
+
+inline void set_format_arg(format_arg& arg, bool value) noexcept {
+  arg.ptr = value ? "true" : "false";
+  arg.size = value ? 4 : 5;
+}
+
+inline void set_format_arg(format_arg& arg, char value) noexcept {
+  arg.buffer[0] = value;
+  arg.ptr = nullptr;
+  arg.size = 1;
+}
+
+inline void set_format_arg(format_arg& arg, const char* value) noexcept {
+  JASL_ASSERT(value != nullptr, "format: null string argument");
+  arg.ptr = value;
+  arg.size = std::strlen(value);
+}
+
+inline void set_format_arg(format_arg& arg, string_view value) noexcept {
+  arg.ptr = value.data();
+  arg.size = value.size();
+}
+
+template <typename Traits, typename AllocatorT>
+void set_format_arg(
+    format_arg& arg,
+    const std::basic_string<char, Traits, AllocatorT>& value) noexcept {
+  arg.ptr = value.data();
+  arg.size = value.size();
+}
+
+inline void set_format_args(format_arg*) noexcept {}
+
+template <typename T, typename... Rest>
+void set_format_args(format_arg* out, const T& value, const Rest&... rest) {
+  set_format_arg(*out, value);
+  set_format_args(out + 1, rest...);
+}
+
+/**
+ * Walks the format string: calls literal(ptr, size) for the characters
+ * between the fields and field(index) for the {} fields. "{{" and "}}" are
+ * the escaped braces. Throws std::invalid_argument if a brace is not matched
+ * or the number of the fields is not arg_count.
+ */
+template <typename LiteralT, typename FieldT>
+void walk_format(string_view fmt,
+                 size_t arg_count,
+                 LiteralT&& literal,
+                 FieldT&& field) {
+  const char* p = fmt.data();
+  const char* const end = p + fmt.size();
+  const char* run = p;
+  size_t index = 0;
+  while (p != end) {
+    const char c = *p;
+    if (c != '{' && c != '}') {
+      ++p;
+      continue;
+    }
+    literal(run, static_cast<size_t>(p - run));
+    if (p + 1 != end && p[1] == c) {
+      literal(p, 1);
+    } else {
+      if (c == '}' || p + 1 == end || p[1] != '}')
+        JASL_THROW(std::invalid_argument("format: unmatched brace"));
+      if (index == arg_count)
+        JASL_THROW(std::invalid_argument("format: too few arguments"));
+      field(index++);
+    }
+    p += 2;
+    run = p;
+  }
+  literal(run, static_cast<size_t>(p - run));
+  if (index != arg_count)
+    JASL_THROW(std::invalid_argument("format: too many arguments"));
+}
+
+inline size_t formatted_size(string_view fmt,
+                             const format_arg* args,
+                             size_t arg_count) {
+  size_t size = 0;
+  walk_format(fmt, arg_count, [&](const char*, size_t n) { size += n; },
+              [&](size_t i) { size += args[i].size; });
+  return size;
+}
+
+inline char* format_into(char* out,
+                         string_view fmt,
+                         const format_arg* args,
+                         size_t arg_count) {
+  walk_format(fmt, arg_count,
+              [&](const char* ptr, size_t n) {
+                // the data of an empty static_string is nullptr
+                if (n != 0)
+                  std::memcpy(out, ptr, n);
+                out += n;
+              },
+              [&](size_t i) {
+                if (args[i].size != 0)
+                  std::memcpy(out, args[i].data(), args[i].size);
+                out += args[i].size;
+              });
+  return out;
+}
+
+}  // namespace inner
+
+/**
+ * The length of the result of jasl::format.
+ */
+template <typename... Args>
+size_t formatted_size(static_string fmt, const Args&... args) {
+  inner::format_arg converted[sizeof...(Args) + 1];
+  inner::set_format_args(converted, args...);
+  return inner::formatted_size(fmt, converted, sizeof...(Args));
+}
+
+/**
+ * Replaces the {} fields of the format string with the arguments in order
+ * ("{{" and "}}" are the braces themselves). The arguments can be
+ * - integers and floating point numbers, written by jasl::to_chars,
+ * - bool ("true" or "false") and char,
+ * - NUL-terminated strings, std::string, views and the jasl strings.
+ *
+ * The numbers are converted into buffers on the stack first, so the exact
+ * size of the result is known and it is written into a single allocation.
+ * There is no locale and no stream. The format string is a static string
+ * (usually a literal). Throws std::invalid_argument if the number of the
+ * fields and the arguments differ or a brace is not matched.
+ */
+template <typename... Args>
+string format(static_string fmt, const Args&... args) {
+  inner::format_arg converted[sizeof...(Args) + 1];
+  inner::set_format_args(converted, args...);
+  const size_t size = inner::formatted_size(fmt, converted, sizeof...(Args));
+  return string::build(size, [&](char* out) {
+    inner::format_into(out, fmt, converted, sizeof...(Args));
+  });
+}
+
+/**
+ * jasl::format into the caller's buffer [first, last), without any
+ * allocation. Returns the end of the written characters, or
+ * std::errc::value_too_large (and last) without writing anything if the
+ * result doesn't fit. No NUL is written.
+ */
+template <typename... Args>
+to_chars_result format_to(char* first,
+                          char* last,
+                          static_string fmt,
+                          const Args&... args) {
+  inner::format_arg converted[sizeof...(Args) + 1];
+  inner::set_format_args(converted, args...);
+  const size_t size = inner::formatted_size(fmt, converted, sizeof...(Args));
+  if (static_cast<size_t>(last - first) < size)
+    return {last, std::errc::value_too_large};
+  return {inner::format_into(first, fmt, converted, sizeof...(Args)),
+          std::errc()};
+}
+
+}  // namespace jasl
@@ -0,0 +1,273 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_varint.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+inline size_t common_prefix_size(const unsigned char* a,
+                                 size_t a_size,
+                                 const unsigned char* b,
+                                 size_t b_size) noexcept {
+  const size_t size = std::min(a_size, b_size);
+  size_t i = 0;
+  while (i < size && a[i] == b[i])
+    ++i;
+  return i;
+}
+
+}  // namespace inner
+
+/**
+ * Immutable set of sorted strings stored with front coding: the keys are
+ * grouped into blocks of block_size() keys, the first key of a block (its
+ * head) is stored whole, the others as the length of the prefix shared with
+ * the previous key and the rest of the key. The lengths are varints. The
+ * offsets of the blocks are the sampled index: a lookup binary searches the
+ * heads in place, then scans one block; the scan compares only the bytes
+ * after the prefix shared by the key and the previous entry.
+ *
+ * The id of a key is its position in the sorted order. The entries are
+ * decoded into a [std::basic_string] buffer supplied by the caller, which can
+ * be reused for many calls without allocations.
+ *
+ * Only single byte characters with the standard traits are supported.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_front_coded_dictionary {
+  static_assert(inner::is_byte_char<CharT, Traits>::value,
+                "Only single byte characters are supported.");
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef std::basic_string<CharT, Traits> buffer_type;
+
+  constexpr static size_t npos = static_cast<size_t>(-1);
+
+ private:
+  size_t _size;
+  size_t _block_size;
+  std::vector<unsigned char> _data;
+  std::vector<size_t> _block_offsets;
+
+ public:
+  /**
+   * The elements of the range can be jasl::string_view-s,
+   * jasl::static_string-s, jasl::string-s, [std::string]-s or anything else
+   * with data() and size(); they are copied. Throws std::invalid_argument
+   * if they are not strictly increasing or block_size is 0.
+   */
+  template <typename InputIt>
+  basic_front_coded_dictionary(InputIt first,
+                               InputIt last,
+                               size_t block_size = 16)
+      : _size(0), _block_size(block_size) {
+    if (block_size == 0) {
+      JASL_THROW(
+          std::invalid_argument("front_coded_dictionary: block_size is 0"));
+    }
+    buffer_type previous;
+    for (; first != last; ++first) {
+      const auto& element = *first;
+      const string_view_type key(element.data(), element.size());
+      const unsigned char* const bytes =
+          reinterpret_cast<const unsigned char*>(key.data());
+      if (_size > 0 &&
+          !(string_view_type(previous.data(), previous.size()) < key)) {
+        JASL_THROW(std::invalid_argument(
+            "front_coded_dictionary: the keys are not sorted and unique"));
+      }
+      size_t shared = 0;
+      if (_size % _block_size == 0) {
+        _block_offsets.push_back(_data.size());
+      } else {
+        shared = inner::common_prefix_size(
+            reinterpret_cast<const unsigned char*>(previous.data()),
+            previous.size(), bytes, key.size());
+        inner::write_varint(_data, shared);
+      }
+      inner::write_varint(_data, key.size() - shared);
+      _data.insert(_data.end(), bytes + shared, bytes + key.size());
+      previous.assign(key.data(), key.size());
+      ++_size;
+    }
+    _data.shrink_to_fit();
+    _block_offsets.shrink_to_fit();
+  }
+
+  /**
+   * Number of keys.
+   */
+  size_t size() const noexcept { return _size; }
+  bool empty() const noexcept { return _size == 0; }
+
+  size_t block_size() const noexcept { return _block_size; }
+
+  /**
+   * Bytes allocated by the dictionary.
+   */
+  size_t memory_usage() const noexcept {
+    return _data.capacity() + _block_offsets.capacity() * sizeof(size_t);
+  }
+
+  /**
+   * The id of key, npos if it isn't in the dictionary.
+   */
+  size_t find(string_view_type key) const noexcept {
+    const std::pair<size_t, bool> l = locate(key);
+    return l.second ? l.first : npos;
+  }
+
+  bool contains(string_view_type key) const noexcept {
+    return locate(key).second;
+  }
+
+  /**
+   * Number of keys less than key (the id of key if it is in the
+   * dictionary).
+   */
+  size_t rank(string_view_type key) const noexcept {
+    return locate(key).first;
+  }
+
+  /**
+   * Decodes the key of id into buffer. The returned view refers to buffer.
+   */
+  string_view_type access(size_t id, buffer_type& buffer) const {
+    JASL_ASSERT(id < _size, "id < size()");
+    const unsigned char* p = _data.data() + _block_offsets[id / _block_size];
+    decode_head(p, buffer);
+    for (size_t i = id % _block_size; i > 0; --i)
+      decode_next(p, buffer);
+    return string_view_type(buffer.data(), buffer.size());
+  }
+
+  /**
+   * Calls f(size_t id, string_view_type key) for every key which starts with
+   * prefix, in order. key refers to buffer, it is valid during the call.
+   */
+  template <typename F>
+  void for_each_prefixed(string_view_type prefix,
+                         buffer_type& buffer,
+                         F&& f) const {
+    size_t id = rank(prefix);
+    if (id == _size)
+      return;
+    const unsigned char* p = _data.data() + _block_offsets[id / _block_size];
+    decode_head(p, buffer);
+    for (size_t i = id % _block_size; i > 0; --i)
+      decode_next(p, buffer);
+    for (;;) {
+      if (buffer.size() < prefix.size() ||
+          Traits::compare(buffer.data(), prefix.data(), prefix.size()) != 0)
+        return;
+      f(id, string_view_type(buffer.data(), buffer.size()));
+      if (++id == _size)
+        return;
+      if (id % _block_size == 0)
+        decode_head(p, buffer);
+      else
+        decode_next(p, buffer);
+    }
+  }
+
+  template <typename F>
+  void for_each_prefixed(string_view_type prefix, F&& f) const {
+    buffer_type buffer;
+    for_each_prefixed(prefix, buffer, f);
+  }
+
+ private:
+  static void decode_head(const unsigned char*& p, buffer_type& buffer) {
+    const size_t size = inner::read_varint(p);
+    buffer.assign(reinterpret_cast<const CharT*>(p), size);
+    p += size;
+  }
+
+  static void decode_next(const unsigned char*& p, buffer_type& buffer) {
+    const size_t shared = inner::read_varint(p);
+    const size_t size = inner::read_varint(p);
+    buffer.resize(shared);
+    buffer.append(reinterpret_cast<const CharT*>(p), size);
+    p += size;
+  }
+
+  string_view_type head(size_t block) const noexcept {
+    const unsigned char* p = _data.data() + _block_offsets[block];
+    const size_t size = inner::read_varint(p);
+    return string_view_type(reinterpret_cast<const CharT*>(p), size);
+  }
+
+  /**
+   * The rank of key and whether it is in the dictionary.
+   */
+  std::pair<size_t, bool> locate(string_view_type key) const noexcept {
+    // the first block whose head is greater than key
+    size_t lo = 0;
+    size_t hi = _block_offsets.size();
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (key < head(mid))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    if (lo == 0)
+      return std::make_pair(0, false);
+
+    const size_t block = lo - 1;
+    const unsigned char* const k =
+        reinterpret_cast<const unsigned char*>(key.data());
+    const unsigned char* p = _data.data() + _block_offsets[block];
+    const size_t head_size = inner::read_varint(p);
+    // the common prefix of key and the current entry, which is less than key
+    size_t match = inner::common_prefix_size(p, head_size, k, key.size());
+    size_t id = block * _block_size;
+    if (match == head_size && match == key.size())
+      return std::make_pair(id, true);
+    p += head_size;
+    const size_t end = std::min(id + _block_size, _size);
+    for (++id; id < end; ++id) {
+      const size_t shared = inner::read_varint(p);
+      const size_t size = inner::read_varint(p);
+      const unsigned char* const rest = p;
+      p += size;
+      // the previous entry differs from key at match by a smaller byte (or
+      // ends there); the entry shares more or less of it
+      if (shared > match)
+        continue;
+      if (shared < match)
+        return std::make_pair(id, false);
+      match += inner::common_prefix_size(rest, size, k + match,
+                                         key.size() - match);
+      const size_t entry_size = shared + size;
+      if (match == key.size())
+        return std::make_pair(id, match == entry_size);
+      if (match != entry_size && rest[match - shared] > k[match])
+        return std::make_pair(id, false);
+    }
+    return std::make_pair(end, false);
+  }
+};
+
+typedef basic_front_coded_dictionary<char> front_coded_dictionary;
+
+}  // namespace jasl
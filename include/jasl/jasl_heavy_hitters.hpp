@@ -0,0 +1,564 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_hash.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+constexpr size_t cms_max_depth = 32;
+
+// The counters of a sketch are plain or (in the shards of the concurrent
+// sketch) atomic. A shard has a single writer, so it needs no read-modify-
+// write operations.
+
+inline uint64_t cms_load(const uint64_t& counter) noexcept {
+  return counter;
+}
+
+inline uint64_t cms_load(const std::atomic<uint64_t>& counter) noexcept {
+  return counter.load(std::memory_order_relaxed);
+}
+
+inline void cms_store(uint64_t& counter, uint64_t value) noexcept {
+  counter = value;
+}
+
+inline void cms_store(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+  counter.store(value, std::memory_order_relaxed);
+}
+
+/**
+ * The counter of the row: the rows are hashed by h1 + row * h2 of the two
+ * halves of one 128 bit hash (Kirsch-Mitzenmacher).
+ */
+inline size_t cms_index(const uint64_t hash[2],
+                        size_t row,
+                        size_t width) noexcept {
+  const uint64_t h = hash[0] + row * hash[1];
+  return row * width + static_cast<size_t>(((h >> 32) * width) >> 32);
+}
+
+/**
+ * Conservative update: only the counters below the new estimate are raised.
+ * Returns the new estimate.
+ */
+template <typename CounterT>
+uint64_t cms_add(CounterT* counters,
+                 size_t width,
+                 size_t depth,
+                 const uint64_t hash[2],
+                 uint64_t count) noexcept {
+  size_t indexes[cms_max_depth];
+  uint64_t minimum = std::numeric_limits<uint64_t>::max();
+  for (size_t row = 0; row < depth; ++row) {
+    indexes[row] = cms_index(hash, row, width);
+    minimum = std::min(minimum, cms_load(counters[indexes[row]]));
+  }
+  const uint64_t estimate = minimum + count;
+  for (size_t row = 0; row < depth; ++row) {
+    if (cms_load(counters[indexes[row]]) < estimate)
+      cms_store(counters[indexes[row]], estimate);
+  }
+  return estimate;
+}
+
+template <typename CounterT>
+uint64_t cms_estimate(const CounterT* counters,
+                      size_t width,
+                      size_t depth,
+                      const uint64_t hash[2]) noexcept {
+  uint64_t minimum = std::numeric_limits<uint64_t>::max();
+  for (size_t row = 0; row < depth; ++row) {
+    minimum =
+        std::min(minimum, cms_load(counters[cms_index(hash, row, width)]));
+  }
+  return minimum;
+}
+
+inline void cms_check_dimensions(size_t width, size_t depth) {
+  if (width == 0 || depth == 0 || depth > cms_max_depth ||
+      static_cast<uint64_t>(width) > (uint64_t(1) << 32)) {
+    JASL_THROW(std::invalid_argument(
+        "count_min_sketch: width is not in [1, 2^32] or depth in [1, 32]"));
+  }
+}
+
+}  // namespace inner
+
+template <typename CharT, typename Traits>
+class basic_concurrent_count_min_sketch;
+
+/**
+ * Count-min sketch: approximate counts of string keys in depth * width
+ * counters. The estimate of a key is never less than its count; with the
+ * width e / epsilon and the depth ln(1 / delta) it is more by at most epsilon
+ * * total() with a probability of 1 - delta.
+ *
+ * The counters are updated conservatively: an add raises only the counters
+ * which are below the new estimate of the key, which makes the
+ * overestimation much smaller on skewed streams. The counters of the rows are
+ * derived from a single MurmurHash3_x64_128 call.
+ *
+ * Sketches of the same dimensions can be merged, the estimates of the sum
+ * still don't underestimate.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_count_min_sketch {
+  friend class basic_concurrent_count_min_sketch<CharT, Traits>;
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+ private:
+  size_t _width;
+  size_t _depth;
+  uint64_t _total;
+  std::vector<uint64_t> _counters;
+
+ public:
+  /**
+   * Throws std::invalid_argument if width isn't in [1, 2^32] or depth in
+   * [1, 32].
+   */
+  explicit basic_count_min_sketch(size_t width, size_t depth = 4)
+      : _width(width), _depth(depth), _total(0) {
+    inner::cms_check_dimensions(width, depth);
+    _counters.assign(width * depth, 0);
+  }
+
+  /**
+   * The sketch of the error bounds: the estimates are more than the counts by
+   * at most epsilon * total() with a probability of 1 - delta.
+   */
+  static basic_count_min_sketch from_error(double epsilon, double delta) {
+    if (!(epsilon > 0 && epsilon < 1 && delta > 0 && delta < 1)) {
+      JASL_THROW(std::invalid_argument(
+          "count_min_sketch: epsilon or delta is not in (0, 1)"));
+    }
+    return basic_count_min_sketch(
+        static_cast<size_t>(std::ceil(2.718281828459045 / epsilon)),
+        static_cast<size_t>(std::ceil(std::log(1 / delta))));
+  }
+
+  size_t width() const noexcept { return _width; }
+  size_t depth() const noexcept { return _depth; }
+
+  /**
+   * The sum of the added counts.
+   */
+  uint64_t total() const noexcept { return _total; }
+
+  /**
+   * Bytes allocated by the sketch.
+   */
+  size_t memory_usage() const noexcept {
+    return _counters.capacity() * sizeof(uint64_t);
+  }
+
+  void clear() noexcept {
+    std::fill(_counters.begin(), _counters.end(), 0);
+    _total = 0;
+  }
+
+  /**
+   * Adds count to the key. Returns the new estimate of the key.
+   */
+  uint64_t add(string_view_type key, uint64_t count = 1) noexcept {
+    uint64_t hash[2];
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    _total += count;
+    return inner::cms_add(_counters.data(), _width, _depth, hash, count);
+  }
+
+  uint64_t estimate(string_view_type key) const noexcept {
+    uint64_t hash[2];
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    return inner::cms_estimate(_counters.data(), _width, _depth, hash);
+  }
+
+  /**
+   * Adds the counters of other. Throws std::invalid_argument if the
+   * dimensions are different.
+   */
+  void merge(const basic_count_min_sketch& other) {
+    if (other._width != _width || other._depth != _depth) {
+      JASL_THROW(std::invalid_argument(
+          "count_min_sketch: the dimensions are different"));
+    }
+    for (size_t i = 0; i < _counters.size(); ++i)
+      _counters[i] += other._counters[i];
+    _total += other._total;
+  }
+};
+
+/**
+ * Count-min sketch written by many threads: every thread adds to its own
+ * shard (without any synchronization), and merge() sums the shards into a
+ * snapshot which answers the queries. merge() can be called periodically
+ * while the threads add; the snapshot reflects the adds which happened
+ * before the merge.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_concurrent_count_min_sketch {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef basic_count_min_sketch<CharT, Traits> sketch_type;
+
+ private:
+  // The shards are whole cache lines, so the threads don't write the same
+  // line: the counters of a shard are followed by its total.
+  static constexpr size_t line_words = 64 / sizeof(uint64_t);
+
+  size_t _width;
+  size_t _depth;
+  size_t _thread_count;
+  size_t _shard_words;
+  std::unique_ptr<std::atomic<uint64_t>[]> _storage;
+  std::atomic<uint64_t>* _shards;  // 64 byte aligned in _storage
+  mutable std::mutex _mutex;  // guards _snapshot
+  sketch_type _snapshot;
+
+ public:
+  /**
+   * Throws std::invalid_argument if thread_count is 0 or the dimensions are
+   * invalid (see basic_count_min_sketch).
+   */
+  basic_concurrent_count_min_sketch(size_t thread_count,
+                                    size_t width,
+                                    size_t depth = 4)
+      : _width(width),
+        _depth(depth),
+        _thread_count(thread_count),
+        _shard_words((width * depth + line_words) / line_words * line_words),
+        _shards(nullptr),
+        _snapshot(width, depth) {
+    if (thread_count == 0) {
+      JASL_THROW(std::invalid_argument(
+          "concurrent_count_min_sketch: thread_count is 0"));
+    }
+    const size_t words = thread_count * _shard_words;
+    _storage.reset(new std::atomic<uint64_t>[words + line_words - 1]);
+    const uintptr_t address = reinterpret_cast<uintptr_t>(_storage.get());
+    _shards = _storage.get() + (64 - address % 64) % 64 / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i)
+      _shards[i].store(0, std::memory_order_relaxed);
+  }
+
+  size_t thread_count() const noexcept { return _thread_count; }
+  size_t width() const noexcept { return _width; }
+  size_t depth() const noexcept { return _depth; }
+
+  /**
+   * Adds count to the key in the shard of thread, which is in [0,
+   * thread_count()). A shard must be written by one thread at a time.
+   * Returns the estimate of the key in the shard.
+   */
+  uint64_t add(size_t thread,
+               string_view_type key,
+               uint64_t count = 1) noexcept {
+    JASL_ASSERT(thread < _thread_count, "thread < thread_count()");
+    uint64_t hash[2];
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    std::atomic<uint64_t>* const counters = shard(thread);
+    std::atomic<uint64_t>& total = counters[_width * _depth];
+    total.store(total.load(std::memory_order_relaxed) + count,
+                std::memory_order_relaxed);
+    return inner::cms_add(counters, _width, _depth, hash, count);
+  }
+
+  /**
+   * Sums the shards into the snapshot.
+   */
+  void merge() {
+    std::vector<uint64_t> counters(_width * _depth, 0);
+    uint64_t total = 0;
+    for (size_t t = 0; t < _thread_count; ++t) {
+      const std::atomic<uint64_t>* const shard_counters = shard(t);
+      for (size_t i = 0; i < counters.size(); ++i)
+        counters[i] += shard_counters[i].load(std::memory_order_relaxed);
+      total += shard_counters[counters.size()].load(std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _snapshot._counters.swap(counters);
+    _snapshot._total = total;
+  }
+
+  /**
+   * The estimate of the key in the last snapshot.
+   */
+  uint64_t estimate(string_view_type key) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _snapshot.estimate(key);
+  }
+
+  /**
+   * A copy of the last snapshot.
+   */
+  sketch_type snapshot() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _snapshot;
+  }
+
+ private:
+  std::atomic<uint64_t>* shard(size_t thread) const noexcept {
+    return _shards + thread * _shard_words;
+  }
+};
+
+/**
+ * Space-saving top-k tracker (Metwally et al.): it keeps capacity keys with
+ * counters. A key which isn't tracked replaces the one with the smallest
+ * count, and inherits its count as its error. Every key with a count more
+ * than total / capacity is tracked; the count of a tracked key is more than
+ * its real count by at most its error.
+ *
+ * The counters are in a min-heap, so an add is O(log capacity), and it
+ * allocates only when a new key is longer than the evicted one.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_space_saving {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef std::basic_string<CharT, Traits> key_type;
+
+  struct entry {
+    key_type key;
+    uint64_t count;  // at least the real count
+    uint64_t error;  // count - error is at most the real count
+  };
+
+ private:
+  struct slot {
+    key_type key;
+    uint64_t count;
+    uint64_t error;
+    size_t heap_index;
+  };
+
+  struct view_hash {
+    size_t operator()(string_view_type key) const noexcept {
+      uint64_t hash[2];
+      inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+      return static_cast<size_t>(hash[0]);
+    }
+  };
+
+  size_t _capacity;
+  // never reallocated: the index refers to the keys of the slots
+  std::vector<slot> _slots;
+  // the slots in a min-heap by count
+  std::vector<size_t> _heap;
+  std::unordered_map<string_view_type, size_t, view_hash> _index;
+
+ public:
+  /**
+   * Throws std::invalid_argument if capacity is 0.
+   */
+  explicit basic_space_saving(size_t capacity) : _capacity(capacity) {
+    if (capacity == 0)
+      JASL_THROW(std::invalid_argument("space_saving: capacity is 0"));
+    _slots.reserve(capacity);
+    _heap.reserve(capacity);
+    _index.reserve(capacity);
+  }
+
+  basic_space_saving(const basic_space_saving& other)
+      : basic_space_saving(other._capacity) {
+    rebuild(other.entries());
+  }
+
+  basic_space_saving& operator=(const basic_space_saving& other) {
+    if (this != &other) {
+      _capacity = other._capacity;
+      rebuild(other.entries());
+    }
+    return *this;
+  }
+
+  basic_space_saving(basic_space_saving&&) = default;
+  basic_space_saving& operator=(basic_space_saving&&) = default;
+
+  size_t capacity() const noexcept { return _capacity; }
+
+  /**
+   * Number of the tracked keys.
+   */
+  size_t size() const noexcept { return _slots.size(); }
+
+  void add(string_view_type key, uint64_t count = 1) {
+    const auto it = _index.find(key);
+    if (it != _index.end()) {
+      slot& s = _slots[it->second];
+      s.count += count;
+      sift_down(s.heap_index);
+      return;
+    }
+    if (_slots.size() < _capacity) {
+      const size_t index = _slots.size();
+      _slots.push_back(slot{key_type(key.data(), key.size()), count, 0,
+                            _heap.size()});
+      _heap.push_back(index);
+      _index.emplace(view(_slots[index].key), index);
+      sift_up(_heap.size() - 1);
+      return;
+    }
+    const size_t index = _heap[0];
+    slot& s = _slots[index];
+    _index.erase(view(s.key));
+    s.key.assign(key.data(), key.size());
+    s.error = s.count;
+    s.count += count;
+    _index.emplace(view(s.key), index);
+    sift_down(0);
+  }
+
+  /**
+   * The count of a tracked key, or the upper bound of the count of the other
+   * keys.
+   */
+  uint64_t estimate(string_view_type key) const {
+    const auto it = _index.find(key);
+    return it != _index.end() ? _slots[it->second].count : min_count();
+  }
+
+  /**
+   * The k tracked keys of the highest counts, in decreasing order.
+   */
+  std::vector<entry> top(size_t k) const {
+    std::vector<entry> result = entries();
+    result.resize(std::min(k, result.size()));
+    return result;
+  }
+
+  /**
+   * Merges other into this tracker (the capacity of this is kept). A key
+   * which isn't tracked by one of them gets the smallest count of that one
+   * as count and error, so the counts are still upper bounds.
+   */
+  void merge(const basic_space_saving& other) {
+    const uint64_t this_min = min_count();
+    const uint64_t other_min = other.min_count();
+    std::vector<entry> merged;
+    merged.reserve(_slots.size() + other._slots.size());
+    for (const slot& s : _slots) {
+      const auto it = other._index.find(view(s.key));
+      if (it != other._index.end()) {
+        const slot& o = other._slots[it->second];
+        merged.push_back(entry{s.key, s.count + o.count, s.error + o.error});
+      } else {
+        merged.push_back(
+            entry{s.key, s.count + other_min, s.error + other_min});
+      }
+    }
+    for (const slot& o : other._slots) {
+      if (_index.find(view(o.key)) == _index.end())
+        merged.push_back(entry{o.key, o.count + this_min, o.error + this_min});
+    }
+    sort(merged);
+    if (merged.size() > _capacity)
+      merged.resize(_capacity);
+    rebuild(merged);
+  }
+
+ private:
+  static string_view_type view(const key_type& key) noexcept {
+    return string_view_type(key.data(), key.size());
+  }
+
+  static void sort(std::vector<entry>& entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const entry& a, const entry& b) {
+                return a.count != b.count ? a.count > b.count : a.key < b.key;
+              });
+  }
+
+  uint64_t min_count() const noexcept {
+    return _slots.size() == _capacity ? _slots[_heap[0]].count : 0;
+  }
+
+  std::vector<entry> entries() const {
+    std::vector<entry> result;
+    result.reserve(_slots.size());
+    for (const slot& s : _slots)
+      result.push_back(entry{s.key, s.count, s.error});
+    sort(result);
+    return result;
+  }
+
+  void rebuild(const std::vector<entry>& entries) {
+    _index.clear();
+    _heap.clear();
+    _slots.clear();
+    _slots.reserve(_capacity);
+    // sorted in decreasing order, so the reverse is a min-heap
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const entry& e = entries[entries.size() - 1 - i];
+      _slots.push_back(slot{e.key, e.count, e.error, i});
+      _heap.push_back(i);
+    }
+    for (size_t i = 0; i < _slots.size(); ++i)
+      _index.emplace(view(_slots[i].key), i);
+  }
+
+  void swap_heap(size_t a, size_t b) noexcept {
+    std::swap(_heap[a], _heap[b]);
+    _slots[_heap[a]].heap_index = a;
+    _slots[_heap[b]].heap_index = b;
+  }
+
+  uint64_t heap_count(size_t i) const noexcept {
+    return _slots[_heap[i]].count;
+  }
+
+  void sift_up(size_t i) noexcept {
+    while (i > 0 && heap_count(i) < heap_count((i - 1) / 2)) {
+      swap_heap(i, (i - 1) / 2);
+      i = (i - 1) / 2;
+    }
+  }
+
+  void sift_down(size_t i) noexcept {
+    for (;;) {
+      const size_t left = 2 * i + 1;
+      if (left >= _heap.size())
+        return;
+      size_t child = left;
+      if (left + 1 < _heap.size() && heap_count(left + 1) < heap_count(left))
+        child = left + 1;
+      if (heap_count(i) <= heap_count(child))
+        return;
+      swap_heap(i, child);
+      i = child;
+    }
+  }
+};
+
+typedef basic_count_min_sketch<char> count_min_sketch;
+typedef basic_concurrent_count_min_sketch<char> concurrent_count_min_sketch;
+typedef basic_space_saving<char> space_saving;
+
+}  // namespace jasl
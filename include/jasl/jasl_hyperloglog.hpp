@@ -0,0 +1,491 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_hash.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_internal/jasl_varint.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+constexpr unsigned hll_min_precision = 4;
+constexpr unsigned hll_max_precision = 18;
+// The sparse entries keep 25 bits of the index: index << 6 | rank.
+constexpr unsigned hll_sparse_precision = 25;
+constexpr unsigned char hll_format_version = 1;
+
+inline uint32_t hll_sparse_entry(uint64_t hash) noexcept {
+  const uint32_t index =
+      static_cast<uint32_t>(hash >> (64 - hll_sparse_precision));
+  const uint64_t w = hash << hll_sparse_precision;
+  const unsigned rank = w == 0 ? 64 - hll_sparse_precision + 1
+                               : count_leading_zeros64(w) + 1;
+  return index << 6 | rank;
+}
+
+/**
+ * dst[i] = max(dst[i], src[i])
+ */
+inline void hll_merge_registers(uint8_t* dst,
+                                const uint8_t* src,
+                                size_t size) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  for (; i + 16 <= size; i += 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(a, b));
+  }
+#endif
+  for (; i < size; ++i)
+    dst[i] = std::max(dst[i], src[i]);
+}
+
+struct hll_sums {
+  double inverse_sum;  // the sum of 2^-register
+  size_t zeros;
+  size_t saturated;  // the registers of the highest possible rank
+};
+
+#if JASL_INNER_SSE2
+// 2^-r of 4 ranks: the floats with exponent r below the bias, no mantissa
+inline __m128 hll_inverse_powers(__m128i ranks) noexcept {
+  return _mm_castsi128_ps(
+      _mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(127), ranks), 23));
+}
+#endif
+
+inline hll_sums hll_register_sums(const uint8_t* registers,
+                                  size_t size,
+                                  unsigned saturated_rank) noexcept {
+  hll_sums sums = {0, 0, 0};
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i saturated =
+      _mm_set1_epi8(static_cast<char>(saturated_rank));
+  const size_t vector_end = size - size % 16;
+  while (i < vector_end) {
+    // float sums of up to 1024 registers, then they are added as doubles
+    __m128 sum = _mm_setzero_ps();
+    for (const size_t end = std::min(vector_end, i + 1024); i < end; i += 16) {
+      const __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(registers + i));
+      sums.zeros += popcount32(
+          static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))));
+      sums.saturated += popcount32(static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(v, saturated))));
+      const __m128i low = _mm_unpacklo_epi8(v, zero);
+      const __m128i high = _mm_unpackhi_epi8(v, zero);
+      sum = _mm_add_ps(
+          sum, _mm_add_ps(hll_inverse_powers(_mm_unpacklo_epi16(low, zero)),
+                          hll_inverse_powers(_mm_unpackhi_epi16(low, zero))));
+      sum = _mm_add_ps(
+          sum, _mm_add_ps(hll_inverse_powers(_mm_unpacklo_epi16(high, zero)),
+                          hll_inverse_powers(_mm_unpackhi_epi16(high, zero))));
+    }
+    float parts[4];
+    _mm_storeu_ps(parts, sum);
+    sums.inverse_sum += static_cast<double>(parts[0]) + parts[1] + parts[2] +
+                        parts[3];
+  }
+#endif
+  for (; i < size; ++i) {
+    const unsigned r = registers[i];
+    sums.inverse_sum += std::ldexp(1.0, -static_cast<int>(r));
+    sums.zeros += r == 0;
+    sums.saturated += r == saturated_rank;
+  }
+  return sums;
+}
+
+// The correction functions of the improved raw estimator of Otmar Ertl: New
+// cardinality estimation algorithms for HyperLogLog sketches (2017).
+
+inline double hll_sigma(double x) noexcept {
+  if (x == 1)
+    return std::numeric_limits<double>::infinity();
+  double y = 1;
+  double z = x;
+  for (double previous = -1; z != previous; y += y) {
+    x *= x;
+    previous = z;
+    z += x * y;
+  }
+  return z;
+}
+
+inline double hll_tau(double x) noexcept {
+  if (x == 0 || x == 1)
+    return 0;
+  double y = 1;
+  double z = 1 - x;
+  for (double previous = -1; z != previous;) {
+    x = std::sqrt(x);
+    previous = z;
+    y *= 0.5;
+    z -= (1 - x) * (1 - x) * y;
+  }
+  return z / 3;
+}
+
+/**
+ * The bias correction constant of m registers. The estimator of Ertl uses the
+ * asymptotic 1 / (2 ln 2), which overestimates by 8% with 16 registers and by
+ * 2-4% with 32 or 64: these get the exact constants of Flajolet et al.
+ */
+inline double hll_alpha(double m) noexcept {
+  if (m == 16)
+    return 0.673;
+  if (m == 32)
+    return 0.697;
+  if (m == 64)
+    return 0.709;
+  return 0.5 / 0.6931471805599453;
+}
+
+/**
+ * The cardinality estimated from the registers of precision p. It needs no
+ * empirical bias correction in any range.
+ */
+inline double hll_estimate(const hll_sums& sums, unsigned p) noexcept {
+  const unsigned q = 64 - p;
+  const double m = std::ldexp(1.0, static_cast<int>(p));
+  const double zeros = static_cast<double>(sums.zeros);
+  const double saturated = static_cast<double>(sums.saturated);
+  // the registers of rank 1 to q
+  const double middle =
+      std::max(sums.inverse_sum - zeros -
+                   saturated * std::ldexp(1.0, -static_cast<int>(q + 1)),
+               0.0);
+  const double z = m * hll_tau(1 - saturated / m) *
+                       std::ldexp(1.0, -static_cast<int>(q)) +
+                   middle + m * hll_sigma(zeros / m);
+  return hll_alpha(m) * m * m / z;
+}
+
+}  // namespace inner
+
+/**
+ * HyperLogLog++ sketch: estimates the number of distinct strings in a stream
+ * in 2^precision bytes, with a relative standard error of about
+ * 1.04 / sqrt(2^precision) (0.8% for the default 14).
+ *
+ * The strings are hashed with MurmurHash3. Up to a few thousand distinct
+ * values the sketch is sparse: it keeps the hashes at a higher precision (25
+ * bits of index), which is much more accurate for the small cardinalities;
+ * it turns dense when the sparse entries would take more space than the
+ * registers. The estimate of the dense registers is the improved estimator
+ * of Ertl, which is unbiased in every range without the empirical tables of
+ * HyperLogLog++ (with the exact bias constants of the precisions 4 to 6).
+ *
+ * Sketches of the same precision can be merged, for example the sketches of
+ * different threads, and they can be serialized to be merged in an other
+ * process.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_hyperloglog {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+ private:
+  unsigned _precision;
+  // sorted, at most one entry per index
+  std::vector<uint32_t> _sparse;
+  // the entries which are not in _sparse yet
+  std::vector<uint32_t> _buffer;
+  // empty while the sketch is sparse
+  std::vector<uint8_t> _registers;
+
+ public:
+  /**
+   * Throws std::invalid_argument if precision isn't in [4, 18].
+   */
+  explicit basic_hyperloglog(unsigned precision = 14) : _precision(precision) {
+    if (precision < inner::hll_min_precision ||
+        precision > inner::hll_max_precision) {
+      JASL_THROW(
+          std::invalid_argument("hyperloglog: precision is not in [4, 18]"));
+    }
+  }
+
+  unsigned precision() const noexcept { return _precision; }
+
+  bool is_sparse() const noexcept { return _registers.empty(); }
+
+  /**
+   * Bytes allocated by the sketch.
+   */
+  size_t memory_usage() const noexcept {
+    return (_sparse.capacity() + _buffer.capacity()) * sizeof(uint32_t) +
+           _registers.capacity();
+  }
+
+  void clear() noexcept {
+    std::vector<uint32_t>().swap(_sparse);
+    std::vector<uint32_t>().swap(_buffer);
+    std::vector<uint8_t>().swap(_registers);
+  }
+
+  void insert(string_view_type key) {
+    uint64_t hash[2];
+    inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+    insert_hash(hash[0]);
+  }
+
+  /**
+   * Inserts the keys of the range. The elements can be jasl::string_view-s,
+   * jasl::string-s, [std::string]-s or anything else with data() and size().
+   */
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    uint64_t hash[2];
+    for (; first != last; ++first) {
+      const auto& key = *first;
+      inner::hash128(key.data(), key.size() * sizeof(CharT), hash);
+      insert_hash(hash[0]);
+    }
+  }
+
+  /**
+   * Inserts a value hashed by the caller; the 64 bits have to be uniformly
+   * distributed.
+   */
+  void insert_hash(uint64_t hash) {
+    if (is_sparse()) {
+      _buffer.push_back(inner::hll_sparse_entry(hash));
+      if (_buffer.size() >= buffer_limit())
+        flush();
+      return;
+    }
+    const uint64_t w = hash << _precision;
+    const unsigned rank = w == 0 ? 64 - _precision + 1
+                                 : inner::count_leading_zeros64(w) + 1;
+    uint8_t& r = _registers[static_cast<size_t>(hash >> (64 - _precision))];
+    r = std::max(r, static_cast<uint8_t>(rank));
+  }
+
+  /**
+   * The estimated number of the distinct inserted values.
+   */
+  double estimate() const {
+    if (is_sparse()) {
+      // linear counting on the 2^25 sparse registers
+      const double m = std::ldexp(1.0, inner::hll_sparse_precision);
+      const double count = static_cast<double>(sparse_entries().size());
+      return m * std::log(m / (m - count));
+    }
+    return inner::hll_estimate(
+        inner::hll_register_sums(_registers.data(), _registers.size(),
+                                 64 - _precision + 1),
+        _precision);
+  }
+
+  /**
+   * Merges other into this sketch: it estimates the union of the two
+   * streams. Throws std::invalid_argument if the precisions differ.
+   */
+  void merge(const basic_hyperloglog& other) {
+    if (other._precision != _precision) {
+      JASL_THROW(
+          std::invalid_argument("hyperloglog: the precisions are different"));
+    }
+    if (!other.is_sparse()) {
+      if (is_sparse())
+        to_dense();
+      inner::hll_merge_registers(_registers.data(), other._registers.data(),
+                                 _registers.size());
+      return;
+    }
+    const std::vector<uint32_t> entries = other.sparse_entries();
+    if (!is_sparse()) {
+      for (uint32_t entry : entries)
+        apply(entry);
+      return;
+    }
+    _buffer.insert(_buffer.end(), entries.begin(), entries.end());
+    flush();
+  }
+
+  /**
+   * Portable binary form of the sketch for deserialize().
+   */
+  std::vector<unsigned char> serialize() const {
+    std::vector<unsigned char> out;
+    out.reserve(5 + _registers.size());
+    out.push_back('J');
+    out.push_back('H');
+    out.push_back(inner::hll_format_version);
+    out.push_back(static_cast<unsigned char>(_precision));
+    out.push_back(static_cast<unsigned char>(!is_sparse()));
+    if (is_sparse()) {
+      const std::vector<uint32_t> entries = sparse_entries();
+      inner::write_varint(out, entries.size());
+      uint32_t previous = 0;
+      for (uint32_t entry : entries) {
+        inner::write_varint(out, entry - previous);
+        previous = entry;
+      }
+    } else {
+      out.insert(out.end(), _registers.begin(), _registers.end());
+    }
+    return out;
+  }
+
+  /**
+   * Throws std::invalid_argument if data isn't a serialized sketch.
+   */
+  static basic_hyperloglog deserialize(const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+    if (size < 5 || p[0] != 'J' || p[1] != 'H' ||
+        p[2] != inner::hll_format_version || p[3] < inner::hll_min_precision ||
+        p[3] > inner::hll_max_precision || p[4] > 1)
+      invalid_format();
+    basic_hyperloglog result(p[3]);
+    const unsigned saturated_rank = 64 - result._precision + 1;
+    const bool dense = p[4] == 1;
+    p += 5;
+    if (dense) {
+      const size_t m = size_t(1) << result._precision;
+      if (static_cast<size_t>(end - p) != m)
+        invalid_format();
+      for (size_t i = 0; i < m; ++i) {
+        if (p[i] > saturated_rank)
+          invalid_format();
+      }
+      result._registers.assign(p, end);
+      return result;
+    }
+    size_t count;
+    if (!inner::read_varint(p, end, count) ||
+        count > static_cast<size_t>(end - p))
+      invalid_format();
+    result._sparse.reserve(count);
+    const uint64_t limit = uint64_t(1) << (inner::hll_sparse_precision + 6);
+    uint64_t entry = 0;
+    for (size_t i = 0; i < count; ++i) {
+      size_t delta;
+      // checked before the addition so that the sum can't wrap around
+      if (!inner::read_varint(p, end, delta) || delta >= limit - entry)
+        invalid_format();
+      entry += delta;
+      const unsigned rank = static_cast<unsigned>(entry & 63);
+      // the indexes are strictly increasing
+      if (rank == 0 || rank > 64 - inner::hll_sparse_precision + 1 ||
+          (i > 0 && (entry >> 6) <= (result._sparse.back() >> 6)))
+        invalid_format();
+      result._sparse.push_back(static_cast<uint32_t>(entry));
+    }
+    // a sparse sketch holds at most dense_limit() flushed entries and a
+    // buffer which isn't full, serialize() writes both
+    if (p != end || result._sparse.size() >=
+                        result.dense_limit() + result.buffer_limit())
+      invalid_format();
+    if (result._sparse.size() > result.dense_limit()) {
+      result._buffer.assign(result._sparse.begin() + result.dense_limit(),
+                            result._sparse.end());
+      result._sparse.resize(result.dense_limit());
+    }
+    return result;
+  }
+
+  static basic_hyperloglog deserialize(
+      const std::vector<unsigned char>& data) {
+    return deserialize(data.data(), data.size());
+  }
+
+ private:
+  [[noreturn]] static void invalid_format() {
+    JASL_THROW(std::invalid_argument("hyperloglog: invalid serialized form"));
+  }
+
+  size_t buffer_limit() const noexcept {
+    return (size_t(1) << _precision) / 16;
+  }
+
+  // where the sparse entries take as much memory as the registers
+  size_t dense_limit() const noexcept {
+    return (size_t(1) << _precision) / sizeof(uint32_t);
+  }
+
+  /**
+   * The sorted union of _sparse and _buffer, one entry (of the highest
+   * rank) per index.
+   */
+  std::vector<uint32_t> sparse_entries() const {
+    std::vector<uint32_t> buffer(_buffer);
+    std::sort(buffer.begin(), buffer.end());
+    std::vector<uint32_t> entries;
+    entries.reserve(_sparse.size() + buffer.size());
+    std::merge(_sparse.begin(), _sparse.end(), buffer.begin(), buffer.end(),
+               std::back_inserter(entries));
+    // the highest rank is the last of an index
+    size_t size = 0;
+    for (uint32_t entry : entries) {
+      if (size > 0 && (entries[size - 1] >> 6) == (entry >> 6))
+        entries[size - 1] = entry;
+      else
+        entries[size++] = entry;
+    }
+    entries.resize(size);
+    return entries;
+  }
+
+  void flush() {
+    _sparse = sparse_entries();
+    _buffer.clear();
+    if (_sparse.size() > dense_limit())
+      to_dense();
+  }
+
+  void to_dense() {
+    const std::vector<uint32_t> entries = sparse_entries();
+    _registers.assign(size_t(1) << _precision, 0);
+    for (uint32_t entry : entries)
+      apply(entry);
+    std::vector<uint32_t>().swap(_sparse);
+    std::vector<uint32_t>().swap(_buffer);
+  }
+
+  /**
+   * Applies a sparse entry to the registers.
+   */
+  void apply(uint32_t entry) noexcept {
+    const unsigned shift = inner::hll_sparse_precision - _precision;
+    const uint32_t sparse_index = entry >> 6;
+    // the bits between the dense and the sparse index come first in the rank
+    const uint64_t between = sparse_index & ((uint32_t(1) << shift) - 1);
+    const unsigned rank =
+        between != 0
+            ? shift - (64 - inner::count_leading_zeros64(between)) + 1
+            : shift + (entry & 63);
+    uint8_t& r = _registers[sparse_index >> shift];
+    r = std::max(r, static_cast<uint8_t>(rank));
+  }
+};
+
+typedef basic_hyperloglog<char> hyperloglog;
+
+}  // namespace jasl
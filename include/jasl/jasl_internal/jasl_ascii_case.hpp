@@ -0,0 +1,152 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * ASCII case mapping and case folding kernels for byte strings. The case of
+ * the ASCII letters differs in the 0x20 bit only, so a block is mapped by
+ * computing the mask of the letters of one case and flipping that bit. The
+ * bytes >= 0x80 (e.g. UTF-8 sequences) are never changed.
+ */
+
+constexpr unsigned char ascii_fold(unsigned char c) noexcept {
+  return static_cast<unsigned>(c - 'A') < 26
+             ? static_cast<unsigned char>(c | 0x20)
+             : c;
+}
+
+/**
+ * Flips the 0x20 bit of the bytes in [first, last] of 8 bytes, the other
+ * bytes (and the ones >= 0x80) are not changed. The bytes are compared
+ * without carries between them: the low 7 bits are shifted so that the high
+ * bit tells whether the byte reached the bound.
+ */
+inline uint64_t map_ascii_range8(uint64_t x,
+                                 unsigned char first,
+                                 unsigned char last) noexcept {
+  const uint64_t ones = 0x0101010101010101ull;
+  const uint64_t high = 0x8080808080808080ull;
+  const uint64_t low7 = x & ~high;
+  const uint64_t ge_first = low7 + ones * (0x80u - first);
+  const uint64_t gt_last = low7 + ones * (0x7Fu - last);
+  const uint64_t in_range = ge_first & ~gt_last & ~x & high;
+  return x ^ (in_range >> 2);
+}
+
+inline uint64_t ascii_fold8(uint64_t x) noexcept {
+  return map_ascii_range8(x, 'A', 'Z');
+}
+
+#if JASL_INNER_SSE2
+/**
+ * Flips the 0x20 bit of the bytes in [first, last] of 16 bytes. The compare
+ * is signed: the bytes >= 0x80 are negative, so out of the range.
+ */
+inline __m128i map_ascii_range16(__m128i x,
+                                 unsigned char first,
+                                 unsigned char last) noexcept {
+  const __m128i below = _mm_set1_epi8(static_cast<char>(first - 1));
+  const __m128i above = _mm_set1_epi8(static_cast<char>(last + 1));
+  const __m128i in_range =
+      _mm_and_si128(_mm_cmpgt_epi8(x, below), _mm_cmplt_epi8(x, above));
+  return _mm_xor_si128(x, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+}
+#endif
+
+/**
+ * Flips the 0x20 bit of the bytes in [first, last]. first and last have to
+ * be ASCII letters of the same case.
+ */
+inline void map_ascii_range(const unsigned char* in,
+                            size_t size,
+                            unsigned char* out,
+                            unsigned char first,
+                            unsigned char last) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  if (size >= 16) {
+    for (;; i += 16) {
+      // the last block overlaps with the previous one
+      if (i + 16 > size)
+        i = size - 16;
+      const __m128i x =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                       map_ascii_range16(x, first, last));
+      if (i + 16 == size)
+        return;
+    }
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    uint64_t x;
+    std::memcpy(&x, in + i, 8);
+    x = map_ascii_range8(x, first, last);
+    std::memcpy(out + i, &x, 8);
+  }
+  for (; i < size; ++i) {
+    const unsigned char c = in[i];
+    out[i] = c >= first && c <= last ? static_cast<unsigned char>(c ^ 0x20)
+                                     : c;
+  }
+}
+
+/**
+ * memcmp of the case folded bytes (-1, 0 or 1): the letters are compared as
+ * lower case. 16 bytes are folded and compared at once with SSE2, 8 bytes
+ * otherwise; only the first differing block is examined byte by byte.
+ */
+inline int ascii_case_insensitive_compare(const unsigned char* a,
+                                          const unsigned char* b,
+                                          size_t size) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  if (size >= 16) {
+    for (;; i += 16) {
+      // the last block overlaps with the already compared, equal bytes
+      if (i + 16 > size)
+        i = size - 16;
+      const __m128i x = map_ascii_range16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), 'A', 'Z');
+      const __m128i y = map_ascii_range16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), 'A', 'Z');
+      const uint32_t mask =
+          static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+      if (mask != 0xFFFF) {
+        const size_t j = i + count_trailing_zeros(~mask & 0xFFFFu);
+        return ascii_fold(a[j]) < ascii_fold(b[j]) ? -1 : 1;
+      }
+      if (i + 16 == size)
+        return 0;
+    }
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    if (ascii_fold8(load_u64(a + i)) != ascii_fold8(load_u64(b + i)))
+      break;
+  }
+  for (; i < size; ++i) {
+    const unsigned char x = ascii_fold(a[i]);
+    const unsigned char y = ascii_fold(b[i]);
+    if (x != y)
+      return x < y ? -1 : 1;
+  }
+  return 0;
+}
+
+}  // namespace inner
+}  // namespace jasl
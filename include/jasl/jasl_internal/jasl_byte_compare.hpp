@@ -0,0 +1,192 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * Bitmask of the equal bytes of two 16 byte blocks: bit i is set if a[i] ==
+ * b[i].
+ */
+inline uint32_t bytes_equal_mask16(const unsigned char* a,
+                                   const unsigned char* b) noexcept {
+#if JASL_INNER_SSE2
+  const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+#else
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < 16; ++i)
+    mask |= static_cast<uint32_t>(a[i] == b[i]) << i;
+  return mask;
+#endif
+}
+
+/**
+ * Equality of two 16 byte blocks.
+ */
+inline bool bytes_equal16(const unsigned char* a,
+                          const unsigned char* b) noexcept {
+#if JASL_INNER_SSE2
+  return bytes_equal_mask16(a, b) == 0xFFFF;
+#else
+  return ((load_u64(a) ^ load_u64(b)) | (load_u64(a + 8) ^ load_u64(b + 8))) ==
+         0;
+#endif
+}
+
+/**
+ * Equality of two 32 byte blocks.
+ */
+inline bool bytes_equal32(const unsigned char* a,
+                          const unsigned char* b) noexcept {
+#if JASL_INNER_SSE2
+  const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+  const __m128i y0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+  const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16));
+  const __m128i y1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16));
+  return _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(x0, y0),
+                                         _mm_cmpeq_epi8(x1, y1))) == 0xFFFF;
+#else
+  return ((load_u64(a) ^ load_u64(b)) | (load_u64(a + 8) ^ load_u64(b + 8)) |
+          (load_u64(a + 16) ^ load_u64(b + 16)) |
+          (load_u64(a + 24) ^ load_u64(b + 24))) == 0;
+#endif
+}
+
+/**
+ * Same as memcmp(left, right, size) == 0, but the short keys (most of the hash
+ * map probes) don't pay for a function call and a loop: up to 32 bytes the
+ * result comes from two overlapping loads of the first and the last bytes.
+ */
+inline bool bytes_equal(const void* left,
+                        const void* right,
+                        size_t size) noexcept {
+  const unsigned char* a = static_cast<const unsigned char*>(left);
+  const unsigned char* b = static_cast<const unsigned char*>(right);
+  if (size >= 16) {
+    if (size <= 32)
+      return bytes_equal16(a, b) && bytes_equal16(a + size - 16, b + size - 16);
+    for (size_t i = 0; i + 32 < size; i += 32) {
+      if (!bytes_equal32(a + i, b + i))
+        return false;
+    }
+    return bytes_equal32(a + size - 32, b + size - 32);
+  }
+  if (size >= 8) {
+    return ((load_u64(a) ^ load_u64(b)) |
+            (load_u64(a + size - 8) ^ load_u64(b + size - 8))) == 0;
+  }
+  if (size >= 4) {
+    return ((load_u32(a) ^ load_u32(b)) |
+            (load_u32(a + size - 4) ^ load_u32(b + size - 4))) == 0;
+  }
+  if (size >= 2) {
+    return ((load_u16(a) ^ load_u16(b)) | (a[size - 1] ^ b[size - 1])) == 0;
+  }
+  return size == 0 || a[0] == b[0];
+}
+
+inline int compare_words(uint64_t x, uint64_t y) noexcept {
+  return static_cast<int>(x > y) - static_cast<int>(x < y);
+}
+
+/**
+ * The first min(size, 8) bytes of the array as a word whose integer order is
+ * the lexicographic order of the bytes. Strings shorter than 8 bytes are
+ * assembled from overlapping loads: the repeated bytes were already equal if
+ * the comparison reaches them.
+ */
+inline uint64_t load_lexicographic_prefix(const unsigned char* p,
+                                          size_t size) noexcept {
+  if (size >= 8)
+    return to_lexicographic_order(load_u64(p));
+  if (size >= 4) {
+    const uint64_t head = to_lexicographic_order(load_u32(p)) >> 32;
+    const uint64_t tail = to_lexicographic_order(load_u32(p + size - 4)) >> 32;
+    return (head << 32) | tail;
+  }
+  if (size > 0) {
+    return (static_cast<uint64_t>(p[0]) << 16) |
+           (static_cast<uint64_t>(p[size / 2]) << 8) | p[size - 1];
+  }
+  return 0;
+}
+
+/**
+ * Same as memcmp(left, right, size) except that the result is always -1, 0
+ * or 1. Up to 16 bytes the words are compared as integers without a loop,
+ * beyond that the blocks are compared as whole and only the first differing
+ * one is examined further.
+ */
+inline int bytes_compare(const void* left,
+                         const void* right,
+                         size_t size) noexcept {
+  const unsigned char* a = static_cast<const unsigned char*>(left);
+  const unsigned char* b = static_cast<const unsigned char*>(right);
+  if (size <= 16) {
+    if (size <= 8) {
+      return compare_words(load_lexicographic_prefix(a, size),
+                           load_lexicographic_prefix(b, size));
+    }
+    const uint64_t x0 = to_lexicographic_order(load_u64(a));
+    const uint64_t y0 = to_lexicographic_order(load_u64(b));
+    const uint64_t x1 = to_lexicographic_order(load_u64(a + size - 8));
+    const uint64_t y1 = to_lexicographic_order(load_u64(b + size - 8));
+    return x0 != y0 ? compare_words(x0, y0) : compare_words(x1, y1);
+  }
+  size_t i = 0;
+  while (i + 32 <= size && bytes_equal32(a + i, b + i))
+    i += 32;
+  for (;; i += 16) {
+    // The last block overlaps with the already compared, equal bytes.
+    const size_t block = i + 16 < size ? i : size - 16;
+    const uint32_t mask = bytes_equal_mask16(a + block, b + block);
+    if (mask != 0xFFFF) {
+      const size_t j = block + count_trailing_zeros(~mask & 0xFFFFu);
+      return a[j] < b[j] ? -1 : 1;
+    }
+    if (block == size - 16)
+      return 0;
+  }
+}
+
+/**
+ * Traits::compare, but for byte characters the word-at-a-time version is used
+ * (except during constant evaluation).
+ */
+template <typename CharT, typename Traits>
+JASL_CONSTEXPR_CXX14 int compare(const CharT* left,
+                                 const CharT* right,
+                                 size_t size) noexcept {
+  if (is_byte_char<CharT, Traits>::value && !JASL_INNER_IS_CONSTANT_EVALUATED())
+    return bytes_compare(left, right, size);
+  return Traits::compare(left, right, size);
+}
+
+/**
+ * Traits::compare(...) == 0, but for byte characters the word-at-a-time
+ * version is used (except during constant evaluation).
+ */
+template <typename CharT, typename Traits>
+JASL_CONSTEXPR_CXX14 bool equal(const CharT* left,
+                                const CharT* right,
+                                size_t size) noexcept {
+  if (is_byte_char<CharT, Traits>::value && !JASL_INNER_IS_CONSTANT_EVALUATED())
+    return bytes_equal(left, right, size);
+  return Traits::compare(left, right, size) == 0;
+}
+
+}  // namespace inner
+}  // namespace jasl
@@ -0,0 +1,351 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "jasl/jasl_internal/jasl_byte_compare.hpp"
+#include "jasl/jasl_internal/jasl_char_set.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * Vectorized search kernels for byte strings. The find functions return the
+ * index of the first occurrence or size_t(-1) (npos). 16 bytes are examined
+ * at once with SSE2, 8 bytes with the word-at-a-time fallback (and for the
+ * short strings). They never read outside of [ptr, ptr + size): the last
+ * block overlaps with the previous one instead.
+ */
+
+/**
+ * Index of the first zero byte of a word loaded from memory, or a value >= 8
+ * if there is none. In (x - 0x01..) & ~x the high bit of every zero byte is
+ * set, and the lowest one is exact: a false positive can only appear above a
+ * real zero byte, where the borrow propagates. Little endian only.
+ */
+inline size_t first_zero_byte(uint64_t x) noexcept {
+  const uint64_t t =
+      (x - 0x0101010101010101ull) & ~x & 0x8080808080808080ull;
+  return t == 0 ? 8 : count_trailing_zeros64(t) / 8;
+}
+
+/**
+ * Index of the first c.
+ */
+inline size_t find_byte(const unsigned char* ptr,
+                        size_t size,
+                        unsigned char c) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  if (size >= 16) {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(c));
+    for (;; i += 16) {
+      if (i + 16 > size)
+        i = size - 16;
+      const __m128i block =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+      const uint32_t mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+      if (mask != 0)
+        return i + count_trailing_zeros(mask);
+      if (i + 16 == size)
+        return static_cast<size_t>(-1);
+    }
+  }
+#endif
+#if JASL_INNER_LITTLE_ENDIAN
+  // The short strings (and the whole string without SSE2) are examined 8
+  // bytes at once. The last word overlaps with the previous one.
+  const uint64_t pattern = 0x0101010101010101ull * c;
+  for (; i + 8 < size; i += 8) {
+    const size_t k = first_zero_byte(load_u64(ptr + i) ^ pattern);
+    if (k < 8)
+      return i + k;
+  }
+  if (size - i >= 8) {
+    const size_t k = first_zero_byte(load_u64(ptr + size - 8) ^ pattern);
+    return k < 8 ? size - 8 + k : static_cast<size_t>(-1);
+  }
+  if (size - i >= 4) {
+    // the upper half of the word is zero, so k is at most 4
+    size_t k = first_zero_byte(load_u32(ptr + i) ^ (pattern >> 32));
+    if (k < 4)
+      return i + k;
+    k = first_zero_byte(load_u32(ptr + size - 4) ^ (pattern >> 32));
+    return k < 4 ? size - 4 + k : static_cast<size_t>(-1);
+  }
+#endif
+  for (; i < size; ++i) {
+    if (ptr[i] == c)
+      return i;
+  }
+  return static_cast<size_t>(-1);
+}
+
+/**
+ * Index of the first byte which is in the set. The set is given both as an
+ * array and as a table: small sets are compared in parallel, bigger ones are
+ * looked up in the table byte by byte.
+ */
+inline size_t find_any_byte(const unsigned char* ptr,
+                            size_t size,
+                            const unsigned char* set,
+                            size_t set_size,
+                            const byte_set& table) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  if (set_size <= 8 && size >= 16) {
+    __m128i needles[8];
+    for (size_t k = 0; k < set_size; ++k)
+      needles[k] = _mm_set1_epi8(static_cast<char>(set[k]));
+    for (;; i += 16) {
+      if (i + 16 > size)
+        i = size - 16;
+      const __m128i block =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+      __m128i eq = _mm_setzero_si128();
+      for (size_t k = 0; k < set_size; ++k)
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, needles[k]));
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+      if (mask != 0)
+        return i + count_trailing_zeros(mask);
+      if (i + 16 == size)
+        return static_cast<size_t>(-1);
+    }
+  }
+#else
+  static_cast<void>(set);
+  static_cast<void>(set_size);
+#endif
+  for (; i < size; ++i) {
+    if (table.contains(ptr[i]))
+      return i;
+  }
+  return static_cast<size_t>(-1);
+}
+
+/**
+ * Index of the first occurrence of the needle. The candidates are the
+ * positions where both the first and the last byte of the needle match, only
+ * those are compared as a whole.
+ */
+inline size_t find_bytes(const unsigned char* ptr,
+                         size_t size,
+                         const unsigned char* needle,
+                         size_t needle_size) noexcept {
+  if (needle_size == 0)
+    return 0;
+  if (needle_size > size)
+    return static_cast<size_t>(-1);
+  if (needle_size == 1)
+    return find_byte(ptr, size, needle[0]);
+  const size_t last = size - needle_size;  // the last possible start
+  const unsigned char first_byte = needle[0];
+  const unsigned char last_byte = needle[needle_size - 1];
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  const __m128i first = _mm_set1_epi8(static_cast<char>(first_byte));
+  const __m128i lastc = _mm_set1_epi8(static_cast<char>(last_byte));
+  for (; i + 16 <= last + 1; i += 16) {
+    const __m128i head =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+    const __m128i tail = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(ptr + i + needle_size - 1));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, lastc))));
+    while (mask != 0) {
+      const size_t j = i + count_trailing_zeros(mask);
+      if (bytes_equal(ptr + j + 1, needle + 1, needle_size - 2))
+        return j;
+      mask &= mask - 1;
+    }
+  }
+#endif
+  while (i <= last) {
+    const size_t k = find_byte(ptr + i, last + 1 - i, first_byte);
+    if (k == static_cast<size_t>(-1))
+      break;
+    i += k;
+    if (ptr[i + needle_size - 1] == last_byte &&
+        bytes_equal(ptr + i + 1, needle + 1, needle_size - 2))
+      return i;
+    ++i;
+  }
+  return static_cast<size_t>(-1);
+}
+
+/**
+ * Index of the first occurrence of the needle for any character type: byte
+ * strings go to find_bytes, the others are compared with the Traits at the
+ * positions of the first character.
+ */
+template <typename CharT, typename Traits>
+inline size_t find_substring(const CharT* ptr,
+                             size_t size,
+                             const CharT* needle,
+                             size_t needle_size) noexcept {
+  if (is_byte_char<CharT, Traits>::value) {
+    return find_bytes(reinterpret_cast<const unsigned char*>(ptr), size,
+                      reinterpret_cast<const unsigned char*>(needle),
+                      needle_size);
+  }
+  if (needle_size == 0)
+    return 0;
+  for (size_t i = 0; i + needle_size <= size; ++i) {
+    const CharT* found =
+        Traits::find(ptr + i, size - needle_size + 1 - i, needle[0]);
+    if (found == nullptr)
+      break;
+    i = static_cast<size_t>(found - ptr);
+    if (Traits::compare(found + 1, needle + 1, needle_size - 1) == 0)
+      return i;
+  }
+  return static_cast<size_t>(-1);
+}
+
+/**
+ * Bitmask of the zero bytes of a word loaded from memory: bit i is set if the
+ * i-th byte is zero. Unlike first_zero_byte it is exact for every byte.
+ * Little endian only.
+ */
+inline uint32_t zero_byte_mask8(uint64_t x) noexcept {
+  const uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+  const uint64_t t = ~(((x & low7) + low7) | x) & 0x8080808080808080ull;
+  // gathers the high bits of the bytes into the top byte
+  return static_cast<uint32_t>(((t >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+#if JASL_INNER_SSE2
+/**
+ * Bitmask of the first min(size, 64) bytes where eq(block) of the 16 byte
+ * blocks is set. size has to be at least 16.
+ */
+template <typename EqT>
+inline uint64_t block_mask64(const unsigned char* ptr,
+                             size_t size,
+                             const EqT& eq) noexcept {
+  JASL_ASSERT(size >= 16, "block_mask64: size >= 16");
+  auto mask16 = [&](size_t i) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(
+        eq(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i))))));
+  };
+  if (size >= 64) {
+    return mask16(0) | (mask16(16) << 16) | (mask16(32) << 32) |
+           (mask16(48) << 48);
+  }
+  uint64_t mask = 0;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16)
+    mask |= mask16(i) << i;
+  if (i < size)
+    mask |= mask16(size - 16) << (size - 16);
+  return mask;
+}
+#endif
+
+/**
+ * Bitmask of the first min(size, 64) bytes: bit i is set if ptr[i] == c.
+ */
+inline uint64_t byte_mask64(const unsigned char* ptr,
+                            size_t size,
+                            unsigned char c) noexcept {
+#if JASL_INNER_SSE2
+  if (size >= 16) {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(c));
+    return block_mask64(ptr, size, [needle](__m128i block) {
+      return _mm_cmpeq_epi8(block, needle);
+    });
+  }
+#endif
+  const size_t n = size < 64 ? size : 64;
+  uint64_t mask = 0;
+  size_t i = 0;
+#if JASL_INNER_LITTLE_ENDIAN
+  const uint64_t pattern = 0x0101010101010101ull * c;
+  for (; i + 8 <= n; i += 8) {
+    mask |= static_cast<uint64_t>(
+                zero_byte_mask8(load_u64(ptr + i) ^ pattern))
+            << i;
+  }
+#endif
+  for (; i < n; ++i)
+    mask |= static_cast<uint64_t>(ptr[i] == c) << i;
+  return mask;
+}
+
+/**
+ * Bitmask of the first min(size, 64) bytes: bit i is set if ptr[i] is in the
+ * set. See find_any_byte for the parameters.
+ */
+inline uint64_t any_byte_mask64(const unsigned char* ptr,
+                                size_t size,
+                                const unsigned char* set,
+                                size_t set_size,
+                                const byte_set& table) noexcept {
+#if JASL_INNER_SSE2
+  if (set_size <= 8 && size >= 16) {
+    __m128i needles[8];
+    for (size_t k = 0; k < set_size; ++k)
+      needles[k] = _mm_set1_epi8(static_cast<char>(set[k]));
+    return block_mask64(ptr, size, [&needles, set_size](__m128i block) {
+      __m128i eq = _mm_setzero_si128();
+      for (size_t k = 0; k < set_size; ++k)
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, needles[k]));
+      return eq;
+    });
+  }
+#else
+  static_cast<void>(set);
+  static_cast<void>(set_size);
+#endif
+  const size_t n = size < 64 ? size : 64;
+  uint64_t mask = 0;
+  for (size_t i = 0; i < n; ++i)
+    mask |= static_cast<uint64_t>(table.contains(ptr[i])) << i;
+  return mask;
+}
+
+/**
+ * Left-to-right scan for single character delimiters which computes the
+ * positions of 64 bytes at once and then just pops them one by one. It suits
+ * the splitting: the next search starts right after the previous result.
+ */
+struct mask_cursor {
+  size_t block;   // the beginning of the window, size_t(-1) if there is none
+  uint64_t mask;  // bit i: block + i is a delimiter
+
+  mask_cursor() noexcept : block(static_cast<size_t>(-1)), mask(0) {}
+
+  /**
+   * Index of the first delimiter in [start, size) or size_t(-1). start must
+   * not decrease between the calls. make_mask(offset) has to return the mask
+   * of [offset, min(offset + 64, size)).
+   */
+  template <typename MaskF>
+  size_t next(size_t size, size_t start, const MaskF& make_mask) noexcept {
+    for (;;) {
+      if (block != static_cast<size_t>(-1) && start - block < 64) {
+        const uint64_t m =
+            mask & (~static_cast<uint64_t>(0) << (start - block));
+        if (m != 0)
+          return block + count_trailing_zeros64(m);
+        start = block + 64;
+      }
+      if (start >= size)
+        return static_cast<size_t>(-1);
+      block = start;
+      mask = make_mask(start);
+    }
+  }
+};
+
+}  // namespace inner
+}  // namespace jasl
@@ -0,0 +1,123 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * Membership table for single byte characters: one bit for each of the 256
+ * possible values. Building it is a single pass over the set and a lookup is
+ * a shift and a mask, so the scan over the searched string is branch-light
+ * and does not depend on the size of the set.
+ */
+class byte_set {
+  uint64_t _bits[4];
+
+ public:
+  constexpr byte_set() noexcept : _bits{0, 0, 0, 0} {}
+
+  template <typename CharT>
+  JASL_CONSTEXPR_CXX14 byte_set(const CharT* ptr, size_t size) noexcept
+      : _bits{0, 0, 0, 0} {
+    static_assert(sizeof(CharT) == 1, "Only for single byte characters.");
+    for (size_t i = 0; i < size; ++i)
+      insert(static_cast<unsigned char>(ptr[i]));
+  }
+
+  JASL_CONSTEXPR_CXX14 void insert(unsigned char c) noexcept {
+    _bits[c >> 6] |= static_cast<uint64_t>(1) << (c & 63);
+  }
+
+  constexpr bool contains(unsigned char c) const noexcept {
+    return ((_bits[c >> 6] >> (c & 63)) & 1) != 0;
+  }
+};
+
+/**
+ * Set membership test of a character against a character array.
+ *
+ * The byte_set is used only for byte characters (see is_byte_char), any other
+ * Traits is asked via Traits::find.
+ */
+template <typename CharT,
+          typename Traits,
+          bool = is_byte_char<CharT, Traits>::value>
+class char_set;
+
+template <typename CharT, typename Traits>
+class char_set<CharT, Traits, true> {
+  byte_set _set;
+
+ public:
+  JASL_CONSTEXPR_CXX14 char_set(const CharT* ptr, size_t size) noexcept
+      : _set(ptr, size) {}
+
+  constexpr bool contains(CharT c) const noexcept {
+    return _set.contains(static_cast<unsigned char>(c));
+  }
+};
+
+template <typename CharT, typename Traits>
+class char_set<CharT, Traits, false> {
+  const CharT* _ptr;
+  size_t _size;
+
+ public:
+  constexpr char_set(const CharT* ptr, size_t size) noexcept
+      : _ptr(ptr), _size(size) {}
+
+  JASL_CONSTEXPR_CXX14 bool contains(CharT c) const noexcept {
+    return _size != 0 && Traits::find(_ptr, _size, c) != nullptr;
+  }
+};
+
+/**
+ * Scanning kernels of the find_first_of family. They return the index or
+ * size_t(-1) (npos). pos is already clamped by the caller when it says so.
+ */
+
+template <typename CharT, typename Traits>
+JASL_CONSTEXPR_CXX14 size_t find_first_of(const CharT* ptr,
+                                          size_t size,
+                                          const CharT* set,
+                                          size_t set_size,
+                                          size_t pos,
+                                          bool match) noexcept {
+  const char_set<CharT, Traits> cs(set, set_size);
+  for (size_t i = pos; i < size; ++i) {
+    if (cs.contains(ptr[i]) == match)
+      return i;
+  }
+  return static_cast<size_t>(-1);
+}
+
+/**
+ * pos has to be less than size.
+ */
+template <typename CharT, typename Traits>
+JASL_CONSTEXPR_CXX14 size_t find_last_of(const CharT* ptr,
+                                         const CharT* set,
+                                         size_t set_size,
+                                         size_t pos,
+                                         bool match) noexcept {
+  const char_set<CharT, Traits> cs(set, set_size);
+  for (size_t i = pos + 1; i-- > 0;) {
+    if (cs.contains(ptr[i]) == match)
+      return i;
+  }
+  return static_cast<size_t>(-1);
+}
+
+}  // namespace inner
+}  // namespace jasl
@@ -150,4 +150,11 @@ static_assert(JASL_VERSION_PATCH < 1000, "JASL_VERSION error");
  */
 #  define JASL_FORCE_USE_MURMURHASH_HASH
 
+/**
+ * Some algorithms use SSE2 instructions if the compiler enables them by default
+ * (every x86-64 compiler does). This macro turns them off: the portable
+ * word-at-a-time implementations will be used instead.
+ */
+#  define JASL_DISABLE_SIMD
+
 #endif  // JASL_DOXYGEN_DOCUMENTATION
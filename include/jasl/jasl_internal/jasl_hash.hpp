@@ -0,0 +1,38 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "jasl/jasl_streaming_murmurhash3.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * Both 64 bit halves of MurmurHash3_x64_128 of the bytes (of any length),
+ * with the seed of the std::hash specialization of the views. The sketches
+ * and filters derive all of their hash values from these.
+ */
+inline void hash128(const void* data, size_t size, uint64_t out[2]) noexcept {
+  murmurhash3_x64_128::hash(data, size, 33, out);
+}
+
+/**
+ * splitmix64 finalizer: derives further well mixed values from a hash and a
+ * counter.
+ */
+inline uint64_t mix64(uint64_t x) noexcept {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+}  // namespace inner
+}  // namespace jasl
@@ -139,10 +139,10 @@ JASL_USAN_IGNORE(integer) FORCE_INLINE uint64_t fmix64(uint64_t k) {
 //-----------------------------------------------------------------------------
 
 JASL_USAN_IGNORE(integer)
-void MurmurHash3_x86_128(const void* key,
-                         const int len,
-                         uint32_t seed,
-                         void* out) {
+inline void MurmurHash3_x86_128(const void* key,
+                                const int len,
+                                uint32_t seed,
+                                void* out) {
   const uint8_t* data = (const uint8_t*)key;
   const int nblocks = len / 16;
 
@@ -302,10 +302,10 @@ void MurmurHash3_x86_128(const void* key,
 //-----------------------------------------------------------------------------
 
 JASL_USAN_IGNORE(integer)
-void MurmurHash3_x64_128(const void* key,
-                         const int len,
-                         const uint32_t seed,
-                         void* out) {
+inline void MurmurHash3_x64_128(const void* key,
+                                const int len,
+                                const uint32_t seed,
+                                void* out) {
   const uint8_t* data = (const uint8_t*)key;
   const int nblocks = len / 16;
 
@@ -0,0 +1,259 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+
+/*
+ * JASL_INNER_SSE2
+ * 1 if the SSE2 intrinsics can be used without any extra compiler flag. It is
+ * the baseline of every x86-64 compiler. Can be turned off by
+ * JASL_DISABLE_SIMD, in that case the word-at-a-time (SWAR) fallbacks are used.
+ */
+#if !defined(JASL_DISABLE_SIMD) &&                      \
+    (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define JASL_INNER_SSE2 1
+#  include <emmintrin.h>
+#else
+#  define JASL_INNER_SSE2 0
+#endif
+
+/*
+ * JASL_INNER_SSSE3
+ * 1 if the SSSE3 intrinsics (byte shuffle, alignr) are enabled by the
+ * compiler flags (-mssse3, -march=native, /arch:AVX). Only a few algorithms
+ * depend on it, they fall back to SSE2 and scalar code without it.
+ */
+#if JASL_INNER_SSE2 && (defined(__SSSE3__) || defined(__AVX__))
+#  define JASL_INNER_SSSE3 1
+#  include <tmmintrin.h>
+#else
+#  define JASL_INNER_SSSE3 0
+#endif
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#  include <stdlib.h>
+#endif
+
+/*
+ * JASL_INNER_LITTLE_ENDIAN
+ * The word-at-a-time algorithms need to know which byte of a loaded word comes
+ * first in memory.
+ */
+#if defined(_MSC_VER)
+#  define JASL_INNER_LITTLE_ENDIAN 1
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#  if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#    define JASL_INNER_LITTLE_ENDIAN 1
+#  else
+#    define JASL_INNER_LITTLE_ENDIAN 0
+#  endif
+#else
+#  error "Unknown byte order!"
+#endif
+
+/*
+ * JASL_INNER_IS_CONSTANT_EVALUATED()
+ * The vectorized paths are not constexpr. Where the compiler can tell, the
+ * constexpr path is chosen during constant evaluation. Where it can't, and
+ * the standard traits are constexpr (C++17), the constexpr path is always
+ * chosen so nothing that worked before breaks. Without the relaxed constexpr
+ * (C++11) the functions are not constexpr at all.
+ */
+#if JASL_cpp_constexpr < 201304L
+#  define JASL_INNER_IS_CONSTANT_EVALUATED() false
+#elif defined(__GNUG__) && !defined(__clang__) && __GNUC__ >= 9
+#  define JASL_INNER_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(__clang__)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#    define JASL_INNER_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#  endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#  define JASL_INNER_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(JASL_INNER_IS_CONSTANT_EVALUATED)
+#  if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+#    define JASL_INNER_IS_CONSTANT_EVALUATED() true
+#  else
+#    define JASL_INNER_IS_CONSTANT_EVALUATED() false
+#  endif
+#endif
+
+namespace jasl {
+namespace inner {
+
+/**
+ * True if the characters can be handled as raw bytes: they are one byte wide
+ * and the Traits is the standard one, so equality and ordering are the ones
+ * of unsigned char. Any other Traits might have its own idea about them (for
+ * example case-insensitivity).
+ */
+template <typename CharT, typename Traits>
+struct is_byte_char
+    : std::integral_constant<
+          bool,
+          sizeof(CharT) == 1 &&
+              std::is_same<Traits, std::char_traits<CharT>>::value> {};
+
+// Unaligned loads. The compilers turn these into single mov instructions.
+
+inline uint16_t load_u16(const void* ptr) noexcept {
+  uint16_t r;
+  std::memcpy(&r, ptr, sizeof(r));
+  return r;
+}
+
+inline uint32_t load_u32(const void* ptr) noexcept {
+  uint32_t r;
+  std::memcpy(&r, ptr, sizeof(r));
+  return r;
+}
+
+inline uint64_t load_u64(const void* ptr) noexcept {
+  uint64_t r;
+  std::memcpy(&r, ptr, sizeof(r));
+  return r;
+}
+
+inline uint64_t byteswap64(uint64_t x) noexcept {
+#if defined(_MSC_VER)
+  return _byteswap_uint64(x);
+#else
+  return __builtin_bswap64(x);
+#endif
+}
+
+// Little-endian loads and stores: byte i of the memory is byte i of the word
+// on every platform.
+
+inline uint64_t load_le64(const void* ptr) noexcept {
+#if JASL_INNER_LITTLE_ENDIAN
+  return load_u64(ptr);
+#else
+  return byteswap64(load_u64(ptr));
+#endif
+}
+
+inline void store_le64(void* ptr, uint64_t x) noexcept {
+#if !JASL_INNER_LITTLE_ENDIAN
+  x = byteswap64(x);
+#endif
+  std::memcpy(ptr, &x, sizeof(x));
+}
+
+/**
+ * Converts a loaded word so that comparing it as an integer is the same as
+ * comparing the bytes lexicographically (as unsigned char).
+ */
+inline uint64_t to_lexicographic_order(uint64_t x) noexcept {
+#if JASL_INNER_LITTLE_ENDIAN
+  return byteswap64(x);
+#else
+  return x;
+#endif
+}
+
+/**
+ * Index of the lowest set bit. x can't be 0.
+ */
+inline unsigned count_trailing_zeros64(uint64_t x) noexcept {
+  JASL_ASSERT(x != 0, "count_trailing_zeros64(0)");
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long r;
+  _BitScanForward64(&r, x);
+  return static_cast<unsigned>(r);
+#elif defined(_MSC_VER)
+  unsigned long r;
+  if (_BitScanForward(&r, static_cast<unsigned long>(x)))
+    return static_cast<unsigned>(r);
+  _BitScanForward(&r, static_cast<unsigned long>(x >> 32));
+  return static_cast<unsigned>(r) + 32;
+#else
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+/**
+ * Index of the lowest set bit. x can't be 0.
+ */
+inline unsigned count_trailing_zeros(uint32_t x) noexcept {
+  JASL_ASSERT(x != 0, "count_trailing_zeros(0)");
+#if defined(_MSC_VER)
+  unsigned long r;
+  _BitScanForward(&r, x);
+  return static_cast<unsigned>(r);
+#else
+  return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+/**
+ * The number of the zero bits above the highest set bit. x can't be 0.
+ */
+inline unsigned count_leading_zeros64(uint64_t x) noexcept {
+  JASL_ASSERT(x != 0, "count_leading_zeros64(0)");
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long r;
+  _BitScanReverse64(&r, x);
+  return 63 - static_cast<unsigned>(r);
+#elif defined(_MSC_VER)
+  unsigned long r;
+  if (_BitScanReverse(&r, static_cast<unsigned long>(x >> 32)))
+    return 31 - static_cast<unsigned>(r);
+  _BitScanReverse(&r, static_cast<unsigned long>(x));
+  return 63 - static_cast<unsigned>(r);
+#else
+  return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+}
+
+/**
+ * The number of the set bits.
+ */
+inline unsigned popcount32(uint32_t x) noexcept {
+#if defined(_MSC_VER)
+  x = x - ((x >> 1) & 0x55555555u);
+  x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+  x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+  return static_cast<unsigned>((x * 0x01010101u) >> 24);
+#else
+  return static_cast<unsigned>(__builtin_popcount(x));
+#endif
+}
+
+inline unsigned popcount64(uint64_t x) noexcept {
+#if defined(_MSC_VER)
+  return popcount32(static_cast<uint32_t>(x)) +
+         popcount32(static_cast<uint32_t>(x >> 32));
+#else
+  return static_cast<unsigned>(__builtin_popcountll(x));
+#endif
+}
+
+/**
+ * Hints the processor to load the cache line of ptr.
+ */
+inline void prefetch(const void* ptr) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#elif defined(__GNUC__)
+  __builtin_prefetch(ptr);
+#else
+  (void)ptr;
+#endif
+}
+
+}  // namespace inner
+}  // namespace jasl
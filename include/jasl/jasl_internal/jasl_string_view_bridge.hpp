@@ -10,9 +10,21 @@
 
 #include <iterator>
 
+#include "jasl/jasl_internal/jasl_byte_compare.hpp"
+
 namespace jasl {
 namespace inner {
 
+/*
+ * Parameter type which doesn't take part in the template argument deduction,
+ * so the functions which take a view and a bridge can get a view for their
+ * other parameters from anything convertible.
+ */
+template <typename T>
+struct non_deduced {
+  typedef T type;
+};
+
 template <typename string_viewT>
 class string_view_bridge {
  public:
@@ -60,20 +72,27 @@ class string_view_bridge {
                                     size_type>::value;
 
  protected:
-  constexpr string_view_bridge() noexcept(is_nothrow_default_constructible) {}
+  constexpr string_view_bridge() noexcept(is_nothrow_default_constructible)
+      : string_view_bridge(string_viewT()) {}
   constexpr explicit string_view_bridge(string_viewT s) noexcept(
       is_nothrow_copy_constructible)
-      : _sv(s) {}
+      : _data(s.data()), _size(s.size()) {}
   constexpr string_view_bridge(const string_view_bridge& s) noexcept(
       is_nothrow_copy_constructible) = default;
   constexpr string_view_bridge(string_view_bridge&& s) noexcept(
       is_nothrow_move_constructible) = default;
   constexpr explicit string_view_bridge(const value_type* str) noexcept(
       std::is_nothrow_constructible<string_viewT, const value_type*>::value)
-      : _sv(str) {}
+      : string_view_bridge(string_viewT(str)) {}
   constexpr string_view_bridge(const value_type* str, size_type len) noexcept(
       is_nothrow_constructible_with_ptr_and_size)
-      : _sv(str, len) {}
+      : string_view_bridge(string_viewT(str, len)) {}
+  constexpr string_view_bridge(const value_type* str,
+                               size_type len,
+                               bool null_terminated) noexcept(
+      is_nothrow_constructible_with_ptr_and_size)
+      : _data(string_viewT(str, len).data()),
+        _size(len | (null_terminated ? null_terminated_bit : 0)) {}
 
   string_view_bridge& operator=(const string_view_bridge&) noexcept(
       is_nothrow_copy_assignable) = default;
@@ -83,129 +102,162 @@ class string_view_bridge {
 
   JASL_CONSTEXPR_CXX14 void swap(string_view_bridge& s) noexcept(
       is_nothrow_swappable) {
-    _sv.swap(s._sv);
+    const value_type* const data = _data;
+    const size_type size = _size;
+    _data = s._data;
+    _size = s._size;
+    s._data = data;
+    s._size = size;
+  }
+
+  JASL_CONSTEXPR_CXX14 void set(
+      const value_type* str,
+      size_type len,
+      bool null_terminated = false) noexcept(is_nothrow_settable) {
+    const string_viewT sv(str, len);
+    _data = sv.data();
+    _size = sv.size() | (null_terminated ? null_terminated_bit : 0);
+  }
+
+  /**
+   * Whether data()[size()] is the null character. The bridge only stores it
+   * (in the top bit of the size, which no string can use), the derived
+   * strings decide when it holds.
+   */
+  constexpr bool null_terminated_flag() const noexcept {
+    return (_size & null_terminated_bit) != 0;
+  }
+
+  JASL_CONSTEXPR_CXX14 void set_null_terminated_flag(bool value) noexcept {
+    _size = (_size & ~null_terminated_bit) |
+            (value ? null_terminated_bit : 0);
   }
 
-  JASL_CONSTEXPR_CXX14 void set(const value_type* str,
-                                size_type len) noexcept(is_nothrow_settable) {
-    _sv = string_viewT(str, len);
+  constexpr string_viewT view() const
+      noexcept(is_nothrow_constructible_with_ptr_and_size) {
+    return string_viewT(_data, _size & ~null_terminated_bit);
   }
 
  public:
-  operator string_viewT() const noexcept { return _sv; }
+  operator string_viewT() const noexcept { return view(); }
 
  public:
   constexpr const_iterator begin() const
       noexcept(noexcept(std::declval<string_viewT>().begin())) {
-    return _sv.begin();
+    return view().begin();
   }
   constexpr const_iterator end() const
       noexcept(noexcept(std::declval<string_viewT>().end())) {
-    return _sv.end();
+    return view().end();
   }
   constexpr const_iterator cbegin() const
       noexcept(noexcept(std::declval<string_viewT>().cbegin())) {
-    return _sv.cbegin();
+    return view().cbegin();
   }
   constexpr const_iterator cend() const
       noexcept(noexcept(std::declval<string_viewT>().cend())) {
-    return _sv.cend();
+    return view().cend();
   }
   const_reverse_iterator rbegin() const
       noexcept(noexcept(std::declval<string_viewT>().rbegin())) {
-    return _sv.rbegin();
+    return view().rbegin();
   }
   const_reverse_iterator rend() const
       noexcept(noexcept(std::declval<string_viewT>().rend())) {
-    return _sv.rend();
+    return view().rend();
   }
   const_reverse_iterator crbegin() const
       noexcept(noexcept(std::declval<string_viewT>().crbegin())) {
-    return _sv.crbegin();
+    return view().crbegin();
   }
   const_reverse_iterator crend() const
       noexcept(noexcept(std::declval<string_viewT>().crend())) {
-    return _sv.crend();
+    return view().crend();
   }
 
   constexpr size_type size() const
       noexcept(noexcept(std::declval<string_viewT>().size())) {
-    return _sv.size();
+    return view().size();
   }
   constexpr size_type length() const
       noexcept(noexcept(std::declval<string_viewT>().length())) {
-    return _sv.length();
+    return view().length();
   }
   constexpr size_type max_size() const
       noexcept(noexcept(std::declval<string_viewT>().max_size())) {
-    return _sv.max_size();
+    return view().max_size();
   }
   constexpr bool empty() const
       noexcept(noexcept(std::declval<string_viewT>().empty())) {
-    return _sv.empty();
+    return view().empty();
   }
 
   constexpr const_reference operator[](size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>()[pos])) {
-    return _sv[pos];
+    return view()[pos];
   }
   constexpr const_reference at(size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().at(pos))) {
-    return _sv.at(pos);
+    return view().at(pos);
   }
   constexpr const_reference front() const
       noexcept(noexcept(std::declval<string_viewT>().front())) {
-    return _sv.front();
+    return view().front();
   }
   constexpr const_reference back() const
       noexcept(noexcept(std::declval<string_viewT>().back())) {
-    return _sv.back();
+    return view().back();
   }
   constexpr const_pointer data() const
       noexcept(noexcept(std::declval<string_viewT>().data())) {
-    return _sv.data();
+    return view().data();
   }
 
   JASL_CONSTEXPR_CXX14 void remove_prefix(size_type n) noexcept(
       noexcept(std::declval<string_viewT>().remove_prefix(n))) {
-    _sv.remove_prefix(n);
+    string_viewT sv = view();
+    sv.remove_prefix(n);
+    _data = sv.data();
+    _size = sv.size() | (_size & null_terminated_bit);
   }
   JASL_CONSTEXPR_CXX14 void remove_suffix(size_type n) noexcept(
       noexcept(std::declval<string_viewT>().remove_suffix(n))) {
-    _sv.remove_suffix(n);
+    string_viewT sv = view();
+    sv.remove_suffix(n);
+    set(sv.data(), sv.size(), n == 0 && null_terminated_flag());
   }
 
   size_type copy(value_type* s, size_type n) const
       noexcept(noexcept(std::declval<string_viewT>().copy(s, n))) {
-    return _sv.copy(s, n);
+    return view().copy(s, n);
   }
   size_type copy(value_type* s, size_type n, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().copy(s, n, pos))) {
-    return _sv.copy(s, n, pos);
+    return view().copy(s, n, pos);
   }
 
   constexpr string_view_bridge substr(size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().substr(pos)) &&
                std::is_nothrow_copy_constructible<string_viewT>::value &&
                std::is_nothrow_copy_constructible<string_view_bridge>::value) {
-    return string_view_bridge(string_viewT(_sv.substr(pos)));
+    return string_view_bridge(string_viewT(view().substr(pos)));
   }
   constexpr string_view_bridge substr(size_type pos, size_type n) const
       noexcept(noexcept(std::declval<string_viewT>().substr(pos, n)) &&
                std::is_nothrow_copy_constructible<string_viewT>::value &&
                std::is_nothrow_copy_constructible<string_view_bridge>::value) {
-    return string_view_bridge(string_viewT(_sv.substr(pos, n)));
+    return string_view_bridge(string_viewT(view().substr(pos, n)));
   }
   constexpr int compare(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().compare(s._sv))) {
-    return _sv.compare(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().compare(s.view()))) {
+    return view().compare(s.view());
   }
   constexpr int compare(size_type pos1,
                         size_type n1,
                         string_view_bridge s) const
       noexcept(
-          noexcept(std::declval<string_viewT>().compare(pos1, n1, s._sv))) {
-    return _sv.compare(pos1, n1, s._sv);
+          noexcept(std::declval<string_viewT>().compare(pos1, n1, s.view()))) {
+    return view().compare(pos1, n1, s.view());
   }
   constexpr int compare(size_type pos1,
                         size_type n1,
@@ -213,16 +265,16 @@ class string_view_bridge {
                         size_type pos2,
                         size_type n2) const
       noexcept(noexcept(
-          std::declval<string_viewT>().compare(pos1, n1, s._sv, pos2, n2))) {
-    return _sv.compare(pos1, n1, s._sv, pos2, n2);
+          std::declval<string_viewT>().compare(pos1, n1, s.view(), pos2, n2))) {
+    return view().compare(pos1, n1, s.view(), pos2, n2);
   }
   constexpr int compare(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().compare(s))) {
-    return _sv.compare(s);
+    return view().compare(s);
   }
   constexpr int compare(size_type pos1, size_type n1, const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().compare(pos1, n1, s))) {
-    return _sv.compare(pos1, n1, s);
+    return view().compare(pos1, n1, s);
   }
   constexpr int compare(size_type pos1,
                         size_type n1,
@@ -230,343 +282,355 @@ class string_view_bridge {
                         size_type n2) const
       noexcept(
           noexcept(std::declval<string_viewT>().compare(pos1, n1, s, n2))) {
-    return _sv.compare(pos1, n1, s, n2);
+    return view().compare(pos1, n1, s, n2);
   }
   constexpr size_type find(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().find(s._sv))) {
-    return _sv.find(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().find(s.view()))) {
+    return view().find(s.view());
   }
   constexpr size_type find(string_view_bridge s, size_type pos) const
-      noexcept(noexcept(std::declval<string_viewT>().find(s._sv, pos))) {
-    return _sv.find(s._sv, pos);
+      noexcept(noexcept(std::declval<string_viewT>().find(s.view(), pos))) {
+    return view().find(s.view(), pos);
   }
   constexpr size_type find(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().find(c))) {
-    return _sv.find(c);
+    return view().find(c);
   }
   constexpr size_type find(value_type c, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find(c, pos))) {
-    return _sv.find(c, pos);
+    return view().find(c, pos);
   }
   constexpr size_type find(const value_type* s,
                            size_type pos,
                            size_type n) const
       noexcept(noexcept(std::declval<string_viewT>().find(s, pos, n))) {
-    return _sv.find(s, pos, n);
+    return view().find(s, pos, n);
   }
   constexpr size_type find(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().find(s))) {
-    return _sv.find(s);
+    return view().find(s);
   }
   constexpr size_type find(const value_type* s, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find(s, pos))) {
-    return _sv.find(s, pos);
+    return view().find(s, pos);
   }
   constexpr size_type rfind(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().rfind(s._sv))) {
-    return _sv.rfind(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().rfind(s.view()))) {
+    return view().rfind(s.view());
   }
   constexpr size_type rfind(string_view_bridge s, size_type pos) const
-      noexcept(noexcept(std::declval<string_viewT>().rfind(s._sv, pos))) {
-    return _sv.rfind(s._sv, pos);
+      noexcept(noexcept(std::declval<string_viewT>().rfind(s.view(), pos))) {
+    return view().rfind(s.view(), pos);
   }
   constexpr size_type rfind(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().rfind(c))) {
-    return _sv.rfind(c);
+    return view().rfind(c);
   }
   constexpr size_type rfind(value_type c, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().rfind(c, pos))) {
-    return _sv.rfind(c, pos);
+    return view().rfind(c, pos);
   }
   constexpr size_type rfind(const value_type* s,
                             size_type pos,
                             size_type n) const
       noexcept(noexcept(std::declval<string_viewT>().rfind(s, pos, n))) {
-    return _sv.rfind(s, pos, n);
+    return view().rfind(s, pos, n);
   }
   constexpr size_type rfind(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().rfind(s))) {
-    return _sv.rfind(s);
+    return view().rfind(s);
   }
   constexpr size_type rfind(const value_type* s, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().rfind(s, pos))) {
-    return _sv.rfind(s, pos);
+    return view().rfind(s, pos);
   }
   constexpr size_type find_first_of(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().find_first_of(s._sv))) {
-    return _sv.find_first_of(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().find_first_of(s.view()))) {
+    return view().find_first_of(s.view());
   }
   constexpr size_type find_first_of(string_view_bridge s, size_type pos) const
-      noexcept(noexcept(std::declval<string_viewT>().find_first_of(s._sv,
+      noexcept(noexcept(std::declval<string_viewT>().find_first_of(s.view(),
                                                                    pos))) {
-    return _sv.find_first_of(s._sv, pos);
+    return view().find_first_of(s.view(), pos);
   }
   constexpr size_type find_first_of(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_of(c))) {
-    return _sv.find_first_of(c);
+    return view().find_first_of(c);
   }
   constexpr size_type find_first_of(value_type c, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_of(c, pos))) {
-    return _sv.find_first_of(c, pos);
+    return view().find_first_of(c, pos);
   }
   constexpr size_type find_first_of(const value_type* s,
                                     size_type pos,
                                     size_type n) const
       noexcept(
           noexcept(std::declval<string_viewT>().find_first_of(s, pos, n))) {
-    return _sv.find_first_of(s, pos, n);
+    return view().find_first_of(s, pos, n);
   }
   constexpr size_type find_first_of(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_of(s))) {
-    return _sv.find_first_of(s);
+    return view().find_first_of(s);
   }
   constexpr size_type find_first_of(const value_type* s, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_of(s, pos))) {
-    return _sv.find_first_of(s, pos);
+    return view().find_first_of(s, pos);
   }
   constexpr size_type find_last_of(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().find_last_of(s._sv))) {
-    return _sv.find_last_of(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().find_last_of(s.view()))) {
+    return view().find_last_of(s.view());
   }
   constexpr size_type find_last_of(string_view_bridge s, size_type pos) const
-      noexcept(noexcept(std::declval<string_viewT>().find_last_of(s._sv,
+      noexcept(noexcept(std::declval<string_viewT>().find_last_of(s.view(),
                                                                   pos))) {
-    return _sv.find_last_of(s._sv, pos);
+    return view().find_last_of(s.view(), pos);
   }
   constexpr size_type find_last_of(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_of(c))) {
-    return _sv.find_last_of(c);
+    return view().find_last_of(c);
   }
   constexpr size_type find_last_of(value_type c, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_of(c, pos))) {
-    return _sv.find_last_of(c, pos);
+    return view().find_last_of(c, pos);
   }
   constexpr size_type find_last_of(const value_type* s,
                                    size_type pos,
                                    size_type n) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_of(s, pos, n))) {
-    return _sv.find_last_of(s, pos, n);
+    return view().find_last_of(s, pos, n);
   }
   constexpr size_type find_last_of(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_of(s))) {
-    return _sv.find_last_of(s);
+    return view().find_last_of(s);
   }
   constexpr size_type find_last_of(const value_type* s, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_of(s, pos))) {
-    return _sv.find_last_of(s, pos);
+    return view().find_last_of(s, pos);
   }
   constexpr size_type find_first_not_of(string_view_bridge s) const noexcept(
-      noexcept(std::declval<string_viewT>().find_first_not_of(s._sv))) {
-    return _sv.find_first_not_of(s._sv);
+      noexcept(std::declval<string_viewT>().find_first_not_of(s.view()))) {
+    return view().find_first_not_of(s.view());
   }
   constexpr size_type find_first_not_of(string_view_bridge s,
                                         size_type pos) const
-      noexcept(noexcept(std::declval<string_viewT>().find_first_not_of(s._sv,
+      noexcept(noexcept(std::declval<string_viewT>().find_first_not_of(s.view(),
                                                                        pos))) {
-    return _sv.find_first_not_of(s._sv, pos);
+    return view().find_first_not_of(s.view(), pos);
   }
   constexpr size_type find_first_not_of(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_not_of(c))) {
-    return _sv.find_first_not_of(c);
+    return view().find_first_not_of(c);
   }
   constexpr size_type find_first_not_of(value_type c, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_not_of(c,
                                                                        pos))) {
-    return _sv.find_first_not_of(c, pos);
+    return view().find_first_not_of(c, pos);
   }
   constexpr size_type find_first_not_of(const value_type* s,
                                         size_type pos,
                                         size_type n) const
       noexcept(
           noexcept(std::declval<string_viewT>().find_first_not_of(s, pos, n))) {
-    return _sv.find_first_not_of(s, pos, n);
+    return view().find_first_not_of(s, pos, n);
   }
   constexpr size_type find_first_not_of(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_not_of(s))) {
-    return _sv.find_first_not_of(s);
+    return view().find_first_not_of(s);
   }
   constexpr size_type find_first_not_of(const value_type* s,
                                         size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_first_not_of(s,
                                                                        pos))) {
-    return _sv.find_first_not_of(s, pos);
+    return view().find_first_not_of(s, pos);
   }
   constexpr size_type find_last_not_of(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(s._sv))) {
-    return _sv.find_last_not_of(s._sv);
+      noexcept(noexcept(
+          std::declval<string_viewT>().find_last_not_of(s.view()))) {
+    return view().find_last_not_of(s.view());
   }
   constexpr size_type find_last_not_of(string_view_bridge s,
                                        size_type pos) const
-      noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(s._sv,
+      noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(s.view(),
                                                                       pos))) {
-    return _sv.find_last_not_of(s._sv, pos);
+    return view().find_last_not_of(s.view(), pos);
   }
   constexpr size_type find_last_not_of(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(c))) {
-    return _sv.find_last_not_of(c);
+    return view().find_last_not_of(c);
   }
   constexpr size_type find_last_not_of(value_type c, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(c,
                                                                       pos))) {
-    return _sv.find_last_not_of(c, pos);
+    return view().find_last_not_of(c, pos);
   }
   constexpr size_type find_last_not_of(const value_type* s,
                                        size_type pos,
                                        size_type n) const
       noexcept(
           noexcept(std::declval<string_viewT>().find_last_not_of(s, pos, n))) {
-    return _sv.find_last_not_of(s, pos, n);
+    return view().find_last_not_of(s, pos, n);
   }
   constexpr size_type find_last_not_of(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(s))) {
-    return _sv.find_last_not_of(s);
+    return view().find_last_not_of(s);
   }
   constexpr size_type find_last_not_of(const value_type* s, size_type pos) const
       noexcept(noexcept(std::declval<string_viewT>().find_last_not_of(s,
                                                                       pos))) {
-    return _sv.find_last_not_of(s, pos);
+    return view().find_last_not_of(s, pos);
   }
   constexpr bool starts_with(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().starts_with(s._sv))) {
-    return _sv.starts_with(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().starts_with(s.view()))) {
+    return view().starts_with(s.view());
   }
   constexpr bool starts_with(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().starts_with(c))) {
-    return _sv.starts_with(c);
+    return view().starts_with(c);
   }
   constexpr bool starts_with(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().starts_with(s))) {
-    return _sv.starts_with(s);
+    return view().starts_with(s);
   }
   constexpr bool ends_with(string_view_bridge s) const
-      noexcept(noexcept(std::declval<string_viewT>().ends_with(s._sv))) {
-    return _sv.ends_with(s._sv);
+      noexcept(noexcept(std::declval<string_viewT>().ends_with(s.view()))) {
+    return view().ends_with(s.view());
   }
   constexpr bool ends_with(value_type c) const
       noexcept(noexcept(std::declval<string_viewT>().ends_with(c))) {
-    return _sv.ends_with(c);
+    return view().ends_with(c);
   }
   constexpr bool ends_with(const value_type* s) const
       noexcept(noexcept(std::declval<string_viewT>().ends_with(s))) {
-    return _sv.ends_with(s);
+    return view().ends_with(s);
   }
 
  protected:
-  string_viewT _sv;
+  static constexpr size_type null_terminated_bit = ~(~size_type(0) >> 1);
+
+  const value_type* _data;
+  size_type _size;  // the top bit is the null terminated flag
 
  public:
+  // The equality doesn't go through the base type's operator== because
+  // std::basic_string_view would call Traits::compare (memcmp) even for the
+  // few bytes long keys.
   friend JASL_CONSTEXPR_CXX14 bool operator==(
       const string_view_bridge<string_viewT>& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x._sv ==
-                                                                   y._sv)) {
-    return x._sv == y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept {
+    return x.size() == y.size() &&
+           inner::equal<value_type, traits_type>(x.data(), y.data(), x.size());
   }
   friend JASL_CONSTEXPR_CXX14 bool operator!=(
       const string_view_bridge<string_viewT>& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x._sv !=
-                                                                   y._sv)) {
-    return x._sv != y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept {
+    return !(x == y);
   }
   friend JASL_CONSTEXPR_CXX14 bool operator<(
       const string_view_bridge<string_viewT>& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x._sv <
-                                                                   y._sv)) {
-    return x._sv < y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x.view() <
+                                                                   y.view())) {
+    return x.view() < y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator>(
       const string_view_bridge<string_viewT>& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x._sv >
-                                                                   y._sv)) {
-    return x._sv > y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x.view() >
+                                                                   y.view())) {
+    return x.view() > y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator<=(
       const string_view_bridge<string_viewT>& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x._sv <=
-                                                                   y._sv)) {
-    return x._sv <= y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x.view() <=
+                                                                   y.view())) {
+    return x.view() <= y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator>=(
       const string_view_bridge<string_viewT>& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x._sv >=
-                                                                   y._sv)) {
-    return x._sv >= y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x.view() >=
+                                                                   y.view())) {
+    return x.view() >= y.view();
   }
 
   friend JASL_CONSTEXPR_CXX14 bool operator==(
       const string_view_bridge<string_viewT>& x,
-      const string_viewT& y) noexcept(noexcept(x._sv == y)) {
-    return x._sv == y;
+      const string_viewT& y) noexcept(noexcept(x.view() == y)) {
+    return x.view() == y;
   }
   friend JASL_CONSTEXPR_CXX14 bool operator!=(
       const string_view_bridge<string_viewT>& x,
-      const string_viewT& y) noexcept(noexcept(x._sv != y)) {
-    return x._sv != y;
+      const string_viewT& y) noexcept(noexcept(x.view() != y)) {
+    return x.view() != y;
   }
   friend JASL_CONSTEXPR_CXX14 bool operator<(
       const string_view_bridge<string_viewT>& x,
-      const string_viewT& y) noexcept(noexcept(x._sv < y)) {
-    return x._sv < y;
+      const string_viewT& y) noexcept(noexcept(x.view() < y)) {
+    return x.view() < y;
   }
   friend JASL_CONSTEXPR_CXX14 bool operator>(
       const string_view_bridge<string_viewT>& x,
-      const string_viewT& y) noexcept(noexcept(x._sv > y)) {
-    return x._sv > y;
+      const string_viewT& y) noexcept(noexcept(x.view() > y)) {
+    return x.view() > y;
   }
   friend JASL_CONSTEXPR_CXX14 bool operator<=(
       const string_view_bridge<string_viewT>& x,
-      const string_viewT& y) noexcept(noexcept(x._sv <= y)) {
-    return x._sv <= y;
+      const string_viewT& y) noexcept(noexcept(x.view() <= y)) {
+    return x.view() <= y;
   }
   friend JASL_CONSTEXPR_CXX14 bool operator>=(
       const string_view_bridge<string_viewT>& x,
-      const string_viewT& y) noexcept(noexcept(x._sv >= y)) {
-    return x._sv >= y;
+      const string_viewT& y) noexcept(noexcept(x.view() >= y)) {
+    return x.view() >= y;
   }
 
   friend JASL_CONSTEXPR_CXX14 bool operator==(
       const string_viewT& x,
       const string_view_bridge<string_viewT>& y) noexcept(noexcept(x ==
-                                                                   y._sv)) {
-    return x == y._sv;
+                                                                   y.view())) {
+    return x == y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator!=(
       const string_viewT& x,
       const string_view_bridge<string_viewT>& y) noexcept(noexcept(x !=
-                                                                   y._sv)) {
-    return x != y._sv;
+                                                                   y.view())) {
+    return x != y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator<(
       const string_viewT& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x < y._sv)) {
-    return x < y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x <
+                                                                   y.view())) {
+    return x < y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator>(
       const string_viewT& x,
-      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x > y._sv)) {
-    return x > y._sv;
+      const string_view_bridge<string_viewT>& y) noexcept(noexcept(x >
+                                                                   y.view())) {
+    return x > y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator<=(
       const string_viewT& x,
       const string_view_bridge<string_viewT>& y) noexcept(noexcept(x <=
-                                                                   y._sv)) {
-    return x <= y._sv;
+                                                                   y.view())) {
+    return x <= y.view();
   }
   friend JASL_CONSTEXPR_CXX14 bool operator>=(
       const string_viewT& x,
       const string_view_bridge<string_viewT>& y) noexcept(noexcept(x >=
-                                                                   y._sv)) {
-    return x >= y._sv;
+                                                                   y.view())) {
+    return x >= y.view();
   }
 
   friend std::basic_ostream<value_type, traits_type>& operator<<(
       std::basic_ostream<value_type, traits_type>& os,
       const string_view_bridge<string_viewT>& str) {
-    return os << str._sv;
+    return os << str.view();
   }
 
   friend struct ::std::hash<string_view_bridge>;
 };
 
+template <typename string_viewT>
+constexpr typename string_view_bridge<string_viewT>::size_type
+    string_view_bridge<string_viewT>::null_terminated_bit;
+
 }  // namespace inner
 }  // namespace jasl
 
@@ -574,8 +638,8 @@ namespace std {
 template <typename string_viewT>
 struct hash<jasl::inner::string_view_bridge<string_viewT>> {
   size_t operator()(jasl::inner::string_view_bridge<string_viewT> x) const
-      noexcept(noexcept(std::hash<string_viewT>{}(x._sv))) {
-    return std::hash<string_viewT>{}(x._sv);
+      noexcept(noexcept(std::hash<string_viewT>{}(x.view()))) {
+    return std::hash<string_viewT>{}(x.view());
   }
 };
 }  // namespace std
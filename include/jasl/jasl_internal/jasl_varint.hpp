@@ -0,0 +1,69 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace jasl {
+namespace inner {
+
+// LEB128 style: 7 bits per byte, the high bit is set on all but the last.
+
+constexpr size_t max_varint_size = (sizeof(size_t) * 8 + 6) / 7;
+
+inline void write_varint(std::vector<unsigned char>& out, size_t value) {
+  for (; value >= 0x80; value >>= 7)
+    out.push_back(static_cast<unsigned char>(value | 0x80));
+  out.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ * Writes value to out, which has room for max_varint_size bytes. Returns the
+ * number of the written bytes.
+ */
+inline size_t write_varint(unsigned char* out, size_t value) noexcept {
+  size_t size = 0;
+  for (; value >= 0x80; value >>= 7)
+    out[size++] = static_cast<unsigned char>(value | 0x80);
+  out[size++] = static_cast<unsigned char>(value);
+  return size;
+}
+
+inline size_t read_varint(const unsigned char*& p) noexcept {
+  size_t value = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    const unsigned char byte = *p++;
+    value |= static_cast<size_t>(byte & 0x7f) << shift;
+    if (byte < 0x80)
+      return value;
+  }
+}
+
+/**
+ * Reads a varint of untrusted input from [p, end). Returns false if it is
+ * truncated or doesn't fit in size_t.
+ */
+inline bool read_varint(const unsigned char*& p,
+                        const unsigned char* end,
+                        size_t& value) noexcept {
+  value = 0;
+  for (unsigned shift = 0; p != end && shift < sizeof(size_t) * 8;
+       shift += 7) {
+    const unsigned char byte = *p++;
+    const size_t bits = static_cast<size_t>(byte & 0x7f);
+    if (shift > 0 && (bits >> (sizeof(size_t) * 8 - shift)) != 0)
+      return false;
+    value |= bits << shift;
+    if (byte < 0x80)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace inner
+}  // namespace jasl
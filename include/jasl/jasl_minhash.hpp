@@ -0,0 +1,364 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_hash.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * Number of the equal elements of a and b.
+ */
+inline size_t minhash_count_equal(const uint32_t* a,
+                                  const uint32_t* b,
+                                  size_t size) noexcept {
+  size_t count = 0;
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  for (; i + 4 <= size; i += 4) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    count += popcount32(static_cast<uint32_t>(
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, y)))));
+  }
+#endif
+  for (const uint32_t* const end = a + size; a + i != end; ++i)
+    count += a[i] == b[i];
+  return count;
+}
+
+/**
+ * The 8 bits of a byte spread to the lowest bits of 8 bytes: adding them
+ * counts the bits of 8 positions at once.
+ */
+struct simhash_spread_table {
+  uint64_t values[256];
+
+  simhash_spread_table() noexcept {
+    for (unsigned byte = 0; byte < 256; ++byte) {
+      values[byte] = 0;
+      for (unsigned bit = 0; bit < 8; ++bit)
+        values[byte] |= uint64_t((byte >> bit) & 1) << (8 * bit);
+    }
+  }
+};
+
+inline const uint64_t* simhash_spread() noexcept {
+  static const simhash_spread_table table;
+  return table.values;
+}
+
+}  // namespace inner
+
+/**
+ * MinHash and SimHash of documents for near-duplicate detection. The
+ * shingles of a document are its substrings of shingle_size characters
+ * (or the whole document if it is shorter), each hashed once by
+ * MurmurHash3_x64_128.
+ *
+ * The MinHash signature uses one-permutation hashing: the hash of a shingle
+ * chooses one of the signature_size bins and competes for the minimum there,
+ * so a signature costs one hash per shingle instead of one per shingle and
+ * bin. The empty bins are filled by optimal densification (Shrivastava), so
+ * the ratio of the equal elements of two signatures estimates the Jaccard
+ * similarity of the shingle sets.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_minhash {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef std::vector<uint32_t> signature_type;
+
+ private:
+  size_t _signature_size;
+  size_t _shingle_size;
+
+ public:
+  /**
+   * Throws std::invalid_argument if signature_size isn't in [1, 2^32] or
+   * shingle_size is 0.
+   */
+  explicit basic_minhash(size_t signature_size = 128, size_t shingle_size = 5)
+      : _signature_size(signature_size), _shingle_size(shingle_size) {
+    if (signature_size == 0 ||
+        static_cast<uint64_t>(signature_size) > (uint64_t(1) << 32) ||
+        shingle_size == 0) {
+      JASL_THROW(std::invalid_argument(
+          "minhash: signature_size or shingle_size is out of range"));
+    }
+  }
+
+  size_t signature_size() const noexcept { return _signature_size; }
+  size_t shingle_size() const noexcept { return _shingle_size; }
+
+  signature_type signature(string_view_type document) const {
+    signature_type result(_signature_size);
+    signature(document, result.data());
+    return result;
+  }
+
+  /**
+   * Writes the signature of signature_size() elements to out.
+   */
+  void signature(string_view_type document, uint32_t* out) const {
+    const uint64_t bins = _signature_size;
+    std::vector<unsigned char> filled(_signature_size, 0);
+    std::fill(out, out + _signature_size, UINT32_MAX);
+    size_t filled_count = 0;
+    for_each_shingle(document, [&](const uint64_t hash[2]) {
+      const size_t bin = static_cast<size_t>(((hash[0] >> 32) * bins) >> 32);
+      const uint32_t value = static_cast<uint32_t>(hash[0]);
+      if (!filled[bin]) {
+        filled[bin] = 1;
+        ++filled_count;
+      }
+      out[bin] = std::min(out[bin], value);
+    });
+    // the signature of an empty document is all UINT32_MAX
+    if (filled_count == 0 || filled_count == _signature_size)
+      return;
+    for (size_t bin = 0; bin < _signature_size; ++bin) {
+      if (filled[bin])
+        continue;
+      // the sources only depend on the bin, so they are the same for every
+      // document
+      for (uint64_t attempt = 0;; ++attempt) {
+        const uint64_t h = inner::mix64((uint64_t(bin) << 32) + attempt);
+        const size_t source = static_cast<size_t>(((h >> 32) * bins) >> 32);
+        if (filled[source]) {
+          out[bin] = out[source];
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * 64 bit SimHash of the shingles: documents with similar shingles differ
+   * in few bits (see simhash_distance).
+   */
+  uint64_t simhash(string_view_type document) const {
+    const uint64_t* const spread = inner::simhash_spread();
+    // byte j of lanes[k] counts the bit 8 * k + j of up to 255 hashes
+    uint64_t lanes[8] = {0};
+    uint64_t counts[64] = {0};
+    uint64_t shingle_count = 0;
+    unsigned pending = 0;
+    const auto flush = [&] {
+      for (unsigned k = 0; k < 8; ++k) {
+        for (unsigned j = 0; j < 8; ++j)
+          counts[8 * k + j] += (lanes[k] >> (8 * j)) & 0xFF;
+        lanes[k] = 0;
+      }
+      pending = 0;
+    };
+    for_each_shingle(document, [&](const uint64_t hash[2]) {
+      for (unsigned k = 0; k < 8; ++k)
+        lanes[k] += spread[(hash[1] >> (8 * k)) & 0xFF];
+      ++shingle_count;
+      if (++pending == 255)
+        flush();
+    });
+    flush();
+    // a bit is set if it is set in the majority of the hashes
+    uint64_t result = 0;
+    for (unsigned bit = 0; bit < 64; ++bit) {
+      if (2 * counts[bit] > shingle_count)
+        result |= uint64_t(1) << bit;
+    }
+    return result;
+  }
+
+  /**
+   * The estimated Jaccard similarity of the shingles of two documents.
+   * Throws std::invalid_argument if the sizes of the signatures differ or
+   * they are empty (a signature has at least one element).
+   */
+  static double similarity(const signature_type& a, const signature_type& b) {
+    if (a.size() != b.size()) {
+      JASL_THROW(
+          std::invalid_argument("minhash: the signature sizes are different"));
+    }
+    if (a.empty())
+      JASL_THROW(std::invalid_argument("minhash: the signatures are empty"));
+    return static_cast<double>(
+               inner::minhash_count_equal(a.data(), b.data(), a.size())) /
+           static_cast<double>(a.size());
+  }
+
+  /**
+   * Number of the different bits of two SimHashes.
+   */
+  static unsigned simhash_distance(uint64_t a, uint64_t b) noexcept {
+    return inner::popcount64(a ^ b);
+  }
+
+ private:
+  template <typename FunctionT>
+  void for_each_shingle(string_view_type document, FunctionT&& fn) const {
+    uint64_t hash[2];
+    if (document.empty())
+      return;
+    const size_t size = std::min(_shingle_size, document.size());
+    for (size_t i = 0; i + size <= document.size(); ++i) {
+      inner::hash128(document.data() + i, size * sizeof(CharT), hash);
+      fn(hash);
+    }
+  }
+};
+
+/**
+ * Locality-sensitive hashing index of MinHash signatures: the signatures are
+ * cut into bands of rows_per_band elements, and documents which are equal
+ * in at least one band are candidates. Two documents of Jaccard similarity s
+ * become candidates with a probability of 1 - (1 - s^rows)^bands, which is an
+ * S-curve around threshold().
+ *
+ * query() verifies the candidates by their signatures, so the near-
+ * duplicates are found without comparing every pair of documents.
+ */
+class lsh_index {
+ public:
+  typedef std::vector<uint32_t> signature_type;
+
+ private:
+  size_t _band_count;
+  size_t _rows_per_band;
+  std::vector<uint32_t> _signatures;  // all of them, one after the other
+  // per band: hash of the band -> ids
+  std::vector<std::unordered_map<uint64_t, std::vector<size_t>>> _buckets;
+
+ public:
+  /**
+   * For signatures of band_count * rows_per_band elements. Throws
+   * std::invalid_argument if any of them is 0.
+   */
+  lsh_index(size_t band_count, size_t rows_per_band)
+      : _band_count(band_count),
+        _rows_per_band(rows_per_band),
+        _buckets(band_count) {
+    if (band_count == 0 || rows_per_band == 0) {
+      JASL_THROW(std::invalid_argument(
+          "lsh_index: band_count or rows_per_band is 0"));
+    }
+  }
+
+  size_t band_count() const noexcept { return _band_count; }
+  size_t rows_per_band() const noexcept { return _rows_per_band; }
+  size_t signature_size() const noexcept {
+    return _band_count * _rows_per_band;
+  }
+
+  /**
+   * Number of the signatures.
+   */
+  size_t size() const noexcept { return _signatures.size() / signature_size(); }
+
+  /**
+   * The similarity where the candidate probability rises the fastest:
+   * (1 / bands)^(1 / rows).
+   */
+  double threshold() const noexcept {
+    return std::pow(1 / static_cast<double>(_band_count),
+                    1 / static_cast<double>(_rows_per_band));
+  }
+
+  /**
+   * Adds a signature. Returns its id, which is size() before the insert.
+   * Throws std::invalid_argument if its size isn't signature_size().
+   */
+  size_t insert(const signature_type& signature) {
+    check(signature);
+    const size_t id = size();
+    _signatures.insert(_signatures.end(), signature.begin(), signature.end());
+    for (size_t band = 0; band < _band_count; ++band)
+      _buckets[band][band_hash(signature, band)].push_back(id);
+    return id;
+  }
+
+  /**
+   * The sorted ids of the signatures which are equal to signature in at
+   * least one band.
+   */
+  std::vector<size_t> candidates(const signature_type& signature) const {
+    check(signature);
+    std::vector<size_t> result;
+    for (size_t band = 0; band < _band_count; ++band) {
+      const auto it = _buckets[band].find(band_hash(signature, band));
+      if (it != _buckets[band].end())
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  /**
+   * The sorted ids of the candidates with an estimated similarity of at
+   * least min_similarity.
+   */
+  std::vector<size_t> query(const signature_type& signature,
+                            double min_similarity) const {
+    std::vector<size_t> result = candidates(signature);
+    const size_t n = signature_size();
+    const double needed = min_similarity * static_cast<double>(n);
+    result.erase(
+        std::remove_if(result.begin(), result.end(),
+                       [&](size_t id) {
+                         return static_cast<double>(inner::minhash_count_equal(
+                                    signature.data(),
+                                    _signatures.data() + id * n, n)) < needed;
+                       }),
+        result.end());
+    return result;
+  }
+
+  /**
+   * The signature of id.
+   */
+  signature_type signature(size_t id) const {
+    JASL_ASSERT(id < size(), "id < size()");
+    const auto first = _signatures.begin() +
+                       static_cast<std::ptrdiff_t>(id * signature_size());
+    return signature_type(
+        first, first + static_cast<std::ptrdiff_t>(signature_size()));
+  }
+
+ private:
+  void check(const signature_type& signature) const {
+    if (signature.size() != signature_size()) {
+      JASL_THROW(std::invalid_argument(
+          "lsh_index: the signature size is not band_count * rows_per_band"));
+    }
+  }
+
+  uint64_t band_hash(const signature_type& signature, size_t band) const {
+    uint64_t hash[2];
+    inner::hash128(signature.data() + band * _rows_per_band,
+                   _rows_per_band * sizeof(uint32_t), hash);
+    return hash[0];
+  }
+};
+
+typedef basic_minhash<char> minhash;
+
+}  // namespace jasl
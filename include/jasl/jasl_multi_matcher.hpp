@@ -0,0 +1,273 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+
+/**
+ * Finds every occurrence of a set of patterns in a single pass over the text
+ * (Aho-Corasick).
+ *
+ * The patterns are compiled into a complete DFA: one row of transitions for
+ * each state and one column for each character class. The characters which
+ * don't appear in any pattern share one class, so the table is as narrow as
+ * the alphabet of the patterns. The transitions hold the offset of the next
+ * row and a flag in the top bit if the next state has output, so the scan
+ * loop is a table lookup and a test per character.
+ *
+ * The patterns are not copied, only their lengths are stored, so the
+ * jasl::static_string-s, jasl::string-s and views can be destroyed after the
+ * construction.
+ *
+ * The matches are reported ordered by their end position. Matches with the
+ * same end are reported from the longest to the shortest, the identical
+ * patterns in construction order.
+ *
+ * Only single byte characters with the standard traits are supported.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_multi_matcher {
+  static_assert(inner::is_byte_char<CharT, Traits>::value,
+                "Only single byte characters are supported.");
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+  struct match {
+    size_t pattern;   ///< index of the pattern in the construction order
+    size_t position;  ///< offset of the first character in the text/stream
+  };
+
+  class scanner;
+
+ private:
+  constexpr static uint32_t output_flag = static_cast<uint32_t>(1) << 31;
+  constexpr static uint32_t row_mask = output_flag - 1;
+
+  uint16_t _class_of[256];
+  uint32_t _class_count;
+  // state_count * _class_count transitions: row offset | output_flag
+  std::vector<uint32_t> _delta;
+  // The own patterns of state s: _outputs[_output_begin[s].._output_begin[s+1])
+  std::vector<uint32_t> _output_begin;
+  std::vector<uint32_t> _outputs;
+  // The longest proper suffix state which has own patterns, 0 if there is none.
+  std::vector<uint32_t> _output_link;
+  std::vector<size_t> _lengths;
+
+ public:
+  basic_multi_matcher(
+      std::initializer_list<basic_static_string<CharT, Traits>> patterns)
+      : basic_multi_matcher(patterns.begin(), patterns.end()) {}
+
+  /**
+   * The elements of the range have to be convertible to string_view_type.
+   * Throws std::invalid_argument if a pattern is empty and
+   * std::length_error if the automaton would be too big.
+   */
+  template <typename InputIt>
+  basic_multi_matcher(InputIt first, InputIt last) : _class_count(0) {
+    std::vector<string_view_type> patterns;
+    for (; first != last; ++first)
+      patterns.push_back(static_cast<string_view_type>(*first));
+    build(patterns);
+  }
+
+  /**
+   * Number of patterns.
+   */
+  size_t size() const noexcept { return _lengths.size(); }
+
+  size_t pattern_length(size_t pattern) const noexcept {
+    JASL_ASSERT(pattern < _lengths.size(), "pattern < size()");
+    return _lengths[pattern];
+  }
+
+  /**
+   * Number of states of the automaton (the root included).
+   */
+  size_t state_count() const noexcept { return _output_link.size(); }
+
+  /**
+   * Calls on_match(const match&) for every occurrence.
+   */
+  template <typename F>
+  void find_all(string_view_type text, F&& on_match) const {
+    scanner s(*this);
+    s.feed(text, on_match);
+  }
+
+  std::vector<match> find_all(string_view_type text) const {
+    std::vector<match> result;
+    find_all(text, [&result](const match& m) { result.push_back(m); });
+    return result;
+  }
+
+ private:
+  void build(const std::vector<string_view_type>& patterns) {
+    bool used[256] = {};
+    size_t total_length = 0;
+    for (const string_view_type& p : patterns) {
+      if (p.empty())
+        JASL_THROW(std::invalid_argument("multi_matcher: empty pattern"));
+      for (CharT c : p)
+        used[static_cast<unsigned char>(c)] = true;
+      total_length += p.size();
+    }
+    _class_count = 1;
+    for (size_t c = 0; c < 256; ++c)
+      _class_of[c] = used[c] ? static_cast<uint16_t>(_class_count++) : 0;
+    const size_t K = _class_count;
+    if (patterns.size() > row_mask || total_length >= row_mask / K)
+      JASL_THROW(std::length_error("multi_matcher: too many patterns"));
+
+    // trie: 0 is the root and also "no edge", nothing goes back to the root
+    _delta.assign(K, 0);
+    std::vector<uint32_t> terminal(patterns.size());
+    uint32_t state_count = 1;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      size_t row = 0;
+      for (CharT c : patterns[i]) {
+        const size_t idx = row + _class_of[static_cast<unsigned char>(c)];
+        if (_delta[idx] == 0) {
+          _delta[idx] = state_count++ * static_cast<uint32_t>(K);
+          _delta.resize(_delta.size() + K, 0);
+        }
+        row = _delta[idx];
+      }
+      terminal[i] = static_cast<uint32_t>(row / K);
+      _lengths.push_back(patterns[i].size());
+    }
+
+    _output_begin.assign(state_count + 1, 0);
+    for (uint32_t s : terminal)
+      ++_output_begin[s + 1];
+    for (size_t s = 0; s < state_count; ++s)
+      _output_begin[s + 1] += _output_begin[s];
+    _outputs.resize(patterns.size());
+    {
+      std::vector<uint32_t> next(_output_begin.begin(),
+                                 _output_begin.end() - 1);
+      for (size_t i = 0; i < terminal.size(); ++i)
+        _outputs[next[terminal[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    // Breadth-first the failure states are already complete rows, so the
+    // missing edges are copied from them.
+    _output_link.assign(state_count, 0);
+    std::vector<uint32_t> fail(state_count, 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(state_count);
+    queue.push_back(0);
+    for (size_t qi = 0; qi < queue.size(); ++qi) {
+      const uint32_t s = queue[qi];
+      const size_t row = s * K;
+      const size_t fail_row = fail[s] * K;
+      for (size_t c = 0; c < K; ++c) {
+        const uint32_t edge = _delta[row + c];
+        if (edge == 0) {
+          _delta[row + c] = _delta[fail_row + c];
+          continue;
+        }
+        const uint32_t t = static_cast<uint32_t>(edge / K);
+        const uint32_t f =
+            s == 0 ? 0
+                   : static_cast<uint32_t>((_delta[fail_row + c] & row_mask) /
+                                           K);
+        fail[t] = f;
+        _output_link[t] = has_own_output(f) ? f : _output_link[f];
+        if (has_own_output(t) || _output_link[t] != 0)
+          _delta[row + c] = edge | output_flag;
+        queue.push_back(t);
+      }
+    }
+  }
+
+  bool has_own_output(uint32_t s) const noexcept {
+    return _output_begin[s] != _output_begin[s + 1];
+  }
+
+  template <typename F>
+  void report(uint32_t row, size_t end, F& on_match) const {
+    for (uint32_t s = row / _class_count; s != 0; s = _output_link[s]) {
+      for (uint32_t i = _output_begin[s]; i < _output_begin[s + 1]; ++i) {
+        const size_t p = _outputs[i];
+        on_match(match{p, end - _lengths[p]});
+      }
+    }
+  }
+};
+
+/**
+ * Scans a text which arrives in chunks. The state of the automaton is kept
+ * between the feed calls, so the occurrences spanning chunk boundaries are
+ * found too. The positions are relative to the beginning of the stream.
+ *
+ * The matcher has to outlive the scanner.
+ */
+template <typename CharT, typename Traits>
+class basic_multi_matcher<CharT, Traits>::scanner {
+  const basic_multi_matcher* _matcher;
+  uint32_t _row;
+  size_t _offset;
+
+ public:
+  explicit scanner(const basic_multi_matcher& matcher) noexcept
+      : _matcher(&matcher), _row(0), _offset(0) {}
+
+  /**
+   * Calls on_match(const match&) for every occurrence which ends in the chunk.
+   */
+  template <typename F>
+  void feed(string_view_type chunk, F&& on_match) {
+    const uint32_t* delta = _matcher->_delta.data();
+    const uint16_t* class_of = _matcher->_class_of;
+    const unsigned char* p =
+        reinterpret_cast<const unsigned char*>(chunk.data());
+    const size_t size = chunk.size();
+    uint32_t row = _row;
+    for (size_t i = 0; i < size; ++i) {
+      const uint32_t next = delta[row + class_of[p[i]]];
+      row = next & row_mask;
+      if (next & output_flag)
+        _matcher->report(row, _offset + i + 1, on_match);
+    }
+    _row = row;
+    _offset += size;
+  }
+
+  /**
+   * Forgets the partial matches and restarts the positions from 0.
+   */
+  void reset() noexcept {
+    _row = 0;
+    _offset = 0;
+  }
+
+  /**
+   * Number of characters fed since the construction or the last reset.
+   */
+  size_t offset() const noexcept { return _offset; }
+};
+
+typedef basic_multi_matcher<char> multi_matcher;
+
+}  // namespace jasl
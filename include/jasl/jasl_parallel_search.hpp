@@ -0,0 +1,241 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_byte_find.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_string_view_bridge.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * The haystack is cut into chunks by the possible starting positions of the
+ * needle: a chunk owns the occurrences which start in it, and it is searched
+ * together with the first needle_size - 1 characters of the next one. So an
+ * occurrence crossing a chunk boundary is found exactly once.
+ */
+template <typename CharT, typename Traits>
+class search_chunks {
+  const CharT* _ptr;
+  size_t _size;
+  const CharT* _needle;
+  size_t _needle_size;
+  size_t _positions;  // the number of the possible starting positions
+
+ public:
+  // Small enough to balance the load and to stop soon after a find.
+  static constexpr size_t chunk_size = (size_t(1) << 20) / sizeof(CharT);
+
+  search_chunks(basic_string_view<CharT, Traits> haystack,
+                basic_string_view<CharT, Traits> needle) noexcept
+      : _ptr(haystack.data()),
+        _size(haystack.size()),
+        _needle(needle.data()),
+        _needle_size(needle.size()),
+        _positions(needle.size() <= haystack.size()
+                       ? haystack.size() - needle.size() + 1
+                       : 0) {}
+
+  size_t count() const noexcept {
+    return (_positions + chunk_size - 1) / chunk_size;
+  }
+
+  /**
+   * Calls on_match(position) for the occurrences of the i-th chunk in
+   * increasing order while it returns true.
+   */
+  template <typename F>
+  void for_each(size_t i, F&& on_match) const {
+    size_t pos = i * chunk_size;
+    const size_t end = std::min(_positions, pos + chunk_size);
+    const size_t limit = end + _needle_size - 1;
+    while (pos < end) {
+      const size_t found = find_substring<CharT, Traits>(
+          _ptr + pos, limit - pos, _needle, _needle_size);
+      if (found == static_cast<size_t>(-1) || !on_match(pos + found))
+        return;
+      pos += found + 1;
+    }
+  }
+};
+
+template <typename CharT, typename Traits>
+size_t parallel_find(basic_string_view<CharT, Traits> haystack,
+                     basic_string_view<CharT, Traits> needle,
+                     thread_pool& pool) {
+  if (needle.empty())
+    return 0;
+  const search_chunks<CharT, Traits> chunks(haystack, needle);
+  const size_t count = chunks.count();
+  if (count <= 1 || pool.size() == 1) {
+    return find_substring<CharT, Traits>(haystack.data(), haystack.size(),
+                                         needle.data(), needle.size());
+  }
+  // The chunks after the first one with an occurrence are skipped.
+  std::atomic<size_t> first(count);
+  std::vector<size_t> found(count, static_cast<size_t>(-1));
+  pool.run(count, [&](size_t i) {
+    if (i > first.load(std::memory_order_relaxed))
+      return;
+    chunks.for_each(i, [&](size_t pos) {
+      found[i] = pos;
+      return false;
+    });
+    if (found[i] == static_cast<size_t>(-1))
+      return;
+    size_t current = first.load();
+    while (i < current && !first.compare_exchange_weak(current, i)) {
+    }
+  });
+  const size_t i = first.load();
+  return i == count ? static_cast<size_t>(-1) : found[i];
+}
+
+template <typename CharT, typename Traits>
+size_t parallel_count(basic_string_view<CharT, Traits> haystack,
+                      basic_string_view<CharT, Traits> needle,
+                      thread_pool& pool) {
+  if (needle.empty())
+    JASL_THROW(std::invalid_argument("parallel_count: empty needle"));
+  const search_chunks<CharT, Traits> chunks(haystack, needle);
+  std::atomic<size_t> total(0);
+  auto count_chunk = [&](size_t i) {
+    size_t n = 0;
+    chunks.for_each(i, [&](size_t) {
+      ++n;
+      return true;
+    });
+    total.fetch_add(n, std::memory_order_relaxed);
+  };
+  if (pool.size() == 1) {
+    for (size_t i = 0; i < chunks.count(); ++i)
+      count_chunk(i);
+  } else {
+    pool.run(chunks.count(), count_chunk);
+  }
+  return total.load();
+}
+
+template <typename CharT, typename Traits>
+std::vector<size_t> parallel_find_all(basic_string_view<CharT, Traits> haystack,
+                                      basic_string_view<CharT, Traits> needle,
+                                      thread_pool& pool) {
+  if (needle.empty())
+    JASL_THROW(std::invalid_argument("parallel_find_all: empty needle"));
+  const search_chunks<CharT, Traits> chunks(haystack, needle);
+  std::vector<std::vector<size_t>> found(chunks.count());
+  auto find_chunk = [&](size_t i) {
+    chunks.for_each(i, [&](size_t pos) {
+      found[i].push_back(pos);
+      return true;
+    });
+  };
+  if (pool.size() == 1) {
+    for (size_t i = 0; i < chunks.count(); ++i)
+      find_chunk(i);
+  } else {
+    pool.run(chunks.count(), find_chunk);
+  }
+  size_t total = 0;
+  for (const std::vector<size_t>& positions : found)
+    total += positions.size();
+  std::vector<size_t> result;
+  result.reserve(total);
+  for (const std::vector<size_t>& positions : found)
+    result.insert(result.end(), positions.begin(), positions.end());
+  return result;
+}
+
+}  // namespace inner
+
+/**
+ * Index of the first occurrence of the needle in the haystack or npos (0 for
+ * an empty needle), like basic_string_view::find.
+ *
+ * The haystack is cut into chunks of 1 MiB which overlap by the length of the
+ * needle, and they are searched by the threads of the pool in increasing
+ * order. The chunks after the first one with an occurrence are skipped. A
+ * haystack of a single chunk is searched on the calling thread.
+ */
+template <typename CharT, typename Traits>
+size_t parallel_find(
+    basic_string_view<CharT, Traits> haystack,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type needle,
+    thread_pool& pool = default_thread_pool()) {
+  return inner::parallel_find(haystack, needle, pool);
+}
+
+template <typename CharT, typename Traits>
+size_t parallel_find(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& haystack,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type needle,
+    thread_pool& pool = default_thread_pool()) {
+  return inner::parallel_find(
+      static_cast<basic_string_view<CharT, Traits>>(haystack), needle, pool);
+}
+
+/**
+ * The number of the occurrences of the needle in the haystack, overlapping
+ * ones included ("aa" occurs 3 times in "aaaa"). Chunked like
+ * jasl::parallel_find.
+ *
+ * @throw std::invalid_argument if the needle is empty.
+ */
+template <typename CharT, typename Traits>
+size_t parallel_count(
+    basic_string_view<CharT, Traits> haystack,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type needle,
+    thread_pool& pool = default_thread_pool()) {
+  return inner::parallel_count(haystack, needle, pool);
+}
+
+template <typename CharT, typename Traits>
+size_t parallel_count(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& haystack,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type needle,
+    thread_pool& pool = default_thread_pool()) {
+  return inner::parallel_count(
+      static_cast<basic_string_view<CharT, Traits>>(haystack), needle, pool);
+}
+
+/**
+ * The indices of the occurrences of the needle in the haystack in increasing
+ * order, overlapping ones included. The chunks collect their occurrences
+ * separately, then they are concatenated.
+ *
+ * @throw std::invalid_argument if the needle is empty.
+ */
+template <typename CharT, typename Traits>
+std::vector<size_t> parallel_find_all(
+    basic_string_view<CharT, Traits> haystack,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type needle,
+    thread_pool& pool = default_thread_pool()) {
+  return inner::parallel_find_all(haystack, needle, pool);
+}
+
+template <typename CharT, typename Traits>
+std::vector<size_t> parallel_find_all(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& haystack,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type needle,
+    thread_pool& pool = default_thread_pool()) {
+  return inner::parallel_find_all(
+      static_cast<basic_string_view<CharT, Traits>>(haystack), needle, pool);
+}
+
+}  // namespace jasl
@@ -0,0 +1,740 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * Adaptive radix tree (Leis et al.): the inner nodes branch on one byte and
+ * grow from 4 to 16, 48 and 256 children. node4 and node16 hold their keys
+ * sorted, node16 is searched with one SSE2 comparison; node48 maps the bytes
+ * to the slots of its children and node256 is indexed directly.
+ *
+ * The paths without branches are compressed into the prefix of the next
+ * inner node. The prefix isn't copied: it points into the key of a leaf of
+ * the subtree, which has the same bytes there. The leaves are neither moved
+ * nor freed before the tree, so the pointer stays valid when the node is
+ * split. The key which ends right after the prefix of a node is held by its
+ * terminal leaf; the other keys continue in the children.
+ */
+
+enum class radix_node_type : uint8_t { leaf, node4, node16, node48, node256 };
+
+struct radix_node {
+  radix_node_type type;
+
+  explicit radix_node(radix_node_type t) noexcept : type(t) {}
+};
+
+struct radix_leaf : radix_node {
+  const unsigned char* key_data;
+  size_t key_size;
+
+  radix_leaf(const unsigned char* data, size_t size) noexcept
+      : radix_node(radix_node_type::leaf), key_data(data), key_size(size) {}
+};
+
+struct radix_inner : radix_node {
+  uint32_t count;
+  size_t prefix_size;
+  const unsigned char* prefix;
+  radix_leaf* terminal;
+
+  explicit radix_inner(radix_node_type t) noexcept
+      : radix_node(t),
+        count(0),
+        prefix_size(0),
+        prefix(nullptr),
+        terminal(nullptr) {}
+};
+
+struct radix_node4 : radix_inner {
+  unsigned char keys[4];
+  radix_node* children[4];
+
+  radix_node4() noexcept : radix_inner(radix_node_type::node4) {}
+};
+
+struct radix_node16 : radix_inner {
+  unsigned char keys[16];
+  radix_node* children[16];
+
+  // the unused keys are loaded by the SIMD search too
+  radix_node16() noexcept : radix_inner(radix_node_type::node16) {
+    std::memset(keys, 0, sizeof(keys));
+  }
+};
+
+struct radix_node48 : radix_inner {
+  unsigned char index[256];  // slot + 1 of the child, 0 if there is none
+  radix_node* children[48];
+
+  radix_node48() noexcept : radix_inner(radix_node_type::node48) {
+    std::memset(index, 0, sizeof(index));
+  }
+};
+
+struct radix_node256 : radix_inner {
+  radix_node* children[256];
+
+  radix_node256() noexcept : radix_inner(radix_node_type::node256) {
+    for (radix_node*& child : children)
+      child = nullptr;
+  }
+};
+
+inline bool radix_equal(const unsigned char* a,
+                        const unsigned char* b,
+                        size_t size) noexcept {
+  return size == 0 || std::memcmp(a, b, size) == 0;
+}
+
+inline size_t radix_common_prefix(const unsigned char* a,
+                                  const unsigned char* b,
+                                  size_t size) noexcept {
+  size_t i = 0;
+  while (i < size && a[i] == b[i])
+    ++i;
+  return i;
+}
+
+/**
+ * The slot of the child of byte c, nullptr if there is none.
+ */
+inline radix_node** radix_find_child(radix_inner* n, unsigned char c) noexcept {
+  switch (n->type) {
+    case radix_node_type::node4: {
+      radix_node4* n4 = static_cast<radix_node4*>(n);
+      for (uint32_t i = 0; i < n4->count; ++i) {
+        if (n4->keys[i] == c)
+          return &n4->children[i];
+      }
+      return nullptr;
+    }
+    case radix_node_type::node16: {
+      radix_node16* n16 = static_cast<radix_node16*>(n);
+#if JASL_INNER_SSE2
+      const __m128i eq = _mm_cmpeq_epi8(
+          _mm_set1_epi8(static_cast<char>(c)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(n16->keys)));
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq)) &
+                            ((static_cast<uint32_t>(1) << n16->count) - 1);
+      return mask != 0 ? &n16->children[count_trailing_zeros(mask)] : nullptr;
+#else
+      for (uint32_t i = 0; i < n16->count; ++i) {
+        if (n16->keys[i] == c)
+          return &n16->children[i];
+      }
+      return nullptr;
+#endif
+    }
+    case radix_node_type::node48: {
+      radix_node48* n48 = static_cast<radix_node48*>(n);
+      return n48->index[c] != 0 ? &n48->children[n48->index[c] - 1] : nullptr;
+    }
+    default: {
+      radix_node256* n256 = static_cast<radix_node256*>(n);
+      return n256->children[c] != nullptr ? &n256->children[c] : nullptr;
+    }
+  }
+}
+
+/**
+ * The first child from position i in byte order, nullptr after the last one;
+ * i is moved to the position of the child. The position is the slot in node4
+ * and node16 and the byte in node48 and node256.
+ */
+inline radix_node* radix_next_child(const radix_inner* n,
+                                    uint32_t& i) noexcept {
+  switch (n->type) {
+    case radix_node_type::node4:
+      return i < n->count ? static_cast<const radix_node4*>(n)->children[i]
+                          : nullptr;
+    case radix_node_type::node16:
+      return i < n->count ? static_cast<const radix_node16*>(n)->children[i]
+                          : nullptr;
+    case radix_node_type::node48: {
+      const radix_node48* n48 = static_cast<const radix_node48*>(n);
+      for (; i < 256; ++i) {
+        if (n48->index[i] != 0)
+          return n48->children[n48->index[i] - 1];
+      }
+      return nullptr;
+    }
+    default: {
+      const radix_node256* n256 = static_cast<const radix_node256*>(n);
+      for (; i < 256; ++i) {
+        if (n256->children[i] != nullptr)
+          return n256->children[i];
+      }
+      return nullptr;
+    }
+  }
+}
+
+template <typename NodeT>
+void radix_insert_sorted(NodeT* n,
+                         unsigned char c,
+                         radix_node* child) noexcept {
+  uint32_t i = n->count;
+  for (; i > 0 && n->keys[i - 1] > c; --i) {
+    n->keys[i] = n->keys[i - 1];
+    n->children[i] = n->children[i - 1];
+  }
+  n->keys[i] = c;
+  n->children[i] = child;
+  ++n->count;
+}
+
+inline void radix_copy_header(radix_inner* to,
+                              const radix_inner* from) noexcept {
+  to->count = from->count;
+  to->prefix_size = from->prefix_size;
+  to->prefix = from->prefix;
+  to->terminal = from->terminal;
+}
+
+inline void radix_delete_inner(radix_inner* n) noexcept {
+  switch (n->type) {
+    case radix_node_type::node4:
+      delete static_cast<radix_node4*>(n);
+      break;
+    case radix_node_type::node16:
+      delete static_cast<radix_node16*>(n);
+      break;
+    case radix_node_type::node48:
+      delete static_cast<radix_node48*>(n);
+      break;
+    default:
+      delete static_cast<radix_node256*>(n);
+      break;
+  }
+}
+
+inline uint32_t radix_capacity(radix_node_type type) noexcept {
+  switch (type) {
+    case radix_node_type::node4:
+      return 4;
+    case radix_node_type::node16:
+      return 16;
+    case radix_node_type::node48:
+      return 48;
+    default:
+      return 256;
+  }
+}
+
+/**
+ * Replaces the full node n by the next size; n is freed.
+ */
+inline radix_inner* radix_grow(radix_inner* n) {
+  switch (n->type) {
+    case radix_node_type::node4: {
+      const radix_node4* n4 = static_cast<const radix_node4*>(n);
+      radix_node16* grown = new radix_node16();
+      radix_copy_header(grown, n4);
+      std::memcpy(grown->keys, n4->keys, sizeof(n4->keys));
+      std::memcpy(grown->children, n4->children, sizeof(n4->children));
+      delete n4;
+      return grown;
+    }
+    case radix_node_type::node16: {
+      const radix_node16* n16 = static_cast<const radix_node16*>(n);
+      radix_node48* grown = new radix_node48();
+      radix_copy_header(grown, n16);
+      for (uint32_t i = 0; i < 16; ++i) {
+        grown->index[n16->keys[i]] = static_cast<unsigned char>(i + 1);
+        grown->children[i] = n16->children[i];
+      }
+      delete n16;
+      return grown;
+    }
+    default: {
+      JASL_ASSERT(n->type == radix_node_type::node48, "node48 expected");
+      const radix_node48* n48 = static_cast<const radix_node48*>(n);
+      radix_node256* grown = new radix_node256();
+      radix_copy_header(grown, n48);
+      for (uint32_t c = 0; c < 256; ++c) {
+        if (n48->index[c] != 0)
+          grown->children[c] = n48->children[n48->index[c] - 1];
+      }
+      delete n48;
+      return grown;
+    }
+  }
+}
+
+/**
+ * Adds the child of byte c, which n doesn't have yet. Returns the node which
+ * replaces n: n is grown (and freed) if it is full.
+ */
+inline radix_inner* radix_add_child(radix_inner* n,
+                                    unsigned char c,
+                                    radix_node* child) {
+  if (n->count == radix_capacity(n->type))
+    n = radix_grow(n);
+  switch (n->type) {
+    case radix_node_type::node4:
+      radix_insert_sorted(static_cast<radix_node4*>(n), c, child);
+      break;
+    case radix_node_type::node16:
+      radix_insert_sorted(static_cast<radix_node16*>(n), c, child);
+      break;
+    case radix_node_type::node48: {
+      radix_node48* n48 = static_cast<radix_node48*>(n);
+      n48->children[n48->count] = child;
+      n48->index[c] = static_cast<unsigned char>(++n48->count);
+      break;
+    }
+    default:
+      static_cast<radix_node256*>(n)->children[c] = child;
+      ++n->count;
+      break;
+  }
+  return n;
+}
+
+/**
+ * Hangs leaf on the new node n (which has room for it), whose prefix ends at
+ * depth.
+ */
+inline void radix_attach(radix_node4* n,
+                         radix_leaf* leaf,
+                         size_t depth) noexcept {
+  if (leaf->key_size == depth)
+    n->terminal = leaf;
+  else
+    radix_insert_sorted(n, leaf->key_data[depth], leaf);
+}
+
+/**
+ * The node which replaces the leaf reached at depth when a different key
+ * arrives there.
+ */
+inline radix_inner* radix_split_leaf(radix_leaf* leaf,
+                                     radix_leaf* added,
+                                     size_t depth) {
+  radix_node4* n = new radix_node4();
+  n->prefix = leaf->key_data + depth;
+  n->prefix_size = radix_common_prefix(
+      leaf->key_data + depth, added->key_data + depth,
+      std::min(leaf->key_size, added->key_size) - depth);
+  radix_attach(n, leaf, depth + n->prefix_size);
+  radix_attach(n, added, depth + n->prefix_size);
+  return n;
+}
+
+/**
+ * The node which replaces n when the key of added (reached n at depth)
+ * differs from the prefix of n at common.
+ */
+inline radix_inner* radix_split_prefix(radix_inner* n,
+                                       size_t common,
+                                       radix_leaf* added,
+                                       size_t depth) {
+  radix_node4* split = new radix_node4();
+  split->prefix = n->prefix;
+  split->prefix_size = common;
+  const unsigned char c = n->prefix[common];
+  n->prefix += common + 1;
+  n->prefix_size -= common + 1;
+  radix_insert_sorted(split, c, n);
+  radix_attach(split, added, depth + common);
+  return split;
+}
+
+}  // namespace inner
+
+/**
+ * Map from strings to T for exact, longest prefix and prefix range lookups
+ * (adaptive radix tree with path compression).
+ *
+ * A lookup walks down one node per distinct branching byte of the key
+ * instead of comparing it with the keys one by one, so a longest prefix
+ * match (e.g. routing of URL paths) costs about the same for ten or ten
+ * thousand keys. The iteration is in the lexicographic order of the keys.
+ *
+ * The jasl::static_string keys are not copied, the tree refers to their
+ * characters; the other keys are copied into the leaves. The entries have
+ * stable addresses until the tree is destroyed or cleared. Removal isn't
+ * supported.
+ *
+ * Only single byte characters with the standard traits are supported.
+ */
+template <typename T,
+          typename CharT = char,
+          typename Traits = std::char_traits<CharT>>
+class basic_radix_tree {
+  static_assert(inner::is_byte_char<CharT, Traits>::value,
+                "Only single byte characters are supported.");
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  typedef basic_static_string<CharT, Traits> static_string_type;
+  typedef T mapped_type;
+
+  class entry : public inner::radix_leaf {
+    friend class basic_radix_tree;
+
+    std::unique_ptr<unsigned char[]> _owned;  // copy of the non-static key
+    T _value;
+
+    entry(const unsigned char* data, size_t size, T&& value)
+        : inner::radix_leaf(data, size), _value(std::move(value)) {}
+
+   public:
+    string_view_type key() const noexcept {
+      return string_view_type(reinterpret_cast<const CharT*>(key_data),
+                              key_size);
+    }
+
+    T& value() noexcept { return _value; }
+    const T& value() const noexcept { return _value; }
+  };
+
+ private:
+  inner::radix_node* _root;
+  size_t _size;
+
+ public:
+  basic_radix_tree() noexcept : _root(nullptr), _size(0) {}
+
+  basic_radix_tree(const basic_radix_tree&) = delete;
+  basic_radix_tree& operator=(const basic_radix_tree&) = delete;
+
+  basic_radix_tree(basic_radix_tree&& other) noexcept
+      : _root(other._root), _size(other._size) {
+    other._root = nullptr;
+    other._size = 0;
+  }
+
+  basic_radix_tree& operator=(basic_radix_tree&& other) noexcept {
+    if (this != &other) {
+      clear();
+      std::swap(_root, other._root);
+      std::swap(_size, other._size);
+    }
+    return *this;
+  }
+
+  ~basic_radix_tree() { clear(); }
+
+  size_t size() const noexcept { return _size; }
+  bool empty() const noexcept { return _size == 0; }
+
+  void clear() noexcept {
+    destroy(_root);
+    _root = nullptr;
+    _size = 0;
+  }
+
+  /**
+   * Inserts the key or assigns the value of the existing one. Returns true
+   * if the key was new. The characters of key are not copied, they have to
+   * outlive the tree.
+   */
+  bool insert_or_assign(const static_string_type& key, T value) {
+    return insert(reinterpret_cast<const unsigned char*>(key.data()),
+                  key.size(), false, value);
+  }
+
+  template <size_t N>
+  bool insert_or_assign(const CharT (&key)[N], T value) {
+    return insert_or_assign(static_string_type(key), std::move(value));
+  }
+
+  /**
+   * Inserts a copy of the key or assigns the value of the existing one.
+   * Returns true if the key was new.
+   */
+  bool insert_or_assign(string_view_type key, T value) {
+    return insert(reinterpret_cast<const unsigned char*>(key.data()),
+                  key.size(), true, value);
+  }
+
+  /**
+   * The entry of key, nullptr if there is none.
+   */
+  entry* find(string_view_type key) noexcept { return find_entry(key); }
+  const entry* find(string_view_type key) const noexcept {
+    return find_entry(key);
+  }
+
+  /**
+   * The entry of the longest key which is a prefix of str (or equal to it),
+   * nullptr if there is none.
+   */
+  entry* longest_prefix(string_view_type str) noexcept {
+    return longest_prefix_entry(str);
+  }
+  const entry* longest_prefix(string_view_type str) const noexcept {
+    return longest_prefix_entry(str);
+  }
+
+  /**
+   * Calls f(entry&) for every entry in the order of the keys.
+   */
+  template <typename F>
+  void for_each(F&& f) {
+    if (_root != nullptr)
+      walk<entry>(_root, f);
+  }
+
+  template <typename F>
+  void for_each(F&& f) const {
+    if (_root != nullptr)
+      walk<const entry>(_root, f);
+  }
+
+  /**
+   * Calls f(entry&) for every entry whose key starts with prefix, in the
+   * order of the keys.
+   */
+  template <typename F>
+  void for_each_prefixed(string_view_type prefix, F&& f) {
+    inner::radix_node* n = prefixed_subtree(prefix);
+    if (n != nullptr)
+      walk<entry>(n, f);
+  }
+
+  template <typename F>
+  void for_each_prefixed(string_view_type prefix, F&& f) const {
+    inner::radix_node* n = prefixed_subtree(prefix);
+    if (n != nullptr)
+      walk<const entry>(n, f);
+  }
+
+ private:
+  static void destroy(inner::radix_node* n) noexcept {
+    if (n == nullptr)
+      return;
+    if (n->type == inner::radix_node_type::leaf) {
+      delete static_cast<entry*>(n);
+      return;
+    }
+    inner::radix_inner* in = static_cast<inner::radix_inner*>(n);
+    destroy(in->terminal);
+    for (uint32_t i = 0;; ++i) {
+      inner::radix_node* const child = inner::radix_next_child(in, i);
+      if (child == nullptr)
+        break;
+      destroy(child);
+    }
+    inner::radix_delete_inner(in);
+  }
+
+  template <typename EntryT, typename F>
+  static void walk(inner::radix_node* n, F& f) {
+    if (n->type == inner::radix_node_type::leaf) {
+      f(static_cast<EntryT&>(*static_cast<entry*>(n)));
+      return;
+    }
+    const inner::radix_inner* in = static_cast<const inner::radix_inner*>(n);
+    if (in->terminal != nullptr)
+      f(static_cast<EntryT&>(*static_cast<entry*>(in->terminal)));
+    for (uint32_t i = 0;; ++i) {
+      inner::radix_node* const child = inner::radix_next_child(in, i);
+      if (child == nullptr)
+        break;
+      walk<EntryT>(child, f);
+    }
+  }
+
+  static entry* new_entry(const unsigned char* data,
+                          size_t size,
+                          bool copy,
+                          T& value) {
+    if (!copy)
+      return new entry(data, size, std::move(value));
+    std::unique_ptr<unsigned char[]> owned(new unsigned char[size]);
+    if (size != 0)
+      std::memcpy(owned.get(), data, size);
+    entry* e = new entry(owned.get(), size, std::move(value));
+    e->_owned = std::move(owned);
+    return e;
+  }
+
+  bool insert(const unsigned char* key, size_t size, bool copy, T& value) {
+    inner::radix_node** ref = &_root;
+    size_t depth = 0;
+    for (;;) {
+      inner::radix_node* const n = *ref;
+      if (n == nullptr) {
+        *ref = new_entry(key, size, copy, value);
+        ++_size;
+        return true;
+      }
+      if (n->type == inner::radix_node_type::leaf) {
+        entry* const e = static_cast<entry*>(n);
+        if (e->key_size == size &&
+            inner::radix_equal(e->key_data + depth, key + depth,
+                               size - depth)) {
+          e->_value = std::move(value);
+          return false;
+        }
+        std::unique_ptr<entry> added(new_entry(key, size, copy, value));
+        *ref = inner::radix_split_leaf(e, added.get(), depth);
+        added.release();
+        ++_size;
+        return true;
+      }
+      inner::radix_inner* const in = static_cast<inner::radix_inner*>(n);
+      const size_t common = inner::radix_common_prefix(
+          in->prefix, key + depth, std::min(in->prefix_size, size - depth));
+      if (common < in->prefix_size) {
+        std::unique_ptr<entry> added(new_entry(key, size, copy, value));
+        *ref = inner::radix_split_prefix(in, common, added.get(), depth);
+        added.release();
+        ++_size;
+        return true;
+      }
+      depth += in->prefix_size;
+      if (depth == size) {
+        if (in->terminal != nullptr) {
+          static_cast<entry*>(in->terminal)->_value = std::move(value);
+          return false;
+        }
+        in->terminal = new_entry(key, size, copy, value);
+        ++_size;
+        return true;
+      }
+      inner::radix_node** const child = inner::radix_find_child(in, key[depth]);
+      if (child == nullptr) {
+        std::unique_ptr<entry> added(new_entry(key, size, copy, value));
+        *ref = inner::radix_add_child(in, key[depth], added.get());
+        added.release();
+        ++_size;
+        return true;
+      }
+      ref = child;
+      ++depth;
+    }
+  }
+
+  entry* find_entry(string_view_type str) const noexcept {
+    const unsigned char* const key =
+        reinterpret_cast<const unsigned char*>(str.data());
+    const size_t size = str.size();
+    inner::radix_node* n = _root;
+    size_t depth = 0;
+    while (n != nullptr) {
+      if (n->type == inner::radix_node_type::leaf) {
+        entry* const e = static_cast<entry*>(n);
+        return e->key_size == size && inner::radix_equal(e->key_data + depth,
+                                                         key + depth,
+                                                         size - depth)
+                   ? e
+                   : nullptr;
+      }
+      inner::radix_inner* const in = static_cast<inner::radix_inner*>(n);
+      if (size - depth < in->prefix_size ||
+          !inner::radix_equal(in->prefix, key + depth, in->prefix_size))
+        return nullptr;
+      depth += in->prefix_size;
+      if (depth == size)
+        return static_cast<entry*>(in->terminal);
+      inner::radix_node** const child = inner::radix_find_child(in, key[depth]);
+      if (child == nullptr)
+        return nullptr;
+      n = *child;
+      ++depth;
+    }
+    return nullptr;
+  }
+
+  entry* longest_prefix_entry(string_view_type str) const noexcept {
+    const unsigned char* const key =
+        reinterpret_cast<const unsigned char*>(str.data());
+    const size_t size = str.size();
+    entry* best = nullptr;
+    inner::radix_node* n = _root;
+    size_t depth = 0;
+    while (n != nullptr) {
+      if (n->type == inner::radix_node_type::leaf) {
+        entry* const e = static_cast<entry*>(n);
+        if (e->key_size <= size &&
+            inner::radix_equal(e->key_data + depth, key + depth,
+                               e->key_size - depth))
+          best = e;
+        break;
+      }
+      inner::radix_inner* const in = static_cast<inner::radix_inner*>(n);
+      if (size - depth < in->prefix_size ||
+          !inner::radix_equal(in->prefix, key + depth, in->prefix_size))
+        break;
+      depth += in->prefix_size;
+      if (in->terminal != nullptr)
+        best = static_cast<entry*>(in->terminal);
+      if (depth == size)
+        break;
+      inner::radix_node** const child = inner::radix_find_child(in, key[depth]);
+      if (child == nullptr)
+        break;
+      n = *child;
+      ++depth;
+    }
+    return best;
+  }
+
+  /**
+   * The node whose every key starts with prefix and which holds all of
+   * them, nullptr if there is no such key.
+   */
+  inner::radix_node* prefixed_subtree(string_view_type str) const noexcept {
+    const unsigned char* const prefix =
+        reinterpret_cast<const unsigned char*>(str.data());
+    const size_t size = str.size();
+    inner::radix_node* n = _root;
+    size_t depth = 0;
+    while (n != nullptr) {
+      if (n->type == inner::radix_node_type::leaf) {
+        const inner::radix_leaf* const leaf =
+            static_cast<const inner::radix_leaf*>(n);
+        return leaf->key_size >= size &&
+                       inner::radix_equal(leaf->key_data + depth,
+                                          prefix + depth, size - depth)
+                   ? n
+                   : nullptr;
+      }
+      inner::radix_inner* const in = static_cast<inner::radix_inner*>(n);
+      if (!inner::radix_equal(in->prefix, prefix + depth,
+                              std::min(in->prefix_size, size - depth)))
+        return nullptr;
+      if (depth + in->prefix_size >= size)
+        return n;
+      depth += in->prefix_size;
+      inner::radix_node** const child =
+          inner::radix_find_child(in, prefix[depth]);
+      if (child == nullptr)
+        return nullptr;
+      n = *child;
+      ++depth;
+    }
+    return nullptr;
+  }
+};
+
+template <typename T>
+using radix_tree = basic_radix_tree<T, char>;
+
+}  // namespace jasl
@@ -0,0 +1,329 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "jasl/jasl_internal/jasl_byte_find.hpp"
+#include "jasl/jasl_internal/jasl_char_set.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_internal/jasl_string_view_bridge.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+
+/**
+ * What happens with the empty pieces between two adjacent delimiters and
+ * before/after a delimiter at the beginning/end.
+ */
+enum class empty_fields { keep, skip };
+
+namespace inner {
+
+/*
+ * Delimiters of the split. find returns the index of the first delimiter in
+ * [start, size) of the string or size_t(-1), size is the length of the
+ * delimiter. The single character delimiters of byte strings use the cursor
+ * (which belongs to the iterator) to find 64 positions at once.
+ */
+
+template <typename CharT, typename Traits>
+class split_char_delimiter {
+  CharT _c;
+
+ public:
+  split_char_delimiter() noexcept : _c() {}
+  explicit split_char_delimiter(CharT c) noexcept : _c(c) {}
+
+  size_t size() const noexcept { return 1; }
+
+  size_t find(const CharT* ptr,
+              size_t size,
+              size_t start,
+              mask_cursor& cursor) const noexcept {
+    if (is_byte_char<CharT, Traits>::value) {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(ptr);
+      const unsigned char c = static_cast<unsigned char>(_c);
+      return cursor.next(size, start, [p, size, c](size_t offset) {
+        return byte_mask64(p + offset, size - offset, c);
+      });
+    }
+    const CharT* found = Traits::find(ptr + start, size - start, _c);
+    return found == nullptr ? static_cast<size_t>(-1)
+                            : static_cast<size_t>(found - ptr);
+  }
+};
+
+template <typename CharT, typename Traits>
+class split_set_delimiter {
+  basic_string_view<CharT, Traits> _set;
+  byte_set _table;
+
+ public:
+  split_set_delimiter() noexcept : _set(), _table() {}
+  explicit split_set_delimiter(basic_string_view<CharT, Traits> set) noexcept
+      : _set(set), _table() {
+    if (is_byte_char<CharT, Traits>::value) {
+      for (CharT c : set)
+        _table.insert(static_cast<unsigned char>(c));
+    }
+  }
+
+  size_t size() const noexcept { return 1; }
+
+  size_t find(const CharT* ptr,
+              size_t size,
+              size_t start,
+              mask_cursor& cursor) const noexcept {
+    if (is_byte_char<CharT, Traits>::value) {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(ptr);
+      const unsigned char* set =
+          reinterpret_cast<const unsigned char*>(_set.data());
+      const size_t set_size = _set.size();
+      const byte_set& table = _table;
+      return cursor.next(size, start, [=, &table](size_t offset) {
+        return any_byte_mask64(p + offset, size - offset, set, set_size,
+                               table);
+      });
+    }
+    for (size_t i = start; i < size; ++i) {
+      if (Traits::find(_set.data(), _set.size(), ptr[i]) != nullptr)
+        return i;
+    }
+    return static_cast<size_t>(-1);
+  }
+};
+
+template <typename CharT, typename Traits>
+class split_string_delimiter {
+  basic_string_view<CharT, Traits> _delimiter;
+
+ public:
+  split_string_delimiter() noexcept : _delimiter() {}
+  explicit split_string_delimiter(basic_string_view<CharT, Traits> delimiter)
+      : _delimiter(delimiter) {
+    if (delimiter.empty())
+      JASL_THROW(std::invalid_argument("split: empty delimiter"));
+  }
+
+  size_t size() const noexcept { return _delimiter.size(); }
+
+  size_t find(const CharT* ptr,
+              size_t size,
+              size_t start,
+              mask_cursor&) const noexcept {
+    const size_t found = find_substring<CharT, Traits>(
+        ptr + start, size - start, _delimiter.data(), _delimiter.size());
+    return found == static_cast<size_t>(-1) ? found : start + found;
+  }
+};
+
+}  // namespace inner
+
+/**
+ * Lazy range of the pieces of a string between the delimiters. Nothing is
+ * allocated or copied: the pieces are views into the original string, which
+ * has to outlive the range and its iterators (and so do the delimiter and the
+ * character set). The iterators don't refer to the range itself.
+ *
+ * It is created by the jasl::split and jasl::split_any_of functions.
+ */
+template <typename CharT, typename Traits, typename DelimiterT>
+class basic_split_range {
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+  class iterator;
+  typedef iterator const_iterator;
+
+ private:
+  string_view_type _str;
+  DelimiterT _delimiter;
+  empty_fields _empty;
+
+ public:
+  basic_split_range(string_view_type str,
+                    const DelimiterT& delimiter,
+                    empty_fields empty) noexcept
+      : _str(str), _delimiter(delimiter), _empty(empty) {}
+
+  iterator begin() const noexcept { return iterator(_str, _delimiter, _empty); }
+
+  iterator end() const noexcept { return iterator(); }
+};
+
+template <typename CharT, typename Traits, typename DelimiterT>
+class basic_split_range<CharT, Traits, DelimiterT>::iterator {
+  friend class basic_split_range;
+
+  string_view_type _str;
+  DelimiterT _delimiter;
+  empty_fields _empty;
+  size_t _pos;  // the beginning of the piece, size_t(-1) at the end
+  string_view_type _piece;
+  bool _last;  // there is no delimiter after the piece
+  inner::mask_cursor _cursor;
+
+  iterator(string_view_type str,
+           const DelimiterT& delimiter,
+           empty_fields empty) noexcept
+      : _str(str),
+        _delimiter(delimiter),
+        _empty(empty),
+        _pos(0),
+        _piece(),
+        _last(true),
+        _cursor() {
+    find_from(0);
+  }
+
+  void find_from(size_t start) noexcept {
+    for (;;) {
+      const size_t found =
+          _delimiter.find(_str.data(), _str.size(), start, _cursor);
+      const bool last = found == static_cast<size_t>(-1);
+      const size_t end = last ? _str.size() : found;
+      if (end == start && _empty == empty_fields::skip) {
+        if (last) {
+          _pos = static_cast<size_t>(-1);
+          return;
+        }
+        start = end + _delimiter.size();
+        continue;
+      }
+      _pos = start;
+      _piece = string_view_type(_str.data() + start, end - start);
+      _last = last;
+      return;
+    }
+  }
+
+ public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef string_view_type value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const string_view_type* pointer;
+  typedef const string_view_type& reference;
+
+  iterator() noexcept
+      : _str(),
+        _delimiter(),
+        _empty(empty_fields::keep),
+        _pos(static_cast<size_t>(-1)),
+        _piece(),
+        _last(true),
+        _cursor() {}
+
+  reference operator*() const noexcept {
+    JASL_ASSERT(_pos != static_cast<size_t>(-1), "dereferencing end()");
+    return _piece;
+  }
+
+  pointer operator->() const noexcept { return &_piece; }
+
+  iterator& operator++() noexcept {
+    JASL_ASSERT(_pos != static_cast<size_t>(-1), "incrementing end()");
+    if (_last)
+      _pos = static_cast<size_t>(-1);
+    else
+      find_from(_pos + _piece.size() + _delimiter.size());
+    return *this;
+  }
+
+  iterator operator++(int) noexcept {
+    iterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  friend bool operator==(const iterator& x, const iterator& y) noexcept {
+    return x._pos == y._pos;
+  }
+
+  friend bool operator!=(const iterator& x, const iterator& y) noexcept {
+    return x._pos != y._pos;
+  }
+};
+
+/**
+ * Splits the string at every occurrence of the character.
+ *
+ * `for (jasl::string_view field : jasl::split(line, ','))`
+ */
+template <typename CharT, typename Traits>
+basic_split_range<CharT, Traits, inner::split_char_delimiter<CharT, Traits>>
+split(basic_string_view<CharT, Traits> str,
+      CharT delimiter,
+      empty_fields empty = empty_fields::keep) noexcept {
+  return {str, inner::split_char_delimiter<CharT, Traits>(delimiter), empty};
+}
+
+/**
+ * Splits the string at every occurrence of the (non-empty) delimiter.
+ * Throws std::invalid_argument if the delimiter is empty.
+ */
+template <typename CharT, typename Traits>
+basic_split_range<CharT, Traits, inner::split_string_delimiter<CharT, Traits>>
+split(basic_string_view<CharT, Traits> str,
+      typename inner::non_deduced<basic_string_view<CharT, Traits>>::type
+          delimiter,
+      empty_fields empty = empty_fields::keep) {
+  return {str, inner::split_string_delimiter<CharT, Traits>(delimiter), empty};
+}
+
+/**
+ * Splits the string at every character which is in the set.
+ */
+template <typename CharT, typename Traits>
+basic_split_range<CharT, Traits, inner::split_set_delimiter<CharT, Traits>>
+split_any_of(
+    basic_string_view<CharT, Traits> str,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type set,
+    empty_fields empty = empty_fields::keep) noexcept {
+  return {str, inner::split_set_delimiter<CharT, Traits>(set), empty};
+}
+
+/*
+ * The same for the jasl::static_string and jasl::string. The string has to
+ * outlive the range.
+ */
+
+template <typename CharT, typename Traits>
+basic_split_range<CharT, Traits, inner::split_char_delimiter<CharT, Traits>>
+split(const inner::string_view_bridge<basic_string_view<CharT, Traits>>& str,
+      CharT delimiter,
+      empty_fields empty = empty_fields::keep) noexcept {
+  return split(static_cast<basic_string_view<CharT, Traits>>(str), delimiter,
+               empty);
+}
+
+template <typename CharT, typename Traits>
+basic_split_range<CharT, Traits, inner::split_string_delimiter<CharT, Traits>>
+split(const inner::string_view_bridge<basic_string_view<CharT, Traits>>& str,
+      typename inner::non_deduced<basic_string_view<CharT, Traits>>::type
+          delimiter,
+      empty_fields empty = empty_fields::keep) {
+  return split(static_cast<basic_string_view<CharT, Traits>>(str), delimiter,
+               empty);
+}
+
+template <typename CharT, typename Traits>
+basic_split_range<CharT, Traits, inner::split_set_delimiter<CharT, Traits>>
+split_any_of(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& str,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type set,
+    empty_fields empty = empty_fields::keep) noexcept {
+  return split_any_of(static_cast<basic_string_view<CharT, Traits>>(str), set,
+                      empty);
+}
+
+}  // namespace jasl
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <stdexcept>
 #include <string>
 
 #include "jasl/jasl_internal/jasl_common.hpp"
@@ -16,6 +17,20 @@
 #include "jasl/jasl_string_view.hpp"
 
 namespace jasl {
+namespace inner {
+
+/**
+ * The c_str() of the empty strings: they may have no data at all.
+ */
+template <typename CharT>
+struct null_terminator {
+  static const CharT value[1];
+};
+
+template <typename CharT>
+const CharT null_terminator<CharT>::value[1] = {CharT()};
+
+}  // namespace inner
 
 /**
  * This class derives from [std::string_view] (or optionally from
@@ -24,12 +39,14 @@ namespace jasl {
  * safer and faster comparing to string_view-s.
  *
  * Remarks:
- * Why is there no c_str method? While jasl::static_string("one") is null
- * terminated, jasl::static_string({'t', 'w', 'o'}) is not. In both cases
- * the size()/length() of them will be 3, so the terminating null character will
+ * While jasl::static_string("one") is null terminated,
+ * jasl::static_string({'t', 'w', 'o'}) is not. In both cases the
+ * size()/length() of them will be 3, so the terminating null character will
  * be here in the first case but it won't be counted. If you want the null
  * terminator as a part of it, write jasl::static_string("one\0") or
  * jasl::static_string({'t', 'w', 'o', '\0', '\0'}).
+ * The constructor remembers which case it was: is_null_terminated() tells
+ * whether c_str() can return the array itself.
  */
 
 template <typename CharT, class Traits = std::char_traits<CharT>>
@@ -41,9 +58,11 @@ class basic_static_string
   typedef typename bridge_type::bridge_to_type base_type;
 
  private:
-  constexpr basic_static_string(const bridge_type& other) noexcept(
-      std::is_nothrow_constructible<bridge_type, const bridge_type&>::value)
-      : bridge_type(other) {}
+  // whether data()[size()] is the null character is kept by the bridge
+  constexpr basic_static_string(const bridge_type& other,
+                                bool null_terminated) noexcept(
+      bridge_type::is_nothrow_constructible_with_ptr_and_size)
+      : bridge_type(other.data(), other.size(), null_terminated) {}
 
  public:
   JASL_CONSTEXPR_CXX14 basic_static_string() noexcept(
@@ -53,7 +72,7 @@ class basic_static_string
   template <size_t N>
   constexpr basic_static_string(const CharT (&str)[N]) noexcept(
       bridge_type::is_nothrow_constructible_with_ptr_and_size)
-      : bridge_type(str, str[N - 1] == 0 ? N - 1 : N) {}
+      : bridge_type(str, str[N - 1] == 0 ? N - 1 : N, str[N - 1] == 0) {}
 
   constexpr basic_static_string(const basic_static_string& other) noexcept(
       bridge_type::is_nothrow_copy_constructible)
@@ -69,7 +88,7 @@ class basic_static_string
   template <size_t N>
   JASL_CONSTEXPR_CXX14 basic_static_string& operator=(
       const CharT (&str)[N]) noexcept(bridge_type::is_nothrow_settable) {
-    bridge_type::set(str, str[N - 1] == 0 ? N - 1 : N);
+    bridge_type::set(str, str[N - 1] == 0 ? N - 1 : N, str[N - 1] == 0);
     return *this;
   }
 
@@ -114,10 +133,37 @@ class basic_static_string
     bridge_type::swap(other);
   }
 
+  /**
+   * A suffix of a null terminated string is null terminated too.
+   */
   constexpr basic_static_string substr(
       typename bridge_type::size_type pos,
       typename bridge_type::size_type count = bridge_type::npos) const {
-    return basic_static_string(bridge_type::substr(pos, count));
+    return basic_static_string(
+        bridge_type::substr(pos, count),
+        bridge_type::null_terminated_flag() &&
+            count >= bridge_type::size() - pos);
+  }
+
+  /**
+   * True if c_str() doesn't throw: the string was constructed from a null
+   * terminated array (e.g. a literal) or it is empty.
+   */
+  constexpr bool is_null_terminated() const noexcept {
+    return bridge_type::null_terminated_flag() || bridge_type::empty();
+  }
+
+  /**
+   * The characters followed by the null character, without copying.
+   * Throws std::logic_error if the array wasn't null terminated, see
+   * jasl::basic_c_str_buffer for those.
+   */
+  const CharT* c_str() const {
+    if (bridge_type::empty())
+      return inner::null_terminator<CharT>::value;
+    if (!bridge_type::null_terminated_flag())
+      JASL_THROW(std::logic_error("c_str: not null terminated"));
+    return bridge_type::data();
   }
 };
 
@@ -0,0 +1,350 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+#include "jasl/jasl_internal/jasl_murmurhash3.hpp"
+
+namespace jasl {
+namespace inner {
+
+inline uint32_t murmur_rotl32(uint32_t x, unsigned r) noexcept {
+  return (x << r) | (x >> (32 - r));
+}
+
+inline uint64_t murmur_rotl64(uint64_t x, unsigned r) noexcept {
+  return (x << r) | (x >> (64 - r));
+}
+
+}  // namespace inner
+
+/**
+ * Streaming MurmurHash3_x64_128: the data can arrive in any number of
+ * chunks of any size, the hash is the same as the one of their
+ * concatenation. The length is 64 bit; up to INT_MAX bytes the result is
+ * bit-identical to murmurhash3::MurmurHash3_x64_128.
+ *
+ * Partial 16 byte blocks are buffered, so the chunks don't have to be kept.
+ */
+class murmurhash3_x64_128 {
+ public:
+  static constexpr size_t digest_size = 16;
+
+ private:
+  uint64_t _h1;
+  uint64_t _h2;
+  uint64_t _size;
+  unsigned char _buffer[16];
+
+ public:
+  explicit murmurhash3_x64_128(uint32_t seed = 0) noexcept { init(seed); }
+
+  /**
+   * Starts a new hash.
+   */
+  void init(uint32_t seed = 0) noexcept {
+    _h1 = seed;
+    _h2 = seed;
+    _size = 0;
+  }
+
+  /**
+   * Number of the bytes hashed since init().
+   */
+  uint64_t size() const noexcept { return _size; }
+
+  void update(const void* data, size_t size) noexcept {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    size_t buffered = static_cast<size_t>(_size % 16);
+    _size += size;
+    if (buffered != 0) {
+      const size_t count = size < 16 - buffered ? size : 16 - buffered;
+      std::memcpy(_buffer + buffered, p, count);
+      p += count;
+      size -= count;
+      buffered += count;
+      if (buffered < 16)
+        return;
+      block(_buffer);
+    }
+    for (; size >= 16; p += 16, size -= 16)
+      block(p);
+    if (size != 0)
+      std::memcpy(_buffer, p, size);
+  }
+
+  /**
+   * Hashes the bytes of a string: anything with data() and size().
+   */
+  template <typename StringT>
+  void update(const StringT& str) noexcept {
+    update(str.data(), str.size() * sizeof(*str.data()));
+  }
+
+  /**
+   * Writes the 16 byte hash of the data to out. The state is not changed,
+   * so the stream can be continued.
+   */
+  JASL_USAN_IGNORE(integer)
+  void finalize(void* out) const noexcept {
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    uint64_t h1 = _h1;
+    uint64_t h2 = _h2;
+
+    const size_t rest = static_cast<size_t>(_size % 16);
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = rest; i > 8; --i)
+      k2 ^= static_cast<uint64_t>(_buffer[i - 1]) << ((i - 9) * 8);
+    for (size_t i = rest < 8 ? rest : 8; i > 0; --i)
+      k1 ^= static_cast<uint64_t>(_buffer[i - 1]) << ((i - 1) * 8);
+    if (rest > 8) {
+      k2 *= c2;
+      k2 = inner::murmur_rotl64(k2, 33);
+      k2 *= c1;
+      h2 ^= k2;
+    }
+    if (rest > 0) {
+      k1 *= c1;
+      k1 = inner::murmur_rotl64(k1, 31);
+      k1 *= c2;
+      h1 ^= k1;
+    }
+
+    h1 ^= _size;
+    h2 ^= _size;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = murmurhash3::fmix64(h1);
+    h2 = murmurhash3::fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    const uint64_t result[2] = {h1, h2};
+    std::memcpy(out, result, digest_size);
+  }
+
+  /**
+   * One-shot hash of size bytes.
+   */
+  static void hash(const void* data,
+                   size_t size,
+                   uint32_t seed,
+                   void* out) noexcept {
+    murmurhash3_x64_128 hasher(seed);
+    hasher.update(data, size);
+    hasher.finalize(out);
+  }
+
+ private:
+  JASL_USAN_IGNORE(integer)
+  void block(const unsigned char* p) noexcept {
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    uint64_t k1;
+    uint64_t k2;
+    std::memcpy(&k1, p, 8);
+    std::memcpy(&k2, p + 8, 8);
+
+    k1 *= c1;
+    k1 = inner::murmur_rotl64(k1, 31);
+    k1 *= c2;
+    _h1 ^= k1;
+
+    _h1 = inner::murmur_rotl64(_h1, 27);
+    _h1 += _h2;
+    _h1 = _h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = inner::murmur_rotl64(k2, 33);
+    k2 *= c1;
+    _h2 ^= k2;
+
+    _h2 = inner::murmur_rotl64(_h2, 31);
+    _h2 += _h1;
+    _h2 = _h2 * 5 + 0x38495ab5;
+  }
+};
+
+/**
+ * Streaming MurmurHash3_x86_128, see murmurhash3_x64_128. The algorithm
+ * mixes in only the low 32 bits of the length, so beyond 4 GiB the lengths
+ * are distinguished by the data only.
+ */
+class murmurhash3_x86_128 {
+ public:
+  static constexpr size_t digest_size = 16;
+
+ private:
+  uint32_t _h[4];
+  uint64_t _size;
+  unsigned char _buffer[16];
+
+ public:
+  explicit murmurhash3_x86_128(uint32_t seed = 0) noexcept { init(seed); }
+
+  /**
+   * Starts a new hash.
+   */
+  void init(uint32_t seed = 0) noexcept {
+    _h[0] = _h[1] = _h[2] = _h[3] = seed;
+    _size = 0;
+  }
+
+  /**
+   * Number of the bytes hashed since init().
+   */
+  uint64_t size() const noexcept { return _size; }
+
+  void update(const void* data, size_t size) noexcept {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    size_t buffered = static_cast<size_t>(_size % 16);
+    _size += size;
+    if (buffered != 0) {
+      const size_t count = size < 16 - buffered ? size : 16 - buffered;
+      std::memcpy(_buffer + buffered, p, count);
+      p += count;
+      size -= count;
+      buffered += count;
+      if (buffered < 16)
+        return;
+      block(_buffer);
+    }
+    for (; size >= 16; p += 16, size -= 16)
+      block(p);
+    if (size != 0)
+      std::memcpy(_buffer, p, size);
+  }
+
+  /**
+   * Hashes the bytes of a string: anything with data() and size().
+   */
+  template <typename StringT>
+  void update(const StringT& str) noexcept {
+    update(str.data(), str.size() * sizeof(*str.data()));
+  }
+
+  /**
+   * Writes the 16 byte hash of the data to out. The state is not changed,
+   * so the stream can be continued.
+   */
+  JASL_USAN_IGNORE(integer)
+  void finalize(void* out) const noexcept {
+    static const uint32_t c[5] = {0x239b961b, 0xab0e9789, 0x38b34ae5,
+                                  0xa1e38b93, 0x239b961b};
+    static const unsigned rotations[4] = {15, 16, 17, 18};
+    uint32_t h[4] = {_h[0], _h[1], _h[2], _h[3]};
+
+    // the lane i of the tail is mixed like the lane i of a block
+    const size_t rest = static_cast<size_t>(_size % 16);
+    for (size_t lane = 0; lane < 4 && lane * 4 < rest; ++lane) {
+      uint32_t k = 0;
+      const size_t end = rest < lane * 4 + 4 ? rest : lane * 4 + 4;
+      for (size_t i = end; i > lane * 4; --i) {
+        k ^= static_cast<uint32_t>(_buffer[i - 1])
+             << ((i - 1 - lane * 4) * 8);
+      }
+      k *= c[lane];
+      k = inner::murmur_rotl32(k, rotations[lane]);
+      k *= c[lane + 1];
+      h[lane] ^= k;
+    }
+
+    const uint32_t length = static_cast<uint32_t>(_size);
+    for (size_t i = 0; i < 4; ++i)
+      h[i] ^= length;
+
+    h[0] += h[1];
+    h[0] += h[2];
+    h[0] += h[3];
+    h[1] += h[0];
+    h[2] += h[0];
+    h[3] += h[0];
+
+    for (size_t i = 0; i < 4; ++i)
+      h[i] = murmurhash3::fmix32(h[i]);
+
+    h[0] += h[1];
+    h[0] += h[2];
+    h[0] += h[3];
+    h[1] += h[0];
+    h[2] += h[0];
+    h[3] += h[0];
+
+    std::memcpy(out, h, digest_size);
+  }
+
+  /**
+   * One-shot hash of size bytes.
+   */
+  static void hash(const void* data,
+                   size_t size,
+                   uint32_t seed,
+                   void* out) noexcept {
+    murmurhash3_x86_128 hasher(seed);
+    hasher.update(data, size);
+    hasher.finalize(out);
+  }
+
+ private:
+  JASL_USAN_IGNORE(integer)
+  void block(const unsigned char* p) noexcept {
+    const uint32_t c1 = 0x239b961b;
+    const uint32_t c2 = 0xab0e9789;
+    const uint32_t c3 = 0x38b34ae5;
+    const uint32_t c4 = 0xa1e38b93;
+    uint32_t k[4];
+    std::memcpy(k, p, 16);
+
+    k[0] *= c1;
+    k[0] = inner::murmur_rotl32(k[0], 15);
+    k[0] *= c2;
+    _h[0] ^= k[0];
+
+    _h[0] = inner::murmur_rotl32(_h[0], 19);
+    _h[0] += _h[1];
+    _h[0] = _h[0] * 5 + 0x561ccd1b;
+
+    k[1] *= c2;
+    k[1] = inner::murmur_rotl32(k[1], 16);
+    k[1] *= c3;
+    _h[1] ^= k[1];
+
+    _h[1] = inner::murmur_rotl32(_h[1], 17);
+    _h[1] += _h[2];
+    _h[1] = _h[1] * 5 + 0x0bcaa747;
+
+    k[2] *= c3;
+    k[2] = inner::murmur_rotl32(k[2], 17);
+    k[2] *= c4;
+    _h[2] ^= k[2];
+
+    _h[2] = inner::murmur_rotl32(_h[2], 15);
+    _h[2] += _h[3];
+    _h[2] = _h[2] * 5 + 0x96cd1c35;
+
+    k[3] *= c4;
+    k[3] = inner::murmur_rotl32(k[3], 18);
+    k[3] *= c1;
+    _h[3] ^= k[3];
+
+    _h[3] = inner::murmur_rotl32(_h[3], 13);
+    _h[3] += _h[0];
+    _h[3] = _h[3] * 5 + 0x32ac3b17;
+  }
+};
+
+}  // namespace jasl
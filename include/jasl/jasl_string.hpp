@@ -10,6 +10,7 @@
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 #include "jasl/jasl_internal/jasl_common.hpp"
@@ -26,7 +27,9 @@ namespace jasl {
  * construct with) character array to it, it won't allocate, copy and
  * deallocate. In other cases it will allocate, copy and deallocate.
  *
- * It has the functionality of its base class ([std::string_view]) only.
+ * It has the functionality of its base class ([std::string_view]) and
+ * c_str(). The allocated strings have a null character after their last
+ * character, the static ones if their array had it.
  */
 
 template <typename CharT,
@@ -51,7 +54,9 @@ class basic_string
 
  private:
   allocator_type _alloc;
-  size_t _cap;  // capacity
+  // capacity, including the null character; whether data()[size()] is the
+  // null character is kept by the bridge
+  size_t _cap;
 
  private:
   struct CStr {
@@ -77,17 +82,18 @@ class basic_string
         std::is_standard_layout<CharT>::value && std::is_trivial<CharT>::value,
         "Unsupported CharT");
     if (size == 0) {
-      bridge_type::set(nullptr, 0);
+      bridge_type::set(nullptr, 0, true);
       return;
     }
     std::unique_ptr<CharT, std::function<void(CharT*)>> begin(
-        alloc_traits::allocate(_alloc, size), [&](CharT * ptd) noexcept {
-          alloc_traits::deallocate(_alloc, ptd, size);
+        alloc_traits::allocate(_alloc, size + 1), [&](CharT * ptd) noexcept {
+          alloc_traits::deallocate(_alloc, ptd, size + 1);
         });
-    bridge_type::set(begin.get(), size);
-    _cap = size;
+    bridge_type::set(begin.get(), size, true);
+    _cap = size + 1;
     auto raw_begin = begin.release();
     Traits::copy(raw_begin, ptr, size);
+    raw_begin[size] = CharT();
   }
 
   inline void dispose() noexcept {
@@ -139,13 +145,17 @@ class basic_string
   basic_string(const CharT (&str)[N]) noexcept(
       bridge_type::is_nothrow_constructible_with_ptr_and_size&&
           std::is_nothrow_default_constructible<AllocatorT>::value)
-      : bridge_type(str, str[N - 1] == 0 ? N - 1 : N), _alloc(), _cap(0) {}
+      : bridge_type(str, str[N - 1] == 0 ? N - 1 : N, str[N - 1] == 0),
+        _alloc(),
+        _cap(0) {}
 
   template <size_t N>
   basic_string(const CharT (&str)[N], const AllocatorT& alloc) noexcept(
       bridge_type::is_nothrow_constructible_with_ptr_and_size&&
           std::is_nothrow_copy_constructible<AllocatorT>::value)
-      : bridge_type(str, str[N - 1] == 0 ? N - 1 : N), _alloc(alloc), _cap(0) {}
+      : bridge_type(str, str[N - 1] == 0 ? N - 1 : N, str[N - 1] == 0),
+        _alloc(alloc),
+        _cap(0) {}
 
   basic_string(const basic_string& other)
       : basic_string(
@@ -172,7 +182,7 @@ class basic_string
   basic_string(basic_string&& other, const AllocatorT& alloc)
       : bridge_type(), _alloc(alloc), _cap(0) {
     if (_alloc == other._alloc) {
-      bridge_type::set(other.data(), other.size());
+      bridge_type::operator=(other);
       std::swap(_cap, other._cap);
     } else {
       init(other.data(), other.size());
@@ -182,7 +192,9 @@ class basic_string
   basic_string(const basic_static_string<CharT, Traits>& ss) noexcept(
       bridge_type::is_nothrow_constructible_with_ptr_and_size&&
           std::is_nothrow_default_constructible<AllocatorT>::value)
-      : bridge_type(ss.data(), ss.size()), _alloc(), _cap(0) {}
+      : bridge_type(ss.data(), ss.size(), ss.is_null_terminated()),
+        _alloc(),
+        _cap(0) {}
 
   basic_string(
       const basic_static_string<CharT, Traits>& ss,
@@ -191,7 +203,9 @@ class basic_string
                               is_nothrow_constructible_with_ptr_and_size&&
                                   std::is_nothrow_copy_constructible<
                                       AllocatorT>::value)
-      : bridge_type(ss.data(), ss.size()), _alloc(alloc), _cap(0) {}
+      : bridge_type(ss.data(), ss.size(), ss.is_null_terminated()),
+        _alloc(alloc),
+        _cap(0) {}
 
 #if defined(JASL_SUPPORT_STD_TO_JASL)
 #  if defined(JASL_cpp_lib_string_view)
@@ -268,7 +282,7 @@ class basic_string
   basic_string& assign(const CharT (&str)[N]) noexcept(
       bridge_type::is_nothrow_settable) {
     dispose();
-    bridge_type::set(str, str[N - 1] == 0 ? N - 1 : N);
+    bridge_type::set(str, str[N - 1] == 0 ? N - 1 : N, str[N - 1] == 0);
     return *this;
   }
 
@@ -332,7 +346,7 @@ class basic_string
   basic_string& assing(const basic_static_string<CharT, Traits>& ss) noexcept(
       bridge_type::is_nothrow_settable) {
     dispose();
-    bridge_type::set(ss.data(), ss.size());
+    bridge_type::set(ss.data(), ss.size(), ss.is_null_terminated());
     return *this;
   }
 
@@ -355,7 +369,56 @@ class basic_string
     return assign(other);
   }
 
+  /**
+   * Allocates exactly size characters (and the null character) and lets
+   * fill(CharT* ptr) write all of them. The functions which compute the size
+   * of their result first (e.g. unescaping) can build the string with a
+   * single allocation and without a temporary buffer.
+   */
+  template <typename FillT>
+  static basic_string build(size_t size,
+                            FillT&& fill,
+                            const AllocatorT& alloc = AllocatorT()) {
+    basic_string result(alloc);
+    result.bridge_type::set_null_terminated_flag(true);
+    if (size == 0)
+      return result;
+    std::unique_ptr<CharT, std::function<void(CharT*)>> begin(
+        alloc_traits::allocate(result._alloc, size + 1),
+        [&](CharT * ptd) noexcept {
+          alloc_traits::deallocate(result._alloc, ptd, size + 1);
+        });
+    fill(begin.get());
+    begin.get()[size] = CharT();
+    result.bridge_type::set(begin.get(), size, true);
+    result._cap = size + 1;
+    begin.release();
+    return result;
+  }
+
   constexpr bool is_static() const noexcept { return _cap == 0; }
+
+  /**
+   * True if c_str() doesn't throw: the string is allocated, or it was
+   * constructed from a null terminated array (e.g. a literal), or it is
+   * empty.
+   */
+  constexpr bool is_null_terminated() const noexcept {
+    return bridge_type::null_terminated_flag() || bridge_type::empty();
+  }
+
+  /**
+   * The characters followed by the null character, without copying.
+   * Throws std::logic_error if the string refers to an array which wasn't
+   * null terminated, see jasl::basic_c_str_buffer for those.
+   */
+  const CharT* c_str() const {
+    if (bridge_type::empty())
+      return inner::null_terminator<CharT>::value;
+    if (!bridge_type::null_terminated_flag())
+      JASL_THROW(std::logic_error("c_str: not null terminated"));
+    return bridge_type::data();
+  }
   AllocatorT get_alloc() const
       noexcept(std::is_nothrow_copy_constructible<AllocatorT>::value) {
     return _alloc;
@@ -386,6 +449,8 @@ class basic_string
     if (_cap == 0) {
       basic_string cpy(*this, _alloc);
       cpy.bridge_type::operator=(bridge_type::substr(pos));
+      cpy.bridge_type::set_null_terminated_flag(
+          bridge_type::null_terminated_flag());
       return cpy;
     } else {
       return basic_string(bridge_type::substr(pos), _alloc);
@@ -397,6 +462,9 @@ class basic_string
     if (_cap == 0) {
       basic_string cpy(*this);
       cpy.bridge_type::operator=(bridge_type::substr(pos, count));
+      cpy.bridge_type::set_null_terminated_flag(
+          bridge_type::null_terminated_flag() &&
+          count >= bridge_type::size() - pos);
       return cpy;
     } else {
       return basic_string(bridge_type::substr(pos, count), _alloc);
@@ -0,0 +1,185 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "jasl/jasl_internal/jasl_ascii_case.hpp"
+#include "jasl/jasl_internal/jasl_byte_find.hpp"
+#include "jasl/jasl_internal/jasl_char_set.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_string_view_bridge.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * The algorithms compute the exact size of their result first, then the
+ * characters are written into a single allocation of jasl::basic_string
+ * (see basic_string::build): there is no growth and no reallocation.
+ */
+
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> map_ascii_case(basic_string_view<CharT, Traits> str,
+                                           char first,
+                                           char last) {
+  return basic_string<CharT, Traits>::build(str.size(), [&](CharT* out) {
+    if (is_byte_char<CharT, Traits>::value) {
+      map_ascii_range(reinterpret_cast<const unsigned char*>(str.data()),
+                      str.size(), reinterpret_cast<unsigned char*>(out),
+                      static_cast<unsigned char>(first),
+                      static_cast<unsigned char>(last));
+      return;
+    }
+    const CharT* in = str.data();
+    for (size_t i = 0; i < str.size(); ++i) {
+      const CharT c = in[i];
+      out[i] = c >= static_cast<CharT>(first) && c <= static_cast<CharT>(last)
+                   ? static_cast<CharT>(c ^ 0x20)
+                   : c;
+    }
+  });
+}
+
+}  // namespace inner
+
+/**
+ * Concatenates the pieces with the separator between them. The pieces are
+ * anything convertible to a view: views, jasl strings, [std::string]-s. The
+ * range is iterated twice, first for the size.
+ *
+ * `jasl::join(fields, jasl::static_string(", "))`
+ *
+ * For other characters than char: `jasl::join<char16_t>(...)`.
+ */
+template <typename CharT = char,
+          typename Traits = std::char_traits<CharT>,
+          typename RangeT>
+basic_string<CharT, Traits> join(
+    const RangeT& pieces,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type
+        separator) {
+  size_t size = 0;
+  size_t count = 0;
+  for (const auto& piece : pieces) {
+    const basic_string_view<CharT, Traits> v = piece;
+    size += v.size();
+    ++count;
+  }
+  if (count > 1)
+    size += separator.size() * (count - 1);
+  return basic_string<CharT, Traits>::build(size, [&](CharT* out) {
+    bool first = true;
+    for (const auto& piece : pieces) {
+      const basic_string_view<CharT, Traits> v = piece;
+      if (!first && !separator.empty()) {
+        Traits::copy(out, separator.data(), separator.size());
+        out += separator.size();
+      }
+      first = false;
+      if (!v.empty()) {
+        Traits::copy(out, v.data(), v.size());
+        out += v.size();
+      }
+    }
+  });
+}
+
+/**
+ * Copy of the string with every (non-overlapping, leftmost first) occurrence
+ * of from replaced with to. The occurrences are counted first, then the
+ * string is copied between them; both passes use the vectorized substring
+ * search. Throws std::invalid_argument if from is empty.
+ */
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> replace_all(
+    basic_string_view<CharT, Traits> str,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type from,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type to) {
+  if (from.empty())
+    JASL_THROW(std::invalid_argument("replace_all: empty pattern"));
+  const CharT* const ptr = str.data();
+  const size_t size = str.size();
+  const size_t npos = static_cast<size_t>(-1);
+  size_t count = 0;
+  for (size_t pos = 0;;) {
+    const size_t found = inner::find_substring<CharT, Traits>(
+        ptr + pos, size - pos, from.data(), from.size());
+    if (found == npos)
+      break;
+    ++count;
+    pos += found + from.size();
+  }
+  const size_t result_size = size - count * from.size() + count * to.size();
+  return basic_string<CharT, Traits>::build(result_size, [&](CharT* out) {
+    size_t pos = 0;
+    for (size_t n = 0; n < count; ++n) {
+      const size_t found = inner::find_substring<CharT, Traits>(
+          ptr + pos, size - pos, from.data(), from.size());
+      if (found > 0)
+        Traits::copy(out, ptr + pos, found);
+      out += found;
+      if (!to.empty())
+        Traits::copy(out, to.data(), to.size());
+      out += to.size();
+      pos += found + from.size();
+    }
+    if (pos < size)
+      Traits::copy(out, ptr + pos, size - pos);
+  });
+}
+
+/**
+ * Copy of the string with the ASCII letters in lower case; the other
+ * characters (including the non-ASCII bytes of UTF-8) are not changed.
+ * Byte strings are converted 16 bytes at once.
+ */
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> to_lower(basic_string_view<CharT, Traits> str) {
+  return inner::map_ascii_case(str, 'A', 'Z');
+}
+
+/**
+ * Copy of the string with the ASCII letters in upper case, see to_lower.
+ */
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> to_upper(basic_string_view<CharT, Traits> str) {
+  return inner::map_ascii_case(str, 'a', 'z');
+}
+
+/*
+ * The same for the jasl::static_string and jasl::string.
+ */
+
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> replace_all(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& str,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type from,
+    typename inner::non_deduced<basic_string_view<CharT, Traits>>::type to) {
+  return replace_all(static_cast<basic_string_view<CharT, Traits>>(str), from,
+                     to);
+}
+
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> to_lower(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& str) {
+  return to_lower(static_cast<basic_string_view<CharT, Traits>>(str));
+}
+
+template <typename CharT, typename Traits>
+basic_string<CharT, Traits> to_upper(
+    const inner::string_view_bridge<basic_string_view<CharT, Traits>>& str) {
+  return to_upper(static_cast<basic_string_view<CharT, Traits>>(str));
+}
+
+}  // namespace jasl
@@ -0,0 +1,320 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_byte_compare.hpp"
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+
+namespace jasl {
+namespace inner {
+
+/*
+ * Multikey quicksort (Bentley-Sedgewick) on 8 byte keys: every string is
+ * represented by an entry which caches the 8 bytes of the string from the
+ * current depth as a word in lexicographic order. The partitioning compares
+ * only the cached words, so it doesn't touch the characters. The strings
+ * which are equal to the pivot in these 8 bytes are sorted from depth + 8;
+ * only their keys are reloaded.
+ *
+ * The keys are zero padded after the end of the string, so a string which
+ * ends within the key ("finished") is equal to the pivot also if the other
+ * strings have zero bytes there. The finished ones are prefixes of all the
+ * other equal strings, so they come first, ordered by their size.
+ */
+
+struct string_sort_entry {
+  uint64_t key;
+  const unsigned char* ptr;
+  size_t size;
+  size_t index;  // position of the element in the input
+};
+
+inline uint64_t string_sort_key(const unsigned char* ptr,
+                                size_t size,
+                                size_t depth) noexcept {
+  if (size >= depth + 8)
+    return to_lexicographic_order(load_u64(ptr + depth));
+  uint64_t key = 0;
+  for (size_t i = depth; i < size; ++i)
+    key |= static_cast<uint64_t>(ptr[i]) << (56 - 8 * (i - depth));
+  return key;
+}
+
+/**
+ * Order of two entries whose keys are loaded from depth.
+ */
+inline bool string_sort_less(const string_sort_entry& a,
+                             const string_sort_entry& b,
+                             size_t depth) noexcept {
+  if (a.key != b.key)
+    return a.key < b.key;
+  const size_t next = depth + 8;
+  const size_t a_rest = a.size > next ? a.size - next : 0;
+  const size_t b_rest = b.size > next ? b.size - next : 0;
+  if (a_rest == 0 && b_rest == 0)
+    return a.size < b.size;
+  const size_t common = std::min(a_rest, b_rest);
+  const int c =
+      common == 0 ? 0 : bytes_compare(a.ptr + next, b.ptr + next, common);
+  return c != 0 ? c < 0 : a_rest < b_rest;
+}
+
+inline void string_sort_insertion(string_sort_entry* a,
+                                  size_t size,
+                                  size_t depth) noexcept {
+  for (size_t i = 1; i < size; ++i) {
+    const string_sort_entry e = a[i];
+    size_t j = i;
+    for (; j > 0 && string_sort_less(e, a[j - 1], depth); --j)
+      a[j] = a[j - 1];
+    a[j] = e;
+  }
+}
+
+inline uint64_t median_of_three(uint64_t a, uint64_t b, uint64_t c) noexcept {
+  return a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+}
+
+/**
+ * One partitioning step of the range loaded from depth: a[0, less) are less
+ * than the pivot key, a[greater, size) are greater; a[less, unfinished) are
+ * the finished strings equal to the pivot, sorted already; the keys of
+ * a[unfinished, greater) are reloaded from depth + 8.
+ */
+struct string_sort_split {
+  size_t less;
+  size_t unfinished;
+  size_t greater;
+};
+
+inline string_sort_split string_sort_partition(string_sort_entry* a,
+                                               size_t size,
+                                               size_t depth) {
+  const uint64_t pivot =
+      median_of_three(a[0].key, a[size / 2].key, a[size - 1].key);
+  size_t lt = 0;
+  size_t i = 0;
+  size_t gt = size;
+  while (i < gt) {
+    if (a[i].key < pivot)
+      std::swap(a[lt++], a[i++]);
+    else if (a[i].key > pivot)
+      std::swap(a[i], a[--gt]);
+    else
+      ++i;
+  }
+  const size_t next = depth + 8;
+  string_sort_entry* const unfinished =
+      std::partition(a + lt, a + gt, [next](const string_sort_entry& e) {
+        return e.size <= next;
+      });
+  std::sort(a + lt, unfinished,
+            [](const string_sort_entry& x, const string_sort_entry& y) {
+              return x.size < y.size;
+            });
+  for (string_sort_entry* e = unfinished; e != a + gt; ++e)
+    e->key = string_sort_key(e->ptr, e->size, next);
+  string_sort_split split = {lt, static_cast<size_t>(unfinished - a), gt};
+  return split;
+}
+
+/**
+ * budget limits the depth of the recursion on the less and greater parts
+ * (2 log2(size) at the start, like introsort); when it runs out the range
+ * is finished by std::sort.
+ */
+inline void multikey_quicksort(string_sort_entry* a,
+                               size_t size,
+                               size_t depth,
+                               size_t budget) {
+  while (size > 32) {
+    if (budget == 0) {
+      std::sort(a, a + size,
+                [depth](const string_sort_entry& x,
+                        const string_sort_entry& y) {
+                  return string_sort_less(x, y, depth);
+                });
+      return;
+    }
+    --budget;
+    const string_sort_split split = string_sort_partition(a, size, depth);
+    multikey_quicksort(a, split.less, depth, budget);
+    multikey_quicksort(a + split.greater, size - split.greater, depth, budget);
+    a += split.unfinished;
+    size = split.greater - split.unfinished;
+    depth += 8;
+  }
+  string_sort_insertion(a, size, depth);
+}
+
+inline size_t string_sort_budget(size_t size) noexcept {
+  size_t budget = 0;
+  for (; size > 1; size >>= 1)
+    budget += 2;
+  return budget;
+}
+
+template <typename RandomIt>
+void string_sort_load(RandomIt first,
+                      string_sort_entry* entries,
+                      size_t begin,
+                      size_t end) {
+  typedef typename std::iterator_traits<RandomIt>::difference_type
+      difference_type;
+  for (size_t i = begin; i < end; ++i) {
+    const auto& str = first[static_cast<difference_type>(i)];
+    string_sort_entry& e = entries[i];
+    e.ptr = reinterpret_cast<const unsigned char*>(str.data());
+    e.size = str.size();
+    e.index = i;
+    e.key = string_sort_key(e.ptr, e.size, 0);
+  }
+}
+
+/**
+ * Moves the elements into the sorted order: the i-th element is the one
+ * which was at entries[i].index. They are gathered into a temporary array
+ * and moved back: the reads are independent of each other, unlike the
+ * rotation of the cycles of the permutation.
+ */
+template <typename RandomIt>
+void string_sort_apply(RandomIt first,
+                       const string_sort_entry* entries,
+                       size_t size) {
+  typedef typename std::iterator_traits<RandomIt>::value_type element_type;
+  typedef typename std::iterator_traits<RandomIt>::difference_type
+      difference_type;
+  std::vector<element_type> sorted;
+  sorted.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    sorted.push_back(
+        std::move(first[static_cast<difference_type>(entries[i].index)]));
+  }
+  std::move(sorted.begin(), sorted.end(), first);
+}
+
+template <typename RandomIt>
+void check_string_sort_element() {
+  typedef typename std::iterator_traits<RandomIt>::value_type element_type;
+  static_assert(is_byte_char<typename element_type::value_type,
+                             typename element_type::traits_type>::value,
+                "Only single byte characters are supported.");
+}
+
+}  // namespace inner
+
+/**
+ * Sorts the strings of the range lexicographically (as
+ * basic_string_view::compare). The elements can be jasl::string_view-s,
+ * jasl::static_string-s, jasl::string-s, [std::string]-s or anything else
+ * with data(), size(), value_type and traits_type.
+ *
+ * The order is computed on an array of entries holding the pointer, the size
+ * and 8 cached bytes of each string (multikey quicksort on the cached words),
+ * so most of the comparisons don't dereference the strings. Then the
+ * elements are moved into place through a temporary array. It is not
+ * stable, and it allocates 32 bytes plus an element per element
+ * temporarily.
+ *
+ * Only single byte characters with the standard traits are supported.
+ */
+template <typename RandomIt>
+void string_sort(RandomIt first, RandomIt last) {
+  inner::check_string_sort_element<RandomIt>();
+  const size_t size = static_cast<size_t>(std::distance(first, last));
+  if (size < 2)
+    return;
+  std::unique_ptr<inner::string_sort_entry[]> entries(
+      new inner::string_sort_entry[size]);
+  inner::string_sort_load(first, entries.get(), 0, size);
+  inner::multikey_quicksort(entries.get(), size, 0,
+                            inner::string_sort_budget(size));
+  inner::string_sort_apply(first, entries.get(), size);
+}
+
+/**
+ * jasl::string_sort on a thread pool. The keys are loaded in chunks by the
+ * threads, then the largest ranges are partitioned on the calling thread
+ * until there are enough small ones (about 8 per thread); those are sorted by
+ * the threads, the largest first. The partitioning shares the depth budget
+ * of the serial sort: a range which runs out of it is left to the threads,
+ * which finish it by std::sort. Moving the elements into place happens on
+ * the calling thread. Small ranges are sorted on the calling thread.
+ */
+template <typename RandomIt>
+void parallel_string_sort(RandomIt first,
+                          RandomIt last,
+                          thread_pool& pool = default_thread_pool()) {
+  inner::check_string_sort_element<RandomIt>();
+  const size_t size = static_cast<size_t>(std::distance(first, last));
+  const size_t threads = pool.size();
+  if (threads == 1 || size < 65536) {
+    string_sort(first, last);
+    return;
+  }
+  std::unique_ptr<inner::string_sort_entry[]> entries(
+      new inner::string_sort_entry[size]);
+  inner::string_sort_entry* const a = entries.get();
+  const size_t load_chunks = threads * 4;
+  pool.run(load_chunks, [&](size_t c) {
+    inner::string_sort_load(first, a, size * c / load_chunks,
+                            size * (c + 1) / load_chunks);
+  });
+
+  struct range {
+    size_t begin;
+    size_t size;
+    size_t depth;
+    size_t budget;
+  };
+  const size_t small = size / (threads * 8);
+  std::vector<range> pending(
+      1, range{0, size, 0, inner::string_sort_budget(size)});
+  std::vector<range> ready;
+  while (!pending.empty()) {
+    const range r = pending.back();
+    pending.pop_back();
+    if (r.size <= small || r.budget == 0) {
+      if (r.size > 1)
+        ready.push_back(r);
+      continue;
+    }
+    const size_t budget = r.budget - 1;
+    const inner::string_sort_split split =
+        inner::string_sort_partition(a + r.begin, r.size, r.depth);
+    pending.push_back(range{r.begin, split.less, r.depth, budget});
+    pending.push_back(range{r.begin + split.unfinished,
+                            split.greater - split.unfinished, r.depth + 8,
+                            budget});
+    pending.push_back(range{r.begin + split.greater, r.size - split.greater,
+                            r.depth, budget});
+  }
+  std::sort(ready.begin(), ready.end(), [](const range& x, const range& y) {
+    return x.size > y.size;
+  });
+  pool.run(ready.size(), [&](size_t i) {
+    const range& r = ready[i];
+    inner::multikey_quicksort(a + r.begin, r.size, r.depth, r.budget);
+  });
+  inner::string_sort_apply(first, a, size);
+}
+
+}  // namespace jasl
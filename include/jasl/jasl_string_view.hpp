@@ -10,10 +10,13 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 
+#include "jasl/jasl_internal/jasl_byte_compare.hpp"
+#include "jasl/jasl_internal/jasl_char_set.hpp"
 #include "jasl/jasl_internal/jasl_common.hpp"
 #include "jasl/jasl_internal/jasl_feature_test_macro.hpp"
 
@@ -277,7 +280,7 @@ class basic_string_view {
   JASL_CONSTEXPR_CXX14 int compare(const basic_string_view& right) const
       noexcept {
     size_type rlen = std::min(size(), right.size());
-    int retval = Traits::compare(data(), right.data(), rlen);
+    int retval = inner::compare<CharT, Traits>(data(), right.data(), rlen);
     if (retval == 0)  // first rlen chars matched
       retval = size() == right.size() ? 0 : (size() < right.size() ? -1 : 1);
     return retval;
@@ -287,26 +290,158 @@ class basic_string_view {
   size_type find(const basic_string_view& s) const noexcept {
     JASL_ASSERT(s.size() == 0 || s.data() != nullptr,
                 "string_view::find(): received nullptr");
-    auto itWhere = cbegin();
-    auto itWhat = s.cbegin();
-    while (itWhere != cend() && itWhat != s.cend()) {
-      if (*itWhere != *itWhat) {
-        ++itWhere;
-      } else {
-        auto match = itWhere++;
-        ++itWhat;
-        while (itWhere != cend() && itWhat != s.cend() && *itWhere == *itWhat) {
-          ++itWhere;
-          ++itWhat;
-        }
-        if (itWhat == s.cend()) {
-          return static_cast<size_type>(match - cbegin());
-        }
-        itWhat = s.cbegin();
-      }
+    if (s.size() > size())
+      return npos;
+    if (s.size() == 0)
+      return 0;
+    for (size_type i = 0; i <= size() - s.size(); ++i) {
+      if (Traits::eq(_ptr[i], s._ptr[0]) &&
+          Traits::compare(_ptr + i, s._ptr, s.size()) == 0)
+        return i;
     }
     return npos;
   }
+
+  JASL_CONSTEXPR_CXX14 size_type rfind(const basic_string_view& s,
+                                       size_type pos = npos) const noexcept {
+    JASL_ASSERT(s.size() == 0 || s.data() != nullptr,
+                "string_view::rfind(): received nullptr");
+    if (s.size() > size())
+      return npos;
+    size_type i = std::min(size() - s.size(), pos);
+    if (s.size() == 0)
+      return i;
+    do {
+      if (Traits::eq(_ptr[i], s._ptr[0]) &&
+          Traits::compare(_ptr + i, s._ptr, s.size()) == 0)
+        return i;
+    } while (i-- > 0);
+    return npos;
+  }
+  JASL_CONSTEXPR_CXX14 size_type rfind(CharT c, size_type pos = npos) const
+      noexcept {
+    if (empty())
+      return npos;
+    for (size_type i = std::min(size() - 1, pos) + 1; i-- > 0;) {
+      if (Traits::eq(_ptr[i], c))
+        return i;
+    }
+    return npos;
+  }
+  JASL_CONSTEXPR_CXX14 size_type rfind(const CharT* s,
+                                       size_type pos,
+                                       size_type n) const noexcept {
+    return rfind(basic_string_view(s, n), pos);
+  }
+  JASL_CONSTEXPR_CXX14 size_type rfind(const CharT* s,
+                                       size_type pos = npos) const noexcept {
+    return rfind(basic_string_view(s, Traits::length(s)), pos);
+  }
+
+  JASL_CONSTEXPR_CXX14 size_type find_first_of(const basic_string_view& s,
+                                               size_type pos = 0) const
+      noexcept {
+    return inner::find_first_of<CharT, Traits>(_ptr, _size, s._ptr, s._size,
+                                               pos, true);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_first_of(CharT c,
+                                               size_type pos = 0) const
+      noexcept {
+    if (pos >= size())
+      return npos;
+    const CharT* found = Traits::find(_ptr + pos, size() - pos, c);
+    return found == nullptr ? npos : static_cast<size_type>(found - _ptr);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_first_of(const CharT* s,
+                                               size_type pos,
+                                               size_type n) const noexcept {
+    return find_first_of(basic_string_view(s, n), pos);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_first_of(const CharT* s,
+                                               size_type pos = 0) const
+      noexcept {
+    return find_first_of(basic_string_view(s, Traits::length(s)), pos);
+  }
+
+  JASL_CONSTEXPR_CXX14 size_type find_last_of(const basic_string_view& s,
+                                              size_type pos = npos) const
+      noexcept {
+    if (empty())
+      return npos;
+    return inner::find_last_of<CharT, Traits>(
+        _ptr, s._ptr, s._size, std::min(size() - 1, pos), true);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_last_of(CharT c,
+                                              size_type pos = npos) const
+      noexcept {
+    return rfind(c, pos);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_last_of(const CharT* s,
+                                              size_type pos,
+                                              size_type n) const noexcept {
+    return find_last_of(basic_string_view(s, n), pos);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_last_of(const CharT* s,
+                                              size_type pos = npos) const
+      noexcept {
+    return find_last_of(basic_string_view(s, Traits::length(s)), pos);
+  }
+
+  JASL_CONSTEXPR_CXX14 size_type find_first_not_of(const basic_string_view& s,
+                                                   size_type pos = 0) const
+      noexcept {
+    return inner::find_first_of<CharT, Traits>(_ptr, _size, s._ptr, s._size,
+                                               pos, false);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_first_not_of(CharT c,
+                                                   size_type pos = 0) const
+      noexcept {
+    for (size_type i = pos; i < size(); ++i) {
+      if (!Traits::eq(_ptr[i], c))
+        return i;
+    }
+    return npos;
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_first_not_of(const CharT* s,
+                                                   size_type pos,
+                                                   size_type n) const noexcept {
+    return find_first_not_of(basic_string_view(s, n), pos);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_first_not_of(const CharT* s,
+                                                   size_type pos = 0) const
+      noexcept {
+    return find_first_not_of(basic_string_view(s, Traits::length(s)), pos);
+  }
+
+  JASL_CONSTEXPR_CXX14 size_type find_last_not_of(const basic_string_view& s,
+                                                  size_type pos = npos) const
+      noexcept {
+    if (empty())
+      return npos;
+    return inner::find_last_of<CharT, Traits>(
+        _ptr, s._ptr, s._size, std::min(size() - 1, pos), false);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_last_not_of(CharT c,
+                                                  size_type pos = npos) const
+      noexcept {
+    if (empty())
+      return npos;
+    for (size_type i = std::min(size() - 1, pos) + 1; i-- > 0;) {
+      if (!Traits::eq(_ptr[i], c))
+        return i;
+    }
+    return npos;
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_last_not_of(const CharT* s,
+                                                  size_type pos,
+                                                  size_type n) const noexcept {
+    return find_last_not_of(basic_string_view(s, n), pos);
+  }
+  JASL_CONSTEXPR_CXX14 size_type find_last_not_of(const CharT* s,
+                                                  size_type pos = npos) const
+      noexcept {
+    return find_last_not_of(basic_string_view(s, Traits::length(s)), pos);
+  }
 };
 
 // http://en.cppreference.com/w/cpp/algorithm/lexicographical_compare
@@ -318,14 +453,14 @@ JASL_CONSTEXPR_CXX14 bool operator==(
   if (left.size() != right.size()) {
     return false;
   }
-  return left.compare(right) == 0;
+  return inner::equal<CharT, Traits>(left.data(), right.data(), left.size());
 }
 
 template <typename CharT, typename Traits>
 JASL_CONSTEXPR_CXX14 bool operator!=(
     const basic_string_view<CharT, Traits>& left,
     const basic_string_view<CharT, Traits>& right) {
-  return left.compare(right) != 0;
+  return !(left == right);
 }
 
 template <typename CharT, typename Traits>
@@ -397,7 +532,7 @@ struct hash<jasl::nonstd::basic_string_view<CharT, Traits>> {
 };
 }  // namespace std
 #  else
-#    include "jasl/jasl_internal/jasl_murmurhash3.hpp"
+#    include "jasl/jasl_streaming_murmurhash3.hpp"
 namespace std {
 template <typename CharT, typename Traits>
 struct hash<jasl::nonstd::basic_string_view<CharT, Traits>> {
@@ -405,13 +540,12 @@ struct hash<jasl::nonstd::basic_string_view<CharT, Traits>> {
       const jasl::nonstd::basic_string_view<CharT, Traits>& x) const noexcept {
     static_assert(sizeof(size_t) <= 16, "Unexpected platform!");
     size_t res[16 / sizeof(size_t)];
-    auto len = static_cast<int>(
-        std::min(x.size() * sizeof(CharT),
-                 static_cast<size_t>(std::numeric_limits<int>::max())));
     if (sizeof(size_t) >= 8) {
-      jasl::murmurhash3::MurmurHash3_x64_128(x.data(), len, 33, &res);
+      jasl::murmurhash3_x64_128::hash(x.data(), x.size() * sizeof(CharT), 33,
+                                      &res);
     } else {
-      jasl::murmurhash3::MurmurHash3_x86_128(x.data(), len, 33, &res);
+      jasl::murmurhash3_x86_128::hash(x.data(), x.size() * sizeof(CharT), 33,
+                                      &res);
     }
     return res[0];
   }
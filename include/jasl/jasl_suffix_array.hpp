@@ -0,0 +1,392 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+
+namespace jasl {
+namespace inner {
+
+constexpr uint32_t sais_empty = static_cast<uint32_t>(-1);
+
+/**
+ * Suffix array of s[0, n) over the alphabet [0, upper] by induced sorting
+ * (SA-IS, Nong-Zhang-Chan) in linear time: the LMS suffixes (the S-type
+ * suffixes after an L-type one) are sorted by inducing from their first
+ * characters, the LMS substrings are named and sorted recursively if they
+ * are not unique, and the other suffixes are induced from the sorted LMS
+ * suffixes.
+ */
+template <typename SymbolT>
+void sais(const SymbolT* s, uint32_t n, uint32_t upper, uint32_t* sa) {
+  if (n == 0)
+    return;
+  if (n == 1) {
+    sa[0] = 0;
+    return;
+  }
+  if (n == 2) {
+    sa[0] = s[0] < s[1] ? 0 : 1;
+    sa[1] = 1 - sa[0];
+    return;
+  }
+
+  // is_s[i]: the suffix i is smaller than the suffix i + 1
+  std::vector<bool> is_s(n);
+  for (uint32_t i = n - 1; i-- > 0;)
+    is_s[i] = s[i] == s[i + 1] ? is_s[i + 1] : s[i] < s[i + 1];
+
+  // l_start[c]: the bucket of c, s_start[c]: its S-type part
+  std::vector<uint32_t> l_start(upper + 1);
+  std::vector<uint32_t> s_start(upper + 1);
+  for (uint32_t i = 0; i < n; ++i) {
+    if (is_s[i])
+      ++l_start[static_cast<uint32_t>(s[i]) + 1];
+    else
+      ++s_start[s[i]];
+  }
+  for (uint32_t c = 0; c <= upper; ++c) {
+    s_start[c] += l_start[c];
+    if (c < upper)
+      l_start[c + 1] += s_start[c];
+  }
+
+  std::vector<uint32_t> bucket(upper + 1);
+  auto induce = [&](const std::vector<uint32_t>& lms) {
+    std::fill(sa, sa + n, sais_empty);
+    bucket = s_start;
+    for (uint32_t d : lms)
+      sa[bucket[s[d]]++] = d;
+    bucket = l_start;
+    sa[bucket[s[n - 1]]++] = n - 1;
+    for (uint32_t i = 0; i < n; ++i) {
+      const uint32_t v = sa[i];
+      if (v != sais_empty && v >= 1 && !is_s[v - 1])
+        sa[bucket[s[v - 1]]++] = v - 1;
+    }
+    bucket = l_start;
+    for (uint32_t i = n; i-- > 0;) {
+      const uint32_t v = sa[i];
+      if (v != sais_empty && v >= 1 && is_s[v - 1])
+        sa[--bucket[static_cast<uint32_t>(s[v - 1]) + 1]] = v - 1;
+    }
+  };
+
+  std::vector<uint32_t> lms_index(n, sais_empty);
+  std::vector<uint32_t> lms;
+  for (uint32_t i = 1; i < n; ++i) {
+    if (!is_s[i - 1] && is_s[i]) {
+      lms_index[i] = static_cast<uint32_t>(lms.size());
+      lms.push_back(i);
+    }
+  }
+  const uint32_t m = static_cast<uint32_t>(lms.size());
+  induce(lms);
+  if (m == 0)
+    return;
+
+  // names of the LMS substrings in sorted order
+  std::vector<uint32_t> sorted_lms;
+  sorted_lms.reserve(m);
+  for (uint32_t i = 0; i < n; ++i) {
+    if (lms_index[sa[i]] != sais_empty)
+      sorted_lms.push_back(sa[i]);
+  }
+  std::vector<uint32_t> reduced(m);
+  uint32_t reduced_upper = 0;
+  reduced[lms_index[sorted_lms[0]]] = 0;
+  for (uint32_t i = 1; i < m; ++i) {
+    uint32_t l = sorted_lms[i - 1];
+    uint32_t r = sorted_lms[i];
+    const uint32_t end_l = lms_index[l] + 1 < m ? lms[lms_index[l] + 1] : n;
+    const uint32_t end_r = lms_index[r] + 1 < m ? lms[lms_index[r] + 1] : n;
+    bool same = end_l - l == end_r - r;
+    if (same) {
+      while (l < end_l && s[l] == s[r]) {
+        ++l;
+        ++r;
+      }
+      same = l != n && r != n && s[l] == s[r];
+    }
+    if (!same)
+      ++reduced_upper;
+    reduced[lms_index[sorted_lms[i]]] = reduced_upper;
+  }
+  lms_index.clear();
+  lms_index.shrink_to_fit();
+
+  std::vector<uint32_t> reduced_sa(m);
+  sais(reduced.data(), m, reduced_upper, reduced_sa.data());
+  for (uint32_t i = 0; i < m; ++i)
+    sorted_lms[i] = lms[reduced_sa[i]];
+  induce(sorted_lms);
+}
+
+/**
+ * Calls task(i) for every i in [0, count) on pool, or on the calling thread
+ * if pool is nullptr.
+ */
+template <typename TaskT>
+void run_chunks(thread_pool* pool, size_t count, TaskT&& task) {
+  if (pool != nullptr) {
+    pool->run(count, task);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i)
+    task(i);
+}
+
+/**
+ * lcp[r] = LCP(suffix sa[r - 1], suffix sa[r]) by the permuted LCP array
+ * (Karkkainen-Manzini-Puglisi): plcp[sa[r]] = lcp[r] decreases by at most
+ * one from a position to the next one, so the comparisons continue from the
+ * previous value. The positions are processed in chunk_count independent
+ * chunks (each restarts from 0), on pool if it isn't nullptr.
+ */
+inline void lcp_array(const unsigned char* text,
+                      uint32_t n,
+                      const uint32_t* sa,
+                      uint32_t* lcp,
+                      thread_pool* pool) {
+  const size_t chunk_count = pool != nullptr ? pool->size() * 4 : 1;
+  if (n == 0)
+    return;
+  // phi[p]: the suffix before suffix p in the suffix array, then plcp[p]
+  std::vector<uint32_t> plcp(n);
+  run_chunks(pool, chunk_count, [&](size_t c) {
+    const size_t begin = n * c / chunk_count;
+    const size_t end = n * (c + 1) / chunk_count;
+    for (size_t r = begin; r < end; ++r)
+      plcp[sa[r]] = r == 0 ? sais_empty : sa[r - 1];
+  });
+  run_chunks(pool, chunk_count, [&](size_t c) {
+    const uint32_t begin = static_cast<uint32_t>(n * c / chunk_count);
+    const uint32_t end = static_cast<uint32_t>(n * (c + 1) / chunk_count);
+    uint32_t h = 0;
+    for (uint32_t p = begin; p < end; ++p) {
+      const uint32_t q = plcp[p];
+      if (q == sais_empty) {
+        plcp[p] = 0;
+        h = 0;
+        continue;
+      }
+      while (p + h < n && q + h < n && text[p + h] == text[q + h])
+        ++h;
+      plcp[p] = h;
+      if (h > 0)
+        --h;
+    }
+  });
+  run_chunks(pool, chunk_count, [&](size_t c) {
+    const size_t begin = n * c / chunk_count;
+    const size_t end = n * (c + 1) / chunk_count;
+    for (size_t r = begin; r < end; ++r)
+      lcp[r] = plcp[sa[r]];
+  });
+}
+
+}  // namespace inner
+
+/**
+ * Full-text index of a string: its suffix array (the start positions of the
+ * suffixes in lexicographic order) and LCP array (the length of the longest
+ * common prefix of the neighbouring suffixes).
+ *
+ * The suffix array is built by SA-IS in linear time, the LCP array by the
+ * permuted LCP method. The occurrences of a pattern are a range of the suffix
+ * array, found by binary search in O(m log n) without scanning the text; the
+ * comparisons skip the characters which are known to match both ends of the
+ * range.
+ *
+ * The text isn't copied, it has to outlive the index. The index takes 8
+ * bytes per character (see memory_usage()); the texts of 4 GiB or longer are
+ * rejected with std::length_error.
+ *
+ * Only single byte characters with the standard traits are supported.
+ */
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_suffix_array {
+  static_assert(inner::is_byte_char<CharT, Traits>::value,
+                "Only single byte characters are supported.");
+
+ public:
+  typedef basic_string_view<CharT, Traits> string_view_type;
+
+  constexpr static size_t npos = static_cast<size_t>(-1);
+
+ private:
+  string_view_type _text;
+  std::vector<uint32_t> _sa;
+  std::vector<uint32_t> _lcp;
+
+ public:
+  explicit basic_suffix_array(string_view_type text) : _text(text) {
+    build(nullptr);
+  }
+
+  /**
+   * Builds the LCP array on the threads of pool; the SA-IS construction of
+   * the suffix array is sequential.
+   */
+  basic_suffix_array(string_view_type text, thread_pool& pool) : _text(text) {
+    build(&pool);
+  }
+
+  string_view_type text() const noexcept { return _text; }
+
+  /**
+   * Number of suffixes: the size of the text.
+   */
+  size_t size() const noexcept { return _sa.size(); }
+
+  /**
+   * Start position of the suffix of the given rank in lexicographic order.
+   */
+  size_t suffix(size_t rank) const noexcept {
+    JASL_ASSERT(rank < _sa.size(), "rank < size()");
+    return _sa[rank];
+  }
+
+  /**
+   * Length of the longest common prefix of the suffixes of rank - 1 and
+   * rank, 0 for rank 0.
+   */
+  size_t lcp(size_t rank) const noexcept {
+    JASL_ASSERT(rank < _lcp.size(), "rank < size()");
+    return _lcp[rank];
+  }
+
+  /**
+   * The ranks [first, second) of the suffixes which start with pattern. The
+   * empty pattern matches every suffix.
+   */
+  std::pair<size_t, size_t> equal_range(string_view_type pattern) const
+      noexcept {
+    const size_t first = bound(pattern, 0, false);
+    return std::make_pair(first, bound(pattern, first, true));
+  }
+
+  size_t count(string_view_type pattern) const noexcept {
+    const std::pair<size_t, size_t> range = equal_range(pattern);
+    return range.second - range.first;
+  }
+
+  /**
+   * Position of an occurrence of pattern (not necessarily the first one),
+   * npos if there is none.
+   */
+  size_t find(string_view_type pattern) const noexcept {
+    const size_t first = bound(pattern, 0, false);
+    return first < _sa.size() && match(pattern, _sa[first]) ? _sa[first]
+                                                            : npos;
+  }
+
+  /**
+   * Positions of every occurrence of pattern in increasing order.
+   */
+  std::vector<size_t> locate(string_view_type pattern) const {
+    const std::pair<size_t, size_t> range = equal_range(pattern);
+    std::vector<size_t> result(_sa.begin() + static_cast<std::ptrdiff_t>(
+                                                 range.first),
+                               _sa.begin() + static_cast<std::ptrdiff_t>(
+                                                 range.second));
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /**
+   * The longest substring which occurs at least twice (the first one in
+   * lexicographic order if there are more), empty if there is none.
+   */
+  string_view_type longest_repeated_substring() const noexcept {
+    size_t best = 0;
+    for (size_t r = 1; r < _lcp.size(); ++r) {
+      if (_lcp[r] > _lcp[best])
+        best = r;
+    }
+    return _lcp.empty() ? string_view_type()
+                        : _text.substr(_sa[best], _lcp[best]);
+  }
+
+  /**
+   * Bytes allocated by the index; the text is not included.
+   */
+  size_t memory_usage() const noexcept {
+    return (_sa.capacity() + _lcp.capacity()) * sizeof(uint32_t);
+  }
+
+ private:
+  void build(thread_pool* pool) {
+    if (_text.size() >= inner::sais_empty)
+      JASL_THROW(std::length_error("suffix_array: the text is too long"));
+    const uint32_t n = static_cast<uint32_t>(_text.size());
+    const unsigned char* const text =
+        reinterpret_cast<const unsigned char*>(_text.data());
+    _sa.resize(n);
+    inner::sais(text, n, 255, _sa.data());
+    _lcp.resize(n);
+    inner::lcp_array(text, n, _sa.data(), _lcp.data(), pool);
+  }
+
+  bool match(string_view_type pattern, size_t pos) const noexcept {
+    return _text.size() - pos >= pattern.size() &&
+           _text.substr(pos, pattern.size()) == pattern;
+  }
+
+  /**
+   * The first rank from first whose suffix is not less than pattern
+   * (upper: is greater than pattern) in its first pattern.size() characters.
+   * known_left and known_right are the common prefixes of pattern and the
+   * suffixes around the range, every suffix inside shares the smaller one.
+   */
+  size_t bound(string_view_type pattern, size_t first, bool upper) const
+      noexcept {
+    const unsigned char* const text =
+        reinterpret_cast<const unsigned char*>(_text.data());
+    const unsigned char* const p =
+        reinterpret_cast<const unsigned char*>(pattern.data());
+    const size_t n = _text.size();
+    const size_t m = pattern.size();
+    size_t lo = first;
+    size_t hi = _sa.size();
+    size_t known_left = 0;
+    size_t known_right = 0;
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      const size_t pos = _sa[mid];
+      size_t k = std::min(known_left, known_right);
+      while (k < m && pos + k < n && text[pos + k] == p[k])
+        ++k;
+      const bool go_right =
+          k == m ? upper : pos + k == n || text[pos + k] < p[k];
+      if (go_right) {
+        lo = mid + 1;
+        known_left = k;
+      } else {
+        hi = mid;
+        known_right = k;
+      }
+    }
+    return lo;
+  }
+};
+
+typedef basic_suffix_array<char> suffix_array;
+
+}  // namespace jasl
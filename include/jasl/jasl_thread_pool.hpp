@@ -0,0 +1,169 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_diagnostic.hpp"
+
+namespace jasl {
+
+/**
+ * Fixed set of worker threads which execute indexed tasks.
+ *
+ * run(task_count, task) calls task(i) for every i in [0, task_count): the
+ * workers and the calling thread take the next index from a shared counter,
+ * so the tasks start in increasing order and the faster threads take more of
+ * them. It returns when every task has finished; the first exception thrown
+ * by a task is rethrown (the tasks which haven't started yet are skipped).
+ *
+ * The runs are serialized: a run called from an other thread waits for the
+ * current one. A task must not call run of the same pool.
+ */
+class thread_pool {
+  std::vector<std::thread> _workers;
+  std::mutex _run_mutex;  // serializes the runs
+  std::mutex _mutex;      // guards the fields below
+  std::condition_variable _wake;
+  std::condition_variable _finished;
+  const std::function<void(size_t)>* _task;
+  size_t _task_count;
+  std::atomic<size_t> _next;
+  size_t _generation;
+  size_t _busy;  // the workers which haven't finished the current run
+  bool _stop;
+  std::exception_ptr _error;
+
+ public:
+  /**
+   * thread_count is the number of the threads which execute the tasks,
+   * including the calling thread of run. 0 means
+   * std::thread::hardware_concurrency().
+   */
+  explicit thread_pool(size_t thread_count = 0)
+      : _task(nullptr),
+        _task_count(0),
+        _next(0),
+        _generation(0),
+        _busy(0),
+        _stop(false) {
+    if (thread_count == 0)
+      thread_count = std::thread::hardware_concurrency();
+    for (size_t i = 1; i < thread_count; ++i)
+      _workers.emplace_back([this] { worker(); });
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _wake.notify_all();
+    for (std::thread& worker : _workers)
+      worker.join();
+  }
+
+  /**
+   * The number of the threads which execute the tasks of a run.
+   */
+  size_t size() const noexcept { return _workers.size() + 1; }
+
+  template <typename TaskT>
+  void run(size_t task_count, TaskT&& task) {
+    if (task_count == 0)
+      return;
+    const std::function<void(size_t)> function(std::ref(task));
+    std::lock_guard<std::mutex> run_lock(_run_mutex);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _task = &function;
+      _task_count = task_count;
+      _next.store(0);
+      _busy = _workers.size();
+      _error = nullptr;
+      ++_generation;
+    }
+    _wake.notify_all();
+    work();
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _finished.wait(lock, [this] { return _busy == 0; });
+      _task = nullptr;
+      error = _error;
+      _error = nullptr;
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+ private:
+  void worker() {
+    size_t seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wake.wait(lock, [&] { return _stop || _generation != seen; });
+        if (_stop)
+          return;
+        seen = _generation;
+      }
+      work();
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (--_busy == 0)
+        _finished.notify_one();
+    }
+  }
+
+  void work() {
+    for (;;) {
+      const size_t i = _next.fetch_add(1);
+      if (i >= _task_count)
+        return;
+#ifdef JASL_TERMINATE_ON_EXCEPTION_ON
+      (*_task)(i);
+#else
+      try {
+        (*_task)(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_error)
+          _error = std::current_exception();
+        _next.store(_task_count);
+      }
+#endif
+    }
+  }
+};
+
+/**
+ * The pool of the functions which take an optional pool argument, with
+ * std::thread::hardware_concurrency() threads. It is created at the first
+ * call.
+ */
+inline thread_pool& default_thread_pool() {
+  JASL_DIAGNOSTIC_PUSH()
+  JASL_DIAGNOSTIC_IGNORED_CLANG("-Wexit-time-destructors")
+  static thread_pool pool;
+  JASL_DIAGNOSTIC_POP()
+  return pool;
+}
+
+}  // namespace jasl
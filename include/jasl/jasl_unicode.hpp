@@ -0,0 +1,1053 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+/** @file */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_internal/jasl_simd.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+namespace jasl {
+namespace inner {
+
+/**
+ * A decoded UTF-8, UTF-16 or UTF-32 sequence, the length is in code units. An
+ * invalid one is the maximal subpart of an ill-formed sequence (at least one
+ * code unit) and decodes to U+FFFD, as the Unicode standard recommends for the
+ * replacement.
+ */
+struct decoded_sequence {
+  char32_t code_point;
+  size_t length;
+  bool valid;
+};
+
+/**
+ * Decodes the sequence at the beginning of [ptr, ptr + size), size > 0. The
+ * valid sequences are the ones of the Unicode standard's "Well-Formed UTF-8
+ * Byte Sequences" table: no overlong forms, no surrogates, nothing above
+ * U+10FFFF.
+ */
+inline decoded_sequence decode_utf8(const unsigned char* ptr,
+                                    size_t size) noexcept {
+  const unsigned char c = ptr[0];
+  if (c < 0x80)
+    return {c, 1, true};
+  size_t length;
+  char32_t code_point;
+  unsigned char low = 0x80;  // the range of the second byte
+  unsigned char high = 0xBF;
+  if (c < 0xC2) {
+    return {0xFFFD, 1, false};
+  } else if (c < 0xE0) {
+    length = 2;
+    code_point = c & 0x1Fu;
+  } else if (c < 0xF0) {
+    length = 3;
+    code_point = c & 0x0Fu;
+    if (c == 0xE0)
+      low = 0xA0;
+    else if (c == 0xED)
+      high = 0x9F;
+  } else if (c < 0xF5) {
+    length = 4;
+    code_point = c & 0x07u;
+    if (c == 0xF0)
+      low = 0x90;
+    else if (c == 0xF4)
+      high = 0x8F;
+  } else {
+    return {0xFFFD, 1, false};
+  }
+  for (size_t i = 1; i < length; ++i) {
+    if (i == size || ptr[i] < low || ptr[i] > high)
+      return {0xFFFD, i, false};
+    code_point = (code_point << 6) | (ptr[i] & 0x3Fu);
+    low = 0x80;
+    high = 0xBF;
+  }
+  return {code_point, length, true};
+}
+
+/**
+ * The number of the ASCII bytes at the beginning.
+ */
+inline size_t ascii_prefix(const unsigned char* ptr, size_t size) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  for (; i + 16 <= size; i += 16) {
+    const int mask = _mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i)));
+    if (mask != 0)
+      return i + count_trailing_zeros(static_cast<uint32_t>(mask));
+  }
+#elif JASL_INNER_LITTLE_ENDIAN
+  for (; i + 8 <= size; i += 8) {
+    const uint64_t high = load_u64(ptr + i) & 0x8080808080808080ull;
+    if (high != 0)
+      return i + count_trailing_zeros64(high) / 8;
+  }
+#endif
+  while (i < size && ptr[i] < 0x80)
+    ++i;
+  return i;
+}
+
+inline bool is_ascii(const unsigned char* ptr, size_t size) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  for (; i + 64 <= size; i += 64) {
+    const __m128i* p = reinterpret_cast<const __m128i*>(ptr + i);
+    const __m128i any = _mm_or_si128(
+        _mm_or_si128(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+        _mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+    if (_mm_movemask_epi8(any) != 0)
+      return false;
+  }
+#else
+  for (; i + 32 <= size; i += 32) {
+    const uint64_t any = load_u64(ptr + i) | load_u64(ptr + i + 8) |
+                         load_u64(ptr + i + 16) | load_u64(ptr + i + 24);
+    if ((any & 0x8080808080808080ull) != 0)
+      return false;
+  }
+#endif
+  return ascii_prefix(ptr + i, size - i) == size - i;
+}
+
+/**
+ * Skips the ASCII runs vectorized, decodes the rest one sequence at a time.
+ */
+inline bool is_valid_utf8_scalar(const unsigned char* ptr,
+                                 size_t size) noexcept {
+  size_t i = 0;
+  while (i < size) {
+    if (ptr[i] < 0x80) {
+      i += ascii_prefix(ptr + i, size - i);
+      continue;
+    }
+    const decoded_sequence s = decode_utf8(ptr + i, size - i);
+    if (!s.valid)
+      return false;
+    i += s.length;
+  }
+  return true;
+}
+
+#if JASL_INNER_SSSE3
+
+/*
+ * The lookup algorithm of Keiser and Lemire ("Validating UTF-8 In Less Than
+ * One Instruction Per Byte"). Every error of a two byte window is detectable
+ * from the high nibble of the first byte, its low nibble and the high nibble
+ * of the second byte: three shuffles look up which errors each of them
+ * permits, and the window is invalid where all three agree. The missing or
+ * superfluous third and fourth continuation bytes are checked by comparing
+ * the bytes 2 and 3 positions back.
+ */
+enum : unsigned char {
+  utf8_too_short = 1 << 0,   // 11______ 0_______ or 11______ 11______
+  utf8_too_long = 1 << 1,    // 0_______ 10______
+  utf8_overlong_3 = 1 << 2,  // 11100000 100_____
+  utf8_too_large = 1 << 3,   // 11110100 1001____ ... 11111___ 101_____
+  utf8_surrogate = 1 << 4,   // 11101101 101_____
+  utf8_overlong_2 = 1 << 5,  // 1100000_ 10______
+  utf8_too_large_1000 = 1 << 6,  // 11110101 1000____ ... 11111___ 1000____
+  utf8_overlong_4 = 1 << 6,      // 11110000 1000____
+  utf8_two_conts = 1 << 7,       // 10______ 10______
+  utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts
+};
+
+class utf8_lookup_validator {
+  __m128i _error;
+  __m128i _previous;
+  __m128i _previous_incomplete;
+
+  static __m128i high_nibbles(__m128i x) noexcept {
+    return _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F));
+  }
+
+  static __m128i load(const unsigned char* table) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+  }
+
+  static __m128i special_cases(__m128i input, __m128i previous1) noexcept {
+    static const unsigned char byte_1_high[16] = {
+        // 0_______ ________
+        utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+        utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+        // 10______ ________
+        utf8_two_conts, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+        // 1100____ ________
+        utf8_too_short | utf8_overlong_2,
+        // 1101____ ________
+        utf8_too_short,
+        // 1110____ ________
+        utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+        // 1111____ ________
+        utf8_too_short | utf8_too_large | utf8_too_large_1000 |
+            utf8_overlong_4};
+    static const unsigned char byte_1_low[16] = {
+        // ____0000 ________
+        utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+        // ____0001 ________
+        utf8_carry | utf8_overlong_2,
+        // ____001_ ________
+        utf8_carry, utf8_carry,
+        // ____0100 ________
+        utf8_carry | utf8_too_large,
+        // ____0101 ________ ... ____1111 ________
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        // ____1101 ________
+        utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+        utf8_carry | utf8_too_large | utf8_too_large_1000,
+        utf8_carry | utf8_too_large | utf8_too_large_1000};
+    static const unsigned char byte_2_high[16] = {
+        // ________ 0_______
+        utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+        utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+        // ________ 1000____
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 |
+            utf8_too_large_1000 | utf8_overlong_4,
+        // ________ 1001____
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 |
+            utf8_too_large,
+        // ________ 101_____
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate |
+            utf8_too_large,
+        utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate |
+            utf8_too_large,
+        // ________ 11______
+        utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short};
+    const __m128i b1h =
+        _mm_shuffle_epi8(load(byte_1_high), high_nibbles(previous1));
+    const __m128i b1l = _mm_shuffle_epi8(
+        load(byte_1_low), _mm_and_si128(previous1, _mm_set1_epi8(0x0F)));
+    const __m128i b2h =
+        _mm_shuffle_epi8(load(byte_2_high), high_nibbles(input));
+    return _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+  }
+
+ public:
+  utf8_lookup_validator() noexcept
+      : _error(_mm_setzero_si128()),
+        _previous(_mm_setzero_si128()),
+        _previous_incomplete(_mm_setzero_si128()) {}
+
+  /**
+   * An ASCII block is valid unless the previous one ended too early.
+   */
+  void feed_ascii(__m128i last) noexcept {
+    _error = _mm_or_si128(_error, _previous_incomplete);
+    _previous_incomplete = _mm_setzero_si128();
+    _previous = last;
+  }
+
+  void feed(__m128i input) noexcept {
+    if (_mm_movemask_epi8(input) == 0) {
+      feed_ascii(input);
+      return;
+    }
+    const __m128i previous1 = _mm_alignr_epi8(input, _previous, 15);
+    const __m128i special = special_cases(input, previous1);
+    // the bytes which must be the third or the fourth of a sequence
+    const __m128i previous2 = _mm_alignr_epi8(input, _previous, 14);
+    const __m128i previous3 = _mm_alignr_epi8(input, _previous, 13);
+    const __m128i third = _mm_subs_epu8(
+        previous2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m128i fourth = _mm_subs_epu8(
+        previous3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m128i must_be_continuation =
+        _mm_and_si128(_mm_or_si128(third, fourth),
+                      _mm_set1_epi8(static_cast<char>(0x80)));
+    _error = _mm_or_si128(_error,
+                          _mm_xor_si128(must_be_continuation, special));
+    // 1111____ 111_____ 11______ at the end need more bytes
+    static const unsigned char incomplete_max[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+    _previous_incomplete = _mm_subs_epu8(input, load(incomplete_max));
+    _previous = input;
+  }
+
+  bool finish() noexcept {
+    _error = _mm_or_si128(_error, _previous_incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_error, _mm_setzero_si128())) ==
+           0xFFFF;
+  }
+};
+
+inline bool is_valid_utf8_ssse3(const unsigned char* ptr,
+                                size_t size) noexcept {
+  utf8_lookup_validator validator;
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    const __m128i* p = reinterpret_cast<const __m128i*>(ptr + i);
+    const __m128i a = _mm_loadu_si128(p);
+    const __m128i b = _mm_loadu_si128(p + 1);
+    const __m128i c = _mm_loadu_si128(p + 2);
+    const __m128i d = _mm_loadu_si128(p + 3);
+    if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b),
+                                       _mm_or_si128(c, d))) == 0) {
+      validator.feed_ascii(d);
+      continue;
+    }
+    validator.feed(a);
+    validator.feed(b);
+    validator.feed(c);
+    validator.feed(d);
+  }
+  for (; i + 16 <= size; i += 16)
+    validator.feed(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i)));
+  if (i < size) {
+    // zero padding: ASCII, so it completes nothing
+    unsigned char tail[16] = {};
+    std::memcpy(tail, ptr + i, size - i);
+    validator.feed(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)));
+  }
+  return validator.finish();
+}
+
+#endif
+
+inline bool is_valid_utf8(const unsigned char* ptr, size_t size) noexcept {
+#if JASL_INNER_SSSE3
+  return is_valid_utf8_ssse3(ptr, size);
+#else
+  return is_valid_utf8_scalar(ptr, size);
+#endif
+}
+
+/*
+ * Transcoding. Both the size of the result and the result itself are
+ * computed from the same decoders, so the ill-formed sequences become U+FFFD
+ * in both. The ASCII runs and the blocks which don't need the decoding (no
+ * surrogates, only valid code points) are handled with SSE2.
+ */
+
+#if JASL_INNER_SSE2
+inline __m128i load128(const void* ptr) noexcept {
+  return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+#endif
+
+inline decoded_sequence decode_utf16(const char16_t* ptr,
+                                     size_t size) noexcept {
+  const char32_t c = ptr[0];
+  if (c < 0xD800 || c > 0xDFFF)
+    return {c, 1, true};
+  if (c < 0xDC00 && size > 1 && ptr[1] >= 0xDC00 && ptr[1] <= 0xDFFF) {
+    const char32_t low = ptr[1];
+    return {0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00), 2, true};
+  }
+  return {0xFFFD, 1, false};
+}
+
+inline decoded_sequence decode_utf32(const char32_t* ptr, size_t) noexcept {
+  const char32_t c = ptr[0];
+  if (c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+    return {0xFFFD, 1, false};
+  return {c, 1, true};
+}
+
+struct utf8_codec {
+  typedef char unit_type;
+  static decoded_sequence decode(const char* ptr, size_t size) noexcept {
+    return decode_utf8(reinterpret_cast<const unsigned char*>(ptr), size);
+  }
+  static size_t length(char32_t c) noexcept {
+    return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+  }
+  static char* encode(char32_t c, char* out) noexcept {
+    if (c < 0x80) {
+      *out++ = static_cast<char>(c);
+    } else if (c < 0x800) {
+      *out++ = static_cast<char>(0xC0 | (c >> 6));
+      *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+      *out++ = static_cast<char>(0xE0 | (c >> 12));
+      *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+      *out++ = static_cast<char>(0xF0 | (c >> 18));
+      *out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+      *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+    return out;
+  }
+};
+
+struct utf16_codec {
+  typedef char16_t unit_type;
+  static decoded_sequence decode(const char16_t* ptr, size_t size) noexcept {
+    return decode_utf16(ptr, size);
+  }
+  static size_t length(char32_t c) noexcept { return c < 0x10000 ? 1 : 2; }
+  static char16_t* encode(char32_t c, char16_t* out) noexcept {
+    if (c < 0x10000) {
+      *out++ = static_cast<char16_t>(c);
+    } else {
+      c -= 0x10000;
+      *out++ = static_cast<char16_t>(0xD800 + (c >> 10));
+      *out++ = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+    }
+    return out;
+  }
+};
+
+struct utf32_codec {
+  typedef char32_t unit_type;
+  static decoded_sequence decode(const char32_t* ptr, size_t size) noexcept {
+    return decode_utf32(ptr, size);
+  }
+  static size_t length(char32_t) noexcept { return 1; }
+  static char32_t* encode(char32_t c, char32_t* out) noexcept {
+    *out++ = c;
+    return out;
+  }
+};
+
+inline bool is_ascii_unit(char c) noexcept {
+  return static_cast<unsigned char>(c) < 0x80;
+}
+inline bool is_ascii_unit(char16_t c) noexcept {
+  return c < 0x80;
+}
+inline bool is_ascii_unit(char32_t c) noexcept {
+  return c < 0x80;
+}
+
+/**
+ * The number of the ASCII code units at the beginning.
+ */
+inline size_t ascii_run(const char* ptr, size_t size) noexcept {
+  return ascii_prefix(reinterpret_cast<const unsigned char*>(ptr), size);
+}
+
+inline size_t ascii_run(const char16_t* ptr, size_t size) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  for (; i + 8 <= size; i += 8) {
+    const __m128i x = load128(ptr + i);
+    const uint32_t ascii = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi16(_mm_and_si128(x, _mm_set1_epi16(-0x80)),
+                        _mm_setzero_si128())));
+    if (ascii != 0xFFFF)
+      return i + count_trailing_zeros(~ascii) / 2;
+  }
+#endif
+  while (i < size && ptr[i] < 0x80)
+    ++i;
+  return i;
+}
+
+inline size_t ascii_run(const char32_t* ptr, size_t size) noexcept {
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  for (; i + 4 <= size; i += 4) {
+    const __m128i x = load128(ptr + i);
+    const uint32_t ascii = static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi32(_mm_and_si128(x, _mm_set1_epi32(-0x80)),
+                        _mm_setzero_si128())));
+    if (ascii != 0xFFFF)
+      return i + count_trailing_zeros(~ascii) / 4;
+  }
+#endif
+  while (i < size && ptr[i] < 0x80)
+    ++i;
+  return i;
+}
+
+/**
+ * Copies ASCII code units into an other encoding.
+ */
+template <typename FromT, typename ToT>
+inline ToT* copy_ascii(const FromT* ptr, size_t size, ToT* out) noexcept {
+  for (size_t i = 0; i < size; ++i)
+    out[i] = static_cast<ToT>(ptr[i]);
+  return out + size;
+}
+
+#if JASL_INNER_SSE2
+
+inline char16_t* copy_ascii(const char* ptr,
+                            size_t size,
+                            char16_t* out) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i x = load128(ptr + i);
+    __m128i* o = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(o, _mm_unpacklo_epi8(x, _mm_setzero_si128()));
+    _mm_storeu_si128(o + 1, _mm_unpackhi_epi8(x, _mm_setzero_si128()));
+  }
+  return copy_ascii<char, char16_t>(ptr + i, size - i, out + i);
+}
+
+inline char32_t* copy_ascii(const char* ptr,
+                            size_t size,
+                            char32_t* out) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i x = load128(ptr + i);
+    const __m128i low = _mm_unpacklo_epi8(x, _mm_setzero_si128());
+    const __m128i high = _mm_unpackhi_epi8(x, _mm_setzero_si128());
+    __m128i* o = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(o, _mm_unpacklo_epi16(low, _mm_setzero_si128()));
+    _mm_storeu_si128(o + 1, _mm_unpackhi_epi16(low, _mm_setzero_si128()));
+    _mm_storeu_si128(o + 2, _mm_unpacklo_epi16(high, _mm_setzero_si128()));
+    _mm_storeu_si128(o + 3, _mm_unpackhi_epi16(high, _mm_setzero_si128()));
+  }
+  return copy_ascii<char, char32_t>(ptr + i, size - i, out + i);
+}
+
+inline char* copy_ascii(const char16_t* ptr,
+                        size_t size,
+                        char* out) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i* p = reinterpret_cast<const __m128i*>(ptr + i);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out + i),
+        _mm_packus_epi16(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)));
+  }
+  return copy_ascii<char16_t, char>(ptr + i, size - i, out + i);
+}
+
+inline char* copy_ascii(const char32_t* ptr,
+                        size_t size,
+                        char* out) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i* p = reinterpret_cast<const __m128i*>(ptr + i);
+    const __m128i low =
+        _mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+    const __m128i high =
+        _mm_packs_epi32(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_packus_epi16(low, high));
+  }
+  return copy_ascii<char32_t, char>(ptr + i, size - i, out + i);
+}
+
+#endif
+
+/**
+ * Blocks of code units which can be counted (for the size of the result) or
+ * transcoded without decoding them one by one. size is the number of the code
+ * units of a block, 0 if there is no such block. count and write return false
+ * if the block needs the decoding.
+ */
+template <typename From, typename To>
+struct transcode_blocks {
+  static constexpr size_t size = 0;
+  static bool count(const typename From::unit_type*, size_t&) noexcept {
+    return false;
+  }
+  static bool write(const typename From::unit_type*,
+                    typename To::unit_type*) noexcept {
+    return false;
+  }
+};
+
+#if JASL_INNER_SSE2
+
+/**
+ * The number of the units of the block where (unit & mask) != 0.
+ */
+inline size_t count_nonzero16(__m128i x, int16_t mask) noexcept {
+  const __m128i masked = _mm_and_si128(x, _mm_set1_epi16(mask));
+  const uint32_t zero = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi16(masked, _mm_setzero_si128())));
+  return 8 - popcount32(zero) / 2;
+}
+
+inline size_t count_nonzero32(__m128i x, int32_t mask) noexcept {
+  const __m128i masked = _mm_and_si128(x, _mm_set1_epi32(mask));
+  const uint32_t zero = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi32(masked, _mm_setzero_si128())));
+  return 4 - popcount32(zero) / 4;
+}
+
+inline bool has_surrogate16(__m128i x) noexcept {
+  return _mm_movemask_epi8(_mm_cmpeq_epi16(
+             _mm_and_si128(x, _mm_set1_epi16(-0x800)),
+             _mm_set1_epi16(static_cast<int16_t>(0xD800 - 0x10000)))) != 0;
+}
+
+/**
+ * Surrogates or values above U+10FFFF (the negative ones included).
+ */
+inline bool has_invalid32(__m128i x) noexcept {
+  const __m128i surrogate =
+      _mm_cmpeq_epi32(_mm_and_si128(x, _mm_set1_epi32(-0x800)),
+                      _mm_set1_epi32(0xD800));
+  const __m128i too_large = _mm_or_si128(
+      _mm_cmpgt_epi32(x, _mm_set1_epi32(0x10FFFF)),
+      _mm_cmplt_epi32(x, _mm_setzero_si128()));
+  return _mm_movemask_epi8(_mm_or_si128(surrogate, too_large)) != 0;
+}
+
+template <>
+struct transcode_blocks<utf16_codec, utf8_codec> {
+  static constexpr size_t size = 8;
+  static bool count(const char16_t* ptr, size_t& result) noexcept {
+    const __m128i x = load128(ptr);
+    if (has_surrogate16(x))
+      return false;
+    result += 8 + count_nonzero16(x, -0x80) + count_nonzero16(x, -0x800);
+    return true;
+  }
+  // the variable length output isn't vectorized (it would need a byte shuffle
+  // to compact it), only its ASCII runs are copied with SSE2
+  static bool write(const char16_t*, char*) noexcept { return false; }
+};
+
+template <>
+struct transcode_blocks<utf16_codec, utf32_codec> {
+  static constexpr size_t size = 8;
+  static bool count(const char16_t* ptr, size_t& result) noexcept {
+    if (has_surrogate16(load128(ptr)))
+      return false;
+    result += 8;
+    return true;
+  }
+  static bool write(const char16_t* ptr, char32_t* out) noexcept {
+    const __m128i x = load128(ptr);
+    if (has_surrogate16(x))
+      return false;
+    __m128i* o = reinterpret_cast<__m128i*>(out);
+    _mm_storeu_si128(o, _mm_unpacklo_epi16(x, _mm_setzero_si128()));
+    _mm_storeu_si128(o + 1, _mm_unpackhi_epi16(x, _mm_setzero_si128()));
+    return true;
+  }
+};
+
+template <>
+struct transcode_blocks<utf32_codec, utf8_codec> {
+  static constexpr size_t size = 4;
+  static bool count(const char32_t* ptr, size_t& result) noexcept {
+    const __m128i x = load128(ptr);
+    if (has_invalid32(x))
+      return false;
+    result += 4 + count_nonzero32(x, -0x80) + count_nonzero32(x, -0x800) +
+              count_nonzero32(x, -0x10000);
+    return true;
+  }
+  // like the UTF-16 to UTF-8 one, only the size is counted by blocks
+  static bool write(const char32_t*, char*) noexcept { return false; }
+};
+
+template <>
+struct transcode_blocks<utf32_codec, utf16_codec> {
+  static constexpr size_t size = 8;
+  static bool count(const char32_t* ptr, size_t& result) noexcept {
+    const __m128i x = load128(ptr);
+    const __m128i y = load128(ptr + 4);
+    if (has_invalid32(x) || has_invalid32(y))
+      return false;
+    result += 8 + count_nonzero32(x, -0x10000) + count_nonzero32(y, -0x10000);
+    return true;
+  }
+  static bool write(const char32_t* ptr, char16_t* out) noexcept {
+    const __m128i x = load128(ptr);
+    const __m128i y = load128(ptr + 4);
+    // only the BMP without the surrogates, packed with signed saturation
+    if (has_invalid32(x) || has_invalid32(y) ||
+        count_nonzero32(x, -0x10000) + count_nonzero32(y, -0x10000) != 0)
+      return false;
+    const __m128i bias = _mm_set1_epi32(0x8000);
+    const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(x, bias),
+                                           _mm_sub_epi32(y, bias));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     _mm_add_epi16(packed, _mm_set1_epi16(-0x8000)));
+    return true;
+  }
+};
+
+#endif
+
+template <typename From, typename To>
+size_t transcoded_size(const typename From::unit_type* ptr,
+                       size_t size) noexcept {
+  typedef transcode_blocks<From, To> blocks;
+  size_t result = 0;
+  size_t i = 0;
+  size_t decode_until = 0;  // the end of a block which has to be decoded
+  while (i < size) {
+    if (i >= decode_until) {
+      if (blocks::size != 0 && i + blocks::size <= size) {
+        if (blocks::count(ptr + i, result)) {
+          i += blocks::size;
+          continue;
+        }
+        decode_until = i + blocks::size;
+      } else if (is_ascii_unit(ptr[i])) {
+        const size_t n = ascii_run(ptr + i, size - i);
+        result += n;
+        i += n;
+        continue;
+      }
+    }
+    const decoded_sequence s = From::decode(ptr + i, size - i);
+    result += To::length(s.code_point);
+    i += s.length;
+  }
+  return result;
+}
+
+/**
+ * In valid UTF-8 every byte but the continuation bytes starts a code point,
+ * and the ones from 0xF0 start the code points above U+FFFF.
+ */
+inline void count_utf8_leads(const char* ptr,
+                             size_t size,
+                             size_t& leads,
+                             size_t& four_byte_leads) noexcept {
+  leads = 0;
+  four_byte_leads = 0;
+  size_t i = 0;
+#if JASL_INNER_SSE2
+  // -1 per matching byte is subtracted from 8-bit counters, which are summed
+  // before they could overflow
+  const __m128i zero = _mm_setzero_si128();
+  while (i + 16 <= size) {
+    __m128i lead_counts = zero;
+    __m128i four_byte_counts = zero;
+    const size_t end = i + 16 * std::min<size_t>((size - i) / 16, 255);
+    for (; i < end; i += 16) {
+      const __m128i x = load128(ptr + i);
+      // signed: the continuation bytes are below -64, 0xF0.. is -16..-1
+      lead_counts = _mm_sub_epi8(lead_counts,
+                                 _mm_cmpgt_epi8(x, _mm_set1_epi8(-65)));
+      four_byte_counts = _mm_sub_epi8(
+          four_byte_counts,
+          _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(-17)),
+                        _mm_cmplt_epi8(x, zero)));
+    }
+    const __m128i lead_sums = _mm_sad_epu8(lead_counts, zero);
+    const __m128i four_byte_sums = _mm_sad_epu8(four_byte_counts, zero);
+    leads +=
+        static_cast<size_t>(_mm_cvtsi128_si32(lead_sums)) +
+        static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(lead_sums, 8)));
+    four_byte_leads +=
+        static_cast<size_t>(_mm_cvtsi128_si32(four_byte_sums)) +
+        static_cast<size_t>(
+            _mm_cvtsi128_si32(_mm_srli_si128(four_byte_sums, 8)));
+  }
+#endif
+  for (; i < size; ++i) {
+    const unsigned char c = static_cast<unsigned char>(ptr[i]);
+    leads += (c & 0xC0) != 0x80 ? 1 : 0;
+    four_byte_leads += c >= 0xF0 ? 1 : 0;
+  }
+}
+
+template <typename From, typename To>
+typename To::unit_type* transcode_into(const typename From::unit_type* ptr,
+                                       size_t size,
+                                       typename To::unit_type* out) noexcept {
+  typedef transcode_blocks<From, To> blocks;
+  size_t i = 0;
+  size_t decode_until = 0;
+  while (i < size) {
+    if (i >= decode_until) {
+      if (blocks::size != 0 && i + blocks::size <= size) {
+        if (blocks::write(ptr + i, out)) {
+          i += blocks::size;
+          out += blocks::size;
+          continue;
+        }
+        decode_until = i + blocks::size;
+      }
+      if (is_ascii_unit(ptr[i])) {
+        const size_t n = ascii_run(ptr + i, size - i);
+        out = copy_ascii(ptr + i, n, out);
+        i += n;
+        continue;
+      }
+    }
+    const decoded_sequence s = From::decode(ptr + i, size - i);
+    out = To::encode(s.code_point, out);
+    i += s.length;
+  }
+  return out;
+}
+
+/**
+ * Computes the size first, then writes the result into its single
+ * allocation.
+ */
+template <typename From, typename To>
+basic_string<typename To::unit_type> transcode(
+    const typename From::unit_type* ptr,
+    size_t size) {
+  typedef typename To::unit_type to_type;
+  const size_t result_size = transcoded_size<From, To>(ptr, size);
+  return basic_string<to_type>::build(result_size, [&](to_type* out) {
+    to_type* const end = transcode_into<From, To>(ptr, size, out);
+    JASL_ASSERT(end == out + result_size, "transcode: size mismatch");
+    static_cast<void>(end);
+  });
+}
+
+/**
+ * transcode_into for validated UTF-8: no checks in the decoding, and the
+ * blocks of 16 ASCII bytes are copied at once.
+ */
+template <typename To>
+typename To::unit_type* transcode_valid_utf8_into(
+    const char* ptr,
+    size_t size,
+    typename To::unit_type* out) noexcept {
+  const unsigned char* const p = reinterpret_cast<const unsigned char*>(ptr);
+  size_t i = 0;
+  while (i < size) {
+#if JASL_INNER_SSE2
+    if (i + 16 <= size && _mm_movemask_epi8(load128(p + i)) == 0) {
+      out = copy_ascii(ptr + i, 16, out);
+      i += 16;
+      continue;
+    }
+#endif
+    const unsigned char c = p[i];
+    char32_t code_point;
+    if (c < 0x80) {
+      code_point = c;
+      i += 1;
+    } else if (c < 0xE0) {
+      code_point = (char32_t(c & 0x1F) << 6) | char32_t(p[i + 1] & 0x3F);
+      i += 2;
+    } else if (c < 0xF0) {
+      code_point = (char32_t(c & 0x0F) << 12) |
+                   (char32_t(p[i + 1] & 0x3F) << 6) |
+                   char32_t(p[i + 2] & 0x3F);
+      i += 3;
+    } else {
+      code_point = (char32_t(c & 0x07) << 18) |
+                   (char32_t(p[i + 1] & 0x3F) << 12) |
+                   (char32_t(p[i + 2] & 0x3F) << 6) |
+                   char32_t(p[i + 3] & 0x3F);
+      i += 4;
+    }
+    out = To::encode(code_point, out);
+  }
+  return out;
+}
+
+/**
+ * transcode from UTF-8. The valid input (the usual case) is validated with
+ * SIMD, then its size is counted from the lead bytes.
+ */
+template <typename To>
+basic_string<typename To::unit_type> transcode_utf8(const char* ptr,
+                                                    size_t size) {
+  typedef typename To::unit_type to_type;
+  if (!is_valid_utf8(reinterpret_cast<const unsigned char*>(ptr), size))
+    return transcode<utf8_codec, To>(ptr, size);
+  size_t leads, four_byte_leads;
+  count_utf8_leads(ptr, size, leads, four_byte_leads);
+  const size_t result_size =
+      sizeof(to_type) == 2 ? leads + four_byte_leads : leads;
+  return basic_string<to_type>::build(result_size, [&](to_type* out) {
+    to_type* const end = transcode_valid_utf8_into<To>(ptr, size, out);
+    JASL_ASSERT(end == out + result_size, "transcode: size mismatch");
+    static_cast<void>(end);
+  });
+}
+
+}  // namespace inner
+
+/**
+ * True if every byte is ASCII (below 0x80). ASCII is valid UTF-8, so the
+ * callers can skip the validation and use the byte functions for such
+ * strings. 64 bytes are checked at once with SSE2.
+ */
+inline bool is_ascii(string_view str) noexcept {
+  return inner::is_ascii(reinterpret_cast<const unsigned char*>(str.data()),
+                         str.size());
+}
+
+/**
+ * True if the string is well-formed UTF-8: no overlong forms, no surrogates,
+ * no code points above U+10FFFF and no truncated sequences.
+ *
+ * With SSSE3 16 bytes are validated at once with table lookups (Keiser and
+ * Lemire). Otherwise the ASCII runs are skipped with SSE2 and the other
+ * sequences are decoded one by one.
+ *
+ * The SSSE3 validator is chosen at compile time, there is no runtime CPU
+ * dispatch: it is used only if SSSE3 is enabled by the compiler flags (e.g.
+ * -mssse3 or -march=native with gcc and clang, /arch:AVX with MSVC). A default
+ * x86-64 build gets the SSE2 ASCII skipping and the scalar decoding.
+ */
+inline bool is_valid_utf8(string_view str) noexcept {
+  return inner::is_valid_utf8(
+      reinterpret_cast<const unsigned char*>(str.data()), str.size());
+}
+
+/**
+ * Forward range of the code points (char32_t) of an UTF-8 string. It decodes
+ * on the fly and it doesn't allocate. The ill-formed sequences (maximal
+ * subparts) are U+FFFD, the iterator tells whether the current one is valid
+ * and which bytes it was decoded from.
+ *
+ * `for (char32_t c : jasl::utf8_code_points(str)) ...`
+ */
+class utf8_code_point_range {
+  const unsigned char* _begin;
+  const unsigned char* _end;
+
+ public:
+  class iterator {
+    const unsigned char* _ptr;
+    const unsigned char* _end;
+    inner::decoded_sequence _current;
+
+    void decode() noexcept {
+      if (_ptr != _end)
+        _current = inner::decode_utf8(_ptr, static_cast<size_t>(_end - _ptr));
+    }
+
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef char32_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const char32_t* pointer;
+    typedef const char32_t& reference;
+
+    iterator() noexcept : _ptr(nullptr), _end(nullptr), _current() {}
+    iterator(const unsigned char* ptr, const unsigned char* end) noexcept
+        : _ptr(ptr), _end(end), _current() {
+      decode();
+    }
+
+    reference operator*() const noexcept { return _current.code_point; }
+    pointer operator->() const noexcept { return &_current.code_point; }
+
+    /**
+     * False if the current code point is U+FFFD because of an ill-formed
+     * sequence.
+     */
+    bool valid() const noexcept { return _current.valid; }
+
+    /**
+     * The bytes of the current code point.
+     */
+    string_view sequence() const noexcept {
+      return string_view(reinterpret_cast<const char*>(_ptr),
+                         _current.length);
+    }
+
+    iterator& operator++() noexcept {
+      _ptr += _current.length;
+      decode();
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const iterator& other) const noexcept {
+      return _ptr == other._ptr;
+    }
+    bool operator!=(const iterator& other) const noexcept {
+      return _ptr != other._ptr;
+    }
+  };
+  typedef iterator const_iterator;
+
+  explicit utf8_code_point_range(string_view str) noexcept
+      : _begin(reinterpret_cast<const unsigned char*>(str.data())),
+        _end(_begin + str.size()) {}
+
+  iterator begin() const noexcept { return iterator(_begin, _end); }
+  iterator end() const noexcept { return iterator(_end, _end); }
+};
+
+/**
+ * The code points of the UTF-8 string, see jasl::utf8_code_point_range. The
+ * string has to outlive the range.
+ */
+inline utf8_code_point_range utf8_code_points(string_view str) noexcept {
+  return utf8_code_point_range(str);
+}
+
+/**
+ * Transcodes UTF-8 to UTF-16. The size of the result is computed first
+ * (vectorized for valid input), then the result is written into a single
+ * allocation: the ASCII blocks are widened with SSE2, the other sequences
+ * are decoded one by one. The ill-formed sequences become U+FFFD (see
+ * jasl::utf8_code_points), so it never fails; use jasl::is_valid_utf8 to
+ * reject them.
+ */
+inline u16string to_utf16(string_view str) {
+  return inner::transcode_utf8<inner::utf16_codec>(str.data(), str.size());
+}
+
+/**
+ * Transcodes UTF-32 to UTF-16. The invalid code points (surrogates, above
+ * U+10FFFF) become U+FFFD. The blocks of the BMP are narrowed with SSE2.
+ */
+inline u16string to_utf16(u32string_view str) {
+  return inner::transcode<inner::utf32_codec, inner::utf16_codec>(str.data(),
+                                                                  str.size());
+}
+
+/**
+ * Transcodes UTF-8 to UTF-32, like jasl::to_utf16.
+ */
+inline u32string to_utf32(string_view str) {
+  return inner::transcode_utf8<inner::utf32_codec>(str.data(), str.size());
+}
+
+/**
+ * Transcodes UTF-16 to UTF-32. The unpaired surrogates become U+FFFD. The
+ * blocks without surrogates are widened with SSE2.
+ */
+inline u32string to_utf32(u16string_view str) {
+  return inner::transcode<inner::utf16_codec, inner::utf32_codec>(str.data(),
+                                                                  str.size());
+}
+
+/**
+ * Transcodes UTF-16 to UTF-8. The unpaired surrogates become U+FFFD. Only the
+ * size of the result is computed by blocks with SSE2; the ASCII runs are
+ * narrowed with SSE2 too, but the other code points are encoded one by one.
+ */
+inline string to_utf8(u16string_view str) {
+  return inner::transcode<inner::utf16_codec, inner::utf8_codec>(str.data(),
+                                                                 str.size());
+}
+
+/**
+ * Transcodes UTF-32 to UTF-8. The invalid code points become U+FFFD. Like
+ * jasl::to_utf8 of UTF-16, the non-ASCII code points are encoded one by one.
+ */
+inline string to_utf8(u32string_view str) {
+  return inner::transcode<inner::utf32_codec, inner::utf8_codec>(str.data(),
+                                                                 str.size());
+}
+
+}  // namespace jasl
@@ -0,0 +1,74 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "jasl/jasl_bloom_filter.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 4000000;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the single and the bulk "
+               "queries of\n[jasl::bloom_filter] to [std::unordered_set].");
+
+  std::vector<std::string> keys;
+  std::vector<std::string> queries;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    keys.push_back("user/" + std::to_string(i * 2));
+    queries.push_back("user/" + std::to_string(i * 2 + i % 2));
+  }
+  jasl::bloom_filter filter(KeyCount, 0.01);
+  filter.insert(keys.begin(), keys.end());
+  const std::unordered_set<std::string> set(keys.begin(), keys.end());
+  std::cout << KeyCount << " keys, " << filter.memory_usage() / (1024 * 1024)
+            << " MiB, " << filter.hash_count() << " bits set per key"
+            << std::endl
+            << std::endl;
+
+  std::cout << "Insert" << std::endl << std::endl;
+  auto insert = measure_units(
+      "[jasl::bloom_filter::insert] one by one", KeyCount, IterCount, [&] {
+        for (const std::string& key : keys)
+          filter.insert(jasl::string_view(key.data(), key.size()));
+      });
+  auto bulk_insert = measure_units(
+      "[jasl::bloom_filter::insert] of the range", KeyCount, IterCount,
+      [&] { filter.insert(keys.begin(), keys.end()); });
+  print_compare(bulk_insert, insert);
+
+  std::cout << "Query (half of the queries are members)" << std::endl
+            << std::endl;
+  auto lookup =
+      measure_units("[std::unordered_set::count]", KeyCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const std::string& query : queries)
+          sum += set.count(query);
+        do_not_optimize(sum);
+      });
+  auto contains = measure_units(
+      "[jasl::bloom_filter::contains] one by one", KeyCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const std::string& query : queries)
+          sum += filter.contains(jasl::string_view(query.data(), query.size()));
+        do_not_optimize(sum);
+      });
+  std::vector<char> results(KeyCount);
+  auto bulk_contains = measure_units(
+      "[jasl::bloom_filter::contains] of the range", KeyCount, IterCount, [&] {
+        filter.contains(queries.begin(), queries.end(), results.begin());
+        do_not_optimize(results[0]);
+      });
+  print_compare(contains, lookup);
+  print_compare(bulk_contains, contains);
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "jasl/jasl_case_insensitive.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 64;
+constexpr static size_t LookupCount = 1000000;
+constexpr static size_t IterCount = 5;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the case insensitive lookup "
+               "of [jasl::ci_string_view]\nkeys to the lookup of lower case "
+               "[std::string] temporaries.");
+
+  std::mt19937 gen(42);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    std::string key;
+    const size_t size = 6 + gen() % 24;
+    for (size_t k = 0; k < size; ++k)
+      key += static_cast<char>("abcdefghijklmnopqrstuvwxyz-"[gen() % 27]);
+    keys.push_back(key);
+  }
+  std::vector<std::string> probes;
+  for (size_t i = 0; i < LookupCount; ++i) {
+    std::string probe = keys[gen() % KeyCount];
+    for (char& c : probe) {
+      if (gen() % 2)
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    probes.push_back(probe);
+  }
+
+  std::unordered_map<std::string, size_t> std_map;
+  std::unordered_map<jasl::ci_string_view, size_t,
+                     jasl::ascii_case_insensitive_hash>
+      ci_map;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    std_map[keys[i]] = i;
+    ci_map[jasl::ci_string_view(keys[i].data(), keys[i].size())] = i;
+  }
+
+  auto std_lookup =
+      measure_units("lower case copy + [std::unordered_map<std::string>]",
+                    LookupCount, IterCount, [&] {
+                      size_t sum = 0;
+                      for (const std::string& probe : probes) {
+                        std::string lower = probe;
+                        std::transform(lower.begin(), lower.end(),
+                                       lower.begin(), [](char c) {
+                                         return static_cast<char>(std::tolower(
+                                             static_cast<unsigned char>(c)));
+                                       });
+                        sum += std_map.find(lower)->second;
+                      }
+                      do_not_optimize(sum);
+                    });
+  auto ci_lookup = measure_units(
+      "[std::unordered_map<jasl::ci_string_view>]", LookupCount, IterCount,
+      [&] {
+        size_t sum = 0;
+        for (const std::string& probe : probes)
+          sum += ci_map.find(jasl::ci_string_view(probe.data(), probe.size()))
+                     ->second;
+        do_not_optimize(sum);
+      });
+  print_compare(ci_lookup, std_lookup);
+
+  return 0;
+}
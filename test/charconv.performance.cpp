@@ -0,0 +1,104 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_charconv.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t NumberCount = 1000000;
+constexpr static size_t IterCount = 5;
+
+// The numbers are views into one buffer, like the fields of a parsed file.
+struct fields {
+  std::string buffer;
+  std::vector<jasl::string_view> views;
+
+  explicit fields(const std::vector<std::string>& numbers) {
+    std::vector<size_t> offsets;
+    for (const std::string& number : numbers) {
+      offsets.push_back(buffer.size());
+      buffer += number;
+      buffer += ',';
+    }
+    for (size_t i = 0; i < numbers.size(); ++i)
+      views.emplace_back(buffer.data() + offsets[i], numbers[i].size());
+  }
+};
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the [jasl::from_chars] to "
+               "copying into\n[std::string] and calling [std::strtoll] / "
+               "[std::strtod].");
+
+  std::mt19937_64 gen(42);
+  std::vector<std::string> integers;
+  std::vector<std::string> doubles;
+  std::uniform_real_distribution<double> real(-1000, 1000);
+  char buffer[64];
+  for (size_t i = 0; i < NumberCount; ++i) {
+    integers.push_back(
+        std::to_string(static_cast<int64_t>(gen()) >> (gen() % 64)));
+    std::snprintf(buffer, sizeof(buffer), "%.*g",
+                  static_cast<int>(3 + i % 15), real(gen));
+    doubles.push_back(buffer);
+  }
+  const fields integer_fields(integers);
+  const fields double_fields(doubles);
+
+  std::cout << "Integers" << std::endl << std::endl;
+  auto strtoll =
+      measure_units("copy + [std::strtoll]", NumberCount, IterCount, [&] {
+        long long sum = 0;
+        for (const jasl::string_view& v : integer_fields.views) {
+          const std::string copy(v.data(), v.size());
+          sum += std::strtoll(copy.c_str(), nullptr, 10);
+        }
+        do_not_optimize(sum);
+      });
+  auto jasl_integer =
+      measure_units("[jasl::from_chars]", NumberCount, IterCount, [&] {
+        int64_t sum = 0;
+        for (const jasl::string_view& v : integer_fields.views) {
+          int64_t value = 0;
+          jasl::from_chars(v, value);
+          sum += value;
+        }
+        do_not_optimize(sum);
+      });
+  print_compare(jasl_integer, strtoll);
+
+  std::cout << "Doubles" << std::endl << std::endl;
+  auto strtod =
+      measure_units("copy + [std::strtod]", NumberCount, IterCount, [&] {
+        double sum = 0;
+        for (const jasl::string_view& v : double_fields.views) {
+          const std::string copy(v.data(), v.size());
+          sum += std::strtod(copy.c_str(), nullptr);
+        }
+        do_not_optimize(sum);
+      });
+  auto jasl_double =
+      measure_units("[jasl::from_chars]", NumberCount, IterCount, [&] {
+        double sum = 0;
+        for (const jasl::string_view& v : double_fields.views) {
+          double value = 0;
+          jasl::from_chars(v, value);
+          sum += value;
+        }
+        do_not_optimize(sum);
+      });
+  print_compare(jasl_double, strtod);
+
+  return 0;
+}
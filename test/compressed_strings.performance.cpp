@@ -0,0 +1,127 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_compressed_strings.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t StringCount = 1000000;
+constexpr static size_t QueryCount = 1000;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::compressed_strings] to "
+               "a [std::vector]\nof [std::string]-s.");
+
+  // unsorted URLs
+  std::mt19937 gen(42);
+  const char* const hosts[] = {"https://www.example.com/",
+                               "https://static.example.net/assets/",
+                               "http://api.example.org/v2/"};
+  const char* const words[] = {"products", "search?q=", "user", "&page=",
+                               ".html",    "images/",   "id="};
+  std::vector<std::string> strings;
+  size_t total = 0;
+  for (size_t i = 0; i < StringCount; ++i) {
+    std::string str = hosts[gen() % 3];
+    for (size_t k = 1 + gen() % 4; k > 0; --k) {
+      str += words[gen() % 7];
+      str += std::to_string(gen() % 1000000);
+    }
+    total += str.size();
+    strings.push_back(str);
+  }
+
+  const jasl::compressed_strings compressed(strings.begin(), strings.end());
+  size_t vector_memory = strings.capacity() * sizeof(std::string);
+  for (const std::string& str : strings) {
+    if (str.capacity() >= sizeof(std::string))
+      vector_memory += str.capacity() + 1;
+  }
+  std::cout << strings.size() << " strings, " << total / (1024 * 1024)
+            << " MiB" << std::endl
+            << " - [std::vector] of [std::string]: "
+            << vector_memory / (1024 * 1024) << " MiB" << std::endl
+            << " - [jasl::compressed_strings]: "
+            << compressed.memory_usage() / (1024 * 1024) << " MiB ("
+            << compressed.symbol_count() << " symbols, compression factor "
+            << static_cast<double>(total) /
+                   static_cast<double>(compressed.compressed_size())
+            << ")" << std::endl
+            << std::endl;
+
+  std::cout << "Build" << std::endl << std::endl;
+  auto build = measure_units("[jasl::compressed_strings]", 1, IterCount, [&] {
+    const jasl::compressed_strings c(strings.begin(), strings.end());
+    do_not_optimize(c.size());
+  });
+  print_throughput(build, static_cast<double>(total));
+  std::cout << std::endl;
+
+  std::cout << "Decompress every string into a buffer" << std::endl
+            << std::endl;
+  std::vector<char> out(4096);
+  auto copy = measure_units("copy of the [std::string]-s", 1, IterCount, [&] {
+    size_t sum = 0;
+    for (const std::string& str : strings) {
+      std::memcpy(out.data(), str.data(), str.size());
+      sum += static_cast<size_t>(out[0]) + str.size();
+    }
+    do_not_optimize(sum);
+  });
+  print_throughput(copy, static_cast<double>(total));
+  auto decompress =
+      measure_units("[jasl::compressed_strings::decompress]", 1, IterCount,
+                    [&] {
+                      size_t sum = 0;
+                      for (size_t i = 0; i < compressed.size(); ++i) {
+                        sum += compressed.decompress(i, out.data(),
+                                                     out.size()) +
+                               static_cast<size_t>(out[0]);
+                      }
+                      do_not_optimize(sum);
+                    });
+  print_throughput(decompress, static_cast<double>(total));
+  std::cout << std::endl;
+
+  std::cout << "Find " << QueryCount << " strings" << std::endl << std::endl;
+  std::vector<size_t> ids;
+  for (size_t i = 0; i < QueryCount; ++i)
+    ids.push_back(gen() % strings.size());
+  auto scan = measure_units("scan of the [std::string]-s", QueryCount, 1, [&] {
+    size_t sum = 0;
+    for (size_t id : ids) {
+      const std::string& key = strings[id];
+      for (size_t i = 0; i < strings.size(); ++i) {
+        if (strings[i] == key) {
+          sum += i;
+          break;
+        }
+      }
+    }
+    do_not_optimize(sum);
+  });
+  auto find = measure_units(
+      "[jasl::compressed_strings::find] of the compressed key", QueryCount, 1,
+      [&] {
+        size_t sum = 0;
+        for (size_t id : ids) {
+          const std::string& key = strings[id];
+          sum += compressed.find(
+              compressed.compress(jasl::string_view(key.data(), key.size())));
+        }
+        do_not_optimize(sum);
+      });
+  print_compare(find, scan);
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_consistent_hash.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 1000000;
+constexpr static size_t NodeCount = 64;
+constexpr static size_t IterCount = 5;
+
+void print_lookups(const std::pair<std::string, double>& result) {
+  std::cout << " - " << result.first << ": **"
+            << 1 / result.second / 1000000 << " M lookups/s**" << std::endl;
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test measures the lookups of "
+               "[jasl::jump_hash], [jasl::rendezvous_hash]\nand "
+               "[jasl::hash_ring] compared to [std::hash] % node count.");
+
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i)
+    keys.push_back("user:session:" + std::to_string(i * 2654435761U));
+  std::vector<jasl::string_view> views;
+  for (const std::string& key : keys)
+    views.push_back(jasl::string_view(key.data(), key.size()));
+  std::vector<std::string> nodes;
+  for (size_t i = 0; i < NodeCount; ++i)
+    nodes.push_back("cache-" + std::to_string(i) + ".example.com");
+
+  std::cout << KeyCount << " keys, " << NodeCount << " nodes" << std::endl
+            << std::endl;
+
+  const std::hash<std::string> std_hash;
+  auto modulo = measure_units("[std::hash] % node count", KeyCount, IterCount,
+                              [&] {
+                                size_t sum = 0;
+                                for (const std::string& key : keys)
+                                  sum += std_hash(key) % NodeCount;
+                                do_not_optimize(sum);
+                              });
+  print_lookups(modulo);
+
+  const jasl::jump_hash jump(NodeCount);
+  auto jump_single = measure_units("[jasl::jump_hash::shard]", KeyCount,
+                                   IterCount, [&] {
+                                     size_t sum = 0;
+                                     for (jasl::string_view key : views)
+                                       sum += jump.shard(key);
+                                     do_not_optimize(sum);
+                                   });
+  print_lookups(jump_single);
+  std::vector<size_t> shards(KeyCount);
+  auto jump_batch = measure_units(
+      "[jasl::jump_hash::shards] (batch)", KeyCount, IterCount, [&] {
+        jump.shards(views.begin(), views.end(), shards.begin());
+        do_not_optimize(shards.back());
+      });
+  print_lookups(jump_batch);
+
+  const jasl::rendezvous_hash rendezvous(nodes.begin(), nodes.end());
+  auto rendezvous_single = measure_units(
+      "[jasl::rendezvous_hash::node]", KeyCount, IterCount, [&] {
+        size_t sum = 0;
+        for (jasl::string_view key : views)
+          sum += rendezvous.node(key).size();
+        do_not_optimize(sum);
+      });
+  print_lookups(rendezvous_single);
+
+  const jasl::hash_ring ring(nodes.begin(), nodes.end());
+  auto ring_single = measure_units("[jasl::hash_ring::node]", KeyCount,
+                                   IterCount, [&] {
+                                     size_t sum = 0;
+                                     for (jasl::string_view key : views)
+                                       sum += ring.node(key).size();
+                                     do_not_optimize(sum);
+                                   });
+  print_lookups(ring_single);
+  std::vector<jasl::string_view> owners(KeyCount);
+  auto ring_batch = measure_units(
+      "[jasl::hash_ring::nodes] (batch)", KeyCount, IterCount, [&] {
+        ring.nodes(views.begin(), views.end(), owners.begin());
+        do_not_optimize(owners.back().size());
+      });
+  print_lookups(ring_batch);
+  std::cout << std::endl;
+
+  print_compare(jump_batch, jump_single);
+  print_compare(ring_batch, ring_single);
+
+  return 0;
+}
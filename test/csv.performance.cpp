@@ -0,0 +1,124 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <string>
+
+#include "jasl/jasl_csv.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t RecordCount = 100000;
+constexpr static size_t IterCount = 5;
+
+// Records of an id, two numbers, a name, a free text which is sometimes
+// quoted (with commas, newlines and doubled quotes) and a date.
+std::string make_csv() {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 99);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::string csv;
+  for (size_t i = 0; i < RecordCount; ++i) {
+    csv += std::to_string(i) + ',' + std::to_string(dist(gen) * 1234) + '.' +
+           std::to_string(dist(gen)) + ',' + std::to_string(dist(gen)) + ',';
+    for (int j = dist(gen) % 12 + 3; j > 0; --j)
+      csv += static_cast<char>(letter(gen));
+    csv += ',';
+    const bool quoted = dist(gen) < 30;
+    if (quoted)
+      csv += '"';
+    for (int j = dist(gen) % 60; j > 0; --j) {
+      const int r = dist(gen);
+      if (quoted && r < 3)
+        csv += ",";
+      else if (quoted && r < 5)
+        csv += "\"\"";
+      else if (quoted && r < 6)
+        csv += "\n";
+      else
+        csv += r < 20 ? ' ' : static_cast<char>(letter(gen));
+    }
+    if (quoted)
+      csv += '"';
+    csv += ",2018-07-";
+    csv += std::to_string(dist(gen) % 20 + 10);
+    csv += "\r\n";
+  }
+  return csv;
+}
+
+// A byte by byte state machine which produces the same fields.
+template <typename F>
+void naive_scan(const char* p, size_t size, F&& on_field) {
+  size_t begin = 0;
+  bool inside = false;
+  for (size_t i = 0; i < size; ++i) {
+    const char c = p[i];
+    if (c == '"') {
+      inside = !inside;
+    } else if (!inside && (c == ',' || c == '\n')) {
+      size_t end = i;
+      if (c == '\n' && end > begin && p[end - 1] == '\r')
+        --end;
+      if (end > begin && p[begin] == '"')
+        on_field(jasl::string_view(p + begin + 1, end - begin - 2));
+      else
+        on_field(jasl::string_view(p + begin, end - begin));
+      begin = i + 1;
+    }
+  }
+  if (begin < size)
+    on_field(jasl::string_view(p + begin, size - begin));
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the [jasl::csv_scanner] to a "
+               "byte by byte\nstate machine.");
+
+  const std::string csv = make_csv();
+  const jasl::string_view csv_view(csv.data(), csv.size());
+  std::cout << "Size: " << csv.size() / 1024 << " KiB" << std::endl
+            << std::endl;
+
+  auto naive = measure_units("byte by byte", 1, IterCount, [&] {
+    size_t sum = 0;
+    naive_scan(csv.data(), csv.size(),
+               [&](jasl::string_view field) { sum += field.size(); });
+    do_not_optimize(sum);
+  });
+  auto scanner = measure_units("[jasl::csv_scanner]", 1, IterCount, [&] {
+    size_t sum = 0;
+    jasl::csv_scanner s(csv_view);
+    jasl::csv_scanner::field f;
+    while (s.next(f))
+      sum += f.value.size();
+    do_not_optimize(sum);
+  });
+  auto unescape =
+      measure_units("[jasl::csv_scanner] + unescape", 1, IterCount, [&] {
+        size_t sum = 0;
+        jasl::csv_scanner s(csv_view);
+        jasl::csv_scanner::field f;
+        std::string buffer;
+        while (s.next(f)) {
+          if (f.escaped) {
+            buffer.resize(f.value.size());
+            sum += s.unescape(f, &buffer[0]);
+          } else {
+            sum += f.value.size();
+          }
+        }
+        do_not_optimize(sum);
+      });
+
+  print_compare(scanner, naive);
+  print_throughput(naive, static_cast<double>(csv.size()));
+  print_throughput(scanner, static_cast<double>(csv.size()));
+  print_throughput(unescape, static_cast<double>(csv.size()));
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_edit_distance.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t WordCount = 50000;
+constexpr static size_t QueryCount = 20;
+constexpr static size_t TextSize = 4 * 1024 * 1024;
+constexpr static size_t IterCount = 3;
+
+size_t naive_distance(jasl::string_view a, jasl::string_view b) {
+  std::vector<size_t> row(b.size() + 1);
+  for (size_t j = 0; j <= b.size(); ++j)
+    row[j] = j;
+  for (size_t i = 1; i <= a.size(); ++i) {
+    size_t diagonal = row[0];
+    row[0] = i;
+    for (size_t j = 1; j <= b.size(); ++j) {
+      const size_t above = row[j];
+      row[j] = std::min(std::min(row[j], row[j - 1]) + 1,
+                        diagonal + (a[i - 1] == b[j - 1] ? 0 : 1));
+      diagonal = above;
+    }
+  }
+  return row[b.size()];
+}
+
+// The first end of the pattern with at most k errors (Sellers).
+size_t naive_find_end(jasl::string_view text,
+                      jasl::string_view pattern,
+                      size_t k) {
+  std::vector<size_t> column(pattern.size() + 1);
+  for (size_t i = 0; i <= pattern.size(); ++i)
+    column[i] = i;
+  for (size_t j = 1; j <= text.size(); ++j) {
+    size_t diagonal = column[0];
+    column[0] = 0;
+    for (size_t i = 1; i <= pattern.size(); ++i) {
+      const size_t left = column[i];
+      column[i] = std::min(std::min(column[i], column[i - 1]) + 1,
+                           diagonal + (pattern[i - 1] == text[j - 1] ? 0 : 1));
+      diagonal = left;
+    }
+    if (column.back() <= k)
+      return j;
+  }
+  return static_cast<size_t>(-1);
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the bit-parallel "
+               "[jasl::levenshtein_distance] and [jasl::fuzzy_find]\nto the "
+               "quadratic dynamic programming.");
+
+  std::mt19937 gen(42);
+  std::vector<std::string> words;
+  for (size_t i = 0; i < WordCount; ++i) {
+    std::string word;
+    const size_t size = 4 + gen() % 13;
+    for (size_t k = 0; k < size; ++k)
+      word += static_cast<char>('a' + gen() % 26);
+    words.push_back(word);
+  }
+  std::vector<jasl::string_view> dictionary;
+  for (const std::string& word : words)
+    dictionary.emplace_back(word.data(), word.size());
+  std::vector<std::string> queries;
+  for (size_t i = 0; i < QueryCount; ++i) {
+    std::string query = words[gen() % WordCount];
+    query[gen() % query.size()] = 'x';
+    queries.push_back(query);
+  }
+  const double pairs = static_cast<double>(WordCount * QueryCount);
+
+  std::cout << "Distance of every word of a dictionary" << std::endl
+            << std::endl;
+  auto naive = measure_units("quadratic DP", pairs, IterCount, [&] {
+    size_t sum = 0;
+    for (const std::string& query : queries) {
+      for (jasl::string_view word : dictionary)
+        sum += naive_distance(jasl::string_view(query.data(), query.size()),
+                              word);
+    }
+    do_not_optimize(sum);
+  });
+  auto myers = measure_units("[jasl::levenshtein_distance]", pairs, IterCount,
+                             [&] {
+                               size_t sum = 0;
+                               for (const std::string& query : queries) {
+                                 const jasl::string_view q(query.data(),
+                                                           query.size());
+                                 for (jasl::string_view word : dictionary)
+                                   sum += jasl::levenshtein_distance(q, word);
+                               }
+                               do_not_optimize(sum);
+                             });
+  print_compare(myers, naive);
+
+  std::cout << "Words within 2 errors of a dictionary" << std::endl
+            << std::endl;
+  auto naive_within = measure_units("quadratic DP", pairs, IterCount, [&] {
+    size_t count = 0;
+    for (const std::string& query : queries) {
+      for (jasl::string_view word : dictionary) {
+        if (naive_distance(jasl::string_view(query.data(), query.size()),
+                           word) <= 2)
+          ++count;
+      }
+    }
+    do_not_optimize(count);
+  });
+  auto pattern_within = measure_units(
+      "[jasl::levenshtein_pattern::distance] with max_distance", pairs,
+      IterCount, [&] {
+        size_t count = 0;
+        for (const std::string& query : queries) {
+          const jasl::levenshtein_pattern pattern(
+              jasl::string_view(query.data(), query.size()));
+          for (jasl::string_view word : dictionary) {
+            if (pattern.distance(word, 2) <= 2)
+              ++count;
+          }
+        }
+        do_not_optimize(count);
+      });
+  print_compare(pattern_within, naive_within);
+
+  std::cout << "Fuzzy find in a text" << std::endl << std::endl;
+  std::string text;
+  for (size_t i = 0; i < TextSize; ++i)
+    text += static_cast<char>('a' + gen() % 26);
+  const std::string needle = "approximatestringmatching";
+  const jasl::string_view text_view(text.data(), text.size());
+  const jasl::string_view needle_view(needle.data(), needle.size());
+  auto naive_find = measure_units("Sellers DP", 1, IterCount, [&] {
+    do_not_optimize(naive_find_end(text_view, needle_view, 3));
+  });
+  auto fuzzy_find = measure_units("[jasl::fuzzy_find]", 1, IterCount, [&] {
+    do_not_optimize(jasl::fuzzy_find(text_view, needle_view, 3).position);
+  });
+  print_compare(fuzzy_find, naive_find);
+  print_throughput(fuzzy_find, static_cast<double>(text.size()));
+
+  return 0;
+}
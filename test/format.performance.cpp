@@ -0,0 +1,102 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_format.hpp"
+#include "jasl/jasl_string.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t LineCount = 200000;
+constexpr static size_t IterCount = 5;
+
+// The arguments of one log line.
+struct record {
+  std::string user;
+  int64_t id;
+  unsigned status;
+  double latency;
+};
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::format] and "
+               "[jasl::format_to] to\n[std::ostringstream] and "
+               "[std::snprintf] + [std::string] on log lines.");
+
+  std::mt19937_64 gen(42);
+  std::uniform_real_distribution<double> real(0, 500);
+  std::vector<record> records;
+  for (size_t i = 0; i < LineCount; ++i) {
+    records.push_back({"user" + std::to_string(gen() % 10000),
+                       static_cast<int64_t>(gen() >> 20),
+                       static_cast<unsigned>(200 + gen() % 400), real(gen)});
+  }
+
+  auto ostringstream =
+      measure_units("[std::ostringstream]", LineCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const record& r : records) {
+          std::ostringstream os;
+          os << "user=" << r.user << " id=" << r.id << " status=" << r.status
+             << " latency=" << r.latency << "ms";
+          sum += os.str().size();
+        }
+        do_not_optimize(sum);
+      });
+  auto snprintf =
+      measure_units("[std::snprintf] + [std::string]", LineCount, IterCount,
+                    [&] {
+                      size_t sum = 0;
+                      char buffer[128];
+                      for (const record& r : records) {
+                        const int n = std::snprintf(
+                            buffer, sizeof(buffer),
+                            "user=%s id=%lld status=%u latency=%gms",
+                            r.user.c_str(), static_cast<long long>(r.id),
+                            r.status, r.latency);
+                        const std::string line(buffer,
+                                               static_cast<size_t>(n));
+                        sum += line.size();
+                      }
+                      do_not_optimize(sum);
+                    });
+  auto jasl_format =
+      measure_units("[jasl::format]", LineCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const record& r : records) {
+          const jasl::string line =
+              jasl::format("user={} id={} status={} latency={}ms", r.user,
+                           r.id, r.status, r.latency);
+          sum += line.size();
+        }
+        do_not_optimize(sum);
+      });
+  auto jasl_format_to =
+      measure_units("[jasl::format_to]", LineCount, IterCount, [&] {
+        size_t sum = 0;
+        char buffer[128];
+        for (const record& r : records) {
+          const jasl::to_chars_result res = jasl::format_to(
+              buffer, buffer + sizeof(buffer),
+              "user={} id={} status={} latency={}ms", r.user, r.id, r.status,
+              r.latency);
+          sum += static_cast<size_t>(res.ptr - buffer);
+        }
+        do_not_optimize(sum);
+      });
+
+  print_compare(jasl_format, ostringstream);
+  print_compare(jasl_format, snprintf);
+  print_compare(jasl_format_to, snprintf);
+
+  return 0;
+}
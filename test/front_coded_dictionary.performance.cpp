@@ -0,0 +1,92 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_front_coded_dictionary.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 1000000;
+constexpr static size_t QueryCount = 200000;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::front_coded_dictionary] "
+               "to a sorted\n[std::vector] of [std::string]-s.");
+
+  // URL-like keys with long shared prefixes
+  std::mt19937 gen(42);
+  const char* const hosts[] = {"https://example.com/", "https://example.org/",
+                               "https://static.example.net/assets/"};
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    std::string key = hosts[gen() % 3];
+    for (size_t depth = 1 + gen() % 3; depth > 0; --depth) {
+      for (size_t k = 3 + gen() % 6; k > 0; --k)
+        key += static_cast<char>('a' + gen() % 26);
+      key += '/';
+    }
+    keys.push_back(key);
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  std::vector<std::string> queries;
+  for (size_t i = 0; i < QueryCount; ++i)
+    queries.push_back(keys[gen() % keys.size()]);
+
+  const jasl::front_coded_dictionary dictionary(keys.begin(), keys.end());
+  size_t vector_memory = keys.capacity() * sizeof(std::string);
+  for (const std::string& key : keys) {
+    if (key.capacity() >= sizeof(std::string))
+      vector_memory += key.capacity() + 1;
+  }
+  std::cout << keys.size() << " keys" << std::endl
+            << " - [std::vector] of [std::string]: "
+            << vector_memory / (1024 * 1024) << " MiB" << std::endl
+            << " - [jasl::front_coded_dictionary]: "
+            << dictionary.memory_usage() / (1024 * 1024) << " MiB" << std::endl
+            << std::endl;
+
+  std::cout << "Lookup" << std::endl << std::endl;
+  auto binary_search = measure_units(
+      "[std::lower_bound] on the sorted vector", QueryCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const std::string& query : queries)
+          sum += static_cast<size_t>(
+              std::lower_bound(keys.begin(), keys.end(), query) -
+              keys.begin());
+        do_not_optimize(sum);
+      });
+  auto find = measure_units(
+      "[jasl::front_coded_dictionary::find]", QueryCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const std::string& query : queries)
+          sum += dictionary.find(jasl::string_view(query.data(), query.size()));
+        do_not_optimize(sum);
+      });
+  print_compare(find, binary_search);
+
+  std::cout << "Access by id" << std::endl << std::endl;
+  std::vector<size_t> ids;
+  for (size_t i = 0; i < QueryCount; ++i)
+    ids.push_back(gen() % keys.size());
+  auto access = measure_units(
+      "[jasl::front_coded_dictionary::access]", QueryCount, IterCount, [&] {
+        jasl::front_coded_dictionary::buffer_type buffer;
+        size_t sum = 0;
+        for (size_t id : ids)
+          sum += dictionary.access(id, buffer).size();
+        do_not_optimize(sum);
+      });
+  print_throughput(access, 1);
+
+  return 0;
+}
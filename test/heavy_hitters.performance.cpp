@@ -0,0 +1,102 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "jasl/jasl_heavy_hitters.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 1000000;
+constexpr static size_t StreamLength = 4000000;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::count_min_sketch] and "
+               "[jasl::space_saving]\nto an exact [std::unordered_map] of "
+               "counters.");
+
+  // Zipf-like stream of request paths
+  std::vector<double> weights;
+  for (size_t i = 0; i < KeyCount; ++i)
+    weights.push_back(1.0 / static_cast<double>(i + 1));
+  std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+  std::mt19937 gen(42);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i)
+    keys.push_back("/api/v1/items/" + std::to_string(i * 7919 % KeyCount));
+  std::vector<jasl::string_view> stream;
+  for (size_t i = 0; i < StreamLength; ++i) {
+    const std::string& key = keys[dist(gen)];
+    stream.push_back(jasl::string_view(key.data(), key.size()));
+  }
+
+  std::cout << "Count a stream of " << StreamLength << " requests of "
+            << KeyCount << " paths" << std::endl
+            << std::endl;
+  size_t map_memory = 0;
+  auto map =
+      measure_units("[std::unordered_map]", StreamLength, IterCount, [&] {
+        std::unordered_map<std::string, uint64_t> counts;
+        for (jasl::string_view key : stream)
+          ++counts[std::string(key.data(), key.size())];
+        map_memory = counts.bucket_count() * sizeof(void*) +
+                     counts.size() * (sizeof(std::string) + 48);
+        do_not_optimize(counts.size());
+      });
+  size_t sketch_memory = 0;
+  auto sketch = measure_units(
+      "[jasl::count_min_sketch] and [jasl::space_saving]", StreamLength,
+      IterCount, [&] {
+        jasl::count_min_sketch counts(16384, 4);
+        jasl::space_saving top(100);
+        for (jasl::string_view key : stream)
+          top.add(key);
+        for (jasl::string_view key : stream)
+          counts.add(key);
+        sketch_memory = counts.memory_usage();
+        do_not_optimize(top.top(10).size());
+      });
+  print_compare(sketch, map);
+  std::cout << " - [std::unordered_map]: at least "
+            << map_memory / (1024 * 1024) << " MiB" << std::endl
+            << " - [jasl::count_min_sketch]: " << sketch_memory / 1024
+            << " KiB" << std::endl
+            << std::endl;
+
+  std::cout << "[jasl::concurrent_count_min_sketch] on the default thread pool"
+            << std::endl
+            << std::endl;
+  jasl::thread_pool& pool = jasl::default_thread_pool();
+  auto single = measure_units("[jasl::count_min_sketch]", StreamLength,
+                              IterCount, [&] {
+                                jasl::count_min_sketch counts(16384, 4);
+                                for (jasl::string_view key : stream)
+                                  counts.add(key);
+                                do_not_optimize(counts.total());
+                              });
+  auto concurrent = measure_units(
+      "[jasl::concurrent_count_min_sketch]", StreamLength, IterCount, [&] {
+        jasl::concurrent_count_min_sketch counts(pool.size(), 16384, 4);
+        const size_t part = (stream.size() + pool.size() - 1) / pool.size();
+        pool.run(pool.size(), [&](size_t t) {
+          const size_t last = std::min(stream.size(), (t + 1) * part);
+          for (size_t i = t * part; i < last; ++i)
+            counts.add(t, stream[i]);
+        });
+        counts.merge();
+        do_not_optimize(counts.snapshot().total());
+      });
+  print_compare(concurrent, single);
+
+  return 0;
+}
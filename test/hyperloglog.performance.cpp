@@ -0,0 +1,92 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "jasl/jasl_hyperloglog.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 2000000;
+constexpr static size_t DistinctCount = 500000;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::hyperloglog] to "
+               "counting the distinct\nkeys in a [std::unordered_set].");
+
+  std::mt19937 gen(42);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i)
+    keys.push_back("user/" + std::to_string(gen() % DistinctCount));
+
+  std::cout << "Count the distinct keys of " << KeyCount << " keys"
+            << std::endl
+            << std::endl;
+  size_t set_memory = 0;
+  auto set = measure_units("[std::unordered_set]", KeyCount, IterCount, [&] {
+    std::unordered_set<std::string> distinct;
+    for (const std::string& key : keys)
+      distinct.insert(key);
+    set_memory = distinct.bucket_count() * sizeof(void*) +
+                 distinct.size() * (sizeof(std::string) + 2 * sizeof(void*));
+    do_not_optimize(distinct.size());
+  });
+  size_t sketch_memory = 0;
+  double estimate = 0;
+  auto sketch = measure_units("[jasl::hyperloglog]", KeyCount, IterCount, [&] {
+    jasl::hyperloglog distinct;
+    distinct.insert(keys.begin(), keys.end());
+    sketch_memory = distinct.memory_usage();
+    estimate = distinct.estimate();
+  });
+  print_compare(sketch, set);
+  std::cout << " - memory: " << set_memory / 1024 << " KiB / "
+            << sketch_memory / 1024 << " KiB, estimate: " << estimate
+            << std::endl
+            << std::endl;
+
+  std::cout << "Sketches of the threads merged" << std::endl << std::endl;
+  jasl::thread_pool& pool = jasl::default_thread_pool();
+  auto parallel = measure_units(
+      "[jasl::hyperloglog] on the default thread pool", KeyCount, IterCount,
+      [&] {
+        std::vector<jasl::hyperloglog> sketches(pool.size());
+        const size_t chunk = (KeyCount + pool.size() - 1) / pool.size();
+        pool.run(pool.size(), [&](size_t t) {
+          const size_t first = std::min(KeyCount, t * chunk);
+          const size_t last = std::min(KeyCount, first + chunk);
+          sketches[t].insert(keys.begin() + static_cast<long>(first),
+                             keys.begin() + static_cast<long>(last));
+        });
+        for (size_t t = 1; t < sketches.size(); ++t)
+          sketches[0].merge(sketches[t]);
+        do_not_optimize(sketches[0].estimate());
+      });
+  print_compare(parallel, sketch);
+
+  std::cout << "Estimate and merge of dense sketches (precision 18)"
+            << std::endl
+            << std::endl;
+  jasl::hyperloglog a(18);
+  jasl::hyperloglog b(18);
+  a.insert(keys.begin(), keys.begin() + KeyCount / 2);
+  b.insert(keys.begin() + KeyCount / 2, keys.end());
+  auto estimate_time =
+      measure_units("[jasl::hyperloglog::estimate]", 1, IterCount,
+                    [&] { do_not_optimize(a.estimate()); });
+  print_throughput(estimate_time, 1 << 18);
+  auto merge_time = measure_units("[jasl::hyperloglog::merge]", 1, IterCount,
+                                  [&] { a.merge(b); });
+  print_throughput(merge_time, 1 << 18);
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_bloom_filter.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+std::string key(const char* prefix, size_t i) {
+  return prefix + std::to_string(i);
+}
+
+// the measured false positive rate of non-member queries
+double false_positive_rate(size_t count, double rate) {
+  jasl::bloom_filter filter(count, rate);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; ++i)
+    keys.push_back(key("member/", i));
+  filter.insert(keys.begin(), keys.end());
+  for (const std::string& k : keys) {
+    if (!filter.contains(view(k)))
+      return 1;  // false negative
+  }
+  size_t positives = 0;
+  const size_t queries = 200000;
+  for (size_t i = 0; i < queries; ++i)
+    positives += filter.contains(view(key("other/", i)));
+  return static_cast<double>(positives) / queries;
+}
+
+int main() {
+  {
+    jasl::bloom_filter filter(100);
+    ASSERT_TRUE(filter.bit_count() >= 958);
+    ASSERT_TRUE(filter.bit_count() % 512 == 0);
+    ASSERT_TRUE(filter.hash_count() == 7);
+    ASSERT_TRUE(filter.memory_usage() >= filter.bit_count() / 8);
+    ASSERT_FALSE(filter.contains(jasl::static_string("apple")));
+    ASSERT_TRUE(filter.estimated_false_positive_rate() == 0);
+
+    filter.insert(jasl::static_string("apple"));
+    filter.insert(jasl::static_string(""));
+    ASSERT_TRUE(filter.contains(jasl::static_string("apple")));
+    ASSERT_TRUE(filter.contains(jasl::static_string("")));
+    ASSERT_TRUE(filter.estimated_false_positive_rate() > 0);
+
+    filter.clear();
+    ASSERT_FALSE(filter.contains(jasl::static_string("apple")));
+
+    ASSERT_EXCEPTION(jasl::bloom_filter(10, 0), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::bloom_filter(10, 1), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::bloom_filter(10, -0.5), std::invalid_argument);
+
+    jasl::bloom_filter moved(std::move(filter));
+    moved.insert(jasl::static_string("banana"));
+    ASSERT_TRUE(moved.contains(jasl::static_string("banana")));
+
+    // the moved-from filter has no bits, and can be cleared and assigned to
+    ASSERT_TRUE(filter.bit_count() == 0);
+    ASSERT_TRUE(filter.memory_usage() == 0);
+    filter.clear();
+
+    filter = std::move(moved);
+    ASSERT_TRUE(filter.contains(jasl::static_string("banana")));
+    ASSERT_TRUE(moved.bit_count() == 0);
+    moved = jasl::bloom_filter(10);
+    moved.insert(jasl::static_string("cherry"));
+    ASSERT_TRUE(moved.contains(jasl::static_string("cherry")));
+  }
+  {
+    // the bulk operations agree with the single ones
+    jasl::bloom_filter single(1000, 0.05);
+    jasl::bloom_filter bulk(1000, 0.05);
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 1000; ++i)
+      keys.push_back(key("k", i * 7));
+    for (size_t i = 0; i < 500; ++i)
+      single.insert(view(keys[i]));
+    bulk.insert(keys.begin(), keys.begin() + 500);
+
+    std::vector<bool> results;
+    bulk.contains(keys.begin(), keys.end(), std::back_inserter(results));
+    ASSERT_TRUE(results.size() == keys.size());
+    size_t positives = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ASSERT_TRUE(results[i] == single.contains(view(keys[i])));
+      ASSERT_TRUE(i >= 500 || results[i]);
+      positives += i >= 500 && results[i];
+    }
+    ASSERT_TRUE(positives < 100);
+
+    const jasl::static_string views[] = {"x", "y"};
+    bool found[2];
+    ASSERT_TRUE(bulk.contains(std::begin(views), std::end(views), found) ==
+                found + 2);
+  }
+  {
+    // wide characters are hashed as their bytes
+    jasl::basic_bloom_filter<wchar_t> filter(10);
+    filter.insert(jasl::static_wstring(L"wide"));
+    ASSERT_TRUE(filter.contains(jasl::static_wstring(L"wide")));
+  }
+
+  // the false positive rates are close to the requested ones
+  ASSERT_TRUE(false_positive_rate(100000, 0.01) < 0.012);
+  ASSERT_TRUE(false_positive_rate(100000, 0.001) < 0.0015);
+  ASSERT_TRUE(false_positive_rate(1000, 0.1) < 0.12);
+  ASSERT_TRUE(false_positive_rate(100000, 0.0001) < 0.0002);
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <cstring>
+#include <string>
+
+#include "jasl/jasl_c_str_buffer.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+int main() {
+  {
+    const jasl::static_string literal = "literal";
+    const jasl::c_str_buffer b(literal);
+    ASSERT_FALSE(b.is_copy());
+    ASSERT_TRUE(b.c_str() == literal.data());
+  }
+  {
+    const jasl::c_str_buffer b("literal");
+    ASSERT_FALSE(b.is_copy());
+    ASSERT_TRUE(std::strcmp(b.c_str(), "literal") == 0);
+  }
+  {
+    const std::string str = "std";
+    const jasl::c_str_buffer b(str);
+    ASSERT_FALSE(b.is_copy());
+    ASSERT_TRUE(b.c_str() == str.c_str());
+  }
+  {
+    const jasl::string str("dynamic", 7);
+    const jasl::c_str_buffer b(str);
+    ASSERT_FALSE(b.is_copy());
+    ASSERT_TRUE(b.c_str() == str.data());
+  }
+  {
+    const std::string str = "path/to/file";
+    const jasl::c_str_buffer b(jasl::string_view(str.data(), 7));
+    ASSERT_TRUE(b.is_copy());
+    ASSERT_TRUE(std::strcmp(b.c_str(), "path/to") == 0);
+  }
+  {
+    const jasl::string str = "path/to/file";
+    const jasl::c_str_buffer b(str.substr(0, 4));
+    ASSERT_TRUE(b.is_copy());
+    ASSERT_TRUE(std::strcmp(b.c_str(), "path") == 0);
+  }
+  {
+    const char chars[] = {'a', 'b'};
+    const jasl::static_string str = chars;
+    const jasl::c_str_buffer b(str);
+    ASSERT_TRUE(b.is_copy());
+    ASSERT_TRUE(std::strcmp(b.c_str(), "ab") == 0);
+  }
+  {
+    const jasl::c_str_buffer b((jasl::string_view()));
+    ASSERT_TRUE(b.c_str()[0] == 0);
+  }
+  {
+    // longer than the buffer
+    const std::string str(1000, 'x');
+    const jasl::basic_c_str_buffer<char, std::char_traits<char>, 16> b(
+        jasl::string_view(str.data(), 999));
+    ASSERT_TRUE(b.is_copy());
+    ASSERT_TRUE(std::strlen(b.c_str()) == 999);
+    const jasl::basic_c_str_buffer<char, std::char_traits<char>, 16> exact(
+        jasl::string_view(str.data(), 16));
+    ASSERT_TRUE(std::strlen(exact.c_str()) == 16);
+  }
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <cctype>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "jasl/jasl_case_insensitive.hpp"
+#include "jasl/jasl_internal/jasl_murmurhash3.hpp"
+#include "test_helper.hpp"
+
+jasl::ci_string_view ci_view(const std::string& str) {
+  return jasl::ci_string_view(str.data(), str.size());
+}
+
+std::string lower(std::string str) {
+  for (char& c : str) {
+    if (c >= 'A' && c <= 'Z')
+      c = static_cast<char>(c + ('a' - 'A'));
+  }
+  return str;
+}
+
+int sign(int x) {
+  return (x > 0) - (x < 0);
+}
+
+size_t murmur_of_lower(const std::string& str) {
+  const std::string l = lower(str);
+  uint64_t res[2];
+  jasl::murmurhash3::MurmurHash3_x64_128(l.data(), static_cast<int>(l.size()),
+                                         33, res);
+  return static_cast<size_t>(res[0]);
+}
+
+int main() {
+  {
+    const jasl::ci_static_string a = "Content-Type";
+    const jasl::ci_static_string b = "content-type";
+    const jasl::ci_static_string c = "content-typf";
+    ASSERT_TRUE(a == b);
+    ASSERT_FALSE(a != b);
+    ASSERT_TRUE(a != c);
+    ASSERT_TRUE(a < c);
+    const jasl::ci_string_view av = a;
+    ASSERT_TRUE(av.compare(b) == 0);
+    ASSERT_TRUE(av.find(jasl::ci_static_string("TYPE")) == 8);
+    ASSERT_TRUE(jasl::ascii_case_insensitive_traits::find(a.data(), a.size(),
+                                                          'T') ==
+                a.data() + 3);
+    ASSERT_TRUE(jasl::ascii_case_insensitive_hash()(a) ==
+                jasl::ascii_case_insensitive_hash()(b));
+    ASSERT_TRUE(std::hash<jasl::ci_string_view>()(a) ==
+                jasl::ascii_case_insensitive_hash()(b));
+    const jasl::ci_string s = a;
+    ASSERT_TRUE(s == b);
+    const jasl::ci_string copy("CONTENT-TYPE", 12);
+    ASSERT_TRUE(copy == a);
+  }
+  {
+    // '@' and '`', '[' and '{' differ in the 0x20 bit but are not letters
+    ASSERT_TRUE(jasl::ci_static_string("@") != jasl::ci_static_string("`"));
+    ASSERT_TRUE(jasl::ci_static_string("[") != jasl::ci_static_string("{"));
+    ASSERT_TRUE(jasl::ci_static_string("\xC3\x89") !=
+                jasl::ci_static_string("\xC3\xA9"));
+    ASSERT_TRUE(jasl::ci_static_string("Z") > jasl::ci_static_string("a"));
+    ASSERT_TRUE(jasl::ci_static_string("_") < jasl::ci_static_string("A"));
+  }
+  {
+    std::unordered_map<jasl::ci_string_view, int,
+                       jasl::ascii_case_insensitive_hash>
+        headers;
+    headers[jasl::ci_static_string("Content-Length")] = 1;
+    headers[jasl::ci_static_string("ACCEPT")] = 2;
+    ASSERT_TRUE(headers.count(jasl::ci_static_string("content-length")) == 1);
+    ASSERT_TRUE(headers.at(jasl::ci_static_string("Accept")) == 2);
+    headers[jasl::ci_static_string("accept")] = 3;
+    ASSERT_TRUE(headers.size() == 2);
+    std::map<jasl::ci_string_view, int> ordered;
+    ordered[jasl::ci_static_string("b")] = 1;
+    ordered[jasl::ci_static_string("A")] = 2;
+    ASSERT_TRUE(ordered.begin()->second == 2);
+  }
+  {
+    std::mt19937 gen(42);
+    const char alphabet[] = "aAbBzZ@[`{09 \x80\xE1\xC1";
+    for (size_t iter = 0; iter < 20000; ++iter) {
+      std::string x;
+      const size_t size = gen() % 70;
+      for (size_t i = 0; i < size; ++i)
+        x += alphabet[gen() % (sizeof(alphabet) - 1)];
+      std::string y = x;
+      // change the case of some letters, maybe change one character
+      for (char& c : y) {
+        if (std::isalpha(static_cast<unsigned char>(c)) && gen() % 2 == 0)
+          c = static_cast<char>(c ^ 0x20);
+      }
+      if (!y.empty() && gen() % 2 == 0)
+        y[gen() % y.size()] = alphabet[gen() % (sizeof(alphabet) - 1)];
+      const std::string lx = lower(x);
+      const std::string ly = lower(y);
+      ASSERT_TRUE(sign(ci_view(x).compare(ci_view(y))) ==
+                  sign(lx.compare(ly)));
+      ASSERT_TRUE((ci_view(x) == ci_view(y)) == (lx == ly));
+      ASSERT_TRUE(jasl::ascii_case_insensitive_hash()(ci_view(x)) ==
+                  murmur_of_lower(x));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,412 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+
+#include "jasl/jasl_charconv.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "test_helper.hpp"
+
+template <typename T>
+bool parses(const std::string& str, T expected, size_t length) {
+  T value = T();
+  const jasl::from_chars_result r =
+      jasl::from_chars(str.data(), str.data() + str.size(), value);
+  return r.ec == std::errc() && r.ptr == str.data() + length &&
+         value == expected;
+}
+
+template <typename T>
+bool fails(const std::string& str, std::errc ec, size_t length) {
+  T value = T(7);
+  const jasl::from_chars_result r =
+      jasl::from_chars(str.data(), str.data() + str.size(), value);
+  return r.ec == ec && r.ptr == str.data() + length && value == T(7);
+}
+
+bool same_bits(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+bool same_bits(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Compares to the C library, which is correctly rounded in glibc.
+bool matches_strtod(const std::string& str) {
+  errno = 0;
+  const double expected = std::strtod(str.c_str(), nullptr);
+  const bool out_of_range = errno == ERANGE &&
+                            (expected == 0 || std::isinf(expected));
+  double value = 1;
+  const jasl::from_chars_result r =
+      jasl::from_chars(str.data(), str.data() + str.size(), value);
+  if (out_of_range)
+    return r.ec == std::errc::result_out_of_range && value == 1;
+  return r.ec == std::errc() && r.ptr == str.data() + str.size() &&
+         same_bits(value, expected);
+}
+
+bool matches_strtof(const std::string& str) {
+  errno = 0;
+  const float expected = std::strtof(str.c_str(), nullptr);
+  const bool out_of_range = errno == ERANGE &&
+                            (expected == 0 || std::isinf(expected));
+  float value = 1;
+  const jasl::from_chars_result r =
+      jasl::from_chars(str.data(), str.data() + str.size(), value);
+  if (out_of_range)
+    return r.ec == std::errc::result_out_of_range && value == 1;
+  return r.ec == std::errc() && r.ptr == str.data() + str.size() &&
+         same_bits(value, expected);
+}
+
+template <typename T>
+std::string to_string(T value) {
+  char buffer[64];
+  const jasl::to_chars_result r = jasl::to_chars(buffer, buffer + 64, value);
+  return r.ec == std::errc() ? std::string(buffer, r.ptr) : "error";
+}
+
+template <typename T>
+std::string to_string(T value, int base) {
+  char buffer[80];
+  const jasl::to_chars_result r =
+      jasl::to_chars(buffer, buffer + 80, value, base);
+  return r.ec == std::errc() ? std::string(buffer, r.ptr) : "error";
+}
+
+int test_to_chars() {
+  {
+    ASSERT_TRUE(to_string(0) == "0");
+    ASSERT_TRUE(to_string(-1) == "-1");
+    ASSERT_TRUE(to_string(int8_t(-128)) == "-128");
+    ASSERT_TRUE(to_string(uint8_t(255)) == "255");
+    ASSERT_TRUE(to_string(std::numeric_limits<int64_t>::min()) ==
+                "-9223372036854775808");
+    ASSERT_TRUE(to_string(std::numeric_limits<uint64_t>::max()) ==
+                "18446744073709551615");
+    ASSERT_TRUE(to_string(255, 16) == "ff");
+    ASSERT_TRUE(to_string(-5, 2) == "-101");
+    ASSERT_TRUE(to_string(35, 36) == "z");
+    ASSERT_TRUE(to_string(std::numeric_limits<uint64_t>::max(), 2) ==
+                std::string(64, '1'));
+    std::mt19937_64 gen(4);
+    for (size_t i = 0; i < 20000; ++i) {
+      const uint64_t x = gen() >> (i % 64);
+      ASSERT_TRUE(to_string(x) == std::to_string(x));
+      const int64_t y = static_cast<int64_t>(gen()) >> (i % 64);
+      ASSERT_TRUE(to_string(y) == std::to_string(y));
+    }
+    // the buffer is too small
+    char buffer[4];
+    jasl::to_chars_result r = jasl::to_chars(buffer, buffer + 4, 12345);
+    ASSERT_TRUE(r.ec == std::errc::value_too_large && r.ptr == buffer + 4);
+    r = jasl::to_chars(buffer, buffer + 4, -1234);
+    ASSERT_TRUE(r.ec == std::errc::value_too_large);
+    r = jasl::to_chars(buffer, buffer + 4, -123);
+    ASSERT_TRUE(r.ec == std::errc() && r.ptr == buffer + 4);
+    r = jasl::to_chars(buffer, buffer + 4, 1e100);
+    ASSERT_TRUE(r.ec == std::errc::value_too_large && r.ptr == buffer + 4);
+  }
+  {
+    ASSERT_TRUE(to_string(0.0) == "0");
+    ASSERT_TRUE(to_string(-0.0) == "-0");
+    ASSERT_TRUE(to_string(0.1) == "0.1");
+    ASSERT_TRUE(to_string(0.3) == "0.3");
+    ASSERT_TRUE(to_string(100.0) == "100");
+    ASSERT_TRUE(to_string(-2.5) == "-2.5");
+    ASSERT_TRUE(to_string(123456789012345.0) == "123456789012345");
+    ASSERT_TRUE(to_string(1e15) == "1e+15");
+    ASSERT_TRUE(to_string(1.5e300) == "1.5e+300");
+    ASSERT_TRUE(to_string(1e-4) == "0.0001");
+    ASSERT_TRUE(to_string(1.25e-5) == "1.25e-05");
+    ASSERT_TRUE(to_string(5e-324) == "5e-324");
+    ASSERT_TRUE(to_string(std::numeric_limits<double>::max()) ==
+                "1.7976931348623157e+308");
+    ASSERT_TRUE(to_string(std::numeric_limits<double>::infinity()) == "inf");
+    ASSERT_TRUE(to_string(-std::numeric_limits<double>::infinity()) ==
+                "-inf");
+    ASSERT_TRUE(to_string(std::numeric_limits<double>::quiet_NaN()) ==
+                "nan");
+    ASSERT_TRUE(to_string(0.1f) == "0.1");
+    ASSERT_TRUE(to_string(16777216.0f) == "1.6777216e+07");
+    ASSERT_TRUE(to_string(123456.0f) == "123456");
+    ASSERT_TRUE(to_string(std::numeric_limits<float>::denorm_min()) ==
+                "1e-45");
+  }
+  {
+    // random values parse back to themselves, also with jasl::from_chars
+    std::mt19937_64 gen(5);
+    for (size_t i = 0; i < 100000; ++i) {
+      const uint64_t bits = gen();
+      double d;
+      std::memcpy(&d, &bits, sizeof(d));
+      if (std::isnan(d))
+        continue;
+      const std::string str = to_string(d);
+      ASSERT_TRUE(str.size() <= 24);
+      ASSERT_TRUE(same_bits(std::strtod(str.c_str(), nullptr), d));
+      double parsed = 0;
+      ASSERT_TRUE(
+          jasl::from_chars(str.data(), str.data() + str.size(), parsed).ec ==
+          std::errc());
+      ASSERT_TRUE(same_bits(parsed, d));
+      const uint32_t bits32 = static_cast<uint32_t>(bits);
+      float f;
+      std::memcpy(&f, &bits32, sizeof(f));
+      if (std::isnan(f))
+        continue;
+      const std::string str32 = to_string(f);
+      ASSERT_TRUE(same_bits(std::strtof(str32.c_str(), nullptr), f));
+    }
+  }
+  return 0;
+}
+
+int main() {
+  {
+    ASSERT_TRUE(parses<int>("0", 0, 1));
+    ASSERT_TRUE(parses<int>("-0", 0, 2));
+    ASSERT_TRUE(parses<int>("123abc", 123, 3));
+    ASSERT_TRUE(parses<int>("-2147483648", -2147483647 - 1, 11));
+    ASSERT_TRUE(parses<int>("2147483647", 2147483647, 10));
+    ASSERT_TRUE(parses<int8_t>("-128", -128, 4));
+    ASSERT_TRUE(parses<int8_t>("127", 127, 3));
+    ASSERT_TRUE(parses<uint8_t>("255", 255, 3));
+    ASSERT_TRUE(parses<int>("0000000000000000000000000042", 42, 28));
+    ASSERT_TRUE(parses<uint64_t>("18446744073709551615",
+                                 std::numeric_limits<uint64_t>::max(), 20));
+    ASSERT_TRUE(parses<int64_t>("-9223372036854775808",
+                                std::numeric_limits<int64_t>::min(), 20));
+    ASSERT_TRUE(parses<int64_t>("9223372036854775807",
+                                std::numeric_limits<int64_t>::max(), 19));
+    ASSERT_TRUE(parses<unsigned>("12345678x", 12345678u, 8));
+    ASSERT_TRUE(parses<unsigned>("1234567x9", 1234567u, 7));
+
+    ASSERT_TRUE(fails<int>("", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<int>("-", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<int>("+1", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<int>(" 1", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<unsigned>("-1", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<int8_t>("128", std::errc::result_out_of_range, 3));
+    ASSERT_TRUE(fails<int8_t>("-129", std::errc::result_out_of_range, 4));
+    ASSERT_TRUE(fails<uint64_t>("18446744073709551616",
+                                std::errc::result_out_of_range, 20));
+    ASSERT_TRUE(fails<uint64_t>("99999999999999999999",
+                                std::errc::result_out_of_range, 20));
+    ASSERT_TRUE(fails<uint64_t>("123456789012345678901234567890x",
+                                std::errc::result_out_of_range, 30));
+    ASSERT_TRUE(fails<int64_t>("-9223372036854775809",
+                               std::errc::result_out_of_range, 20));
+  }
+  {
+    // other bases
+    const std::string hex = "7fFFffFFz";
+    int value = 0;
+    jasl::from_chars_result r =
+        jasl::from_chars(hex.data(), hex.data() + hex.size(), value, 16);
+    ASSERT_TRUE(r.ec == std::errc() && r.ptr == hex.data() + 8);
+    ASSERT_TRUE(value == 2147483647);
+    const std::string binary = "-1012";
+    r = jasl::from_chars(binary.data(), binary.data() + binary.size(), value,
+                         2);
+    ASSERT_TRUE(r.ec == std::errc() && r.ptr == binary.data() + 4);
+    ASSERT_TRUE(value == -5);
+    const std::string base36 = "Zz";
+    r = jasl::from_chars(base36.data(), base36.data() + base36.size(), value,
+                         36);
+    ASSERT_TRUE(r.ec == std::errc() && value == 35 * 36 + 35);
+    const std::string too_big = "100000000";
+    r = jasl::from_chars(too_big.data(), too_big.data() + too_big.size(),
+                         value, 16);
+    ASSERT_TRUE(r.ec == std::errc::result_out_of_range);
+  }
+  {
+    // random round trips of every length
+    std::mt19937_64 gen(1);
+    for (size_t i = 0; i < 20000; ++i) {
+      const uint64_t x = gen() >> (i % 64);
+      ASSERT_TRUE(parses<uint64_t>(std::to_string(x), x,
+                                   std::to_string(x).size()));
+      const int64_t y = static_cast<int64_t>(gen()) >> (i % 64);
+      ASSERT_TRUE(parses<int64_t>(std::to_string(y), y,
+                                  std::to_string(y).size()));
+      const int32_t z = static_cast<int32_t>(y);
+      ASSERT_TRUE(parses<int32_t>(std::to_string(z), z,
+                                  std::to_string(z).size()));
+    }
+  }
+  {
+    // no NUL termination: only the characters of the view are used
+    const std::string digits = "1234567890123";
+    const jasl::string_view view(digits.data(), 9);
+    int value = 0;
+    const jasl::from_chars_result r = jasl::from_chars(view, value);
+    ASSERT_TRUE(r.ec == std::errc() && r.ptr == digits.data() + 9);
+    ASSERT_TRUE(value == 123456789);
+    ASSERT_TRUE(jasl::from_chars(jasl::static_string("-42"), value).ec ==
+                std::errc());
+    ASSERT_TRUE(value == -42);
+    double d = 0;
+    ASSERT_TRUE(jasl::from_chars(jasl::string("2.5e3"), d).ec == std::errc());
+    ASSERT_TRUE(d == 2500);
+    const std::string number = "3.14159";
+    ASSERT_TRUE(
+        jasl::from_chars(jasl::string_view(number.data(), 4), d).ec ==
+        std::errc());
+    ASSERT_TRUE(d == 3.14);
+  }
+  {
+    ASSERT_TRUE(parses<double>("0", 0.0, 1));
+    ASSERT_TRUE(parses<double>("1.5", 1.5, 3));
+    ASSERT_TRUE(parses<double>("-1.5e2", -150.0, 6));
+    ASSERT_TRUE(parses<double>(".5", 0.5, 2));
+    ASSERT_TRUE(parses<double>("5.", 5.0, 2));
+    ASSERT_TRUE(parses<double>("1e", 1.0, 1));
+    ASSERT_TRUE(parses<double>("1e+", 1.0, 1));
+    ASSERT_TRUE(parses<double>("1E+2x", 100.0, 4));
+    ASSERT_TRUE(parses<double>("1.5.5", 1.5, 3));
+    ASSERT_TRUE(parses<double>("2.5e-1", 0.25, 6));
+    ASSERT_TRUE(parses<double>("1.7976931348623157e308",
+                               std::numeric_limits<double>::max(), 22));
+    ASSERT_TRUE(parses<double>("4.9406564584124654e-324",
+                               std::numeric_limits<double>::denorm_min(), 23));
+    ASSERT_TRUE(parses<float>("3.4028235e38", std::numeric_limits<float>::max(),
+                              12));
+    double negative_zero = 1;
+    const std::string minus_zero = "-0.0";
+    ASSERT_TRUE(jasl::from_chars(minus_zero.data(),
+                                 minus_zero.data() + minus_zero.size(),
+                                 negative_zero)
+                    .ec == std::errc());
+    ASSERT_TRUE(negative_zero == 0 && std::signbit(negative_zero));
+
+    ASSERT_TRUE(fails<double>("", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>(".", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>("-", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>("+1", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>("e5", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>("-.e1", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>("in", std::errc::invalid_argument, 0));
+    ASSERT_TRUE(fails<double>("1e309", std::errc::result_out_of_range, 5));
+    ASSERT_TRUE(fails<double>("-1e309", std::errc::result_out_of_range, 6));
+    ASSERT_TRUE(fails<double>("1e-400", std::errc::result_out_of_range, 6));
+    ASSERT_TRUE(fails<float>("1e39", std::errc::result_out_of_range, 4));
+    ASSERT_TRUE(fails<float>("1e-50", std::errc::result_out_of_range, 5));
+    ASSERT_TRUE(parses<double>("0e999999999999", 0.0, 14));
+  }
+  {
+    // inf and nan
+    const double inf = std::numeric_limits<double>::infinity();
+    ASSERT_TRUE(parses<double>("inf", inf, 3));
+    ASSERT_TRUE(parses<double>("-INF", -inf, 4));
+    ASSERT_TRUE(parses<double>("Infinity", inf, 8));
+    ASSERT_TRUE(parses<double>("infinit", inf, 3));
+    ASSERT_TRUE(parses<float>("inFx", std::numeric_limits<float>::infinity(),
+                              3));
+    const char* const nans[] = {"nan", "-NaN", "nan(123_abc)", "nan(", "nan(x"};
+    const size_t lengths[] = {3, 4, 12, 3, 3};
+    for (size_t i = 0; i < 5; ++i) {
+      const std::string str = nans[i];
+      double value = 0;
+      const jasl::from_chars_result r =
+          jasl::from_chars(str.data(), str.data() + str.size(), value);
+      ASSERT_TRUE(r.ec == std::errc() && r.ptr == str.data() + lengths[i]);
+      ASSERT_TRUE(std::isnan(value));
+    }
+  }
+  {
+    // the halfway cases between two doubles, 2^53 + 1 and around
+    ASSERT_TRUE(matches_strtod("9007199254740993"));
+    ASSERT_TRUE(matches_strtod("9007199254740993.0000000000000000000001"));
+    ASSERT_TRUE(matches_strtod("9007199254740992.9999999999999999999999"));
+    ASSERT_TRUE(matches_strtod("2.2250738585072011e-308"));
+    ASSERT_TRUE(matches_strtod("2.2250738585072012e-308"));
+    ASSERT_TRUE(matches_strtod("2.4703282292062327e-324"));
+    ASSERT_TRUE(matches_strtod("2.4703282292062328e-324"));
+    ASSERT_TRUE(matches_strtod("1.7976931348623158e308"));
+    ASSERT_TRUE(matches_strtod("1.7976931348623159e308"));
+    ASSERT_TRUE(matches_strtod("7.1e-10"));
+    ASSERT_TRUE(matches_strtod("0.000000000000000000000000000001"));
+    ASSERT_TRUE(matches_strtod("123456789012345678901234567890e-10"));
+    // the exact halfway of 1 and its successor, then a bit above it; the
+    // slow path is needed
+    std::string halfway =
+        "1.00000000000000011102230246251565404236316680908203125";
+    ASSERT_TRUE(matches_strtod(halfway));
+    halfway += std::string(1000, '0');
+    ASSERT_TRUE(matches_strtod(halfway));
+    ASSERT_TRUE(matches_strtod(halfway + "1"));
+    ASSERT_TRUE(matches_strtod(halfway + "1e-5"));
+    ASSERT_TRUE(matches_strtod("0." + std::string(400, '0') + "1" +
+                               std::string(400, '9')));
+    ASSERT_TRUE(matches_strtof("1.00000005960464477539062500001"));
+    ASSERT_TRUE(matches_strtof("1.000000059604644775390625"));
+    ASSERT_TRUE(matches_strtof("1.4e-45"));
+    ASSERT_TRUE(matches_strtof("7e-46"));
+  }
+  {
+    // random doubles in the shortest and the longest forms
+    std::mt19937_64 gen(2);
+    char buffer[64];
+    for (size_t i = 0; i < 100000; ++i) {
+      uint64_t bits = gen();
+      double d;
+      std::memcpy(&d, &bits, sizeof(d));
+      if (std::isnan(d) || std::isinf(d))
+        continue;
+      std::snprintf(buffer, sizeof(buffer), "%.17g", d);
+      ASSERT_TRUE(matches_strtod(buffer));
+      std::snprintf(buffer, sizeof(buffer), "%.*e",
+                    static_cast<int>(i % 25), d);
+      ASSERT_TRUE(matches_strtod(buffer));
+      float f;
+      const uint32_t bits32 = static_cast<uint32_t>(bits);
+      std::memcpy(&f, &bits32, sizeof(f));
+      if (std::isnan(f) || std::isinf(f))
+        continue;
+      std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(f));
+      ASSERT_TRUE(matches_strtof(buffer));
+      std::snprintf(buffer, sizeof(buffer), "%.*e",
+                    static_cast<int>(i % 12), static_cast<double>(f));
+      ASSERT_TRUE(matches_strtof(buffer));
+    }
+  }
+  {
+    // random digits with random exponents, also beyond the range
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> digit('0', '9');
+    std::uniform_int_distribution<int> exponent(-360, 330);
+    for (size_t i = 0; i < 100000; ++i) {
+      std::string str;
+      const size_t count = 1 + i % 40;
+      for (size_t j = 0; j < count; ++j)
+        str += static_cast<char>(digit(gen));
+      if (i % 3 == 0)
+        str.insert(i % count, ".");
+      str += 'e';
+      str += std::to_string(exponent(gen));
+      ASSERT_TRUE(matches_strtod(str));
+      ASSERT_TRUE(matches_strtof(str));
+    }
+  }
+
+  if (test_to_chars() != 0)
+    return 1;
+
+  return 0;
+}
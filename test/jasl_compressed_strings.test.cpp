@@ -0,0 +1,154 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_compressed_strings.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+std::string random_url(std::mt19937& gen) {
+  const std::string hosts[] = {"https://www.example.com/",
+                               "http://jasl.example.org/", "ftp://files.a.b/"};
+  const std::string words[] = {"index", "products", "item", "search?q=",
+                               "user", "&page=", ".html"};
+  std::string url = hosts[gen() % 3];
+  for (size_t i = gen() % 8; i > 0; --i) {
+    url += words[gen() % 7];
+    if (gen() % 3 == 0)
+      url += std::to_string(gen() % 100000);
+  }
+  return url;
+}
+
+std::string random_bytes(std::mt19937& gen, size_t size) {
+  std::string str;
+  for (size_t i = 0; i < size; ++i)
+    str += static_cast<char>(gen() % 256);
+  return str;
+}
+
+int check(const std::vector<std::string>& strings,
+          const jasl::compressed_strings& compressed) {
+  ASSERT_TRUE(compressed.size() == strings.size());
+  jasl::compressed_strings::buffer_type buffer;
+  char small[5];
+  for (size_t i = 0; i < strings.size(); ++i) {
+    const std::string& str = strings[i];
+    ASSERT_TRUE(to_std(compressed.decompress(i, buffer)) == str);
+    const jasl::string decompressed = compressed.to_string(i);
+    ASSERT_TRUE(decompressed == view(str));
+    // null terminated in its own allocation
+    ASSERT_TRUE(std::strlen(decompressed.c_str()) == std::strlen(str.c_str()));
+
+    std::string out(str.size() + 9, '#');
+    ASSERT_TRUE(compressed.decompress(i, &out[0], str.size()) == str.size());
+    ASSERT_TRUE(out == str + "#########");
+    ASSERT_TRUE(compressed.decompress(i, &out[0], out.size()) == str.size());
+    ASSERT_TRUE(out.substr(0, str.size()) == str);
+    // truncated like snprintf
+    std::fill(std::begin(small), std::end(small), '#');
+    ASSERT_TRUE(compressed.decompress(i, small, 4) == str.size());
+    const size_t kept = std::min<size_t>(str.size(), 4);
+    ASSERT_TRUE(std::string(small, kept) == str.substr(0, kept));
+    ASSERT_TRUE(small[4] == '#' && (kept == 4 || small[kept] == '#'));
+
+    const jasl::compressed_strings::compressed_key key =
+        compressed.compress(view(str));
+    ASSERT_TRUE(compressed.equals(i, key));
+    const size_t found = compressed.find(key);
+    ASSERT_TRUE(found <= i && strings[found] == str);
+    ASSERT_TRUE(compressed.find(key, i) == i);
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const jasl::static_string words[] = {"apple", "applesauce", "apply",
+                                         "banana", "", "apple"};
+    const jasl::compressed_strings compressed(std::begin(words),
+                                              std::end(words));
+    ASSERT_TRUE(compressed.size() == 6);
+    ASSERT_FALSE(compressed.empty());
+    ASSERT_TRUE(compressed.symbol_count() > 0);
+    ASSERT_TRUE(compressed.symbol_count() <= 255);
+    ASSERT_TRUE(compressed.to_string(1) == jasl::static_string("applesauce"));
+    ASSERT_TRUE(compressed.to_string(4).empty());
+
+    const auto apple = compressed.compress(jasl::static_string("apple"));
+    ASSERT_TRUE(compressed.equals(0, apple));
+    ASSERT_FALSE(compressed.equals(1, apple));
+    ASSERT_TRUE(compressed.find(apple) == 0);
+    ASSERT_TRUE(compressed.find(apple, 1) == 5);
+    ASSERT_TRUE(compressed.find(apple, 6) == jasl::compressed_strings::npos);
+    ASSERT_TRUE(compressed.find(compressed.compress(jasl::static_string(
+                    "cherry"))) == jasl::compressed_strings::npos);
+    ASSERT_TRUE(compressed.find(compressed.compress(jasl::static_string(""))) ==
+                4);
+
+    std::vector<std::string> strings;
+    for (const jasl::static_string& word : words)
+      strings.push_back(to_std(word));
+    ASSERT_TRUE(check(strings, compressed) == 0);
+  }
+  {
+    // the strings are compressed with the table of the constructor
+    const std::vector<jasl::string_view> none;
+    jasl::compressed_strings compressed(none.begin(), none.end());
+    ASSERT_TRUE(compressed.empty());
+    ASSERT_TRUE(compressed.symbol_count() == 0);
+    ASSERT_TRUE(compressed.find(compressed.compress(jasl::static_string(
+                    "a"))) == jasl::compressed_strings::npos);
+    std::vector<std::string> strings;
+    for (unsigned i = 0; i < 256; ++i)
+      strings.push_back(std::string(i % 7, static_cast<char>(i)));
+    for (const std::string& str : strings)
+      compressed.push_back(view(str));
+    ASSERT_TRUE(check(strings, compressed) == 0);
+  }
+
+  std::mt19937 gen(42);
+  {
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < 5000; ++i)
+      strings.push_back(random_url(gen));
+    const jasl::compressed_strings compressed(strings.begin(), strings.end());
+    ASSERT_TRUE(check(strings, compressed) == 0);
+    size_t total = 0;
+    for (const std::string& str : strings)
+      total += str.size();
+    ASSERT_TRUE(compressed.compressed_size() < total / 2);
+    ASSERT_TRUE(compressed.memory_usage() > compressed.compressed_size());
+
+    // strings which were not in the training sample
+    jasl::compressed_strings extended(strings.begin(), strings.begin() + 10);
+    std::vector<std::string> more(strings.begin(), strings.begin() + 10);
+    for (size_t i = 0; i < 300; ++i) {
+      more.push_back(i % 2 ? random_url(gen) : random_bytes(gen, i));
+      extended.push_back(view(more.back()));
+    }
+    ASSERT_TRUE(check(more, extended) == 0);
+  }
+  {
+    // every byte value, long strings, and more than 2^16 bytes
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < 200; ++i)
+      strings.push_back(random_bytes(gen, gen() % (i % 10 == 0 ? 5000 : 20)));
+    strings.push_back(std::string(100000, 'x'));
+    const jasl::compressed_strings compressed(strings.begin(), strings.end());
+    ASSERT_TRUE(check(strings, compressed) == 0);
+  }
+
+  return 0;
+}
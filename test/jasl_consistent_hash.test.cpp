@@ -0,0 +1,191 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_consistent_hash.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+std::vector<std::string> make_keys(size_t count) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; ++i)
+    keys.push_back("session/" + std::to_string(i));
+  return keys;
+}
+
+std::vector<std::string> make_nodes(size_t count) {
+  std::vector<std::string> nodes;
+  for (size_t i = 0; i < count; ++i)
+    nodes.push_back("cache-" + std::to_string(i) + ".example.com");
+  return nodes;
+}
+
+// every count is within tolerance of the mean
+bool balanced(const std::vector<size_t>& counts, double tolerance) {
+  size_t sum = 0;
+  for (size_t count : counts)
+    sum += count;
+  const double mean =
+      static_cast<double>(sum) / static_cast<double>(counts.size());
+  for (size_t count : counts) {
+    if (static_cast<double>(count) < mean * (1 - tolerance) ||
+        static_cast<double>(count) > mean * (1 + tolerance))
+      return false;
+  }
+  return true;
+}
+
+template <typename HashT>
+std::vector<std::string> owners(const HashT& hash,
+                                const std::vector<std::string>& keys) {
+  std::vector<std::string> result;
+  for (const std::string& key : keys) {
+    const jasl::string_view node = hash.node(view(key));
+    result.push_back(std::string(node.data(), node.size()));
+  }
+  return result;
+}
+
+// the keys which moved went to added, or came from removed
+bool minimal_move(const std::vector<std::string>& before,
+                  const std::vector<std::string>& after,
+                  const std::string& node,
+                  double expected_ratio) {
+  size_t moved = 0;
+  for (size_t i = 0; i < before.size(); ++i) {
+    if (before[i] != after[i]) {
+      if (before[i] != node && after[i] != node)
+        return false;
+      ++moved;
+    }
+  }
+  const double ratio =
+      static_cast<double>(moved) / static_cast<double>(before.size());
+  return ratio > expected_ratio * 0.7 && ratio < expected_ratio * 1.3;
+}
+
+int main() {
+  const std::vector<std::string> keys = make_keys(100000);
+  {
+    const jasl::jump_hash hash(10);
+    ASSERT_TRUE(hash.shard_count() == 10);
+    std::vector<size_t> counts(10);
+    for (const std::string& key : keys) {
+      const size_t shard = hash.shard(view(key));
+      ASSERT_TRUE(shard < 10);
+      ++counts[shard];
+    }
+    ASSERT_TRUE(balanced(counts, 0.05));
+    ASSERT_TRUE(jasl::jump_hash(1).shard(jasl::static_string("x")) == 0);
+
+    // growing moves 1 / (n + 1) of the keys, all to the new shard
+    const jasl::jump_hash grown(11);
+    size_t moved = 0;
+    for (const std::string& key : keys) {
+      const size_t before = hash.shard(view(key));
+      const size_t after = grown.shard(view(key));
+      if (before != after) {
+        ASSERT_TRUE(after == 10);
+        ++moved;
+      }
+    }
+    ASSERT_TRUE(moved > keys.size() / 11 * 9 / 10 &&
+                moved < keys.size() / 11 * 11 / 10);
+
+    // the batch lookup is the same as the single one
+    const size_t lengths[] = {0, 1, 3, 4, 5, 16, 17, 1000};
+    for (size_t length : lengths) {
+      std::vector<size_t> batch;
+      hash.shards(keys.begin(), keys.begin() + static_cast<long>(length),
+                  std::back_inserter(batch));
+      ASSERT_TRUE(batch.size() == length);
+      for (size_t i = 0; i < length; ++i)
+        ASSERT_TRUE(batch[i] == hash.shard(view(keys[i])));
+    }
+
+    ASSERT_EXCEPTION(jasl::jump_hash(0), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::jump_hash(size_t(1) << 31), std::invalid_argument);
+  }
+  {
+    const std::vector<std::string> nodes = make_nodes(8);
+    jasl::rendezvous_hash hash(nodes.begin(), nodes.end());
+    ASSERT_TRUE(hash.node_count() == 8);
+    ASSERT_TRUE(hash.node_names() == nodes);
+    ASSERT_FALSE(hash.add_node(view(nodes[3])));
+    ASSERT_FALSE(hash.remove_node(jasl::static_string("unknown")));
+
+    const std::vector<std::string> before = owners(hash, keys);
+    std::vector<size_t> counts(8);
+    for (const std::string& owner : before) {
+      for (size_t i = 0; i < nodes.size(); ++i)
+        counts[i] += owner == nodes[i];
+    }
+    ASSERT_TRUE(balanced(counts, 0.05));
+
+    ASSERT_TRUE(hash.remove_node(view(nodes[2])));
+    ASSERT_TRUE(minimal_move(before, owners(hash, keys), nodes[2], 1.0 / 8));
+    ASSERT_TRUE(hash.add_node(view(nodes[2])));
+    ASSERT_TRUE(owners(hash, keys) == before);
+    const std::string added = "cache-new.example.com";
+    ASSERT_TRUE(hash.add_node(view(added)));
+    ASSERT_TRUE(minimal_move(before, owners(hash, keys), added, 1.0 / 9));
+
+    std::vector<jasl::string_view> batch;
+    hash.nodes(keys.begin(), keys.begin() + 100, std::back_inserter(batch));
+    ASSERT_TRUE(batch.size() == 100);
+    for (size_t i = 0; i < batch.size(); ++i)
+      ASSERT_TRUE(batch[i] == hash.node(view(keys[i])));
+  }
+  {
+    const std::vector<std::string> nodes = make_nodes(8);
+    jasl::hash_ring ring(nodes.begin(), nodes.end());
+    ASSERT_TRUE(ring.node_count() == 8);
+    ASSERT_TRUE(ring.virtual_node_count() == 160);
+    ASSERT_FALSE(ring.add_node(view(nodes[3])));
+    ASSERT_FALSE(ring.remove_node(jasl::static_string("unknown")));
+
+    const std::vector<std::string> before = owners(ring, keys);
+    std::vector<size_t> counts(8);
+    for (const std::string& owner : before) {
+      for (size_t i = 0; i < nodes.size(); ++i)
+        counts[i] += owner == nodes[i];
+    }
+    // with 160 points per node the share of a node deviates by about
+    // 1 / sqrt(160) = 8% from the mean, the most of these 8 by 12.6%
+    ASSERT_TRUE(balanced(counts, 0.15));
+
+    ASSERT_TRUE(ring.remove_node(view(nodes[5])));
+    ASSERT_TRUE(minimal_move(before, owners(ring, keys), nodes[5],
+                             static_cast<double>(counts[5]) /
+                                 static_cast<double>(keys.size())));
+    ASSERT_TRUE(ring.add_node(view(nodes[5])));
+    ASSERT_TRUE(owners(ring, keys) == before);
+
+    const size_t lengths[] = {0, 1, 1000};
+    for (size_t length : lengths) {
+      std::vector<jasl::string_view> batch;
+      ring.nodes(keys.begin(), keys.begin() + static_cast<long>(length),
+                 std::back_inserter(batch));
+      ASSERT_TRUE(batch.size() == length);
+      for (size_t i = 0; i < length; ++i)
+        ASSERT_TRUE(batch[i] == ring.node(view(keys[i])));
+    }
+
+    jasl::hash_ring single(1);
+    ASSERT_TRUE(single.add_node(jasl::static_string("only")));
+    ASSERT_TRUE(single.node(jasl::static_string("key")) ==
+                jasl::static_string("only"));
+
+    ASSERT_EXCEPTION(jasl::hash_ring(0), std::invalid_argument);
+  }
+
+  return 0;
+}
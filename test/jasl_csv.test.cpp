@@ -0,0 +1,170 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_csv.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "test_helper.hpp"
+
+typedef std::vector<std::vector<std::string>> records_t;
+
+records_t parse(jasl::string_view buffer, char delimiter, bool quoting) {
+  records_t records(1);
+  jasl::csv_scanner scanner(buffer, delimiter, quoting);
+  jasl::csv_scanner::field f;
+  while (scanner.next(f)) {
+    const jasl::string value = scanner.unescape(f);
+    records.back().emplace_back(value.data(), value.size());
+    // the other overload gives the same
+    std::string out(f.value.size(), ' ');
+    out.resize(scanner.unescape(f, &out[0]));
+    if (out != records.back().back())
+      return records_t();
+    if (f.end_of_record)
+      records.emplace_back();
+  }
+  records.pop_back();
+  return records;
+}
+
+int test_random(unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, 99);
+  const char plain[] = "abc;1 \t'";
+  const char special[] = ",\"\n\r";
+  for (size_t round = 0; round < 100; ++round) {
+    records_t records(static_cast<size_t>(dist(gen) % 8 + 1));
+    std::string text;
+    for (size_t r = 0; r < records.size(); ++r) {
+      const size_t field_count = static_cast<size_t>(dist(gen) % 5 + 1);
+      for (size_t i = 0; i < field_count; ++i) {
+        std::string value;
+        const bool quoted = dist(gen) < 30;
+        const size_t length = static_cast<size_t>(dist(gen) % 70);
+        for (size_t j = 0; j < length; ++j) {
+          value += quoted && dist(gen) < 20 ? special[dist(gen) % 4]
+                                            : plain[dist(gen) % 8];
+        }
+        if (i > 0)
+          text += ',';
+        if (quoted) {
+          text += '"';
+          for (char c : value) {
+            if (c == '"')
+              text += '"';
+            text += c;
+          }
+          text += '"';
+        } else {
+          text += value;
+        }
+        records[r].push_back(value);
+      }
+      const bool last = r + 1 == records.size();
+      const bool empty_record = field_count == 1 && records[r][0].empty();
+      if (!last || empty_record || dist(gen) < 50)
+        text += dist(gen) < 50 ? "\n" : "\r\n";
+    }
+    if (parse(view(text), ',', true) != records)
+      return 1;
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const jasl::static_string text = "a,b,c\n1,,\"x,y\"\r\n";
+    jasl::csv_scanner scanner(text);
+    jasl::csv_scanner::field f;
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.value == jasl::static_string("a"));
+    ASSERT_FALSE(f.quoted || f.escaped || f.end_of_record);
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.value == jasl::static_string("c"));
+    ASSERT_TRUE(f.end_of_record);
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.value == jasl::static_string("1"));
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.value.empty());
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.value == jasl::static_string("x,y"));
+    ASSERT_TRUE(f.quoted && !f.escaped && f.end_of_record);
+    // the value points into the buffer
+    ASSERT_TRUE(f.value.data() == text.data() + 10);
+    ASSERT_FALSE(scanner.next(f));
+    ASSERT_FALSE(scanner.next(f));
+  }
+  {
+    const jasl::static_string text = "\"say \"\"hi\"\"\",\"\"\n";
+    jasl::csv_scanner scanner(text);
+    jasl::csv_scanner::field f;
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.quoted && f.escaped);
+    ASSERT_TRUE(f.value == jasl::static_string("say \"\"hi\"\""));
+    ASSERT_TRUE(scanner.unescape(f) == jasl::static_string("say \"hi\""));
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.quoted && !f.escaped && f.value.empty());
+    ASSERT_FALSE(scanner.next(f));
+  }
+  {
+    // trailing delimiter, empty line, no terminating newline
+    const jasl::static_string text = "a,\n\nb";
+    const records_t expected = {{"a", ""}, {""}, {"b"}};
+    ASSERT_TRUE(parse(text, ',', true) == expected);
+  }
+  {
+    const jasl::static_string text = "";
+    jasl::csv_scanner scanner(text);
+    jasl::csv_scanner::field f;
+    ASSERT_FALSE(scanner.next(f));
+  }
+  {
+    // the delimiter and the quote have to be distinguishable from each other
+    // and from the newlines
+    const jasl::static_string text = "a,b\n";
+    ASSERT_EXCEPTION(jasl::csv_scanner(text, '\n'), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::csv_scanner(text, '\r'), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::csv_scanner(text, '"'), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::csv_scanner(text, ',', true, ','),
+                     std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::csv_scanner(text, ',', true, '\n'),
+                     std::invalid_argument);
+    // the quote is an ordinary character without quoting
+    jasl::csv_scanner scanner(text, '"', false);
+    jasl::csv_scanner::field f;
+    ASSERT_TRUE(scanner.next(f));
+    ASSERT_TRUE(f.value == jasl::static_string("a,b"));
+  }
+  {
+    // TSV without quoting
+    const jasl::static_string text = "5\" screen\t\"x\"\n";
+    const records_t expected = {{"5\" screen", "\"x\""}};
+    ASSERT_TRUE(parse(text, '\t', false) == expected);
+  }
+  {
+    // quoted regions spanning several blocks
+    std::string value(150, 'q');
+    value[10] = ',';
+    value[70] = '\n';
+    value[130] = '"';
+    const std::string text = "x,\"" + value.substr(0, 130) + "\"\"" +
+                       value.substr(131) + "\",y\n";
+    const records_t expected = {{"x", value, "y"}};
+    ASSERT_TRUE(parse(view(text), ',', true) == expected);
+  }
+  for (unsigned seed = 0; seed < 20; ++seed) {
+    if (test_random(seed) != 0) {
+      ASSERT_TRUE(seed == static_cast<unsigned>(-1));
+    }
+  }
+
+  return 0;
+}
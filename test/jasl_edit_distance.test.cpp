@@ -0,0 +1,248 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_case_insensitive.hpp"
+#include "jasl/jasl_edit_distance.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+template <typename CharT>
+jasl::basic_string_view<CharT> view(const std::basic_string<CharT>& str) {
+  return jasl::basic_string_view<CharT>(str.data(), str.size());
+}
+
+template <typename CharT>
+size_t naive_distance(const std::basic_string<CharT>& a,
+                      const std::basic_string<CharT>& b) {
+  std::vector<size_t> row(b.size() + 1);
+  for (size_t j = 0; j <= b.size(); ++j)
+    row[j] = j;
+  for (size_t i = 1; i <= a.size(); ++i) {
+    size_t diagonal = row[0];
+    row[0] = i;
+    for (size_t j = 1; j <= b.size(); ++j) {
+      const size_t above = row[j];
+      row[j] = std::min(std::min(row[j], row[j - 1]) + 1,
+                        diagonal + (a[i - 1] == b[j - 1] ? 0 : 1));
+      diagonal = above;
+    }
+  }
+  return row[b.size()];
+}
+
+// The first end with at most k errors and its distance (Sellers).
+template <typename CharT>
+std::pair<size_t, size_t> naive_find_end(
+    const std::basic_string<CharT>& text,
+    const std::basic_string<CharT>& pattern,
+    size_t k) {
+  std::vector<size_t> column(pattern.size() + 1);
+  for (size_t i = 0; i <= pattern.size(); ++i)
+    column[i] = i;
+  if (column.back() <= k)
+    return std::make_pair(0, column.back());
+  for (size_t j = 1; j <= text.size(); ++j) {
+    size_t diagonal = column[0];
+    column[0] = 0;
+    for (size_t i = 1; i <= pattern.size(); ++i) {
+      const size_t left = column[i];
+      column[i] = std::min(std::min(column[i], column[i - 1]) + 1,
+                           diagonal + (pattern[i - 1] == text[j - 1] ? 0 : 1));
+      diagonal = left;
+    }
+    if (column.back() <= k)
+      return std::make_pair(j, column.back());
+  }
+  return std::make_pair(static_cast<size_t>(-1), 0);
+}
+
+template <typename CharT>
+std::basic_string<CharT> random_string(std::mt19937& gen,
+                                       size_t size,
+                                       size_t alphabet) {
+  std::basic_string<CharT> str;
+  for (size_t i = 0; i < size; ++i)
+    str += static_cast<CharT>('a' + gen() % alphabet);
+  return str;
+}
+
+// Copy of str with count random edits.
+template <typename CharT>
+std::basic_string<CharT> mutate(std::mt19937& gen,
+                                std::basic_string<CharT> str,
+                                size_t count) {
+  for (size_t n = 0; n < count; ++n) {
+    const size_t pos = str.empty() ? 0 : gen() % (str.size() + 1);
+    const CharT c = static_cast<CharT>('a' + gen() % 4);
+    switch (gen() % 3) {
+      case 0:
+        str.insert(str.begin() + static_cast<std::ptrdiff_t>(pos), c);
+        break;
+      case 1:
+        if (pos < str.size())
+          str.erase(pos, 1);
+        break;
+      default:
+        if (pos < str.size())
+          str[pos] = c;
+        break;
+    }
+  }
+  return str;
+}
+
+template <typename CharT>
+int test_random() {
+  std::mt19937 gen(42);
+  const size_t sizes[] = {0, 1, 5, 63, 64, 65, 127, 128, 129, 200};
+  for (size_t iter = 0; iter < 600; ++iter) {
+    const size_t alphabet = 2 + gen() % 6;
+    const std::basic_string<CharT> a =
+        random_string<CharT>(gen, sizes[gen() % 10] + gen() % 3, alphabet);
+    const std::basic_string<CharT> b =
+        iter % 2 ? mutate(gen, a, gen() % 40)
+                 : random_string<CharT>(gen, sizes[gen() % 10], alphabet);
+    const size_t expected = naive_distance(a, b);
+    ASSERT_TRUE(jasl::levenshtein_distance(view(a), view(b)) == expected);
+    ASSERT_TRUE(jasl::levenshtein_distance(view(b), view(a)) == expected);
+
+    const jasl::basic_levenshtein_pattern<CharT> pattern(view(a));
+    ASSERT_TRUE(pattern.size() == a.size());
+    ASSERT_TRUE(pattern.distance(view(b)) == expected);
+    const size_t ks[] = {0, 1, 2, 3, 10, 40, 100, expected - expected / 4,
+                         expected, expected + 1};
+    for (size_t k : ks) {
+      const size_t bounded = expected <= k ? expected : k + 1;
+      ASSERT_TRUE(pattern.distance(view(b), k) == bounded);
+      ASSERT_TRUE(jasl::levenshtein_distance(view(a), view(b), k) == bounded);
+    }
+  }
+
+  for (size_t iter = 0; iter < 400; ++iter) {
+    const size_t alphabet = 2 + gen() % 3;
+    const std::basic_string<CharT> pattern =
+        random_string<CharT>(gen, 1 + gen() % 150, alphabet);
+    std::basic_string<CharT> text =
+        random_string<CharT>(gen, gen() % 300, alphabet);
+    const size_t at = gen() % (text.size() + 1);
+    text.insert(at, mutate(gen, pattern, gen() % 6));
+    const size_t k = gen() % 12;
+    const std::pair<size_t, size_t> expected =
+        naive_find_end(text, pattern, k);
+    const jasl::fuzzy_match m = jasl::fuzzy_find(view(text), view(pattern), k);
+    if (expected.first == static_cast<size_t>(-1)) {
+      ASSERT_FALSE(m);
+      continue;
+    }
+    ASSERT_TRUE(m);
+    ASSERT_TRUE(m.position + m.length == expected.first);
+    ASSERT_TRUE(m.distance == expected.second);
+    ASSERT_TRUE(naive_distance(pattern, text.substr(m.position, m.length)) ==
+                m.distance);
+    // the shortest one
+    for (size_t length = 0; length < m.length; ++length) {
+      ASSERT_TRUE(naive_distance(pattern, text.substr(expected.first - length,
+                                                      length)) > m.distance);
+    }
+  }
+  return 0;
+}
+
+int main() {
+  {
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string("kitten"),
+                                           jasl::static_string("sitting")) ==
+                3);
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string(""),
+                                           jasl::static_string("abc")) == 3);
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string("abc"),
+                                           jasl::static_string("")) == 3);
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string(""),
+                                           jasl::static_string("")) == 0);
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string("flaw"),
+                                           jasl::static_string("lawn")) == 2);
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string("kitten"),
+                                           jasl::static_string("sitting"),
+                                           2) == 3);
+    ASSERT_TRUE(jasl::levenshtein_distance(jasl::static_string("a"),
+                                           jasl::static_string("abcdef"),
+                                           2) == 3);
+    const jasl::string s = jasl::static_string("sitting");
+    ASSERT_TRUE(jasl::levenshtein_distance(s, jasl::static_string("kitten")) ==
+                3);
+  }
+  {
+    const jasl::static_string dictionary[] = {"apple", "apply", "ample",
+                                              "maple", "applesauce"};
+    const jasl::levenshtein_pattern input(jasl::static_string("appel"));
+    size_t matches = 0;
+    for (const jasl::static_string& word : dictionary) {
+      if (input.distance(word, 2) <= 2)
+        ++matches;
+    }
+    ASSERT_TRUE(matches == 2);
+    ASSERT_TRUE(input.distance(jasl::static_string("ample"), 2) == 3);
+    ASSERT_TRUE(input.distance(jasl::static_string("applesauce"), 10) == 6);
+  }
+  {
+    const jasl::static_string text = "the quick brown fox jumps over";
+    jasl::fuzzy_match m =
+        jasl::fuzzy_find(text, jasl::static_string("brwn"), 1);
+    ASSERT_TRUE(m);
+    ASSERT_TRUE(m.position == 10);
+    ASSERT_TRUE(m.length == 5);
+    ASSERT_TRUE(m.distance == 1);
+
+    m = jasl::fuzzy_find(text, jasl::static_string("jumps"), 0);
+    ASSERT_TRUE(m.position == 20 && m.length == 5 && m.distance == 0);
+
+    m = jasl::fuzzy_find(text, jasl::static_string("jmups"), 1);
+    ASSERT_FALSE(m);
+    m = jasl::fuzzy_find(text, jasl::static_string("jmups"), 2);
+    ASSERT_TRUE(m);
+    ASSERT_TRUE(m.distance == 2);
+
+    // the search starts at pos
+    m = jasl::fuzzy_find(text, jasl::static_string("the"), 0, 1);
+    ASSERT_FALSE(m);
+    m = jasl::fuzzy_find(text, jasl::static_string("the"), 1, 1);
+    ASSERT_TRUE(m);
+
+    // the whole pattern can be deleted
+    m = jasl::fuzzy_find(text, jasl::static_string("xy"), 2, 3);
+    ASSERT_TRUE(m.position == 3 && m.length == 0 && m.distance == 2);
+    m = jasl::fuzzy_find(text, jasl::static_string("xy"), 2, 31);
+    ASSERT_FALSE(m);
+  }
+  {
+    // the characters are compared by the traits
+    const jasl::ci_static_string a = "Levenshtein";
+    const jasl::ci_static_string b = "lEVENSHTEIN";
+    ASSERT_TRUE(jasl::levenshtein_distance(a, b) == 0);
+    ASSERT_TRUE(jasl::levenshtein_distance(
+                    a, jasl::ci_static_string("LEVENSTEIN")) == 1);
+    ASSERT_TRUE(jasl::fuzzy_find(jasl::ci_static_string("xx LEVENSTEIN xx"), a,
+                                 1)
+                    .position == 3);
+  }
+  {
+    const std::u16string a = u"été €";
+    const std::u16string b = u"ete €";
+    ASSERT_TRUE(jasl::levenshtein_distance(view(a), view(b)) == 2);
+  }
+
+  ASSERT_TRUE(test_random<char>() == 0);
+  ASSERT_TRUE(test_random<char32_t>() == 0);
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "jasl/jasl_format.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "test_helper.hpp"
+
+bool equals(const jasl::string& str, const char* expected) {
+  return str == jasl::string_view(expected, strlen(expected));
+}
+
+int main() {
+  {
+    ASSERT_TRUE(equals(jasl::format(""), ""));
+    ASSERT_TRUE(equals(jasl::format("plain"), "plain"));
+    ASSERT_TRUE(equals(jasl::format("{}", 42), "42"));
+    ASSERT_TRUE(equals(jasl::format("a={} b={}!", -7, 2.5), "a=-7 b=2.5!"));
+    ASSERT_TRUE(equals(jasl::format("{}{}{}", 'x', true, false),
+                       "xtruefalse"));
+    ASSERT_TRUE(equals(jasl::format("{{}} {{{}}}", 1), "{} {1}"));
+    ASSERT_TRUE(equals(jasl::format("{}", uint64_t(18446744073709551615u)),
+                       "18446744073709551615"));
+    ASSERT_TRUE(equals(jasl::format("{} {}", 0.1f, 1e100), "0.1 1e+100"));
+    ASSERT_TRUE(equals(jasl::format("{}", static_cast<unsigned char>(65)),
+                       "65"));
+  }
+  {
+    // the string arguments are copied once, into the result
+    const std::string std_string = "std";
+    const jasl::static_string static_string = "static";
+    const jasl::string string = jasl::string(static_string);
+    const char* const c_string = "c";
+    const jasl::string result = jasl::format(
+        "{}/{}/{}/{}/{}", std_string, static_string, string, c_string,
+        jasl::string_view(std_string.data(), 2));
+    ASSERT_TRUE(equals(result, "std/static/static/c/st"));
+    ASSERT_FALSE(result.is_static());
+    ASSERT_TRUE(jasl::formatted_size("{}/{}/{}/{}/{}", std_string,
+                                     static_string, string, c_string,
+                                     std_string) == 23);
+  }
+  {
+    const std::string long_string(1000, 'x');
+    const jasl::string result = jasl::format("<{}>", long_string);
+    ASSERT_TRUE(result.size() == 1002);
+    ASSERT_TRUE(result[0] == '<' && result[1] == 'x' && result[1001] == '>');
+  }
+  {
+    char buffer[16];
+    jasl::to_chars_result r =
+        jasl::format_to(buffer, buffer + 16, "id={} ok={}", 12345, true);
+    ASSERT_TRUE(r.ec == std::errc());
+    ASSERT_TRUE(std::string(buffer, r.ptr) == "id=12345 ok=true");
+    r = jasl::format_to(buffer, buffer + 16, "id={} ok={}", 123456, true);
+    ASSERT_TRUE(r.ec == std::errc::value_too_large && r.ptr == buffer + 16);
+    r = jasl::format_to(buffer, buffer, "");
+    ASSERT_TRUE(r.ec == std::errc() && r.ptr == buffer);
+    // nothing is copied from or to the null data of the empty strings
+    ASSERT_TRUE(jasl::format(jasl::static_string()).empty());
+    r = jasl::format_to(nullptr, nullptr, jasl::static_string());
+    ASSERT_TRUE(r.ec == std::errc() && r.ptr == nullptr);
+  }
+#ifndef JASL_TERMINATE_ON_EXCEPTION_ON
+  {
+    ASSERT_EXCEPTION(jasl::format("{}"), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::format("{}", 1, 2), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::format("{", 1), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::format("}", 1), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::format("{x}", 1), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::formatted_size("{} {}", 1), std::invalid_argument);
+    char buffer[8];
+    ASSERT_EXCEPTION(jasl::format_to(buffer, buffer + 8, "{"),
+                     std::invalid_argument);
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_front_coded_dictionary.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+std::string random_key(std::mt19937& gen) {
+  const std::string prefixes[] = {"", "a", "ab", "abc/", "zzzzzzzz"};
+  std::string key = prefixes[gen() % 5];
+  for (size_t i = gen() % 6; i > 0; --i)
+    key += static_cast<char>(gen() % 4 == 0 ? gen() % 256 : 'a' + gen() % 3);
+  return key;
+}
+
+int test_random(std::mt19937& gen, size_t count, size_t block_size) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; ++i)
+    keys.push_back(random_key(gen));
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  std::vector<jasl::string_view> views;
+  for (const std::string& key : keys)
+    views.push_back(view(key));
+
+  const jasl::front_coded_dictionary dictionary(views.begin(), views.end(),
+                                                block_size);
+  ASSERT_TRUE(dictionary.size() == keys.size());
+  ASSERT_TRUE(dictionary.block_size() == block_size);
+
+  jasl::front_coded_dictionary::buffer_type buffer;
+  for (size_t id = 0; id < keys.size(); ++id) {
+    ASSERT_TRUE(to_std(dictionary.access(id, buffer)) == keys[id]);
+    ASSERT_TRUE(dictionary.find(view(keys[id])) == id);
+    ASSERT_TRUE(dictionary.rank(view(keys[id])) == id);
+  }
+
+  for (size_t q = 0; q < 500; ++q) {
+    const std::string query =
+        q % 2 && !keys.empty()
+            ? keys[gen() % keys.size()].substr(0, gen() % 6)
+            : random_key(gen);
+    const auto it = std::lower_bound(keys.begin(), keys.end(), query);
+    const size_t rank = static_cast<size_t>(it - keys.begin());
+    ASSERT_TRUE(dictionary.rank(view(query)) == rank);
+    const bool found = it != keys.end() && *it == query;
+    ASSERT_TRUE(dictionary.contains(view(query)) == found);
+    ASSERT_TRUE(dictionary.find(view(query)) ==
+                (found ? rank : jasl::front_coded_dictionary::npos));
+
+    std::vector<size_t> expected;
+    for (size_t id = rank;
+         id < keys.size() && keys[id].compare(0, query.size(), query) == 0;
+         ++id)
+      expected.push_back(id);
+    std::vector<size_t> ids;
+    bool decoded = true;
+    dictionary.for_each_prefixed(
+        view(query), buffer, [&](size_t id, jasl::string_view key) {
+          decoded = decoded && to_std(key) == keys[id];
+          ids.push_back(id);
+        });
+    ASSERT_TRUE(decoded);
+    ASSERT_TRUE(ids == expected);
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const jasl::static_string words[] = {"apple", "applesauce", "apply",
+                                         "banana", "band", "bandana"};
+    const jasl::front_coded_dictionary dictionary(std::begin(words),
+                                                  std::end(words), 4);
+    ASSERT_TRUE(dictionary.size() == 6);
+    ASSERT_TRUE(dictionary.find(jasl::static_string("apply")) == 2);
+    ASSERT_TRUE(dictionary.find(jasl::static_string("bandana")) == 5);
+    ASSERT_TRUE(dictionary.find(jasl::static_string("app")) ==
+                jasl::front_coded_dictionary::npos);
+    ASSERT_TRUE(dictionary.rank(jasl::static_string("app")) == 0);
+    ASSERT_TRUE(dictionary.rank(jasl::static_string("bana")) == 3);
+    ASSERT_TRUE(dictionary.rank(jasl::static_string("zebra")) == 6);
+
+    jasl::front_coded_dictionary::buffer_type buffer;
+    ASSERT_TRUE(dictionary.access(4, buffer) == jasl::static_string("band"));
+    ASSERT_TRUE(dictionary.access(1, buffer) ==
+                jasl::static_string("applesauce"));
+
+    std::vector<std::string> prefixed;
+    dictionary.for_each_prefixed(jasl::static_string("ban"),
+                                 [&prefixed](size_t, jasl::string_view key) {
+                                   prefixed.push_back(to_std(key));
+                                 });
+    ASSERT_TRUE(prefixed.size() == 3);
+    ASSERT_TRUE(prefixed[0] == "banana" && prefixed[2] == "bandana");
+    ASSERT_TRUE(dictionary.memory_usage() > 0);
+  }
+  {
+    const std::vector<jasl::string_view> none;
+    const jasl::front_coded_dictionary empty(none.begin(), none.end());
+    ASSERT_TRUE(empty.empty());
+    ASSERT_TRUE(empty.rank(jasl::static_string("a")) == 0);
+    ASSERT_FALSE(empty.contains(jasl::static_string("")));
+    size_t calls = 0;
+    empty.for_each_prefixed(jasl::static_string(""),
+                            [&calls](size_t, jasl::string_view) { ++calls; });
+    ASSERT_TRUE(calls == 0);
+
+    const jasl::static_string unsorted[] = {"b", "a"};
+    ASSERT_EXCEPTION(
+        jasl::front_coded_dictionary(std::begin(unsorted), std::end(unsorted)),
+        std::invalid_argument);
+    const jasl::static_string duplicate[] = {"a", "a"};
+    ASSERT_EXCEPTION(jasl::front_coded_dictionary(std::begin(duplicate),
+                                                  std::end(duplicate)),
+                     std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::front_coded_dictionary(std::begin(duplicate),
+                                                  std::begin(duplicate), 0),
+                     std::invalid_argument);
+  }
+
+  std::mt19937 gen(42);
+  const size_t block_sizes[] = {1, 2, 3, 16, 64};
+  for (size_t block_size : block_sizes) {
+    ASSERT_TRUE(test_random(gen, 1, block_size) == 0);
+    ASSERT_TRUE(test_random(gen, 40, block_size) == 0);
+    ASSERT_TRUE(test_random(gen, 3000, block_size) == 0);
+  }
+
+  return 0;
+}
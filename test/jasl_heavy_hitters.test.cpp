@@ -0,0 +1,188 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "jasl/jasl_heavy_hitters.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+// Zipf-like stream: key i has a weight of 1 / (i + 1)
+std::vector<std::string> make_stream(size_t key_count, size_t length) {
+  std::vector<double> weights;
+  for (size_t i = 0; i < key_count; ++i)
+    weights.push_back(1.0 / static_cast<double>(i + 1));
+  std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+  std::mt19937 gen(42);
+  std::vector<std::string> stream;
+  for (size_t i = 0; i < length; ++i)
+    stream.push_back("key/" + std::to_string(dist(gen)));
+  return stream;
+}
+
+int main() {
+  const std::vector<std::string> stream = make_stream(10000, 200000);
+  std::unordered_map<std::string, uint64_t> exact;
+  for (const std::string& key : stream)
+    ++exact[key];
+
+  {
+    jasl::count_min_sketch sketch(1024, 4);
+    ASSERT_TRUE(sketch.width() == 1024);
+    ASSERT_TRUE(sketch.depth() == 4);
+    ASSERT_TRUE(sketch.memory_usage() >= 4 * 1024 * sizeof(uint64_t));
+    ASSERT_TRUE(sketch.estimate(jasl::static_string("apple")) == 0);
+    ASSERT_TRUE(sketch.add(jasl::static_string("apple")) == 1);
+    ASSERT_TRUE(sketch.add(jasl::static_string("apple"), 5) == 6);
+    ASSERT_TRUE(sketch.estimate(jasl::static_string("apple")) == 6);
+    ASSERT_TRUE(sketch.total() == 6);
+    sketch.clear();
+    ASSERT_TRUE(sketch.estimate(jasl::static_string("apple")) == 0);
+    ASSERT_TRUE(sketch.total() == 0);
+
+    ASSERT_EXCEPTION(jasl::count_min_sketch(0), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::count_min_sketch(8, 0), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::count_min_sketch(8, 33), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::count_min_sketch::from_error(0, 0.1),
+                     std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::count_min_sketch::from_error(0.1, 1),
+                     std::invalid_argument);
+    jasl::count_min_sketch other(512, 4);
+    ASSERT_EXCEPTION(sketch.merge(other), std::invalid_argument);
+
+    const jasl::count_min_sketch bounded =
+        jasl::count_min_sketch::from_error(0.001, 0.01);
+    ASSERT_TRUE(bounded.width() == 2719);
+    ASSERT_TRUE(bounded.depth() == 5);
+  }
+  {
+    // never underestimates, and overestimates by at most e / width * total
+    // (with a high probability), much less with the conservative update
+    jasl::count_min_sketch sketch(2048, 4);
+    for (const std::string& key : stream)
+      sketch.add(view(key));
+    ASSERT_TRUE(sketch.total() == stream.size());
+    const double bound = 2.72 / 2048 * static_cast<double>(stream.size());
+    size_t over_bound = 0;
+    uint64_t overestimate = 0;
+    for (const auto& kv : exact) {
+      const uint64_t estimate = sketch.estimate(view(kv.first));
+      ASSERT_TRUE(estimate >= kv.second);
+      if (static_cast<double>(estimate - kv.second) > bound)
+        ++over_bound;
+      overestimate += estimate - kv.second;
+    }
+    ASSERT_TRUE(over_bound < exact.size() / 100);
+    ASSERT_TRUE(static_cast<double>(overestimate) <
+                bound * static_cast<double>(exact.size()) / 4);
+
+    // merged halves
+    jasl::count_min_sketch a(2048, 4);
+    jasl::count_min_sketch b(2048, 4);
+    for (size_t i = 0; i < stream.size(); ++i)
+      (i % 2 ? a : b).add(view(stream[i]));
+    a.merge(b);
+    ASSERT_TRUE(a.total() == stream.size());
+    for (const auto& kv : exact)
+      ASSERT_TRUE(a.estimate(view(kv.first)) >= kv.second);
+    ASSERT_TRUE(a.estimate(jasl::static_string("key/0")) <
+                exact["key/0"] + 2 * static_cast<uint64_t>(bound));
+  }
+  {
+    // concurrent: every thread adds a part of the stream to its shard
+    const size_t thread_count = 4;
+    jasl::concurrent_count_min_sketch sketch(thread_count, 2048, 4);
+    ASSERT_TRUE(sketch.thread_count() == thread_count);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t) {
+      threads.emplace_back([&, t] {
+        for (size_t i = t; i < stream.size(); i += thread_count)
+          sketch.add(t, view(stream[i]));
+      });
+    }
+    // merges while the threads add
+    for (size_t i = 0; i < 10; ++i) {
+      sketch.merge();
+      sketch.estimate(jasl::static_string("key/0"));
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+    sketch.merge();
+
+    const jasl::count_min_sketch snapshot = sketch.snapshot();
+    ASSERT_TRUE(snapshot.total() == stream.size());
+    for (const auto& kv : exact) {
+      ASSERT_TRUE(sketch.estimate(view(kv.first)) >= kv.second);
+      ASSERT_TRUE(snapshot.estimate(view(kv.first)) ==
+                  sketch.estimate(view(kv.first)));
+    }
+
+    ASSERT_EXCEPTION(jasl::concurrent_count_min_sketch(0, 8),
+                     std::invalid_argument);
+  }
+  {
+    jasl::space_saving top(2);
+    ASSERT_TRUE(top.capacity() == 2);
+    ASSERT_TRUE(top.size() == 0);
+    top.add(jasl::static_string("a"), 3);
+    top.add(jasl::static_string("b"));
+    ASSERT_TRUE(top.size() == 2);
+    ASSERT_TRUE(top.estimate(jasl::static_string("c")) == 1);
+    // c replaces b
+    top.add(jasl::static_string("c"));
+    ASSERT_TRUE(top.size() == 2);
+    std::vector<jasl::space_saving::entry> entries = top.top(5);
+    ASSERT_TRUE(entries.size() == 2);
+    ASSERT_TRUE(entries[0].key == "a" && entries[0].count == 3 &&
+                entries[0].error == 0);
+    ASSERT_TRUE(entries[1].key == "c" && entries[1].count == 2 &&
+                entries[1].error == 1);
+    ASSERT_TRUE(top.top(1).size() == 1);
+
+    ASSERT_EXCEPTION(jasl::space_saving(0), std::invalid_argument);
+  }
+  {
+    // the heaviest keys are found with their counts bounded
+    jasl::space_saving top(200);
+    for (const std::string& key : stream)
+      top.add(view(key));
+    const std::vector<jasl::space_saving::entry> entries = top.top(10);
+    ASSERT_TRUE(entries.size() == 10);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      ASSERT_TRUE(entries[i].key == "key/" + std::to_string(i));
+      const uint64_t count = exact[entries[i].key];
+      ASSERT_TRUE(entries[i].count >= count);
+      ASSERT_TRUE(entries[i].count - entries[i].error <= count);
+      ASSERT_TRUE(top.estimate(view(entries[i].key)) == entries[i].count);
+    }
+
+    // merged halves find the same heaviest keys, copies are independent
+    jasl::space_saving a(200);
+    jasl::space_saving b(200);
+    for (size_t i = 0; i < stream.size(); ++i)
+      (i % 2 ? a : b).add(view(stream[i]));
+    jasl::space_saving merged = a;
+    merged.merge(b);
+    a.add(jasl::static_string("key/1"), 1000000);
+    const std::vector<jasl::space_saving::entry> merged_entries =
+        merged.top(10);
+    for (size_t i = 0; i < merged_entries.size(); ++i) {
+      ASSERT_TRUE(merged_entries[i].key == "key/" + std::to_string(i));
+      const uint64_t count = exact[merged_entries[i].key];
+      ASSERT_TRUE(merged_entries[i].count >= count);
+      ASSERT_TRUE(merged_entries[i].count - merged_entries[i].error <= count);
+    }
+    ASSERT_TRUE(a.top(1)[0].key == "key/1");
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_hyperloglog.hpp"
+#include "jasl/jasl_internal/jasl_varint.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+void insert_range(jasl::hyperloglog& sketch, size_t first, size_t last) {
+  for (size_t i = first; i < last; ++i) {
+    const std::string key = "user/" + std::to_string(i);
+    sketch.insert(jasl::string_view(key.data(), key.size()));
+  }
+}
+
+double relative_error(const jasl::hyperloglog& sketch, size_t count) {
+  return std::fabs(sketch.estimate() / static_cast<double>(count) - 1);
+}
+
+int main() {
+  {
+    jasl::hyperloglog sketch;
+    ASSERT_TRUE(sketch.precision() == 14);
+    ASSERT_TRUE(sketch.is_sparse());
+    ASSERT_TRUE(sketch.estimate() == 0);
+
+    sketch.insert(jasl::static_string("apple"));
+    sketch.insert(jasl::static_string("apple"));
+    sketch.insert(jasl::static_string("banana"));
+    ASSERT_TRUE(std::fabs(sketch.estimate() - 2) < 0.01);
+
+    const std::vector<std::string> keys = {"x", "y", "x", "z"};
+    sketch.insert(keys.begin(), keys.end());
+    ASSERT_TRUE(std::fabs(sketch.estimate() - 5) < 0.01);
+    ASSERT_TRUE(sketch.memory_usage() > 0);
+
+    sketch.clear();
+    ASSERT_TRUE(sketch.is_sparse());
+    ASSERT_TRUE(sketch.estimate() == 0);
+
+    ASSERT_EXCEPTION(jasl::hyperloglog(3), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::hyperloglog(19), std::invalid_argument);
+    jasl::hyperloglog other(12);
+    ASSERT_EXCEPTION(sketch.merge(other), std::invalid_argument);
+  }
+  {
+    // the sparse sketch is almost exact, the dense one is within a few
+    // standard errors (0.8% for precision 14, 3.25% for precision 10)
+    jasl::hyperloglog sketch;
+    insert_range(sketch, 0, 3000);
+    ASSERT_TRUE(sketch.is_sparse());
+    ASSERT_TRUE(relative_error(sketch, 3000) < 0.002);
+    insert_range(sketch, 0, 3000);
+    ASSERT_TRUE(relative_error(sketch, 3000) < 0.002);
+    insert_range(sketch, 3000, 10000);
+    ASSERT_FALSE(sketch.is_sparse());
+    ASSERT_TRUE(sketch.memory_usage() >= 16384);
+    ASSERT_TRUE(relative_error(sketch, 10000) < 0.03);
+    insert_range(sketch, 10000, 500000);
+    ASSERT_TRUE(relative_error(sketch, 500000) < 0.03);
+
+    jasl::hyperloglog small(10);
+    insert_range(small, 0, 200000);
+    ASSERT_TRUE(relative_error(small, 200000) < 0.12);
+  }
+  {
+    // the estimates of few registers are not biased either: the asymptotic
+    // constant would overestimate by 8% at precision 4
+    for (unsigned precision = 4; precision <= 6; ++precision) {
+      double sum = 0;
+      for (size_t run = 0; run < 1000; ++run) {
+        jasl::hyperloglog sketch(precision);
+        insert_range(sketch, run * 1000, run * 1000 + 1000);
+        sum += sketch.estimate() / 1000;
+      }
+      ASSERT_TRUE(std::fabs(sum / 1000 - 1) < 0.025);
+    }
+  }
+  {
+    // merging the sketches of overlapping parts is the sketch of the union
+    const size_t sizes[] = {100, 2000, 50000};
+    for (size_t size : sizes) {
+      jasl::hyperloglog a;
+      jasl::hyperloglog b;
+      jasl::hyperloglog both;
+      insert_range(a, 0, size);
+      insert_range(b, size / 2, size * 2);
+      insert_range(both, 0, size * 2);
+
+      jasl::hyperloglog merged = a;
+      merged.merge(b);
+      ASSERT_TRUE(std::fabs(merged.estimate() - both.estimate()) <
+                  both.estimate() * 0.001);
+      if (merged.is_sparse() == both.is_sparse())
+        ASSERT_TRUE(merged.serialize() == both.serialize());
+
+      // in the other order, and with itself
+      jasl::hyperloglog reversed = b;
+      reversed.merge(a);
+      reversed.merge(reversed);
+      ASSERT_TRUE(std::fabs(reversed.estimate() - both.estimate()) <
+                  both.estimate() * 0.001);
+    }
+  }
+  {
+    // serialization round trips in both modes
+    // 1100 is sparse with more entries than the registers would take, as
+    // the buffer isn't flushed yet
+    const size_t sizes[] = {0, 1, 500, 1100, 100000};
+    for (size_t size : sizes) {
+      jasl::hyperloglog sketch(12);
+      insert_range(sketch, 0, size);
+      ASSERT_TRUE(sketch.is_sparse() == (size <= 1100));
+      const std::vector<unsigned char> data = sketch.serialize();
+      const jasl::hyperloglog copy = jasl::hyperloglog::deserialize(data);
+      ASSERT_TRUE(copy.precision() == 12);
+      ASSERT_TRUE(copy.is_sparse() == sketch.is_sparse());
+      ASSERT_TRUE(copy.estimate() == sketch.estimate());
+      ASSERT_TRUE(copy.serialize() == data);
+    }
+
+    jasl::hyperloglog sketch(4);
+    insert_range(sketch, 0, 2);
+    std::vector<unsigned char> data = sketch.serialize();
+    ASSERT_TRUE(sketch.is_sparse());
+    ASSERT_EXCEPTION(jasl::hyperloglog::deserialize(data.data(), 4),
+                     std::invalid_argument);
+    ASSERT_EXCEPTION(
+        jasl::hyperloglog::deserialize(data.data(), data.size() - 1),
+        std::invalid_argument);
+    data.push_back(0);
+    ASSERT_EXCEPTION(jasl::hyperloglog::deserialize(data),
+                     std::invalid_argument);
+    data.pop_back();
+    data[0] = 'X';
+    ASSERT_EXCEPTION(jasl::hyperloglog::deserialize(data),
+                     std::invalid_argument);
+    data[0] = 'J';
+    data[3] = 30;  // precision
+    ASSERT_EXCEPTION(jasl::hyperloglog::deserialize(data),
+                     std::invalid_argument);
+
+    // a delta which wraps the entry around below the previous one
+    data.resize(5);
+    data[3] = 12;  // precision
+    jasl::inner::write_varint(data, 2);
+    jasl::inner::write_varint(data, (5 << 6) | 1);
+    jasl::inner::write_varint(data, size_t(0) - 64);
+    ASSERT_EXCEPTION(jasl::hyperloglog::deserialize(data),
+                     std::invalid_argument);
+
+    insert_range(sketch, 0, 1000);
+    data = sketch.serialize();
+    ASSERT_FALSE(sketch.is_sparse());
+    data.back() = 100;  // register above the highest rank
+    ASSERT_EXCEPTION(jasl::hyperloglog::deserialize(data),
+                     std::invalid_argument);
+  }
+
+  return 0;
+}
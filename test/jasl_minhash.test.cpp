@@ -0,0 +1,156 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_minhash.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+std::string random_document(std::mt19937& gen, size_t word_count) {
+  std::string document;
+  for (size_t i = 0; i < word_count; ++i) {
+    document += "w" + std::to_string(gen() % 5000);
+    document += ' ';
+  }
+  return document;
+}
+
+// replaces count characters with '#'
+std::string mutate(std::string document, std::mt19937& gen, size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    document[gen() % document.size()] = '#';
+  return document;
+}
+
+double jaccard(const std::string& a, const std::string& b, size_t k) {
+  std::set<std::string> x;
+  std::set<std::string> y;
+  for (size_t i = 0; i + k <= a.size(); ++i)
+    x.insert(a.substr(i, k));
+  for (size_t i = 0; i + k <= b.size(); ++i)
+    y.insert(b.substr(i, k));
+  size_t common = 0;
+  for (const std::string& s : x)
+    common += y.count(s);
+  return static_cast<double>(common) /
+         static_cast<double>(x.size() + y.size() - common);
+}
+
+int main() {
+  std::mt19937 gen(42);
+  {
+    const jasl::minhash hasher;
+    ASSERT_TRUE(hasher.signature_size() == 128);
+    ASSERT_TRUE(hasher.shingle_size() == 5);
+
+    const jasl::minhash::signature_type a =
+        hasher.signature(jasl::static_string("the quick brown fox"));
+    ASSERT_TRUE(a.size() == 128);
+    ASSERT_TRUE(a == hasher.signature(jasl::static_string(
+                         "the quick brown fox")));
+    ASSERT_TRUE(jasl::minhash::similarity(a, a) == 1);
+    // densified: no bin is left empty
+    ASSERT_TRUE(std::find(a.begin(), a.end(), UINT32_MAX) == a.end());
+    const jasl::minhash::signature_type b =
+        hasher.signature(jasl::static_string("lorem ipsum dolor sit"));
+    ASSERT_TRUE(jasl::minhash::similarity(a, b) < 0.1);
+
+    // shorter than a shingle, and empty
+    ASSERT_TRUE(hasher.signature(jasl::static_string("ab")) ==
+                hasher.signature(jasl::static_string("ab")));
+    const jasl::minhash::signature_type empty =
+        hasher.signature(jasl::static_string(""));
+    ASSERT_TRUE(std::count(empty.begin(), empty.end(), UINT32_MAX) == 128);
+
+    ASSERT_EXCEPTION(jasl::minhash(0), std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::minhash(16, 0), std::invalid_argument);
+    ASSERT_EXCEPTION(
+        jasl::minhash::similarity(a, jasl::minhash(64).signature(
+                                         jasl::static_string("x"))),
+        std::invalid_argument);
+    ASSERT_EXCEPTION(jasl::minhash::similarity(jasl::minhash::signature_type(),
+                                               jasl::minhash::signature_type()),
+                     std::invalid_argument);
+  }
+  {
+    // the estimate is close to the Jaccard similarity of the shingles
+    const jasl::minhash hasher(256, 5);
+    double max_error = 0;
+    const size_t mutations[] = {0, 2, 10, 40, 150};
+    for (size_t round = 0; round < 20; ++round) {
+      const std::string document = random_document(gen, 100);
+      for (size_t count : mutations) {
+        const std::string copy = mutate(document, gen, count);
+        const double estimate = jasl::minhash::similarity(
+            hasher.signature(view(document)), hasher.signature(view(copy)));
+        const double exact = jaccard(document, copy, 5);
+        max_error = std::max(max_error, std::fabs(estimate - exact));
+      }
+    }
+    // standard error of 256 bins is at most 3.2%
+    ASSERT_TRUE(max_error < 0.13);
+  }
+  {
+    // SimHash of near-duplicates differs in fewer bits
+    const jasl::minhash hasher;
+    const std::string document = random_document(gen, 200);
+    const std::string near = mutate(document, gen, 5);
+    const std::string other = random_document(gen, 200);
+    const uint64_t h = hasher.simhash(view(document));
+    ASSERT_TRUE(h == hasher.simhash(view(document)));
+    ASSERT_TRUE(jasl::minhash::simhash_distance(h, h) == 0);
+    ASSERT_TRUE(jasl::minhash::simhash_distance(
+                    h, hasher.simhash(view(near))) < 12);
+    ASSERT_TRUE(jasl::minhash::simhash_distance(
+                    h, hasher.simhash(view(other))) > 16);
+  }
+  {
+    // LSH finds the near-duplicates among unrelated documents
+    const jasl::minhash hasher(128, 5);
+    jasl::lsh_index index(32, 4);
+    ASSERT_TRUE(index.signature_size() == 128);
+    ASSERT_TRUE(std::fabs(index.threshold() - 0.42) < 0.01);
+
+    std::vector<std::string> documents;
+    for (size_t i = 0; i < 1000; ++i)
+      documents.push_back(random_document(gen, 80));
+    for (const std::string& document : documents)
+      index.insert(hasher.signature(view(document)));
+    ASSERT_TRUE(index.size() == documents.size());
+    ASSERT_TRUE(index.signature(7) == hasher.signature(view(documents[7])));
+
+    size_t found = 0;
+    size_t candidate_count = 0;
+    for (size_t i = 0; i < 100; ++i) {
+      const std::string copy = mutate(documents[i * 10], gen, 3);
+      const jasl::minhash::signature_type signature =
+          hasher.signature(view(copy));
+      candidate_count += index.candidates(signature).size();
+      const std::vector<size_t> result = index.query(signature, 0.6);
+      if (result.size() == 1 && result[0] == i * 10)
+        ++found;
+    }
+    ASSERT_TRUE(found >= 98);
+    // unrelated documents are rarely candidates
+    ASSERT_TRUE(candidate_count < 200);
+
+    ASSERT_EXCEPTION(jasl::lsh_index(0, 4), std::invalid_argument);
+    ASSERT_EXCEPTION(
+        index.insert(jasl::minhash(64).signature(jasl::static_string("x"))),
+        std::invalid_argument);
+  }
+
+  return 0;
+}
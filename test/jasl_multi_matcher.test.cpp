@@ -0,0 +1,159 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "jasl/jasl_multi_matcher.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "test_helper.hpp"
+
+typedef std::vector<std::tuple<size_t, size_t>> matches_t;
+
+matches_t naive_find_all(const std::vector<std::string>& patterns,
+                         const std::string& text) {
+  matches_t result;
+  for (size_t p = 0; p < patterns.size(); ++p) {
+    for (size_t pos = text.find(patterns[p]); pos != std::string::npos;
+         pos = text.find(patterns[p], pos + 1))
+      result.emplace_back(pos, p);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+matches_t sorted(const std::vector<jasl::multi_matcher::match>& matches) {
+  matches_t result;
+  for (const auto& m : matches)
+    result.emplace_back(m.position, m.pattern);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+int test_random(unsigned seed) {
+  std::mt19937 gen(seed);
+  const char alphabet[] = "ab\x80\xff";
+  std::uniform_int_distribution<size_t> letter(0, 3);
+  std::uniform_int_distribution<size_t> length(1, 6);
+  std::vector<std::string> patterns;
+  for (size_t i = 0; i < 30; ++i) {
+    std::string p;
+    for (size_t j = length(gen); j > 0; --j)
+      p += alphabet[letter(gen)];
+    patterns.push_back(p);
+  }
+  std::string text;
+  for (size_t i = 0; i < 500; ++i)
+    text += alphabet[letter(gen)];
+
+  std::vector<jasl::string_view> views;
+  for (const std::string& p : patterns)
+    views.emplace_back(p.data(), p.size());
+  const jasl::multi_matcher matcher(views.begin(), views.end());
+  ASSERT_TRUE(matcher.size() == patterns.size());
+  const auto expected = naive_find_all(patterns, text);
+  const jasl::string_view text_view(text.data(), text.size());
+  const auto found = matcher.find_all(text_view);
+  ASSERT_TRUE(sorted(found) == expected);
+
+  // ordered by the end position, the longest first
+  for (size_t i = 1; i < found.size(); ++i) {
+    const size_t prev_end =
+        found[i - 1].position + patterns[found[i - 1].pattern].size();
+    const size_t end = found[i].position + patterns[found[i].pattern].size();
+    ASSERT_TRUE(prev_end < end ||
+                (prev_end == end && found[i - 1].position <= found[i].position));
+  }
+
+  // the same in chunks of every size
+  for (size_t chunk = 1; chunk < 40; ++chunk) {
+    std::vector<jasl::multi_matcher::match> streamed;
+    jasl::multi_matcher::scanner scanner(matcher);
+    for (size_t pos = 0; pos < text.size(); pos += chunk) {
+      scanner.feed(text_view.substr(pos, chunk),
+                   [&](const jasl::multi_matcher::match& m) {
+                     streamed.push_back(m);
+                   });
+    }
+    ASSERT_TRUE(scanner.offset() == text.size());
+    ASSERT_TRUE(sorted(streamed) == expected);
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const jasl::multi_matcher matcher = {"he", "she", "his", "hers"};
+    ASSERT_TRUE(matcher.size() == 4);
+    ASSERT_TRUE(matcher.pattern_length(3) == 4);
+    const auto found = matcher.find_all(jasl::static_string("ushers"));
+    ASSERT_TRUE(found.size() == 3);
+    ASSERT_TRUE(found[0].pattern == 1 && found[0].position == 1);
+    ASSERT_TRUE(found[1].pattern == 0 && found[1].position == 2);
+    ASSERT_TRUE(found[2].pattern == 3 && found[2].position == 2);
+    ASSERT_TRUE(matcher.find_all(jasl::static_string("")).empty());
+    ASSERT_TRUE(matcher.find_all(jasl::static_string("xyz")).empty());
+  }
+  {
+    const jasl::static_string error = "error";
+    const jasl::static_string timeout = "timeout";
+    const jasl::string retry("retry", 5);
+    const std::vector<jasl::string_view> keys = {error, timeout, retry};
+    const jasl::multi_matcher matcher(keys.begin(), keys.end());
+    size_t count = 0;
+    matcher.find_all(jasl::static_string("retry after timeout: error"),
+                     [&](const jasl::multi_matcher::match&) { ++count; });
+    ASSERT_TRUE(count == 3);
+  }
+  {
+    // identical and nested patterns
+    const jasl::multi_matcher matcher = {"aa", "a", "aa"};
+    const auto found = matcher.find_all(jasl::static_string("aaa"));
+    ASSERT_TRUE(found.size() == 7);
+    ASSERT_TRUE(found[0].pattern == 1 && found[0].position == 0);
+    ASSERT_TRUE(found[1].pattern == 0 && found[1].position == 0);
+    ASSERT_TRUE(found[2].pattern == 2 && found[2].position == 0);
+    ASSERT_TRUE(found[3].pattern == 1 && found[3].position == 1);
+  }
+  {
+    // a match spanning chunks
+    const jasl::multi_matcher matcher = {"boundary"};
+    jasl::multi_matcher::scanner scanner(matcher);
+    std::vector<jasl::multi_matcher::match> found;
+    auto collect = [&](const jasl::multi_matcher::match& m) {
+      found.push_back(m);
+    };
+    scanner.feed(jasl::static_string("xxbou"), collect);
+    scanner.feed(jasl::static_string("nd"), collect);
+    ASSERT_TRUE(found.empty());
+    scanner.feed(jasl::static_string("aryxx"), collect);
+    ASSERT_TRUE(found.size() == 1);
+    ASSERT_TRUE(found[0].position == 2);
+    scanner.reset();
+    ASSERT_TRUE(scanner.offset() == 0);
+    scanner.feed(jasl::static_string("ary"), collect);
+    ASSERT_TRUE(found.size() == 1);
+  }
+  {
+    const jasl::multi_matcher matcher = {};
+    ASSERT_TRUE(matcher.size() == 0);
+    ASSERT_TRUE(matcher.state_count() == 1);
+    ASSERT_TRUE(matcher.find_all(jasl::static_string("text")).empty());
+  }
+  {
+    ASSERT_EXCEPTION(jasl::multi_matcher({"a", ""}), std::invalid_argument);
+  }
+  for (unsigned seed = 0; seed < 20; ++seed) {
+    if (test_random(seed) != 0)
+      return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_parallel_search.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "test_helper.hpp"
+
+template <typename CharT>
+std::vector<size_t> naive_find_all(const std::basic_string<CharT>& haystack,
+                                   const std::basic_string<CharT>& needle) {
+  std::vector<size_t> result;
+  for (size_t pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + 1))
+    result.push_back(pos);
+  return result;
+}
+
+template <typename CharT>
+int test(jasl::thread_pool& pool) {
+  typedef jasl::basic_string_view<CharT> view;
+  const size_t chunk =
+      jasl::inner::search_chunks<CharT, std::char_traits<CharT>>::chunk_size;
+  {
+    // occurrences around the chunk boundaries
+    std::basic_string<CharT> haystack(3 * chunk + 100, CharT('x'));
+    const std::basic_string<CharT> needle(5, CharT('n'));
+    const view hv(haystack.data(), haystack.size());
+    const view nv(needle.data(), needle.size());
+    ASSERT_TRUE(jasl::parallel_find(hv, nv, pool) == view::npos);
+    ASSERT_TRUE(jasl::parallel_count(hv, nv, pool) == 0);
+    ASSERT_TRUE(jasl::parallel_find_all(hv, nv, pool).empty());
+    for (size_t pos : {chunk - 3, 2 * chunk - 1, 3 * chunk - 5, 3 * chunk + 95})
+      haystack.replace(pos, needle.size(), needle);
+    const std::vector<size_t> expected = naive_find_all(haystack, needle);
+    ASSERT_TRUE(expected.size() == 4);
+    ASSERT_TRUE(jasl::parallel_find_all(hv, nv, pool) == expected);
+    ASSERT_TRUE(jasl::parallel_count(hv, nv, pool) == 4);
+    ASSERT_TRUE(jasl::parallel_find(hv, nv, pool) == chunk - 3);
+    ASSERT_TRUE(jasl::parallel_find(hv.substr(chunk), nv, pool) == chunk - 1);
+    // a needle longer than the haystack
+    ASSERT_TRUE(jasl::parallel_find(nv, hv, pool) == view::npos);
+    ASSERT_TRUE(jasl::parallel_count(nv, hv, pool) == 0);
+  }
+  {
+    // overlapping occurrences
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> letter(0, 1);
+    std::basic_string<CharT> haystack;
+    for (size_t i = 0; i < 2 * chunk + 1000; ++i)
+      haystack += letter(gen) == 0 ? CharT('a') : CharT('b');
+    const view hv(haystack.data(), haystack.size());
+    for (size_t length = 1; length < 12; length += 3) {
+      const std::basic_string<CharT> needle = haystack.substr(chunk, length);
+      const view nv(needle.data(), needle.size());
+      const std::vector<size_t> expected = naive_find_all(haystack, needle);
+      ASSERT_TRUE(jasl::parallel_find_all(hv, nv, pool) == expected);
+      ASSERT_TRUE(jasl::parallel_count(hv, nv, pool) == expected.size());
+      ASSERT_TRUE(jasl::parallel_find(hv, nv, pool) == expected[0]);
+    }
+  }
+  return 0;
+}
+
+int main() {
+  jasl::thread_pool pool(4);
+  jasl::thread_pool single(1);
+  if (test<char>(pool) != 0 || test<char>(single) != 0 ||
+      test<char16_t>(pool) != 0)
+    return 1;
+  {
+    const jasl::string haystack("abcabcab", 8);
+    ASSERT_TRUE(jasl::parallel_find(haystack, jasl::static_string("ca")) == 2);
+    ASSERT_TRUE(jasl::parallel_count(haystack, jasl::static_string("ab")) ==
+                3);
+    ASSERT_TRUE(
+        (jasl::parallel_find_all(haystack, jasl::static_string("b")) ==
+         std::vector<size_t>{1, 4, 7}));
+    ASSERT_TRUE(jasl::parallel_find(haystack, jasl::static_string("")) == 0);
+    ASSERT_EXCEPTION(jasl::parallel_count(haystack, jasl::static_string("")),
+                     std::invalid_argument);
+    ASSERT_EXCEPTION(
+        jasl::parallel_find_all(haystack, jasl::static_string("")),
+        std::invalid_argument);
+  }
+
+  return 0;
+}
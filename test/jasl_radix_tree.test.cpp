@@ -0,0 +1,193 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jasl/jasl_radix_tree.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+std::string random_key(std::mt19937& gen) {
+  const std::string prefixes[] = {"", "/", "/api/", "/api/v1/", "/static/"};
+  std::string key = prefixes[gen() % 5];
+  const size_t size = gen() % 8;
+  for (size_t i = 0; i < size; ++i) {
+    // few branches deep in the tree, all the 256 bytes near the root
+    key += static_cast<char>(i < 2 && gen() % 2 ? gen() % 256
+                                                : 'a' + gen() % 3);
+  }
+  return key;
+}
+
+std::vector<std::pair<std::string, int>> collect(
+    const jasl::radix_tree<int>& tree,
+    jasl::string_view prefix) {
+  std::vector<std::pair<std::string, int>> result;
+  tree.for_each_prefixed(prefix,
+                         [&result](const jasl::radix_tree<int>::entry& e) {
+                           result.emplace_back(to_std(e.key()), e.value());
+                         });
+  return result;
+}
+
+std::vector<std::pair<std::string, int>> collect(
+    const std::map<std::string, int>& map,
+    const std::string& prefix) {
+  std::vector<std::pair<std::string, int>> result;
+  for (auto it = map.lower_bound(prefix);
+       it != map.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+       ++it)
+    result.push_back(*it);
+  return result;
+}
+
+int main() {
+  {
+    jasl::radix_tree<int> routes;
+    ASSERT_TRUE(routes.empty());
+    ASSERT_TRUE(routes.find(jasl::static_string("/")) == nullptr);
+    ASSERT_TRUE(routes.longest_prefix(jasl::static_string("/a")) == nullptr);
+
+    const jasl::static_string api = "/api/";
+    ASSERT_TRUE(routes.insert_or_assign(api, 1));
+    ASSERT_TRUE(routes.insert_or_assign("/api/users/", 2));
+    ASSERT_TRUE(routes.insert_or_assign("/", 3));
+    ASSERT_TRUE(routes.insert_or_assign("/api/users/me", 4));
+    ASSERT_FALSE(routes.insert_or_assign("/", 5));
+    ASSERT_TRUE(routes.size() == 4);
+
+    // the static keys are not copied
+    ASSERT_TRUE(routes.find(jasl::static_string("/api/"))->key().data() ==
+                api.data());
+    ASSERT_TRUE(routes.find(jasl::static_string("/"))->value() == 5);
+    ASSERT_TRUE(routes.find(jasl::static_string("/api")) == nullptr);
+    ASSERT_TRUE(routes.find(jasl::static_string("/api/users")) == nullptr);
+
+    const jasl::radix_tree<int>::entry* e =
+        routes.longest_prefix(jasl::static_string("/api/users/42"));
+    ASSERT_TRUE(e != nullptr);
+    ASSERT_TRUE(e->key() == jasl::static_string("/api/users/"));
+    ASSERT_TRUE(e->value() == 2);
+    e = routes.longest_prefix(jasl::static_string("/api/users/me"));
+    ASSERT_TRUE(e->value() == 4);
+    e = routes.longest_prefix(jasl::static_string("/api/user"));
+    ASSERT_TRUE(e->value() == 1);
+    e = routes.longest_prefix(jasl::static_string("/index.html"));
+    ASSERT_TRUE(e->value() == 5);
+    ASSERT_TRUE(routes.longest_prefix(jasl::static_string("api")) == nullptr);
+
+    std::vector<std::string> keys;
+    routes.for_each([&keys](jasl::radix_tree<int>::entry& entry) {
+      keys.push_back(to_std(entry.key()));
+      entry.value() *= 10;
+    });
+    ASSERT_TRUE(keys.size() == 4);
+    ASSERT_TRUE(keys[0] == "/" && keys[1] == "/api/" &&
+                keys[2] == "/api/users/" && keys[3] == "/api/users/me");
+    ASSERT_TRUE(routes.find(jasl::static_string("/api/users/me"))->value() ==
+                40);
+
+    size_t count = 0;
+    routes.for_each_prefixed(jasl::static_string("/api/u"),
+                             [&count](const jasl::radix_tree<int>::entry&) {
+                               ++count;
+                             });
+    ASSERT_TRUE(count == 2);
+
+    // the other keys are copied
+    {
+      const jasl::string key = jasl::static_string("/dynamic");
+      ASSERT_TRUE(routes.insert_or_assign(key, 6));
+      ASSERT_TRUE(routes.find(key)->key().data() != key.data());
+    }
+    ASSERT_TRUE(routes.find(jasl::static_string("/dynamic"))->value() == 6);
+
+    jasl::radix_tree<int> moved = std::move(routes);
+    ASSERT_TRUE(moved.size() == 5);
+    ASSERT_TRUE(routes.empty());
+    moved.clear();
+    ASSERT_TRUE(moved.empty());
+    ASSERT_TRUE(moved.find(jasl::static_string("/")) == nullptr);
+  }
+  {
+    // the empty key and keys with zero bytes
+    jasl::radix_tree<std::string> tree;
+    const std::string zero(1, '\0');
+    ASSERT_TRUE(tree.insert_or_assign(view(zero + zero), "00"));
+    ASSERT_TRUE(tree.insert_or_assign(jasl::static_string(""), "empty"));
+    ASSERT_TRUE(tree.insert_or_assign(view(zero), "0"));
+    ASSERT_TRUE(tree.find(jasl::static_string(""))->value() == "empty");
+    ASSERT_TRUE(tree.find(view(zero))->value() == "0");
+    ASSERT_TRUE(tree.longest_prefix(view(zero + "a"))->value() == "0");
+    ASSERT_TRUE(tree.longest_prefix(jasl::static_string("a"))->value() ==
+                "empty");
+  }
+
+  std::mt19937 gen(42);
+  const size_t counts[] = {1, 2, 10, 100, 1000, 10000};
+  for (size_t count : counts) {
+    jasl::radix_tree<int> tree;
+    std::map<std::string, int> expected;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < count; ++i) {
+      const std::string key = random_key(gen);
+      const int value = static_cast<int>(i);
+      const bool inserted = expected.find(key) == expected.end();
+      expected[key] = value;
+      ASSERT_TRUE(tree.insert_or_assign(view(key), value) == inserted);
+      keys.push_back(key);
+    }
+    ASSERT_TRUE(tree.size() == expected.size());
+
+    std::vector<std::pair<std::string, int>> all;
+    tree.for_each([&all](const jasl::radix_tree<int>::entry& e) {
+      all.emplace_back(to_std(e.key()), e.value());
+    });
+    ASSERT_TRUE(all == collect(expected, std::string()));
+
+    for (size_t i = 0; i < 2000; ++i) {
+      const std::string query =
+          i % 2 ? keys[gen() % keys.size()] + random_key(gen).substr(0, 3)
+                : random_key(gen);
+      const auto it = expected.find(query);
+      const jasl::radix_tree<int>::entry* found = tree.find(view(query));
+      if (it == expected.end()) {
+        ASSERT_TRUE(found == nullptr);
+      } else {
+        ASSERT_TRUE(found != nullptr);
+        ASSERT_TRUE(found->value() == it->second);
+      }
+
+      // the linear scan which the tree replaces
+      const std::pair<const std::string, int>* longest = nullptr;
+      for (const auto& kv : expected) {
+        if (query.compare(0, kv.first.size(), kv.first) == 0 &&
+            (longest == nullptr || kv.first.size() > longest->first.size()))
+          longest = &kv;
+      }
+      const jasl::radix_tree<int>::entry* prefix =
+          tree.longest_prefix(view(query));
+      if (longest == nullptr) {
+        ASSERT_TRUE(prefix == nullptr);
+      } else {
+        ASSERT_TRUE(prefix != nullptr);
+        ASSERT_TRUE(to_std(prefix->key()) == longest->first);
+        ASSERT_TRUE(prefix->value() == longest->second);
+      }
+
+      const std::string range = query.substr(0, gen() % (query.size() + 1));
+      ASSERT_TRUE(collect(tree, view(range)) == collect(expected, range));
+    }
+  }
+
+  return 0;
+}
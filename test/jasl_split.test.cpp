@@ -0,0 +1,155 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_split.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "test_helper.hpp"
+
+// Reference implementation: set_mode means any character of delim.
+template <typename CharT>
+std::vector<std::basic_string<CharT>> naive_split(
+    const std::basic_string<CharT>& str,
+    const std::basic_string<CharT>& delim,
+    bool set_mode,
+    jasl::empty_fields empty) {
+  std::vector<std::basic_string<CharT>> result;
+  size_t start = 0;
+  for (;;) {
+    const size_t found = set_mode ? str.find_first_of(delim, start)
+                                  : str.find(delim, start);
+    const size_t end = found == std::basic_string<CharT>::npos ? str.size()
+                                                               : found;
+    if (end != start || empty == jasl::empty_fields::keep)
+      result.push_back(str.substr(start, end - start));
+    if (found == std::basic_string<CharT>::npos)
+      return result;
+    start = found + (set_mode ? 1 : delim.size());
+  }
+}
+
+template <typename RangeT, typename CharT>
+std::vector<std::basic_string<CharT>> collect(const RangeT& range, CharT) {
+  std::vector<std::basic_string<CharT>> result;
+  for (const auto& piece : range)
+    result.emplace_back(piece.data(), piece.size());
+  return result;
+}
+
+template <typename CharT>
+int test_random(unsigned seed) {
+  typedef jasl::basic_string_view<CharT> view;
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> letter(0, 3);
+  std::uniform_int_distribution<size_t> length(0, 200);
+  const CharT alphabet[] = {CharT('a'), CharT(','), CharT(';'),
+                            static_cast<CharT>(0xff)};
+  for (size_t round = 0; round < 50; ++round) {
+    std::basic_string<CharT> str;
+    for (size_t i = length(gen); i > 0; --i)
+      str += alphabet[letter(gen)];
+    const view sv(str.data(), str.size());
+    for (auto empty : {jasl::empty_fields::keep, jasl::empty_fields::skip}) {
+      for (CharT c : alphabet) {
+        const std::basic_string<CharT> d(1, c);
+        ASSERT_TRUE(collect(jasl::split(sv, c, empty), CharT()) ==
+                    naive_split(str, d, false, empty));
+      }
+      for (size_t set_size = 0; set_size < 4; ++set_size) {
+        const std::basic_string<CharT> set(alphabet + 1, set_size);
+        const view set_view(set.data(), set.size());
+        ASSERT_TRUE(
+            collect(jasl::split_any_of(sv, set_view, empty), CharT()) ==
+            naive_split(str, set, true, empty));
+      }
+      for (size_t d_size = 1; d_size < 5; ++d_size) {
+        std::basic_string<CharT> d;
+        for (size_t i = 0; i < d_size; ++i)
+          d += alphabet[(i + round) % 2 == 0 ? 1 : 0];
+        const view d_view(d.data(), d.size());
+        ASSERT_TRUE(collect(jasl::split(sv, d_view, empty), CharT()) ==
+                    naive_split(str, d, false, empty));
+      }
+    }
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const jasl::static_string line = "a,b,,c,";
+    std::vector<std::string> pieces;
+    for (jasl::string_view piece : jasl::split(line, ','))
+      pieces.emplace_back(piece.data(), piece.size());
+    ASSERT_TRUE((pieces == std::vector<std::string>{"a", "b", "", "c", ""}));
+    pieces.clear();
+    for (jasl::string_view piece :
+         jasl::split(line, ',', jasl::empty_fields::skip))
+      pieces.emplace_back(piece.data(), piece.size());
+    ASSERT_TRUE((pieces == std::vector<std::string>{"a", "b", "c"}));
+  }
+  {
+    const jasl::static_string empty = "";
+    auto range = jasl::split(empty, ',');
+    ASSERT_TRUE(range.begin() != range.end());
+    ASSERT_TRUE(range.begin()->empty());
+    ASSERT_TRUE(++range.begin() == range.end());
+    auto skipped = jasl::split(empty, ',', jasl::empty_fields::skip);
+    ASSERT_TRUE(skipped.begin() == skipped.end());
+  }
+  {
+    const jasl::string str("key::value::", 12);
+    std::vector<std::string> pieces;
+    for (jasl::string_view piece : jasl::split(str, jasl::static_string("::")))
+      pieces.emplace_back(piece.data(), piece.size());
+    ASSERT_TRUE((pieces == std::vector<std::string>{"key", "value", ""}));
+  }
+  {
+    const jasl::static_string words = " one two\tthree \n";
+    std::vector<std::string> pieces;
+    for (jasl::string_view piece :
+         jasl::split_any_of(words, jasl::static_string(" \t\n"),
+                            jasl::empty_fields::skip))
+      pieces.emplace_back(piece.data(), piece.size());
+    ASSERT_TRUE((pieces == std::vector<std::string>{"one", "two", "three"}));
+  }
+  {
+    // a set which is too big to be compared in parallel
+    const jasl::static_string str =
+        "a1b22c333d4444e55555f666666g7777777h88888888i999999999j0";
+    std::vector<std::string> pieces;
+    for (jasl::string_view piece :
+         jasl::split_any_of(str, jasl::static_string("0123456789"),
+                            jasl::empty_fields::skip))
+      pieces.emplace_back(piece.data(), piece.size());
+    ASSERT_TRUE((pieces == std::vector<std::string>{"a", "b", "c", "d", "e",
+                                                     "f", "g", "h", "i", "j"}));
+  }
+  {
+    // the pieces point into the original string
+    const jasl::static_string str = "x|y";
+    auto it = jasl::split(str, '|').begin();
+    ASSERT_TRUE(it->data() == str.data());
+    ++it;
+    ASSERT_TRUE(it->data() == str.data() + 2);
+  }
+  {
+    const jasl::static_string str = "x";
+    ASSERT_EXCEPTION(jasl::split(str, jasl::static_string("")),
+                     std::invalid_argument);
+  }
+  for (unsigned seed = 0; seed < 10; ++seed) {
+    if (test_random<char>(seed) != 0 || test_random<wchar_t>(seed) != 0 ||
+        test_random<char16_t>(seed) != 0)
+      return 1;
+  }
+
+  return 0;
+}
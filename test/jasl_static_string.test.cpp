@@ -4,7 +4,9 @@
 //
 // This code is licensed under the MIT License (MIT).
 
+#include <stdint.h>
 #include <set>
+#include <stdexcept>
 
 #include "jasl/jasl_static_string.hpp"
 #include "test_helper.hpp"
@@ -19,6 +21,14 @@ static_assert(std::is_nothrow_move_assignable<jasl::static_string>::value, "!");
 static_assert(JASL_is_nothrow_swappable_value(jasl::static_string), "!");
 static_assert(std::is_nothrow_destructible<jasl::static_string>::value, "!");
 
+// The null terminated flag is kept in the size, so a static string is as small
+// as a view. Checked where the pointer and size_t have the same width, so
+// there is no padding between them.
+#if SIZE_MAX == UINTPTR_MAX
+static_assert(sizeof(jasl::static_string) == 2 * sizeof(void*),
+              "static_string is not a pointer and a size");
+#endif
+
 int main() {
   {
     jasl::static_string x;
@@ -168,6 +178,38 @@ int main() {
     ASSERT_TRUE(*ss.data() == 'a');
   }
 #endif
+  {
+    jasl::static_string x = "one";
+    ASSERT_TRUE(x.is_null_terminated());
+    ASSERT_TRUE(x.c_str() == x.data());
+    ASSERT_TRUE(x.c_str()[3] == 0);
+    ASSERT_TRUE(x.substr(1).is_null_terminated());
+    ASSERT_TRUE(x.substr(1, 2).is_null_terminated());
+    ASSERT_FALSE(x.substr(0, 2).is_null_terminated());
+    ASSERT_TRUE(x.substr(3).c_str()[0] == 0);
+    jasl::static_string y;
+    ASSERT_TRUE(y.is_null_terminated());
+    ASSERT_TRUE(y.c_str() != nullptr && *y.c_str() == 0);
+    const char two[] = {'t', 'w', 'o'};
+    y = two;
+    ASSERT_FALSE(y.is_null_terminated());
+    y.swap(x);
+    ASSERT_TRUE(y.is_null_terminated());
+    y = two;
+    jasl::static_string z(y);
+    ASSERT_FALSE(z.is_null_terminated());
+#ifndef JASL_TERMINATE_ON_EXCEPTION_ON
+    ASSERT_EXCEPTION(z.c_str(), std::logic_error);
+#endif
+
+    // the flag doesn't change the size, and follows the ends
+    jasl::static_string w = "three";
+    ASSERT_TRUE(w.size() == 5 && w == jasl::static_string("three"));
+    w.remove_prefix(2);
+    ASSERT_TRUE(w.size() == 3 && w.is_null_terminated());
+    w.remove_suffix(1);
+    ASSERT_TRUE(w.size() == 2 && !w.is_null_terminated());
+  }
 
   return 0;
 }
@@ -0,0 +1,125 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_hash.hpp"
+#include "jasl/jasl_internal/jasl_murmurhash3.hpp"
+#include "jasl/jasl_streaming_murmurhash3.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+struct x64 {
+  typedef jasl::murmurhash3_x64_128 stream;
+  static void one_shot(const void* key, int len, uint32_t seed, void* out) {
+    jasl::murmurhash3::MurmurHash3_x64_128(key, len, seed, out);
+  }
+};
+
+struct x86 {
+  typedef jasl::murmurhash3_x86_128 stream;
+  static void one_shot(const void* key, int len, uint32_t seed, void* out) {
+    jasl::murmurhash3::MurmurHash3_x86_128(key, len, seed, out);
+  }
+};
+
+// the streams of random chunks are the same as the one-shot hash
+template <typename Variant>
+bool same_as_one_shot(const std::vector<unsigned char>& data,
+                      std::mt19937& gen) {
+  const uint32_t seeds[] = {0, 33, 0xdeadbeef};
+  for (uint32_t seed : seeds) {
+    for (size_t size = 0; size <= data.size(); size += 1 + size / 8) {
+      unsigned char expected[16];
+      Variant::one_shot(data.data(), static_cast<int>(size), seed, expected);
+
+      unsigned char result[16];
+      Variant::stream::hash(data.data(), size, seed, result);
+      if (std::memcmp(result, expected, 16) != 0)
+        return false;
+
+      typename Variant::stream hasher(seed);
+      for (size_t pos = 0; pos < size;) {
+        const size_t chunk = std::min<size_t>(gen() % 40, size - pos);
+        hasher.update(data.data() + pos, chunk);
+        pos += chunk;
+      }
+      hasher.finalize(result);
+      if (hasher.size() != size || std::memcmp(result, expected, 16) != 0)
+        return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  std::mt19937 gen(42);
+  std::vector<unsigned char> data(3000);
+  for (unsigned char& c : data)
+    c = static_cast<unsigned char>(gen());
+
+  ASSERT_TRUE(same_as_one_shot<x64>(data, gen));
+  ASSERT_TRUE(same_as_one_shot<x86>(data, gen));
+  {
+    // byte by byte, finalized in the middle and continued
+    jasl::murmurhash3_x64_128 hasher(7);
+    unsigned char expected[16];
+    unsigned char result[16];
+    for (size_t i = 0; i < 100; ++i) {
+      hasher.update(data.data() + i, 1);
+      hasher.finalize(result);
+      jasl::murmurhash3::MurmurHash3_x64_128(
+          data.data(), static_cast<int>(i + 1), 7, expected);
+      ASSERT_TRUE(std::memcmp(result, expected, 16) == 0);
+    }
+
+    // init starts a new hash
+    hasher.init(7);
+    ASSERT_TRUE(hasher.size() == 0);
+    hasher.update(data.data(), 10);
+    hasher.finalize(result);
+    jasl::murmurhash3::MurmurHash3_x64_128(data.data(), 10, 7, expected);
+    ASSERT_TRUE(std::memcmp(result, expected, 16) == 0);
+  }
+  {
+    // strings, and chunks of a rope
+    const std::string text = "The quick brown fox jumps over the lazy dog";
+    jasl::murmurhash3_x86_128 hasher(33);
+    hasher.update(text.substr(0, 9));
+    hasher.update(jasl::string_view(text.data() + 9, 20));
+    hasher.update(text.substr(29));
+    unsigned char expected[16];
+    unsigned char result[16];
+    hasher.finalize(result);
+    jasl::murmurhash3::MurmurHash3_x86_128(
+        text.data(), static_cast<int>(text.size()), 33, expected);
+    ASSERT_TRUE(std::memcmp(result, expected, 16) == 0);
+
+    // the hashes of the library stay the same
+    uint64_t hash[2];
+    jasl::inner::hash128(text.data(), text.size(), hash);
+    jasl::murmurhash3::MurmurHash3_x64_128(
+        text.data(), static_cast<int>(text.size()), 33, expected);
+    ASSERT_TRUE(std::memcmp(hash, expected, 16) == 0);
+#if !defined(JASL_cpp_lib_string_view) || \
+    defined(JASL_FORCE_USE_MURMURHASH_HASH)
+    if (sizeof(size_t) == 8) {
+      size_t std_hash;
+      std::memcpy(&std_hash, expected, sizeof(size_t));
+      ASSERT_TRUE(std::hash<jasl::nonstd::string_view>()(
+                      jasl::nonstd::string_view(text.data(), text.size())) ==
+                  std_hash);
+    }
+#endif
+  }
+
+  return 0;
+}
@@ -4,7 +4,9 @@
 //
 // This code is licensed under the MIT License (MIT).
 
+#include <stdint.h>
 #include <set>
+#include <stdexcept>
 
 #include "jasl/jasl_string.hpp"
 #include "test_helper.hpp"
@@ -18,6 +20,14 @@ static_assert(std::is_nothrow_move_constructible<jasl::string>::value, "!");
 //static_assert(JASL_is_nothrow_swappable_value(jasl::string), "!");
 static_assert(std::is_nothrow_destructible<jasl::string>::value, "!");
 
+// The c_str() support mustn't grow the string: the null terminated flag is kept
+// in the size of the view. Checked where the pointer and size_t have the same
+// width and the empty allocator is padded to a word.
+#if SIZE_MAX == UINTPTR_MAX
+static_assert(sizeof(jasl::string) == 4 * sizeof(void*),
+              "string is not a view, an allocator and a capacity");
+#endif
+
 struct different_alloc : public std::allocator<char> {
   typedef std::false_type propagate_on_container_move_assignment;
 };
@@ -407,6 +417,46 @@ int main(int, char* argv[]) {
     ASSERT_TRUE(*ss.data() == 'a');
   }
 #endif
+  {
+    jasl::string js = jasl::string::build(3, [](char* out) {
+      out[0] = 'a';
+      out[1] = 'b';
+      out[2] = 'c';
+    });
+    ASSERT_FALSE(js.is_static());
+    ASSERT_TRUE(js == jasl::string("abc"));
+    ASSERT_TRUE(jasl::string::build(0, [](char*) {}).empty());
+    ASSERT_EXCEPTION(jasl::string::build(
+                         3, [](char*) { throw std::runtime_error("fill"); }),
+                     std::runtime_error);
+    ASSERT_TRUE(js.is_null_terminated() && js.c_str()[3] == 0);
+  }
+  {
+    const jasl::string literal = "one";
+    ASSERT_TRUE(literal.c_str() == literal.data());
+    const jasl::string copy("apple", 3);
+    ASSERT_TRUE(copy.is_null_terminated());
+    ASSERT_TRUE(std::string(copy.c_str()) == "app");
+    ASSERT_TRUE(copy.substr(0, 1).c_str()[1] == 0);
+    ASSERT_TRUE(jasl::string().c_str()[0] == 0);
+    const char two[] = {'t', 'w', 'o'};
+    jasl::string x = two;
+    ASSERT_FALSE(x.is_null_terminated());
+    x = jasl::static_string("one");
+    ASSERT_TRUE(x.is_null_terminated());
+    jasl::string prefix = literal.substr(0, 2);
+    ASSERT_FALSE(prefix.is_null_terminated());
+    ASSERT_TRUE(literal.substr(1).is_null_terminated());
+    jasl::string y = literal;
+    y.swap(prefix);
+    ASSERT_FALSE(y.is_null_terminated());
+    ASSERT_TRUE(prefix.c_str() == literal.data());
+    jasl::string moved(std::move(x));
+    ASSERT_TRUE(moved.is_null_terminated());
+#ifndef JASL_TERMINATE_ON_EXCEPTION_ON
+    ASSERT_EXCEPTION(y.c_str(), std::logic_error);
+#endif
+  }
 
   return 0;
 }
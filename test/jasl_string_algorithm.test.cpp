@@ -0,0 +1,146 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_algorithm.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "test_helper.hpp"
+
+template <typename CharT>
+jasl::basic_string_view<CharT> view(const std::basic_string<CharT>& str) {
+  return jasl::basic_string_view<CharT>(str.data(), str.size());
+}
+
+template <typename CharT>
+bool equals(const jasl::basic_string<CharT>& str,
+            const std::basic_string<CharT>& expected) {
+  return str == view(expected);
+}
+
+template <typename CharT>
+std::basic_string<CharT> naive_replace_all(std::basic_string<CharT> str,
+                                           const std::basic_string<CharT>& from,
+                                           const std::basic_string<CharT>& to) {
+  for (size_t pos = str.find(from); pos != std::basic_string<CharT>::npos;
+       pos = str.find(from, pos + to.size())) {
+    str.replace(pos, from.size(), to);
+  }
+  return str;
+}
+
+template <typename CharT>
+std::basic_string<CharT> naive_case(std::basic_string<CharT> str, bool lower) {
+  for (CharT& c : str) {
+    if (lower && c >= 'A' && c <= 'Z')
+      c = static_cast<CharT>(c + ('a' - 'A'));
+    else if (!lower && c >= 'a' && c <= 'z')
+      c = static_cast<CharT>(c - ('a' - 'A'));
+  }
+  return str;
+}
+
+template <typename CharT>
+int test_random() {
+  std::mt19937 gen(42);
+  const char alphabet[] = "abAB@[`{zZ \x80\xC1\xFA";
+  for (size_t iter = 0; iter < 2000; ++iter) {
+    std::basic_string<CharT> str;
+    const size_t size = gen() % 80;
+    for (size_t i = 0; i < size; ++i) {
+      str += static_cast<CharT>(
+          static_cast<unsigned char>(alphabet[gen() % (sizeof(alphabet) - 1)]));
+    }
+    ASSERT_TRUE(equals(jasl::to_lower(view(str)), naive_case(str, true)));
+    ASSERT_TRUE(equals(jasl::to_upper(view(str)), naive_case(str, false)));
+
+    const std::basic_string<CharT> from = str.substr(0, 1 + gen() % 2);
+    const std::basic_string<CharT> to(gen() % 4, static_cast<CharT>('x'));
+    if (!from.empty()) {
+      ASSERT_TRUE(equals(jasl::replace_all(view(str), view(from), view(to)),
+                         naive_replace_all(str, from, to)));
+    }
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const std::vector<jasl::string_view> pieces = {
+        jasl::static_string("a"), jasl::static_string(""),
+        jasl::static_string("bc")};
+    ASSERT_TRUE(equals(jasl::join(pieces, jasl::static_string(", ")),
+                       std::string("a, , bc")));
+    ASSERT_TRUE(equals(jasl::join(pieces, jasl::string_view()),
+                       std::string("abc")));
+    const std::vector<jasl::string_view> none;
+    ASSERT_TRUE(jasl::join(none, jasl::static_string(",")).empty());
+    const std::vector<jasl::string_view> one = {jasl::static_string("one")};
+    ASSERT_TRUE(equals(jasl::join(one, jasl::static_string(",")),
+                       std::string("one")));
+    const std::vector<jasl::string> strings = {jasl::string("x", 1),
+                                               jasl::string("yz")};
+    const jasl::string joined = jasl::join(strings, jasl::static_string("-"));
+    ASSERT_TRUE(equals(joined, std::string("x-yz")));
+    ASSERT_FALSE(joined.is_static());
+    ASSERT_TRUE(joined.c_str()[4] == 0);
+  }
+  {
+    const std::u16string a = u"left";
+    const std::u16string b = u"right";
+    const std::vector<jasl::u16string_view> pieces = {view(a), view(b)};
+    ASSERT_TRUE(
+        equals(jasl::join<char16_t>(pieces, jasl::static_u16string(u"|")),
+               std::u16string(u"left|right")));
+  }
+  {
+    const jasl::static_string str = "a.b..c.";
+    ASSERT_TRUE(equals(jasl::replace_all(str, jasl::static_string("."),
+                                         jasl::static_string("::")),
+                       std::string("a::b::::c::")));
+    ASSERT_TRUE(equals(jasl::replace_all(str, jasl::static_string(".."),
+                                         jasl::string_view()),
+                       std::string("a.bc.")));
+    ASSERT_TRUE(equals(jasl::replace_all(str, jasl::static_string("x"),
+                                         jasl::static_string("y")),
+                       std::string("a.b..c.")));
+    ASSERT_TRUE(equals(jasl::replace_all(jasl::static_string("aaa"),
+                                         jasl::static_string("aa"),
+                                         jasl::static_string("b")),
+                       std::string("ba")));
+    ASSERT_TRUE(jasl::replace_all(jasl::string_view(),
+                                  jasl::static_string("a"),
+                                  jasl::static_string("b"))
+                    .empty());
+#ifndef JASL_TERMINATE_ON_EXCEPTION_ON
+    ASSERT_EXCEPTION(jasl::replace_all(str, jasl::string_view(),
+                                       jasl::static_string("y")),
+                     std::invalid_argument);
+#endif
+  }
+  {
+    const jasl::string key = "Content-Type: TEXT/html; Charset=UTF-8 \xC3\x89";
+    ASSERT_TRUE(equals(jasl::to_lower(key),
+                       std::string("content-type: text/html; "
+                                   "charset=utf-8 \xC3\x89")));
+    ASSERT_TRUE(equals(jasl::to_upper(key),
+                       std::string("CONTENT-TYPE: TEXT/HTML; "
+                                   "CHARSET=UTF-8 \xC3\x89")));
+    ASSERT_TRUE(jasl::to_lower(jasl::string_view()).empty());
+  }
+  if (test_random<char>() != 0)
+    return 1;
+  if (test_random<char32_t>() != 0)
+    return 1;
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_sort.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "test_helper.hpp"
+
+// Keys with long common prefixes, zero bytes, duplicates and empty ones.
+std::vector<std::string> random_keys(std::mt19937& gen, size_t count) {
+  const std::string prefixes[] = {"",
+                                  "a",
+                                  "https://example.com/",
+                                  "https://example.com/path/",
+                                  std::string(2, '\0'),
+                                  "\xff\xfe",
+                                  "abcdefgh",
+                                  "abcdefghi"};
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < count; ++i) {
+    std::string key = prefixes[gen() % 8];
+    const size_t alphabet = 1 + gen() % 4;
+    const size_t size = gen() % 20;
+    for (size_t k = 0; k < size; ++k)
+      key += static_cast<char>(gen() % 2 ? 'a' + gen() % alphabet
+                                         : (gen() % 3 ? 0 : 0xff));
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+template <typename T>
+std::vector<std::string> to_std(const std::vector<T>& strings) {
+  std::vector<std::string> result;
+  for (const T& s : strings) {
+    const jasl::string_view v = s;
+    result.push_back(std::string(v.data(), v.size()));
+  }
+  return result;
+}
+
+int main() {
+  {
+    std::vector<jasl::string_view> empty;
+    jasl::string_sort(empty.begin(), empty.end());
+    ASSERT_TRUE(empty.empty());
+
+    std::vector<jasl::static_string> words = {"pear", "apple", "",
+                                              "applesauce", "app", "apple"};
+    jasl::string_sort(words.begin(), words.end());
+    ASSERT_TRUE(words[0] == jasl::static_string(""));
+    ASSERT_TRUE(words[1] == jasl::static_string("app"));
+    ASSERT_TRUE(words[2] == jasl::static_string("apple"));
+    ASSERT_TRUE(words[3] == jasl::static_string("apple"));
+    ASSERT_TRUE(words[4] == jasl::static_string("applesauce"));
+    ASSERT_TRUE(words[5] == jasl::static_string("pear"));
+  }
+  {
+    // the bytes are compared as unsigned char, zero bytes included
+    const char data[] = "ab\0ab\0\0ab\x80";
+    std::vector<jasl::string_view> views = {
+        jasl::string_view(data + 7, 3), jasl::string_view(data + 3, 4),
+        jasl::string_view(data, 3), jasl::string_view(data, 2)};
+    jasl::string_sort(views.begin(), views.end());
+    ASSERT_TRUE(views[0].size() == 2);
+    ASSERT_TRUE(views[1].size() == 3);
+    ASSERT_TRUE(views[2].size() == 4);
+    ASSERT_TRUE(views[3].size() == 3 && views[3][2] == '\x80');
+  }
+
+  std::mt19937 gen(42);
+  for (size_t count : {10, 33, 100, 1000, 20000, 100000}) {
+    const std::vector<std::string> keys = random_keys(gen, count);
+    std::vector<std::string> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<std::string> std_strings = keys;
+    jasl::string_sort(std_strings.begin(), std_strings.end());
+    ASSERT_TRUE(std_strings == expected);
+
+    std::vector<jasl::string_view> views;
+    for (const std::string& key : keys)
+      views.emplace_back(key.data(), key.size());
+    jasl::string_sort(views.begin(), views.end());
+    ASSERT_TRUE(to_std(views) == expected);
+
+    std::vector<jasl::string> strings;
+    for (const std::string& key : keys)
+      strings.push_back(jasl::string(key.data(), key.size()));
+    jasl::string_sort(strings.begin(), strings.end());
+    ASSERT_TRUE(to_std(strings) == expected);
+
+    for (size_t threads : {1, 3}) {
+      jasl::thread_pool pool(threads);
+      std::vector<jasl::string_view> parallel;
+      for (const std::string& key : keys)
+        parallel.emplace_back(key.data(), key.size());
+      jasl::parallel_string_sort(parallel.begin(), parallel.end(), pool);
+      ASSERT_TRUE(to_std(parallel) == expected);
+    }
+  }
+  {
+    // many equal long keys and sorted input
+    std::vector<std::string> keys(70000, std::string(100, 'x'));
+    for (size_t i = 0; i < keys.size(); i += 7)
+      keys[i] += std::to_string(i);
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::string> expected = keys;
+    jasl::string_sort(keys.begin(), keys.end());
+    ASSERT_TRUE(keys == expected);
+    std::reverse(keys.begin(), keys.end());
+    jasl::thread_pool pool(4);
+    jasl::parallel_string_sort(keys.begin(), keys.end(), pool);
+    ASSERT_TRUE(keys == expected);
+  }
+
+  return 0;
+}
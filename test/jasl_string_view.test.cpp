@@ -20,6 +20,102 @@ static_assert(std::is_nothrow_move_assignable<jasl::string_view>::value, "!");
 static_assert(JASL_is_nothrow_swappable_value(jasl::string_view), "!");
 static_assert(std::is_nothrow_destructible<jasl::string_view>::value, "!");
 
+template <typename T>
+int sign(T x) {
+  return x < 0 ? -1 : (x > 0 ? 1 : 0);
+}
+
+// Every length around the word and vector sizes, the difference at every
+// position.
+template <typename StringViewT>
+int test_compare_lengths() {
+  const size_t max_len = 80;
+  std::string left(max_len, 'x');
+  std::string right(max_len, 'x');
+  for (size_t len = 0; len <= max_len; ++len) {
+    const StringViewT l(left.data(), len);
+    const StringViewT r(right.data(), len);
+    ASSERT_TRUE(l == r);
+    ASSERT_FALSE(l != r);
+    ASSERT_TRUE(l.compare(r) == 0);
+    if (len > 0) {
+      ASSERT_TRUE(l.compare(StringViewT(right.data(), len - 1)) > 0);
+      ASSERT_TRUE(StringViewT(left.data(), len - 1).compare(r) < 0);
+      ASSERT_FALSE(l == StringViewT(right.data(), len - 1));
+    }
+    for (size_t pos = 0; pos < len; ++pos) {
+      for (char c : {'\x00', 'a', '\x80', '\xff'}) {
+        right[pos] = c;
+        const int expected =
+            sign(std::string(left, 0, len).compare(std::string(right, 0, len)));
+        ASSERT_FALSE(l == r);
+        ASSERT_TRUE(l != r);
+        ASSERT_TRUE(sign(l.compare(r)) == expected);
+        ASSERT_TRUE(sign(r.compare(l)) == -expected);
+        ASSERT_TRUE((l < r) == (expected < 0));
+      }
+      right[pos] = 'x';
+    }
+  }
+  return 0;
+}
+
+// Checks the results against std::basic_string for every position.
+template <typename StringViewT>
+int test_find_family(const typename StringViewT::value_type* str,
+                     const typename StringViewT::value_type* set) {
+  typedef typename StringViewT::value_type CharT;
+  const std::basic_string<CharT> ss(str);
+  const std::basic_string<CharT> sset(set);
+  const StringViewT sv(ss.data(), ss.size());
+  const StringViewT svset(sset.data(), sset.size());
+  const size_t npos = StringViewT::npos;
+
+  ASSERT_TRUE(sv.rfind(svset) == ss.rfind(sset));
+  ASSERT_TRUE(sv.find_first_of(svset) == ss.find_first_of(sset));
+  ASSERT_TRUE(sv.find_last_of(svset) == ss.find_last_of(sset));
+  ASSERT_TRUE(sv.find_first_not_of(svset) == ss.find_first_not_of(sset));
+  ASSERT_TRUE(sv.find_last_not_of(svset) == ss.find_last_not_of(sset));
+  ASSERT_TRUE(sv.rfind(set) == ss.rfind(set));
+  ASSERT_TRUE(sv.find_first_of(set) == ss.find_first_of(set));
+  ASSERT_TRUE(sv.find_last_of(set) == ss.find_last_of(set));
+  ASSERT_TRUE(sv.find_first_not_of(set) == ss.find_first_not_of(set));
+  ASSERT_TRUE(sv.find_last_not_of(set) == ss.find_last_not_of(set));
+
+  for (size_t pos = 0; pos <= ss.size() + 1; ++pos) {
+    ASSERT_TRUE(sv.rfind(svset, pos) == ss.rfind(sset, pos));
+    ASSERT_TRUE(sv.find_first_of(svset, pos) == ss.find_first_of(sset, pos));
+    ASSERT_TRUE(sv.find_last_of(svset, pos) == ss.find_last_of(sset, pos));
+    ASSERT_TRUE(sv.find_first_not_of(svset, pos) ==
+                ss.find_first_not_of(sset, pos));
+    ASSERT_TRUE(sv.find_last_not_of(svset, pos) ==
+                ss.find_last_not_of(sset, pos));
+    ASSERT_TRUE(sv.rfind(set, pos, sset.size()) ==
+                ss.rfind(set, pos, sset.size()));
+    ASSERT_TRUE(sv.find_first_of(set, pos, sset.size()) ==
+                ss.find_first_of(set, pos, sset.size()));
+    ASSERT_TRUE(sv.find_last_of(set, pos, sset.size()) ==
+                ss.find_last_of(set, pos, sset.size()));
+    ASSERT_TRUE(sv.find_first_not_of(set, pos, sset.size()) ==
+                ss.find_first_not_of(set, pos, sset.size()));
+    ASSERT_TRUE(sv.find_last_not_of(set, pos, sset.size()) ==
+                ss.find_last_not_of(set, pos, sset.size()));
+    for (size_t i = 0; i < sset.size(); ++i) {
+      const CharT c = sset[i];
+      ASSERT_TRUE(sv.rfind(c, pos) == ss.rfind(c, pos));
+      ASSERT_TRUE(sv.find_first_of(c, pos) == ss.find_first_of(c, pos));
+      ASSERT_TRUE(sv.find_last_of(c, pos) == ss.find_last_of(c, pos));
+      ASSERT_TRUE(sv.find_first_not_of(c, pos) ==
+                  ss.find_first_not_of(c, pos));
+      ASSERT_TRUE(sv.find_last_not_of(c, pos) == ss.find_last_not_of(c, pos));
+    }
+  }
+  ASSERT_TRUE(sv.rfind(svset, npos) == ss.rfind(sset, npos));
+  ASSERT_TRUE(sv.find_last_of(svset, npos) == ss.find_last_of(sset, npos));
+  ASSERT_TRUE(sv.find_first_of(svset, npos) == npos);
+  return 0;
+}
+
 int main() {
   {
     jasl::string_view x;
@@ -163,6 +259,9 @@ int main() {
   ASSERT_TRUE(jasl::string_view("ab", _2) > jasl::string_view("a", _1));
   ASSERT_TRUE(jasl::string_view("ab", _2) >= jasl::string_view("a", _1));
 
+  ASSERT_TRUE(test_compare_lengths<jasl::nonstd::string_view>() == 0);
+  ASSERT_TRUE(test_compare_lengths<jasl::string_view>() == 0);
+
   // test only syntax
   std::cout << jasl::string_view("", 0);
 
@@ -280,6 +379,37 @@ int main() {
                 jasl::string_view::npos);
     ASSERT_TRUE(y.find(jasl::string_view("threeX", 6)) ==
                 jasl::string_view::npos);
+
+    // the search restarts right after the beginning of a partial match
+    jasl::string_view z("aab", 3);
+    ASSERT_TRUE(z.find(jasl::string_view("ab", 2)) == 1);
+    ASSERT_TRUE(z.find(jasl::string_view("aab", 3)) == 0);
+    ASSERT_TRUE(z.find(jasl::string_view("aaab", 4)) ==
+                jasl::string_view::npos);
+  }
+
+  {
+    typedef jasl::nonstd::string_view sv;
+    ASSERT_TRUE(test_find_family<sv>("", "") == 0);
+    ASSERT_TRUE(test_find_family<sv>("", "a") == 0);
+    ASSERT_TRUE(test_find_family<sv>("a", "") == 0);
+    ASSERT_TRUE(test_find_family<sv>("a", "a") == 0);
+    ASSERT_TRUE(test_find_family<sv>("abcabc", "bc") == 0);
+    ASSERT_TRUE(test_find_family<sv>("abcabc", "cab") == 0);
+    ASSERT_TRUE(test_find_family<sv>("abcabc", "xyz") == 0);
+    ASSERT_TRUE(test_find_family<sv>("  key = value ;", " \t=;") == 0);
+    ASSERT_TRUE(test_find_family<sv>("\xff\x80\x7f\x01", "\x80\xff") == 0);
+    ASSERT_TRUE(test_find_family<sv>("aaaa", "aaaaa") == 0);
+
+    typedef jasl::nonstd::wstring_view wsv;
+    ASSERT_TRUE(test_find_family<wsv>(L"", L"") == 0);
+    ASSERT_TRUE(test_find_family<wsv>(L"abcabc", L"bc") == 0);
+    ASSERT_TRUE(test_find_family<wsv>(L"  key = value ;", L" \t=;") == 0);
+
+    typedef jasl::nonstd::u16string_view u16sv;
+    ASSERT_TRUE(test_find_family<u16sv>(u"abcabc", u"cab") == 0);
+
+    ASSERT_TRUE(test_find_family<jasl::string_view>("a,b;c", ",;") == 0);
   }
 
 #if defined(JASL_SUPPORT_STD_TO_JASL)
@@ -187,5 +187,27 @@ int main() {
   ASSERT_TRUE(jasl_string_view("ab") > jasl::static_string("a"));
   ASSERT_TRUE(jasl_string_view("ab") >= jasl::static_string("a"));
 
+  {
+    // Every length around the word and vector sizes, the difference at every
+    // position.
+    char left_array[65] = {};
+    char right_array[65] = {};
+    for (size_t i = 0; i < 64; ++i)
+      left_array[i] = right_array[i] = static_cast<char>('0' + i);
+    const jasl::static_string left(left_array);
+    const jasl::static_string right(right_array);
+    for (size_t len = 0; len <= left.size(); ++len) {
+      ASSERT_TRUE(left.substr(0, len) == right.substr(0, len));
+      ASSERT_FALSE(left.substr(0, len) != right.substr(0, len));
+      for (size_t pos = 0; pos < len; ++pos) {
+        right_array[pos] = 'x';
+        ASSERT_FALSE(left.substr(0, len) == right.substr(0, len));
+        ASSERT_TRUE(left.substr(0, len) != right.substr(0, len));
+        ASSERT_TRUE(left.substr(0, len) < right.substr(0, len));
+        right_array[pos] = left_array[pos];
+      }
+    }
+  }
+
   return 0;
 }
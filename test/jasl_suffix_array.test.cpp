@@ -0,0 +1,138 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_suffix_array.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "test_helper.hpp"
+
+std::vector<size_t> naive_locate(const std::string& text,
+                                 const std::string& pattern) {
+  // the empty pattern matches the non-empty suffixes
+  std::vector<size_t> result;
+  for (size_t pos = 0; pos + std::max<size_t>(pattern.size(), 1) <= text.size();
+       ++pos) {
+    if (text.compare(pos, pattern.size(), pattern) == 0)
+      result.push_back(pos);
+  }
+  return result;
+}
+
+int check(const std::string& text, const jasl::suffix_array& index) {
+  ASSERT_TRUE(index.size() == text.size());
+  std::vector<size_t> expected(text.size());
+  for (size_t i = 0; i < text.size(); ++i)
+    expected[i] = i;
+  std::sort(expected.begin(), expected.end(), [&text](size_t a, size_t b) {
+    return text.compare(a, std::string::npos, text, b, std::string::npos) < 0;
+  });
+  for (size_t r = 0; r < text.size(); ++r) {
+    ASSERT_TRUE(index.suffix(r) == expected[r]);
+    size_t lcp = 0;
+    if (r > 0) {
+      while (expected[r - 1] + lcp < text.size() &&
+             expected[r] + lcp < text.size() &&
+             text[expected[r - 1] + lcp] == text[expected[r] + lcp])
+        ++lcp;
+    }
+    ASSERT_TRUE(index.lcp(r) == lcp);
+  }
+  return 0;
+}
+
+int main() {
+  {
+    const jasl::static_string text = "banana";
+    const jasl::suffix_array index(text);
+    ASSERT_TRUE(index.size() == 6);
+    const size_t sa[] = {5, 3, 1, 0, 4, 2};
+    const size_t lcp[] = {0, 1, 3, 0, 0, 2};
+    for (size_t r = 0; r < 6; ++r) {
+      ASSERT_TRUE(index.suffix(r) == sa[r]);
+      ASSERT_TRUE(index.lcp(r) == lcp[r]);
+    }
+    ASSERT_TRUE(index.count(jasl::static_string("ana")) == 2);
+    ASSERT_TRUE(index.count(jasl::static_string("a")) == 3);
+    ASSERT_TRUE(index.count(jasl::static_string("")) == 6);
+    ASSERT_TRUE(index.count(jasl::static_string("nab")) == 0);
+    ASSERT_TRUE(index.count(jasl::static_string("bananas")) == 0);
+    ASSERT_TRUE(index.find(jasl::static_string("nan")) == 2);
+    ASSERT_TRUE(index.find(jasl::static_string("x")) ==
+                jasl::suffix_array::npos);
+    const std::vector<size_t> positions =
+        index.locate(jasl::static_string("an"));
+    ASSERT_TRUE(positions.size() == 2 && positions[0] == 1 &&
+                positions[1] == 3);
+    ASSERT_TRUE(index.longest_repeated_substring() ==
+                jasl::static_string("ana"));
+    ASSERT_TRUE(index.memory_usage() >= 2 * 6 * sizeof(uint32_t));
+  }
+  {
+    const jasl::suffix_array empty(jasl::static_string(""));
+    ASSERT_TRUE(empty.size() == 0);
+    ASSERT_TRUE(empty.count(jasl::static_string("a")) == 0);
+    ASSERT_TRUE(empty.count(jasl::static_string("")) == 0);
+    ASSERT_TRUE(empty.find(jasl::static_string("")) ==
+                jasl::suffix_array::npos);
+    ASSERT_TRUE(empty.longest_repeated_substring().empty());
+
+    // the text is referred, not copied
+    const jasl::string text = jasl::static_string("abracadabra");
+    const jasl::suffix_array index(text);
+    ASSERT_TRUE(index.text().data() == text.data());
+    ASSERT_TRUE(index.count(jasl::static_string("abra")) == 2);
+    ASSERT_TRUE(index.longest_repeated_substring() ==
+                jasl::static_string("abra"));
+  }
+
+  std::mt19937 gen(42);
+  jasl::thread_pool pool(3);
+  for (size_t iter = 0; iter < 300; ++iter) {
+    const size_t size = iter < 100 ? iter : gen() % 3000;
+    const size_t alphabet = 1 + gen() % (iter % 3 == 0 ? 256 : 4);
+    std::string text;
+    for (size_t i = 0; i < size; ++i)
+      text += static_cast<char>(gen() % 4 == 0 ? text.size() % alphabet
+                                               : gen() % alphabet);
+    if (iter % 5 == 0 && size > 0)
+      text = std::string(size, text[0]);  // periodic texts recurse the most
+
+    const jasl::suffix_array index(view(text));
+    ASSERT_TRUE(check(text, index) == 0);
+    const jasl::suffix_array parallel(view(text), pool);
+    ASSERT_TRUE(check(text, parallel) == 0);
+
+    for (size_t q = 0; q < 20; ++q) {
+      std::string pattern;
+      if (q % 2 && !text.empty()) {
+        const size_t pos = gen() % text.size();
+        pattern = text.substr(pos, gen() % 8);
+      } else {
+        for (size_t i = gen() % 4; i > 0; --i)
+          pattern += static_cast<char>(gen() % alphabet);
+      }
+      const std::vector<size_t> expected = naive_locate(text, pattern);
+      ASSERT_TRUE(index.count(view(pattern)) == expected.size());
+      ASSERT_TRUE(index.locate(view(pattern)) == expected);
+      const size_t found = index.find(view(pattern));
+      if (expected.empty()) {
+        ASSERT_TRUE(found == jasl::suffix_array::npos);
+      } else {
+        ASSERT_TRUE(std::find(expected.begin(), expected.end(), found) !=
+                    expected.end());
+      }
+    }
+  }
+
+  return 0;
+}
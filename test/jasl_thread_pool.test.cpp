@@ -0,0 +1,55 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "jasl/jasl_thread_pool.hpp"
+#include "test_helper.hpp"
+
+int main() {
+  {
+    jasl::thread_pool pool(4);
+    ASSERT_TRUE(pool.size() == 4);
+    for (size_t round = 0; round < 100; ++round) {
+      std::vector<int> done(round * 10, 0);
+      std::atomic<size_t> sum(0);
+      pool.run(done.size(), [&](size_t i) {
+        ++done[i];
+        sum.fetch_add(i);
+      });
+      for (int d : done)
+        ASSERT_TRUE(d == 1);
+      ASSERT_TRUE(sum.load() == done.size() * (done.size() - 1) / 2 ||
+                  done.empty());
+    }
+  }
+  {
+    jasl::thread_pool pool(1);
+    ASSERT_TRUE(pool.size() == 1);
+    size_t count = 0;
+    pool.run(10, [&](size_t i) { count += i; });
+    ASSERT_TRUE(count == 45);
+  }
+  {
+    jasl::thread_pool pool(3);
+    ASSERT_EXCEPTION(pool.run(100,
+                              [](size_t i) {
+                                if (i == 42)
+                                  throw std::runtime_error("task");
+                              }),
+                     std::runtime_error);
+    // the pool is still usable
+    std::atomic<size_t> count(0);
+    pool.run(100, [&](size_t) { ++count; });
+    ASSERT_TRUE(count.load() == 100);
+  }
+  ASSERT_TRUE(jasl::default_thread_pool().size() >= 1);
+  ASSERT_TRUE(&jasl::default_thread_pool() == &jasl::default_thread_pool());
+
+  return 0;
+}
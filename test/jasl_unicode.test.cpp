@@ -0,0 +1,285 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_unicode.hpp"
+#include "test_helper.hpp"
+
+std::string encode(char32_t c) {
+  std::string r;
+  if (c < 0x80) {
+    r += static_cast<char>(c);
+  } else if (c < 0x800) {
+    r += static_cast<char>(0xC0 | (c >> 6));
+    r += static_cast<char>(0x80 | (c & 0x3F));
+  } else if (c < 0x10000) {
+    r += static_cast<char>(0xE0 | (c >> 12));
+    r += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    r += static_cast<char>(0x80 | (c & 0x3F));
+  } else {
+    r += static_cast<char>(0xF0 | (c >> 18));
+    r += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+    r += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    r += static_cast<char>(0x80 | (c & 0x3F));
+  }
+  return r;
+}
+
+std::u16string encode16(char32_t c) {
+  if (c < 0x10000)
+    return std::u16string(1, static_cast<char16_t>(c));
+  c -= 0x10000;
+  std::u16string r;
+  r += static_cast<char16_t>(0xD800 + (c >> 10));
+  r += static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+  return r;
+}
+
+template <typename CharT>
+bool equal(const jasl::basic_string<CharT>& str,
+           const std::basic_string<CharT>& expected) {
+  return str.size() == expected.size() &&
+         std::equal(expected.begin(), expected.end(), str.data());
+}
+
+int test_transcoding(unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<unsigned> dist(0, 0x10FFFF);
+  std::uniform_int_distribution<unsigned> kind(0, 4);
+  for (size_t round = 0; round < 300; ++round) {
+    std::string utf8;
+    std::u16string utf16;
+    std::u32string utf32;
+    for (size_t i = round % 70; i > 0; --i) {
+      char32_t c = static_cast<char32_t>(dist(gen));
+      const unsigned k = kind(gen);
+      if (k <= 1)
+        c &= 0x7F;
+      else if (k == 2)
+        c &= 0x7FF;
+      else if (k == 3)
+        c &= 0xFFFF;
+      if (c >= 0xD800 && c <= 0xDFFF)
+        c = 'x';
+      utf8 += encode(c);
+      utf16 += encode16(c);
+      utf32 += c;
+    }
+    const jasl::string_view v8(utf8.data(), utf8.size());
+    const jasl::u16string_view v16(utf16.data(), utf16.size());
+    const jasl::u32string_view v32(utf32.data(), utf32.size());
+    ASSERT_TRUE(equal(jasl::to_utf16(v8), utf16));
+    ASSERT_TRUE(equal(jasl::to_utf16(v32), utf16));
+    ASSERT_TRUE(equal(jasl::to_utf32(v8), utf32));
+    ASSERT_TRUE(equal(jasl::to_utf32(v16), utf32));
+    ASSERT_TRUE(equal(jasl::to_utf8(v16), utf8));
+    ASSERT_TRUE(equal(jasl::to_utf8(v32), utf8));
+    if (utf32.empty())
+      continue;
+    // ill-formed input: the same as decoding with the code point range
+    const size_t pos = dist(gen) % utf8.size();
+    utf8[pos] = static_cast<char>(dist(gen));
+    std::u32string expected;
+    for (char32_t c : jasl::utf8_code_points(view(utf8)))
+      expected += c;
+    ASSERT_TRUE(equal(jasl::to_utf32(view(utf8)), expected));
+    std::u16string expected16;
+    for (char32_t c : expected)
+      expected16 += encode16(c);
+    ASSERT_TRUE(equal(jasl::to_utf16(view(utf8)), expected16));
+  }
+  return 0;
+}
+
+// Reference: decodes by the lead byte, then checks the value range.
+bool naive_is_valid(const std::string& str) {
+  for (size_t i = 0; i < str.size();) {
+    const unsigned char c = static_cast<unsigned char>(str[i]);
+    size_t length;
+    unsigned long value;
+    if (c < 0x80) {
+      length = 1;
+      value = c;
+    } else if ((c & 0xE0) == 0xC0) {
+      length = 2;
+      value = c & 0x1Fu;
+    } else if ((c & 0xF0) == 0xE0) {
+      length = 3;
+      value = c & 0x0Fu;
+    } else if ((c & 0xF8) == 0xF0) {
+      length = 4;
+      value = c & 0x07u;
+    } else {
+      return false;
+    }
+    if (i + length > str.size())
+      return false;
+    for (size_t j = 1; j < length; ++j) {
+      const unsigned char d = static_cast<unsigned char>(str[i + j]);
+      if ((d & 0xC0) != 0x80)
+        return false;
+      value = (value << 6) | (d & 0x3Fu);
+    }
+    const unsigned long min[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (value < min[length] || value > 0x10FFFF ||
+        (value >= 0xD800 && value <= 0xDFFF))
+      return false;
+    i += length;
+  }
+  return true;
+}
+
+int main() {
+  {
+    ASSERT_TRUE(jasl::is_ascii(jasl::static_string("")));
+    ASSERT_TRUE(jasl::is_ascii(jasl::static_string("plain ascii text\n")));
+    ASSERT_FALSE(jasl::is_ascii(jasl::static_string("caf\xC3\xA9")));
+    std::string long_ascii(1000, 'a');
+    ASSERT_TRUE(jasl::is_ascii(view(long_ascii)));
+    for (size_t i = 0; i < long_ascii.size(); i += 7) {
+      long_ascii[i] = '\x80';
+      ASSERT_FALSE(jasl::is_ascii(view(long_ascii)));
+      long_ascii[i] = 'a';
+    }
+  }
+  {
+    ASSERT_TRUE(jasl::is_valid_utf8(jasl::static_string("")));
+    ASSERT_TRUE(jasl::is_valid_utf8(jasl::static_string("caf\xC3\xA9")));
+    ASSERT_TRUE(
+        jasl::is_valid_utf8(jasl::string("\xE2\x82\xAC \xF0\x9F\x98\x80")));
+    ASSERT_FALSE(jasl::is_valid_utf8(jasl::static_string("\xC0\xAF")));
+    ASSERT_FALSE(jasl::is_valid_utf8(jasl::static_string("\xED\xA0\x80")));
+    ASSERT_FALSE(jasl::is_valid_utf8(jasl::static_string("\xF4\x90\x80\x80")));
+    ASSERT_FALSE(jasl::is_valid_utf8(jasl::static_string("ab\xE2\x82")));
+    ASSERT_FALSE(jasl::is_valid_utf8(jasl::static_string("\x80")));
+  }
+  {
+    // every sequence of at most 3 bytes, after some ASCII so that the SIMD
+    // paths see it at a block boundary too
+    std::string str(16, 'x');
+    for (unsigned a = 0x80; a < 0x100; ++a) {
+      for (unsigned b = 0; b < 0x100; ++b) {
+        str.resize(14);
+        str += static_cast<char>(a);
+        str += static_cast<char>(b);
+        ASSERT_TRUE(jasl::is_valid_utf8(view(str)) == naive_is_valid(str));
+        if (a < 0xE0 || (b & 0xC0) != 0x80)
+          continue;
+        for (unsigned c = 0; c < 0x100; c += (a < 0xF0 ? 1 : 0x11)) {
+          str.resize(16);
+          str += static_cast<char>(c);
+          ASSERT_TRUE(jasl::is_valid_utf8(view(str)) == naive_is_valid(str));
+        }
+      }
+    }
+  }
+  {
+    // random text with random errors
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<unsigned> dist(0, 0x10FFFF);
+    std::uniform_int_distribution<unsigned> kind(0, 3);
+    for (size_t round = 0; round < 2000; ++round) {
+      std::string str;
+      const size_t count = round % 100;
+      for (size_t i = 0; i < count; ++i) {
+        char32_t c = static_cast<char32_t>(dist(gen));
+        const unsigned k = kind(gen);
+        if (k == 0)
+          c &= 0x7F;
+        else if (k == 1)
+          c &= 0x7FF;
+        else if (k == 2)
+          c &= 0xFFFF;
+        if (c >= 0xD800 && c <= 0xDFFF)
+          c = 'x';
+        str += encode(c);
+      }
+      ASSERT_TRUE(jasl::is_valid_utf8(view(str)));
+      if (!str.empty() && round % 2 == 0) {
+        const size_t pos = dist(gen) % str.size();
+        str[pos] = static_cast<char>(dist(gen) & 0xFF);
+      } else if (!str.empty()) {
+        str.resize(dist(gen) % str.size());
+      }
+      ASSERT_TRUE(jasl::is_valid_utf8(view(str)) == naive_is_valid(str));
+    }
+  }
+  {
+    const jasl::static_string str = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    std::vector<char32_t> code_points;
+    for (char32_t c : jasl::utf8_code_points(str))
+      code_points.push_back(c);
+    ASSERT_TRUE(
+        (code_points == std::vector<char32_t>{0x61, 0xE9, 0x20AC, 0x1F600}));
+    auto it = jasl::utf8_code_points(str).begin();
+    ++it;
+    ASSERT_TRUE(it.sequence().size() == 2);
+    ASSERT_TRUE(it.sequence().data() == str.data() + 1);
+    ASSERT_TRUE(it.valid());
+  }
+  {
+    // maximal subparts: "\xF0\x9F\x98" is one, "\xC0" and "\xAF" are two
+    const jasl::static_string str = "\xF0\x9F\x98" "a\xC0\xAF\xED\xA0";
+    std::vector<char32_t> code_points;
+    std::vector<size_t> lengths;
+    for (auto it = jasl::utf8_code_points(str).begin();
+         it != jasl::utf8_code_points(str).end(); ++it) {
+      code_points.push_back(*it);
+      lengths.push_back(it.sequence().size());
+      ASSERT_TRUE(it.valid() == (*it == 'a'));
+    }
+    ASSERT_TRUE((code_points ==
+                 std::vector<char32_t>{0xFFFD, 'a', 0xFFFD, 0xFFFD, 0xFFFD,
+                                       0xFFFD}));
+    ASSERT_TRUE((lengths == std::vector<size_t>{3, 1, 1, 1, 1, 1}));
+  }
+  {
+    const jasl::static_string empty = "";
+    ASSERT_TRUE(jasl::utf8_code_points(empty).begin() ==
+                jasl::utf8_code_points(empty).end());
+  }
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    if (test_transcoding(seed) != 0)
+      return 1;
+  }
+  {
+    ASSERT_TRUE(jasl::to_utf16(jasl::static_string("")).empty());
+    ASSERT_TRUE(equal(jasl::to_utf16(jasl::static_string("\xC0" "a")),
+                      std::u16string(u"\uFFFD" "a")));
+    // unpaired surrogates
+    const std::u16string lone = u"a\xD800\xD800\xDC00\xDC00" "b";
+    ASSERT_TRUE(equal(jasl::to_utf32(jasl::u16string_view(lone.data(),
+                                                          lone.size())),
+                      std::u32string(U"a\uFFFD\U00010000\uFFFD" "b")));
+    ASSERT_TRUE(equal(jasl::to_utf8(jasl::u16string_view(lone.data(),
+                                                         lone.size())),
+                      std::string("a\xEF\xBF\xBD\xF0\x90\x80\x80"
+                                  "\xEF\xBF\xBD" "b")));
+    // invalid code points, also in the middle of vectorized blocks
+    std::u32string invalid(20, U'a');
+    invalid[5] = 0xD800;
+    invalid[11] = 0x110000;
+    invalid[17] = 0xFFFFFFFF;
+    const jasl::u32string_view iv(invalid.data(), invalid.size());
+    std::u16string expected16(20, u'a');
+    expected16[5] = expected16[11] = expected16[17] = 0xFFFD;
+    ASSERT_TRUE(equal(jasl::to_utf16(iv), expected16));
+    ASSERT_TRUE(equal(jasl::to_utf8(jasl::u16string_view(
+                          expected16.data(), expected16.size())),
+                      std::string(jasl::to_utf8(iv).data(),
+                                  jasl::to_utf8(iv).size())));
+    // the result is a single dynamic allocation
+    ASSERT_FALSE(jasl::to_utf8(iv).is_static());
+  }
+
+  return 0;
+}
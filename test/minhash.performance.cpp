@@ -0,0 +1,102 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_minhash.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t DocumentCount = 10000;
+constexpr static size_t WordCount = 200;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test measures [jasl::minhash] and finds the "
+               "near-duplicates\nof documents by [jasl::lsh_index] and by "
+               "comparing every pair of signatures.");
+
+  // every 10th document is a near-duplicate of the previous one
+  std::mt19937 gen(42);
+  std::vector<std::string> documents;
+  size_t total = 0;
+  for (size_t i = 0; i < DocumentCount; ++i) {
+    std::string document;
+    if (i % 10 == 9) {
+      document = documents.back();
+      for (size_t k = 0; k < 5; ++k)
+        document[gen() % document.size()] = '#';
+    } else {
+      for (size_t k = 0; k < WordCount; ++k)
+        document += "w" + std::to_string(gen() % 20000) + ' ';
+    }
+    total += document.size();
+    documents.push_back(document);
+  }
+
+  const jasl::minhash hasher(128, 5);
+  std::cout << "Signatures of " << DocumentCount << " documents" << std::endl
+            << std::endl;
+  std::vector<jasl::minhash::signature_type> signatures(DocumentCount);
+  auto sign = measure_units("[jasl::minhash::signature]", 1, IterCount, [&] {
+    for (size_t i = 0; i < DocumentCount; ++i) {
+      signatures[i] = hasher.signature(
+          jasl::string_view(documents[i].data(), documents[i].size()));
+    }
+    do_not_optimize(signatures.back()[0]);
+  });
+  print_throughput(sign, static_cast<double>(total));
+  auto simhash = measure_units("[jasl::minhash::simhash]", 1, IterCount, [&] {
+    uint64_t sum = 0;
+    for (const std::string& document : documents) {
+      sum += hasher.simhash(
+          jasl::string_view(document.data(), document.size()));
+    }
+    do_not_optimize(sum);
+  });
+  print_throughput(simhash, static_cast<double>(total));
+  std::cout << std::endl;
+
+  std::cout << "Near-duplicates (similarity >= 0.8) of every document"
+            << std::endl
+            << std::endl;
+  size_t pair_count = 0;
+  auto pairwise = measure_units("every pair of signatures", DocumentCount, 1,
+                                [&] {
+                                  size_t count = 0;
+                                  for (size_t i = 0; i < DocumentCount; ++i) {
+                                    for (size_t j = 0; j < i; ++j) {
+                                      count += jasl::minhash::similarity(
+                                                   signatures[i],
+                                                   signatures[j]) >= 0.8;
+                                    }
+                                  }
+                                  pair_count = count;
+                                  do_not_optimize(count);
+                                });
+  size_t lsh_count = 0;
+  auto lsh = measure_units(
+      "[jasl::lsh_index] of 32 bands", DocumentCount, IterCount, [&] {
+        jasl::lsh_index index(32, 4);
+        size_t count = 0;
+        for (const jasl::minhash::signature_type& signature : signatures) {
+          count += index.query(signature, 0.8).size();
+          index.insert(signature);
+        }
+        lsh_count = count;
+        do_not_optimize(count);
+      });
+  print_compare(lsh, pairwise);
+  std::cout << " - pairs found: " << lsh_count << " of " << pair_count
+            << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_multi_matcher.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t LineCount = 20000;
+constexpr static size_t LineLength = 120;
+constexpr static size_t IterCount = 5;
+
+std::string random_word(std::mt19937& gen, size_t min_len, size_t max_len) {
+  std::uniform_int_distribution<size_t> length(min_len, max_len);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::string word(length(gen), ' ');
+  for (char& c : word)
+    c = static_cast<char>(letter(gen));
+  return word;
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the [jasl::multi_matcher] to "
+               "one\n[jasl::string_view]::find loop per keyword on log "
+               "lines.");
+
+  std::mt19937 gen(42);
+  std::string text;
+  std::vector<jasl::string_view> lines;
+  {
+    std::vector<size_t> line_ends;
+    for (size_t i = 0; i < LineCount; ++i) {
+      while (text.size() % LineLength < LineLength - 12)
+        text += random_word(gen, 2, 9) + ' ';
+      text.resize(text.size() - text.size() % LineLength + LineLength - 1,
+                  '.');
+      text += '\n';
+      line_ends.push_back(text.size());
+    }
+    size_t begin = 0;
+    for (size_t end : line_ends) {
+      lines.emplace_back(text.data() + begin, end - begin);
+      begin = end;
+    }
+  }
+
+  for (size_t keyword_count : {10u, 100u, 300u}) {
+    std::vector<std::string> keywords;
+    for (size_t i = 0; i < keyword_count; ++i)
+      keywords.push_back(random_word(gen, 5, 10));
+    std::vector<jasl::string_view> keyword_views;
+    for (const std::string& k : keywords)
+      keyword_views.emplace_back(k.data(), k.size());
+    const jasl::multi_matcher matcher(keyword_views.begin(),
+                                      keyword_views.end());
+
+    std::cout << "Keyword count: " << keyword_count
+              << ", automaton states: " << matcher.state_count() << std::endl
+              << std::endl;
+
+    auto find = measure_units("find() per keyword", LineCount, IterCount, [&] {
+      size_t hits = 0;
+      for (const jasl::string_view& line : lines) {
+        for (const jasl::string_view& k : keyword_views) {
+          jasl::string_view rest = line;
+          for (size_t pos = rest.find(k); pos != jasl::string_view::npos;
+               pos = rest.find(k)) {
+            ++hits;
+            rest = rest.substr(pos + 1);
+          }
+        }
+      }
+      do_not_optimize(hits);
+    });
+    auto multi = measure_units("[jasl::multi_matcher]", LineCount, IterCount,
+                               [&] {
+                                 size_t hits = 0;
+                                 for (const jasl::string_view& line : lines) {
+                                   matcher.find_all(
+                                       line,
+                                       [&](const jasl::multi_matcher::match&) {
+                                         ++hits;
+                                       });
+                                 }
+                                 do_not_optimize(hits);
+                               });
+    auto stream = measure_units(
+        "[jasl::multi_matcher::scanner] 4 KiB chunks", LineCount, IterCount,
+        [&] {
+          size_t hits = 0;
+          jasl::multi_matcher::scanner scanner(matcher);
+          const jasl::string_view all(text.data(), text.size());
+          for (size_t pos = 0; pos < all.size(); pos += 4096) {
+            scanner.feed(all.substr(pos, 4096),
+                         [&](const jasl::multi_matcher::match&) { ++hits; });
+          }
+          do_not_optimize(hits);
+        });
+
+    print_compare(multi, find);
+    print_throughput(multi, LineLength);
+    print_throughput(stream, LineLength);
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jasl/jasl_parallel_search.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t HaystackSize = size_t(128) << 20;
+constexpr static size_t IterCount = 3;
+
+// Log-like lines of random words.
+std::string make_haystack() {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<int> length(1, 12);
+  std::string haystack;
+  haystack.reserve(HaystackSize + 100);
+  while (haystack.size() < HaystackSize) {
+    for (int w = length(gen); w > 0; --w)
+      haystack += static_cast<char>(letter(gen));
+    haystack += length(gen) == 1 ? '\n' : ' ';
+  }
+  return haystack;
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test measures the scaling of the "
+               "[jasl::parallel_find],\n[jasl::parallel_count] and "
+               "[jasl::parallel_find_all] from 1 thread to the\nnumber of "
+               "the cores.");
+
+  const std::string haystack_str = make_haystack();
+  const jasl::string_view haystack(haystack_str.data(), haystack_str.size());
+  const jasl::static_string missing = "the needle is not there";
+  const jasl::static_string frequent = "ab";
+
+  std::vector<size_t> thread_counts;
+  const size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+  for (size_t n = 1; n < cores; n *= 2)
+    thread_counts.push_back(n);
+  thread_counts.push_back(cores);
+
+  std::pair<std::string, double> find_1, count_1, find_all_1;
+  for (size_t n : thread_counts) {
+    jasl::thread_pool pool(n);
+    std::cout << "Threads: " << n << std::endl << std::endl;
+    auto find = measure_units("[jasl::parallel_find] (no match)", 1,
+                              IterCount, [&] {
+                                do_not_optimize(jasl::parallel_find(
+                                    haystack, missing, pool));
+                              });
+    auto count = measure_units("[jasl::parallel_count]", 1, IterCount, [&] {
+      do_not_optimize(jasl::parallel_count(haystack, frequent, pool));
+    });
+    auto find_all =
+        measure_units("[jasl::parallel_find_all]", 1, IterCount, [&] {
+          do_not_optimize(jasl::parallel_find_all(haystack, frequent, pool));
+        });
+    if (n == 1) {
+      find_1 = find;
+      count_1 = count;
+      find_all_1 = find_all;
+    } else {
+      print_compare(find, find_1);
+      print_compare(count, count_1);
+      print_compare(find_all, find_all_1);
+    }
+    print_throughput(find, static_cast<double>(haystack.size()));
+    print_throughput(count, static_cast<double>(haystack.size()));
+    print_throughput(find_all, static_cast<double>(haystack.size()));
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
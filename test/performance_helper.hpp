@@ -0,0 +1,100 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "jasl/jasl_internal/jasl_common.hpp"
+#include "jasl/jasl_string_view.hpp"
+
+// Prevents the compiler from optimizing away a computed value.
+template <typename T>
+void do_not_optimize(const T& value) {
+#if defined(_MSC_VER)
+  static volatile const void* sink;
+  sink = &value;
+#else
+  __asm__ __volatile__("" : : "g"(&value) : "memory");
+#endif
+}
+
+// Calls the work IterCount times and returns the average duration of one unit
+// in seconds. One call of the work has to process unit_count units.
+inline std::pair<std::string, double> measure_units(
+    std::string description,
+    size_t unit_count,
+    size_t iter_count,
+    const std::function<void()>& work) {
+  // warm up the caches and the branch predictors
+  work();
+  std::chrono::duration<double> durSum(0);
+  for (size_t iter = 0; iter < iter_count; ++iter) {
+    // it has to sleep enough time to eliminate other effects as much as
+    // reasonable.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    auto start = std::chrono::high_resolution_clock::now();
+    work();
+    auto stop = std::chrono::high_resolution_clock::now();
+    durSum += std::chrono::duration<double>(stop - start);
+  }
+  auto elapsed = durSum.count() / static_cast<double>(unit_count) /
+                 static_cast<double>(iter_count);
+  return std::pair<std::string, double>(std::move(description), elapsed);
+}
+
+inline void print_compare(const std::pair<std::string, double>& left,
+                          const std::pair<std::string, double>& right) {
+  std::cout << " - " << right.first << " / " << left.first << " = **"
+            << static_cast<int>(100 * right.second / left.second) << " %**"
+            << std::endl
+            << "   - " << left.first << ": " << left.second << " sec / unit"
+            << std::endl
+            << "   - " << right.first << ": " << right.second << " sec / unit"
+            << std::endl
+            << std::endl;
+}
+
+inline void print_throughput(const std::pair<std::string, double>& result,
+                             double bytes_per_unit) {
+  std::cout << " - " << result.first << ": **"
+            << bytes_per_unit / result.second / (1024 * 1024 * 1024)
+            << " GiB/s**" << std::endl
+            << "   - " << result.second << " sec / unit" << std::endl;
+}
+
+inline void print_header(const char* argv0, const char* description) {
+  auto& c = std::cout;
+  using std::endl;
+  c << "**ATTENTION**: Are you sure you don't run any resourceful "
+       "application right now?!"
+    << endl
+    << " - Is you notebook connected to power source?" << endl
+#ifdef JASL_DEBUG
+    << "**!!! WARNING !!!** This is not an optimized build!" << endl
+#endif
+    << endl
+    << "##### " << argv0 << endl
+    << endl
+    << "JASL version: " << JASL_VERSION_STR << endl
+    << endl
+    << description << endl
+    << endl
+    << "**NOTE**: Base type of the [jasl::static_string] and [jasl::string] "
+       "is "
+    << (JASL_INNER_USE_STD_STRING_VIEW_AS_BASE ? "[std::string_view]."
+                                               : "[jasl::string_view].")
+    << endl
+#if defined(JASL_DISABLE_SIMD)
+    << "**NOTE**: JASL_DISABLE_SIMD is defined." << endl
+#endif
+    << endl;
+}
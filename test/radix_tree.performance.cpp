@@ -0,0 +1,94 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_radix_tree.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t QueryCount = 100000;
+constexpr static size_t IterCount = 5;
+
+std::string random_segment(std::mt19937& gen) {
+  std::string segment;
+  const size_t size = 3 + gen() % 8;
+  for (size_t i = 0; i < size; ++i)
+    segment += static_cast<char>('a' + gen() % 26);
+  return segment;
+}
+
+void compare(size_t route_count) {
+  std::mt19937 gen(42);
+  std::vector<std::string> routes;
+  for (size_t i = 0; i < route_count; ++i) {
+    std::string route;
+    const size_t depth = 1 + gen() % 4;
+    for (size_t k = 0; k < depth; ++k) {
+      route += '/';
+      route += k == 0 ? std::string(gen() % 2 ? "api" : "static")
+                      : random_segment(gen);
+    }
+    routes.push_back(route + '/');
+  }
+  std::vector<std::string> queries;
+  for (size_t i = 0; i < QueryCount; ++i)
+    queries.push_back(routes[gen() % route_count] + random_segment(gen));
+
+  std::vector<jasl::string_view> route_views;
+  jasl::radix_tree<size_t> tree;
+  for (size_t i = 0; i < route_count; ++i) {
+    route_views.emplace_back(routes[i].data(), routes[i].size());
+    tree.insert_or_assign(route_views.back(), i);
+  }
+
+  std::cout << route_count << " routes" << std::endl << std::endl;
+  auto linear = measure_units(
+      "linear scan with starts_with", QueryCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const std::string& query : queries) {
+          const jasl::string_view q(query.data(), query.size());
+          size_t best = 0;
+          size_t best_size = 0;
+          for (size_t i = 0; i < route_views.size(); ++i) {
+            const jasl::string_view r = route_views[i];
+            if (r.size() > best_size && r.size() <= q.size() &&
+                q.substr(0, r.size()) == r) {
+              best = i;
+              best_size = r.size();
+            }
+          }
+          sum += best;
+        }
+        do_not_optimize(sum);
+      });
+  auto radix = measure_units(
+      "[jasl::radix_tree::longest_prefix]", QueryCount, IterCount, [&] {
+        size_t sum = 0;
+        for (const std::string& query : queries) {
+          sum += tree.longest_prefix(
+                         jasl::string_view(query.data(), query.size()))
+                     ->value();
+        }
+        do_not_optimize(sum);
+      });
+  print_compare(radix, linear);
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the longest prefix match of "
+               "URL paths in a\n[jasl::radix_tree] to a linear scan of the "
+               "routes.");
+
+  compare(16);
+  compare(256);
+  compare(4096);
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_split.hpp"
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t LineCount = 20000;
+constexpr static size_t IterCount = 5;
+
+// Lines of comma separated fields with the given average length.
+std::vector<std::string> make_lines(size_t field_length) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> length(0, 2 * field_length);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < LineCount; ++i) {
+    std::string line;
+    for (size_t f = 0; f < 12; ++f) {
+      if (f > 0)
+        line += ',';
+      for (size_t j = length(gen); j > 0; --j)
+        line += static_cast<char>(letter(gen));
+    }
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the [jasl::split] to "
+               "tokenizing into\n[std::vector<std::string>] and to a "
+               "Traits::find loop.");
+
+  for (size_t field_length : {4u, 16u, 64u}) {
+    const std::vector<std::string> lines = make_lines(field_length);
+    std::vector<jasl::string_view> views;
+    size_t bytes = 0;
+    for (const std::string& line : lines) {
+      views.emplace_back(line.data(), line.size());
+      bytes += line.size();
+    }
+    const double bytes_per_line =
+        static_cast<double>(bytes) / static_cast<double>(LineCount);
+
+    std::cout << "Average field length: " << field_length << std::endl
+              << std::endl;
+
+    auto vector = measure_units(
+        "getline to [std::vector<std::string>]", LineCount, IterCount, [&] {
+          size_t sum = 0;
+          std::vector<std::string> fields;
+          for (const std::string& line : lines) {
+            fields.clear();
+            std::istringstream is(line);
+            std::string field;
+            while (std::getline(is, field, ','))
+              fields.push_back(field);
+            sum += fields.size();
+          }
+          do_not_optimize(sum);
+        });
+    auto traits = measure_units("Traits::find loop", LineCount, IterCount, [&] {
+      size_t sum = 0;
+      for (const jasl::string_view& line : views) {
+        const char* p = line.data();
+        const char* const end = p + line.size();
+        for (;;) {
+          const char* found = std::char_traits<char>::find(
+              p, static_cast<size_t>(end - p), ',');
+          if (found == nullptr)
+            found = end;
+          sum += static_cast<size_t>(found - p);
+          if (found == end)
+            break;
+          p = found + 1;
+        }
+      }
+      do_not_optimize(sum);
+    });
+    auto split = measure_units("[jasl::split]", LineCount, IterCount, [&] {
+      size_t sum = 0;
+      for (const jasl::string_view& line : views) {
+        for (jasl::string_view field : jasl::split(line, ','))
+          sum += field.size();
+      }
+      do_not_optimize(sum);
+    });
+    auto any_of =
+        measure_units("[jasl::split_any_of]", LineCount, IterCount, [&] {
+          size_t sum = 0;
+          for (const jasl::string_view& line : views) {
+            for (jasl::string_view field :
+                 jasl::split_any_of(line, jasl::static_string(",;\t")))
+              sum += field.size();
+          }
+          do_not_optimize(sum);
+        });
+
+    print_compare(split, vector);
+    print_compare(split, traits);
+    print_throughput(split, bytes_per_line);
+    print_throughput(any_of, bytes_per_line);
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
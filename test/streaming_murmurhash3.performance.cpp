@@ -0,0 +1,106 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_internal/jasl_murmurhash3.hpp"
+#include "jasl/jasl_streaming_murmurhash3.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 1000000;
+constexpr static size_t BufferSize = 64 * 1024 * 1024;
+constexpr static size_t ChunkSize = 4096;
+constexpr static size_t IterCount = 5;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::murmurhash3_x64_128] "
+               "to the one-shot\n[MurmurHash3_x64_128].");
+
+  std::vector<std::string> keys;
+  size_t total = 0;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    keys.push_back("key:" + std::to_string(i * 2654435761U));
+    total += keys.back().size();
+  }
+  std::cout << "Hash " << KeyCount << " short keys" << std::endl << std::endl;
+  auto one_shot =
+      measure_units("[MurmurHash3_x64_128]", KeyCount, IterCount, [&] {
+        uint64_t sum = 0;
+        for (const std::string& key : keys) {
+          uint64_t out[2];
+          jasl::murmurhash3::MurmurHash3_x64_128(
+              key.data(), static_cast<int>(key.size()), 33, out);
+          sum += out[0];
+        }
+        do_not_optimize(sum);
+      });
+  auto streaming = measure_units(
+      "[jasl::murmurhash3_x64_128::hash]", KeyCount, IterCount, [&] {
+        uint64_t sum = 0;
+        for (const std::string& key : keys) {
+          uint64_t out[2];
+          jasl::murmurhash3_x64_128::hash(key.data(), key.size(), 33, out);
+          sum += out[0];
+        }
+        do_not_optimize(sum);
+      });
+  print_compare(streaming, one_shot);
+
+  std::vector<unsigned char> buffer(BufferSize);
+  for (size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = static_cast<unsigned char>(i * 31);
+  std::cout << "Hash " << BufferSize / (1024 * 1024) << " MiB" << std::endl
+            << std::endl;
+  auto whole = measure_units("[MurmurHash3_x64_128] of the buffer", 1,
+                             IterCount, [&] {
+                               uint64_t out[2];
+                               jasl::murmurhash3::MurmurHash3_x64_128(
+                                   buffer.data(),
+                                   static_cast<int>(buffer.size()), 33, out);
+                               do_not_optimize(out[0]);
+                             });
+  print_throughput(whole, static_cast<double>(BufferSize));
+  auto chunks = measure_units(
+      "[jasl::murmurhash3_x64_128] of 4 KiB chunks", 1, IterCount, [&] {
+        jasl::murmurhash3_x64_128 hasher(33);
+        for (size_t pos = 0; pos < buffer.size(); pos += ChunkSize)
+          hasher.update(buffer.data() + pos, ChunkSize);
+        uint64_t out[2];
+        hasher.finalize(out);
+        do_not_optimize(out[0]);
+      });
+  print_throughput(chunks, static_cast<double>(BufferSize));
+  auto odd_chunks = measure_units(
+      "[jasl::murmurhash3_x64_128] of 1000 byte chunks", 1, IterCount, [&] {
+        jasl::murmurhash3_x64_128 hasher(33);
+        for (size_t pos = 0; pos + 1000 <= buffer.size(); pos += 1000)
+          hasher.update(buffer.data() + pos, 1000);
+        uint64_t out[2];
+        hasher.finalize(out);
+        do_not_optimize(out[0]);
+      });
+  print_throughput(odd_chunks, static_cast<double>(BufferSize / 1000 * 1000));
+  std::cout << std::endl;
+
+  std::cout << "Hash a stream of 4 GiB (more than the one-shot [int] length)"
+            << std::endl
+            << std::endl;
+  const uint64_t stream_size = uint64_t(4) * 1024 * 1024 * 1024;
+  auto large = measure_units("[jasl::murmurhash3_x64_128]", 1, 1, [&] {
+    jasl::murmurhash3_x64_128 hasher(33);
+    while (hasher.size() < stream_size)
+      hasher.update(buffer.data(), buffer.size());
+    uint64_t out[2];
+    hasher.finalize(out);
+    do_not_optimize(out[0]);
+  });
+  print_throughput(large, static_cast<double>(stream_size));
+
+  return 0;
+}
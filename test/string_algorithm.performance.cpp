@@ -0,0 +1,103 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_static_string.hpp"
+#include "jasl/jasl_string.hpp"
+#include "jasl/jasl_string_algorithm.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t PieceCount = 100000;
+constexpr static size_t IterCount = 5;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::join], "
+               "[jasl::replace_all] and [jasl::to_lower]\nto the "
+               "[std::string] growing equivalents.");
+
+  std::mt19937 gen(42);
+  std::vector<std::string> pieces;
+  for (size_t i = 0; i < PieceCount; ++i) {
+    std::string piece;
+    const size_t size = 4 + gen() % 28;
+    for (size_t k = 0; k < size; ++k)
+      piece += static_cast<char>("abcdXYZ-_ ./"[gen() % 12]);
+    pieces.push_back(piece);
+  }
+  std::vector<jasl::string_view> views;
+  for (const std::string& piece : pieces)
+    views.emplace_back(piece.data(), piece.size());
+  const jasl::string joined = jasl::join(views, jasl::static_string(", "));
+  const std::string text(joined.data(), joined.size());
+  const double bytes = static_cast<double>(text.size());
+
+  std::cout << "Join" << std::endl << std::endl;
+  auto std_join = measure_units("[std::string] +=", 1, IterCount, [&] {
+    std::string result;
+    for (size_t i = 0; i < views.size(); ++i) {
+      if (i > 0)
+        result += ", ";
+      result.append(views[i].data(), views[i].size());
+    }
+    do_not_optimize(result);
+  });
+  auto jasl_join = measure_units("[jasl::join]", 1, IterCount, [&] {
+    const jasl::string result = jasl::join(views, jasl::static_string(", "));
+    do_not_optimize(result);
+  });
+  print_compare(jasl_join, std_join);
+
+  std::cout << "Replace all" << std::endl << std::endl;
+  auto std_replace =
+      measure_units("[std::string] find + append", 1, IterCount, [&] {
+        std::string result;
+        size_t pos = 0;
+        for (size_t found = text.find("./"); found != std::string::npos;
+             found = text.find("./", pos)) {
+          result.append(text, pos, found - pos);
+          result += "::";
+          pos = found + 2;
+        }
+        result.append(text, pos, std::string::npos);
+        do_not_optimize(result);
+      });
+  auto jasl_replace = measure_units("[jasl::replace_all]", 1, IterCount, [&] {
+    const jasl::string result =
+        jasl::replace_all(jasl::string_view(text.data(), text.size()),
+                          jasl::static_string("./"),
+                          jasl::static_string("::"));
+    do_not_optimize(result);
+  });
+  print_compare(jasl_replace, std_replace);
+
+  std::cout << "ASCII lower case" << std::endl << std::endl;
+  auto std_lower =
+      measure_units("copy + [std::tolower]", 1, IterCount, [&] {
+        std::string result = text;
+        std::transform(result.begin(), result.end(), result.begin(),
+                       [](char c) {
+                         return static_cast<char>(
+                             std::tolower(static_cast<unsigned char>(c)));
+                       });
+        do_not_optimize(result);
+      });
+  auto jasl_lower = measure_units("[jasl::to_lower]", 1, IterCount, [&] {
+    const jasl::string result =
+        jasl::to_lower(jasl::string_view(text.data(), text.size()));
+    do_not_optimize(result);
+  });
+  print_compare(jasl_lower, std_lower);
+  print_throughput(jasl_lower, bytes);
+
+  return 0;
+}
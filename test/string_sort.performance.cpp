@@ -0,0 +1,101 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_string_sort.hpp"
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 1000000;
+constexpr static size_t IterCount = 3;
+
+std::string random_word(std::mt19937& gen, size_t min, size_t max) {
+  std::string word;
+  const size_t size = min + gen() % (max - min + 1);
+  for (size_t i = 0; i < size; ++i)
+    word += static_cast<char>('a' + gen() % 26);
+  return word;
+}
+
+std::vector<std::string> urls(std::mt19937& gen) {
+  const char* const hosts[] = {"https://www.example.com/",
+                               "https://api.example.com/v1/",
+                               "https://cdn.example.org/static/",
+                               "http://intranet.local/"};
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    std::string key = hosts[gen() % 4];
+    const size_t segments = 1 + gen() % 4;
+    for (size_t s = 0; s < segments; ++s)
+      key += random_word(gen, 3, 10) + "/";
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+std::vector<std::string> words(std::mt19937& gen) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i)
+    keys.push_back(random_word(gen, 2, 12));
+  return keys;
+}
+
+std::vector<std::string> ids(std::mt19937& gen) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < KeyCount; ++i) {
+    std::string key = "user-";
+    for (size_t k = 0; k < 16; ++k)
+      key += "0123456789abcdef"[gen() % 16];
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+void compare(const char* title, const std::vector<std::string>& keys) {
+  std::cout << title << std::endl << std::endl;
+  std::vector<jasl::string_view> views;
+  for (const std::string& key : keys)
+    views.emplace_back(key.data(), key.size());
+  std::vector<jasl::string_view> work;
+  auto std_sort = measure_units("[std::sort]", keys.size(), IterCount, [&] {
+    work = views;
+    std::sort(work.begin(), work.end());
+    do_not_optimize(work);
+  });
+  auto string_sort =
+      measure_units("[jasl::string_sort]", keys.size(), IterCount, [&] {
+        work = views;
+        jasl::string_sort(work.begin(), work.end());
+        do_not_optimize(work);
+      });
+  auto parallel_sort = measure_units(
+      "[jasl::parallel_string_sort]", keys.size(), IterCount, [&] {
+        work = views;
+        jasl::parallel_string_sort(work.begin(), work.end());
+        do_not_optimize(work);
+      });
+  print_compare(string_sort, std_sort);
+  print_compare(parallel_sort, std_sort);
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares [jasl::string_sort] and "
+               "[jasl::parallel_string_sort]\nto [std::sort] of "
+               "[jasl::string_view]-s.");
+
+  std::mt19937 gen(42);
+  compare("URLs with common prefixes", urls(gen));
+  compare("Words", words(gen));
+  compare("Identifiers with a common prefix", ids(gen));
+
+  return 0;
+}
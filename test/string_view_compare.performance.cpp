@@ -0,0 +1,117 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_string_view.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t KeyCount = 4096;
+constexpr static size_t RoundCount = 200;
+constexpr static size_t IterCount = 5;
+
+// The previous implementation of the operator==.
+bool traits_equal(const jasl::nonstd::string_view& left,
+                  const jasl::nonstd::string_view& right) {
+  if (left.size() != right.size())
+    return false;
+  return std::char_traits<char>::compare(left.data(), right.data(),
+                                         left.size()) == 0;
+}
+
+// The previous implementation of the compare.
+int traits_compare(const jasl::nonstd::string_view& left,
+                   const jasl::nonstd::string_view& right) {
+  size_t rlen = std::min(left.size(), right.size());
+  int retval = std::char_traits<char>::compare(left.data(), right.data(), rlen);
+  if (retval == 0)
+    retval = left.size() == right.size()
+                 ? 0
+                 : (left.size() < right.size() ? -1 : 1);
+  return retval;
+}
+
+// Every second pair is equal, the others differ in the last character, which
+// is the worst case for the comparison.
+std::vector<std::string> make_keys(size_t len, size_t variant) {
+  std::vector<std::string> keys;
+  keys.reserve(KeyCount);
+  for (size_t i = 0; i < KeyCount; ++i) {
+    std::string key(len, 'k');
+    for (size_t j = 0; j < len; ++j)
+      key[j] = static_cast<char>('a' + (i + j) % 26);
+    if (len > 0 && i % 2 == 1 && variant == 1)
+      key[len - 1] = '#';
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+template <typename T, typename EqualT>
+std::pair<std::string, double> measure_equal(std::string description,
+                                             const std::vector<T>& left,
+                                             const std::vector<T>& right,
+                                             EqualT equal) {
+  return measure_units(std::move(description), KeyCount * RoundCount,
+                       IterCount, [&] {
+                         size_t hits = 0;
+                         for (size_t r = 0; r < RoundCount; ++r) {
+                           for (size_t i = 0; i < KeyCount; ++i)
+                             hits += equal(left[i], right[i]) ? 1 : 0;
+                           do_not_optimize(hits);
+                         }
+                       });
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the equality and the compare "
+               "of the\n[jasl::string_view] to the Traits::compare based "
+               "implementation and to [std::string].");
+
+  for (size_t len : {4, 8, 15, 24, 31, 64, 256}) {
+    std::cout << "Key length: " << len << std::endl << std::endl;
+    const std::vector<std::string> left_str = make_keys(len, 0);
+    const std::vector<std::string> right_str = make_keys(len, 1);
+    std::vector<jasl::nonstd::string_view> left_sv;
+    std::vector<jasl::nonstd::string_view> right_sv;
+    for (size_t i = 0; i < KeyCount; ++i) {
+      left_sv.emplace_back(left_str[i].data(), left_str[i].size());
+      right_sv.emplace_back(right_str[i].data(), right_str[i].size());
+    }
+
+    auto traits = measure_equal(
+        "Traits::compare ==", left_sv, right_sv,
+        [](const jasl::nonstd::string_view& l,
+           const jasl::nonstd::string_view& r) { return traits_equal(l, r); });
+    auto jasl_sv = measure_equal("[jasl::string_view] ==", left_sv, right_sv,
+                                 [](const jasl::nonstd::string_view& l,
+                                    const jasl::nonstd::string_view& r) {
+                                   return l == r;
+                                 });
+    auto std_str = measure_equal(
+        "[std::string] ==", left_str, right_str,
+        [](const std::string& l, const std::string& r) { return l == r; });
+    auto traits_cmp = measure_equal(
+        "Traits::compare <", left_sv, right_sv,
+        [](const jasl::nonstd::string_view& l,
+           const jasl::nonstd::string_view& r) {
+          return traits_compare(l, r) < 0;
+        });
+    auto jasl_cmp = measure_equal("[jasl::string_view] <", left_sv, right_sv,
+                                  [](const jasl::nonstd::string_view& l,
+                                     const jasl::nonstd::string_view& r) {
+                                    return l < r;
+                                  });
+
+    print_compare(jasl_sv, traits);
+    print_compare(jasl_sv, std_str);
+    print_compare(jasl_cmp, traits_cmp);
+  }
+
+  return 0;
+}
@@ -0,0 +1,90 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_suffix_array.hpp"
+#include "jasl/jasl_thread_pool.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t TextSize = 8 * 1024 * 1024;
+constexpr static size_t QueryCount = 200;
+constexpr static size_t IterCount = 3;
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the substring queries of "
+               "[jasl::suffix_array]\nto the scans of the text.");
+
+  // words of a small vocabulary, like a log file
+  std::mt19937 gen(42);
+  std::vector<std::string> vocabulary;
+  for (size_t i = 0; i < 5000; ++i) {
+    std::string word;
+    const size_t size = 2 + gen() % 9;
+    for (size_t k = 0; k < size; ++k)
+      word += static_cast<char>('a' + gen() % 26);
+    vocabulary.push_back(word);
+  }
+  std::string text;
+  while (text.size() < TextSize) {
+    text += vocabulary[gen() % vocabulary.size()];
+    text += ' ';
+  }
+  const jasl::string_view text_view(text.data(), text.size());
+  std::vector<std::string> queries;
+  for (size_t i = 0; i < QueryCount; ++i) {
+    queries.push_back(vocabulary[gen() % vocabulary.size()] + ' ' +
+                      vocabulary[gen() % vocabulary.size()].substr(0, 2));
+  }
+
+  std::cout << "Build" << std::endl << std::endl;
+  auto build = measure_units("[jasl::suffix_array]", 1, IterCount, [&] {
+    const jasl::suffix_array index(text_view);
+    do_not_optimize(index.size());
+  });
+  print_throughput(build, static_cast<double>(text.size()));
+  jasl::thread_pool& pool = jasl::default_thread_pool();
+  auto parallel_build =
+      measure_units("[jasl::suffix_array] on the default thread pool", 1,
+                    IterCount, [&] {
+                      const jasl::suffix_array index(text_view, pool);
+                      do_not_optimize(index.size());
+                    });
+  print_throughput(parallel_build, static_cast<double>(text.size()));
+  const jasl::suffix_array index(text_view);
+  std::cout << " - memory usage: " << index.memory_usage() / (1024 * 1024)
+            << " MiB" << std::endl
+            << std::endl;
+
+  std::cout << "Count the occurrences of " << QueryCount << " patterns"
+            << std::endl
+            << std::endl;
+  auto scan = measure_units("[std::string::find] loop", QueryCount, 1, [&] {
+    size_t sum = 0;
+    for (const std::string& query : queries) {
+      for (size_t pos = text.find(query); pos != std::string::npos;
+           pos = text.find(query, pos + 1))
+        ++sum;
+    }
+    do_not_optimize(sum);
+  });
+  auto count = measure_units("[jasl::suffix_array::count]", QueryCount,
+                             IterCount, [&] {
+                               size_t sum = 0;
+                               for (const std::string& query : queries)
+                                 sum += index.count(jasl::string_view(
+                                     query.data(), query.size()));
+                               do_not_optimize(sum);
+                             });
+  print_compare(count, scan);
+
+  return 0;
+}
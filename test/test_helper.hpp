@@ -7,6 +7,9 @@
 #pragma once
 
 #include <iostream>
+#include <string>
+
+#include "jasl/jasl_string_view.hpp"
 
 #define ASSERT_TRUE(expr)                                              \
   do {                                                                 \
@@ -34,3 +37,11 @@
 
 template<typename T>
 void unused_variable(T&&) {}
+
+inline jasl::string_view view(const std::string& str) {
+  return jasl::string_view(str.data(), str.size());
+}
+
+inline std::string to_std(jasl::string_view v) {
+  return std::string(v.data(), v.size());
+}
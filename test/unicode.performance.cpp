@@ -0,0 +1,161 @@
+// JASL: For more information see https://github.com/matepek/jasl
+//
+// Copyright (c) 2018 Mate Pek
+//
+// This code is licensed under the MIT License (MIT).
+
+#include <random>
+#include <string>
+
+#include "jasl/jasl_string_view.hpp"
+#include "jasl/jasl_unicode.hpp"
+#include "performance_helper.hpp"
+
+constexpr static size_t TextSize = size_t(16) << 20;
+constexpr static size_t IterCount = 10;
+
+// Text of code points below the limit.
+std::string make_text(char32_t limit) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned> dist(0x20, limit - 1);
+  std::string text;
+  while (text.size() < TextSize) {
+    char32_t c = static_cast<char32_t>(dist(gen));
+    if (c >= 0xD800 && c <= 0xDFFF)
+      c = ' ';
+    if (c < 0x80) {
+      text += static_cast<char>(c);
+    } else if (c < 0x800) {
+      text += static_cast<char>(0xC0 | (c >> 6));
+      text += static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+      text += static_cast<char>(0xE0 | (c >> 12));
+      text += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      text += static_cast<char>(0x80 | (c & 0x3F));
+    }
+  }
+  return text;
+}
+
+// The usual byte loop.
+bool naive_is_valid(const unsigned char* p, size_t size) {
+  size_t i = 0;
+  while (i < size) {
+    const unsigned char c = p[i];
+    size_t n;
+    if (c < 0x80) {
+      ++i;
+      continue;
+    } else if (c >= 0xC2 && c < 0xE0) {
+      n = 1;
+    } else if (c >= 0xE0 && c < 0xF0) {
+      n = 2;
+    } else if (c >= 0xF0 && c < 0xF5) {
+      n = 3;
+    } else {
+      return false;
+    }
+    if (i + n >= size)
+      return false;
+    const unsigned char d = p[i + 1];
+    if ((c == 0xE0 && d < 0xA0) || (c == 0xED && d > 0x9F) ||
+        (c == 0xF0 && d < 0x90) || (c == 0xF4 && d > 0x8F))
+      return false;
+    for (size_t j = 1; j <= n; ++j) {
+      if ((p[i + j] & 0xC0) != 0x80)
+        return false;
+    }
+    i += n + 1;
+  }
+  return true;
+}
+
+// Decodes (without validation) and encodes one code point at a time, growing
+// the result.
+std::u16string naive_to_utf16(const unsigned char* p, size_t size) {
+  std::u16string result;
+  for (size_t i = 0; i < size;) {
+    const unsigned char c = p[i];
+    char32_t cp;
+    if (c < 0x80) {
+      cp = c;
+      i += 1;
+    } else if (c < 0xE0) {
+      cp = (char32_t(c & 0x1F) << 6) | (p[i + 1] & 0x3F);
+      i += 2;
+    } else {
+      cp = (char32_t(c & 0x0F) << 12) | (char32_t(p[i + 1] & 0x3F) << 6) |
+           (p[i + 2] & 0x3F);
+      i += 3;
+    }
+    result += static_cast<char16_t>(cp);
+  }
+  return result;
+}
+
+int main(int, char* argv[]) {
+  print_header(argv[0],
+               "This performance test compares the [jasl::is_valid_utf8] to "
+               "a byte loop,\nmeasures [jasl::is_ascii] and compares "
+               "[jasl::to_utf16] to a code point loop.");
+#if JASL_INNER_SSSE3
+  std::cout << "SSSE3 lookup validator" << std::endl << std::endl;
+#else
+  std::cout << "No SSSE3 (compile with -mssse3 or -march=native for the "
+               "lookup validator)"
+            << std::endl
+            << std::endl;
+#endif
+
+  const char* const names[] = {"ASCII", "Latin (< U+0800)",
+                               "mixed (< U+FFFF)"};
+  const char32_t limits[] = {0x80, 0x800, 0xFFFF};
+  for (size_t t = 0; t < 3; ++t) {
+    const std::string text = make_text(limits[t]);
+    const jasl::string_view sv(text.data(), text.size());
+    const unsigned char* p =
+        reinterpret_cast<const unsigned char*>(text.data());
+    std::cout << "Text: " << names[t] << std::endl << std::endl;
+
+    auto naive = measure_units("byte loop", 1, IterCount, [&] {
+      do_not_optimize(naive_is_valid(p, text.size()));
+    });
+    auto valid = measure_units("[jasl::is_valid_utf8]", 1, IterCount, [&] {
+      do_not_optimize(jasl::is_valid_utf8(sv));
+    });
+    auto code_points =
+        measure_units("[jasl::utf8_code_points]", 1, IterCount, [&] {
+          char32_t sum = 0;
+          for (char32_t c : jasl::utf8_code_points(sv))
+            sum += c;
+          do_not_optimize(sum);
+        });
+
+    print_compare(valid, naive);
+    print_throughput(naive, static_cast<double>(text.size()));
+    print_throughput(valid, static_cast<double>(text.size()));
+    print_throughput(code_points, static_cast<double>(text.size()));
+    if (t == 0) {
+      auto ascii = measure_units("[jasl::is_ascii]", 1, IterCount, [&] {
+        do_not_optimize(jasl::is_ascii(sv));
+      });
+      print_throughput(ascii, static_cast<double>(text.size()));
+    }
+    auto naive16 = measure_units("code point loop", 1, IterCount, [&] {
+      do_not_optimize(naive_to_utf16(p, text.size()).size());
+    });
+    auto to16 = measure_units("[jasl::to_utf16]", 1, IterCount, [&] {
+      do_not_optimize(jasl::to_utf16(sv).size());
+    });
+    const jasl::u16string utf16 = jasl::to_utf16(sv);
+    auto to8 = measure_units("[jasl::to_utf8]", 1, IterCount, [&] {
+      do_not_optimize(jasl::to_utf8(utf16).size());
+    });
+    print_compare(to16, naive16);
+    print_throughput(to16, static_cast<double>(text.size()));
+    print_throughput(to8, static_cast<double>(text.size()));
+    std::cout << std::endl;
+  }
+
+  return 0;
+}